@@ -0,0 +1,139 @@
+/*
+ * A program to compare the speed of the batch conversion functions against
+ * calling the corresponding single-element function in a loop:
+ *
+ * - atc_time_zone_offset_date_times_from_epoch_seconds() versus
+ *   atc_time_zone_offset_date_time_from_epoch_seconds()
+ * - atc_processor_resolve_local_date_times() versus
+ *   atc_time_zone_offset_date_time_from_local_date_time() followed by
+ *   atc_offset_date_time_to_epoch_seconds()
+ */
+#include <stdio.h> // printf()
+#include <stdlib.h> // exit()
+#include <time.h> // clock_gettime()
+#include <acetimec.h>
+
+enum { kNumElements = 1000000 };
+
+static atc_time_t epoch_seconds[kNumElements];
+static AtcOffsetDateTime odts[kNumElements];
+static int32_t offsets[kNumElements];
+static uint8_t folds[kNumElements];
+
+static AtcLocalDateTime ldts[kNumElements];
+static AtcLocalResolution resolutions[kNumElements];
+
+// Prevents the compiler from optimizing away the conversions.
+static volatile int32_t sink;
+
+static double now_nanos(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Fill epoch_seconds with timestamps from 2020 to 2030, in increasing order if
+// `sorted` is true, or in random order otherwise.
+static void fill_epoch_seconds(bool sorted)
+{
+  AtcLocalDateTime ldt = {2020, 1, 1, 0, 0, 0, 0 /*fold*/};
+  atc_time_t start = atc_local_date_time_to_epoch_seconds(&ldt);
+  const int32_t range = 10 * 366 * 86400;
+  uint32_t state = 1;
+  for (int32_t i = 0; i < kNumElements; i++) {
+    if (sorted) {
+      epoch_seconds[i] = start + (atc_time_t) ((int64_t) range * i
+          / kNumElements);
+    } else {
+      state = state * 1103515245u + 12345u;
+      epoch_seconds[i] = start + (atc_time_t) (state % range);
+    }
+  }
+}
+
+static void run_benchmark(const AtcTimeZone *tz, const char *label)
+{
+  double start = now_nanos();
+  for (int32_t i = 0; i < kNumElements; i++) {
+    atc_time_zone_offset_date_time_from_epoch_seconds(
+        tz, epoch_seconds[i], &odts[i]);
+  }
+  double loop = now_nanos() - start;
+  sink = odts[kNumElements - 1].offset_seconds;
+
+  start = now_nanos();
+  atc_time_zone_offset_date_times_from_epoch_seconds(
+      tz, epoch_seconds, kNumElements, odts);
+  double batch = now_nanos() - start;
+  sink = odts[kNumElements - 1].offset_seconds;
+
+  start = now_nanos();
+  atc_time_zone_offsets_from_epoch_seconds(
+      tz, epoch_seconds, kNumElements, offsets, folds);
+  double batch_offsets = now_nanos() - start;
+  sink = offsets[kNumElements - 1];
+
+  printf("%-8s loop %7.1f ns/elem, batch %7.1f ns/elem, "
+      "batch offsets %7.1f ns/elem\n",
+      label,
+      loop / kNumElements,
+      batch / kNumElements,
+      batch_offsets / kNumElements);
+}
+
+// Fill ldts with the local date times of epoch_seconds, interpreted as UTC.
+static void fill_local_date_times(void)
+{
+  for (int32_t i = 0; i < kNumElements; i++) {
+    atc_local_date_time_from_epoch_seconds(&ldts[i], epoch_seconds[i]);
+  }
+}
+
+static void run_local_benchmark(const AtcTimeZone *tz, const char *label)
+{
+  double start = now_nanos();
+  for (int32_t i = 0; i < kNumElements; i++) {
+    AtcOffsetDateTime odt;
+    atc_time_zone_offset_date_time_from_local_date_time(tz, &ldts[i], &odt);
+    sink = atc_offset_date_time_to_epoch_seconds(&odt);
+  }
+  double loop = now_nanos() - start;
+
+  start = now_nanos();
+  atc_processor_resolve_local_date_times(
+      tz->zone_processor, ldts, kNumElements, resolutions);
+  double batch = now_nanos() - start;
+  sink = resolutions[kNumElements - 1].std_offset_seconds;
+
+  printf("%-8s loop %7.1f ns/elem, batch %7.1f ns/elem\n",
+      label,
+      loop / kNumElements,
+      batch / kNumElements);
+}
+
+int main(void)
+{
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  AtcTimeZone tz = {&kAtcZoneAmerica_Los_Angeles, &processor};
+
+  atc_processor_init_for_zone_info(&processor, tz.zone_info);
+  printf("Zone: America/Los_Angeles, %d elements from 2020 to 2030\n",
+      kNumElements);
+  printf("Epoch seconds\n");
+  fill_epoch_seconds(true);
+  run_benchmark(&tz, "sorted");
+  fill_epoch_seconds(false);
+  run_benchmark(&tz, "random");
+
+  printf("Local date times\n");
+  fill_epoch_seconds(true);
+  fill_local_date_times();
+  run_local_benchmark(&tz, "sorted");
+  fill_epoch_seconds(false);
+  fill_local_date_times();
+  run_local_benchmark(&tz, "random");
+
+  return 0;
+}
@@ -0,0 +1,101 @@
+/*
+ * A program to compare the speed of the Hinnant and the Neri-Schneider
+ * versions of atc_convert_from_internal_days() and
+ * atc_convert_to_internal_days(), over every day of the years [0,10000], and
+ * the speed of atc_local_date_time_from_epoch_seconds() over pseudo-random
+ * 32-bit epoch seconds, using the algorithm selected by
+ * ATC_ENABLE_NERI_SCHNEIDER at build time.
+ */
+#include <stdio.h> // printf()
+#include <time.h> // clock_gettime()
+#include <acetimec.h>
+
+enum {
+  kNumDays = 3652791, // 0000-01-01 to 10000-12-31
+  kNumSeconds = 1000000,
+};
+
+static int16_t years[kNumDays];
+static uint8_t months[kNumDays];
+static uint8_t days[kNumDays];
+static atc_time_t epoch_seconds[kNumSeconds];
+
+static volatile int32_t sink;
+
+static double now_nanos(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void run_days_benchmark(
+    const char *label,
+    void (*from_days)(int32_t, int16_t *, uint8_t *, uint8_t *),
+    int32_t (*to_days)(int16_t, uint8_t, uint8_t))
+{
+  int32_t begin = atc_convert_to_internal_days(0, 1, 1);
+
+  double start = now_nanos();
+  for (int32_t i = 0; i < kNumDays; i++) {
+    from_days(begin + i, &years[i], &months[i], &days[i]);
+  }
+  double from_elapsed = now_nanos() - start;
+
+  start = now_nanos();
+  int32_t errors = 0;
+  for (int32_t i = 0; i < kNumDays; i++) {
+    errors += (to_days(years[i], months[i], days[i]) != begin + i);
+  }
+  double to_elapsed = now_nanos() - start;
+  sink = errors;
+
+  printf("%-15s from_internal_days %5.2f ns/call, to_internal_days %5.2f "
+      "ns/call%s\n",
+      label,
+      from_elapsed / kNumDays,
+      to_elapsed / kNumDays,
+      errors ? " ERROR" : "");
+}
+
+static void run_seconds_benchmark(void)
+{
+  uint32_t state = 1;
+  for (int32_t i = 0; i < kNumSeconds; i++) {
+    state = state * 1103515245u + 12345u;
+    epoch_seconds[i] = (int32_t) state;
+    if (epoch_seconds[i] == kAtcInvalidEpochSeconds) epoch_seconds[i] = 0;
+  }
+
+  double start = now_nanos();
+  for (int32_t i = 0; i < kNumSeconds; i++) {
+    AtcLocalDateTime ldt;
+    atc_local_date_time_from_epoch_seconds(&ldt, epoch_seconds[i]);
+    sink = ldt.second;
+  }
+  double elapsed = now_nanos() - start;
+
+  printf("local_date_time_from_epoch_seconds (ATC_ENABLE_NERI_SCHNEIDER=%d) "
+      "%5.2f ns/call\n",
+      ATC_ENABLE_NERI_SCHNEIDER,
+      elapsed / kNumSeconds);
+}
+
+int main(void)
+{
+  // Touch the arrays, so that the page faults are not measured.
+  for (int32_t i = 0; i < kNumDays; i++) {
+    years[i] = 0;
+    months[i] = 1;
+    days[i] = 1;
+  }
+
+  run_days_benchmark("hinnant",
+      atc_convert_from_internal_days_hinnant,
+      atc_convert_to_internal_days_hinnant);
+  run_days_benchmark("neri_schneider",
+      atc_convert_from_internal_days_neri_schneider,
+      atc_convert_to_internal_days_neri_schneider);
+  run_seconds_benchmark();
+  return 0;
+}
@@ -0,0 +1,136 @@
+/*
+ * A program to measure the contention of the AtcClockService. For 1 to 8
+ * reader threads, it compares the cost of reading the clock and converting it
+ * with an AtcZoneProcessor owned by each thread, and of reading a snapshot of
+ * an AtcClockService. The updater thread of the service updates it as often
+ * as it can, which is the worst case for the readers, instead of once per
+ * second. The results are the elapsed time divided by the number of reads of
+ * each thread, so they grow with the number of threads if there are fewer
+ * CPUs than threads.
+ */
+#include <pthread.h>
+#include <stdio.h> // printf()
+#include <time.h> // clock_gettime()
+#include <acetimec.h>
+
+enum {
+  kNumReads = 1000000,
+  kMaxReaders = 8,
+  kNumZones = 4,
+};
+
+static AtcClockEntry entries[kNumZones];
+static AtcClockService service;
+static const AtcZoneInfo *zone_infos[kNumZones];
+
+static volatile int updater_done;
+static volatile int32_t sink;
+
+static double now_nanos(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static atc_time_t now_epoch_seconds(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  return atc_epoch_seconds_from_unix_seconds(ts.tv_sec);
+}
+
+static void *updater_thread(void *arg)
+{
+  (void) arg;
+  atc_time_t es = now_epoch_seconds();
+  while (!__atomic_load_n(&updater_done, __ATOMIC_ACQUIRE)) {
+    atc_clock_service_update(&service, es++);
+  }
+  return NULL;
+}
+
+// Read the clock and convert it using a processor owned by this thread.
+static void *direct_thread(void *arg)
+{
+  uintptr_t id = (uintptr_t) arg;
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  AtcTimeZone tz = {zone_infos[id % kNumZones], &processor};
+
+  int32_t sum = 0;
+  for (int32_t i = 0; i < kNumReads; i++) {
+    AtcZonedDateTime zdt;
+    AtcZonedExtra extra;
+    atc_time_t es = now_epoch_seconds();
+    atc_zoned_date_time_from_epoch_seconds(&zdt, es, &tz);
+    atc_zoned_extra_from_epoch_seconds(&extra, es, &tz);
+    sum += zdt.second + extra.abbrev[0];
+  }
+  sink = sum;
+  return NULL;
+}
+
+// Read the snapshot of the clock service.
+static void *service_thread(void *arg)
+{
+  uintptr_t id = (uintptr_t) arg;
+  uint16_t index = (uint16_t) (id % kNumZones);
+
+  int32_t sum = 0;
+  for (int32_t i = 0; i < kNumReads; i++) {
+    AtcClockSnapshot snapshot;
+    atc_clock_service_get(&service, index, &snapshot);
+    sum += snapshot.zdt.second + snapshot.extra.abbrev[0];
+  }
+  sink = sum;
+  return NULL;
+}
+
+// Run `num_readers` threads, and return the average ns per read of each
+// thread.
+static double run_readers(void *(*reader)(void *), int num_readers)
+{
+  pthread_t threads[kMaxReaders];
+  double start = now_nanos();
+  for (uintptr_t i = 0; i < (uintptr_t) num_readers; i++) {
+    pthread_create(&threads[i], NULL, reader, (void *) i);
+  }
+  for (int i = 0; i < num_readers; i++) {
+    pthread_join(threads[i], NULL);
+  }
+  double elapsed = now_nanos() - start;
+  return elapsed / kNumReads;
+}
+
+int main(void)
+{
+  zone_infos[0] = &kAtcAllZoneAmerica_Los_Angeles;
+  zone_infos[1] = &kAtcAllZoneEurope_London;
+  zone_infos[2] = &kAtcAllZoneAsia_Tokyo;
+  zone_infos[3] = &kAtcAllZoneAustralia_Sydney;
+
+  atc_clock_service_init(&service, entries, kNumZones);
+  for (int i = 0; i < kNumZones; i++) {
+    uint16_t index;
+    atc_clock_service_add_zone(&service, zone_infos[i], &index);
+  }
+  atc_clock_service_update(&service, now_epoch_seconds());
+
+  pthread_t updater;
+  updater_done = 0;
+  pthread_create(&updater, NULL, updater_thread, NULL);
+
+  printf("Reads per thread: %d\n", kNumReads);
+  printf("%-8s %14s %14s\n", "threads", "direct ns/op", "service ns/op");
+  for (int n = 1; n <= kMaxReaders; n *= 2) {
+    double direct = run_readers(direct_thread, n);
+    double snapshot = run_readers(service_thread, n);
+    printf("%-8d %14.1f %14.1f\n", n, direct, snapshot);
+  }
+
+  __atomic_store_n(&updater_done, 1, __ATOMIC_RELEASE);
+  pthread_join(updater, NULL);
+  printf("Updates: %lu\n", (unsigned long) service.num_updates);
+  return 0;
+}
@@ -0,0 +1,57 @@
+# Common rules of the benchmark programs. Each benchmark Makefile defines its
+# `all` target, then includes this file:
+#
+#	TARGETS := foo_benchmark.out
+#	all: $(TARGETS)
+#	include ../common.mk
+#
+#	foo_benchmark.out: foo_benchmark.c $(ACETIMEC_LIB)
+#		$(CC) $(CFLAGS) -o $@ $^
+#
+# The unoptimized ../src/acetimec.a is not used. Instead, the library is
+# compiled at -O2 into $(ACETIMEC_BUILD_DIR), once for all the benchmarks, so
+# that the numbers reflect a release build. A benchmark which needs a library
+# compiled with different flags defines a variant of it using
+# `$(eval $(call acetimec_library,<name>,<flags>))`, which is built into
+# $(ACETIMEC_BUILD_DIR)/<name>/acetimec.a.
+
+ACETIMEC_BENCHMARKS_DIR := $(patsubst %/,%,$(dir $(lastword $(MAKEFILE_LIST))))
+ACETIMEC_SRC_DIR := $(ACETIMEC_BENCHMARKS_DIR)/../src
+ACETIMEC_BUILD_DIR := $(ACETIMEC_BENCHMARKS_DIR)/build
+
+ACETIMEC_CFLAGS := -std=c11 -Wall -Wextra -Werror -O2 \
+	-I $(ACETIMEC_SRC_DIR) \
+	-D _POSIX_C_SOURCE=200809L
+
+CFLAGS := $(ACETIMEC_CFLAGS)
+
+CXXFLAGS := -std=c++11 -Wall -Wextra -Werror -O2 \
+	-I $(ACETIMEC_SRC_DIR) \
+	-D _POSIX_C_SOURCE=200809L
+
+ACETIMEC_SRCS := \
+	$(wildcard $(ACETIMEC_SRC_DIR)/zoneinfo/*.c) \
+	$(wildcard $(ACETIMEC_SRC_DIR)/acetimec/*.c) \
+	$(wildcard $(ACETIMEC_SRC_DIR)/zonedb/*.c) \
+	$(wildcard $(ACETIMEC_SRC_DIR)/zonedball/*.c) \
+	$(wildcard $(ACETIMEC_SRC_DIR)/zonedbtesting/*.c)
+
+# $(call acetimec_library,NAME,FLAGS) defines the rules of the library
+# $(ACETIMEC_BUILD_DIR)/NAME/acetimec.a, compiled with the additional FLAGS.
+define acetimec_library
+$(ACETIMEC_BUILD_DIR)/$(1)/%.o: $(ACETIMEC_SRC_DIR)/%.c
+	@mkdir -p $$(dir $$@)
+	$$(CC) $$(ACETIMEC_CFLAGS) $(2) -MMD -MP -c -o $$@ $$<
+
+$(ACETIMEC_BUILD_DIR)/$(1)/acetimec.a: \
+		$(patsubst $(ACETIMEC_SRC_DIR)/%.c,$(ACETIMEC_BUILD_DIR)/$(1)/%.o,\
+		$(ACETIMEC_SRCS))
+	rm -f $$@
+	$$(AR) rcs $$@ $$^
+
+-include $(wildcard $(ACETIMEC_BUILD_DIR)/$(1)/*/*.d)
+endef
+
+$(eval $(call acetimec_library,release,))
+
+ACETIMEC_LIB := $(ACETIMEC_BUILD_DIR)/release/acetimec.a
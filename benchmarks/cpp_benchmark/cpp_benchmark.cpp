@@ -0,0 +1,228 @@
+/*
+ * A program to compare the speed of the C++ wrapper in acetimec.hpp with the
+ * C functions that it wraps. The inline helpers (atc::daysInYearMonth() and
+ * the atc::zoneEra*Seconds() accessors) are compared with the C functions over
+ * every month of 400 years and every era of every zone. The value types
+ * LocalDateTime and ZonedDateTime are compared with the C functions over a
+ * stream of pseudo-random epoch seconds in the year 2024.
+ */
+#include <stdio.h> // printf()
+#include <time.h> // clock_gettime()
+#include <acetimec.hpp>
+
+enum {
+  kNumTimestamps = 100000,
+  kMaxEras = 4096,
+  kNumLoops = 10,
+  kNumEraLoops = 1000,
+};
+
+static atc_time_t stream[kNumTimestamps];
+static AtcLocalDateTime ldts[kNumTimestamps];
+static const AtcZoneEra *eras[kMaxEras];
+static int32_t num_eras;
+
+static volatile int32_t sink;
+
+static double now_nanos(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void print_result(
+    const char *label, double c_elapsed, double cpp_elapsed, double num_ops)
+{
+  printf("%-24s C %6.2f ns/op, C++ %6.2f ns/op\n",
+      label, c_elapsed / num_ops, cpp_elapsed / num_ops);
+}
+
+//---------------------------------------------------------------------------
+
+static void run_days_in_year_month(void)
+{
+  double start = now_nanos();
+  for (int loop = 0; loop < kNumEraLoops; loop++) {
+    int32_t sum = 0;
+    for (int16_t year = 2000; year < 2400; year++) {
+      for (uint8_t month = 1; month <= 12; month++) {
+        sum += atc_local_date_days_in_year_month(year + loop, month);
+      }
+    }
+    sink = sum;
+  }
+  double c_elapsed = now_nanos() - start;
+
+  start = now_nanos();
+  for (int loop = 0; loop < kNumEraLoops; loop++) {
+    int32_t sum = 0;
+    for (int16_t year = 2000; year < 2400; year++) {
+      for (uint8_t month = 1; month <= 12; month++) {
+        sum += atc::daysInYearMonth(year + loop, month);
+      }
+    }
+    sink = sum;
+  }
+  double cpp_elapsed = now_nanos() - start;
+
+  print_result("days_in_year_month", c_elapsed, cpp_elapsed,
+      400.0 * 12 * kNumEraLoops);
+}
+
+static void run_zone_era_seconds(void)
+{
+  double start = now_nanos();
+  for (int loop = 0; loop < kNumEraLoops; loop++) {
+    int32_t sum = loop;
+    for (int32_t i = 0; i < num_eras; i++) {
+      const AtcZoneEra *era = eras[i];
+      sum += atc_zone_era_std_offset_seconds(era)
+          + atc_zone_era_dst_offset_seconds(era)
+          + atc_zone_era_until_seconds(era);
+    }
+    sink = sum;
+  }
+  double c_elapsed = now_nanos() - start;
+
+  start = now_nanos();
+  for (int loop = 0; loop < kNumEraLoops; loop++) {
+    int32_t sum = loop;
+    for (int32_t i = 0; i < num_eras; i++) {
+      const AtcZoneEra &era = *eras[i];
+      sum += atc::zoneEraStdOffsetSeconds(era)
+          + atc::zoneEraDstOffsetSeconds(era)
+          + atc::zoneEraUntilSeconds(era);
+    }
+    sink = sum;
+  }
+  double cpp_elapsed = now_nanos() - start;
+
+  print_result("zone_era_*_seconds", c_elapsed, cpp_elapsed,
+      (double) num_eras * kNumEraLoops);
+}
+
+//---------------------------------------------------------------------------
+
+static void run_local_date_time(void)
+{
+  double start = now_nanos();
+  for (int loop = 0; loop < kNumLoops; loop++) {
+    for (int32_t i = 0; i < kNumTimestamps; i++) {
+      AtcLocalDateTime ldt;
+      atc_local_date_time_from_epoch_seconds(&ldt, stream[i]);
+      sink = ldt.hour;
+    }
+  }
+  double c_elapsed = now_nanos() - start;
+
+  start = now_nanos();
+  for (int loop = 0; loop < kNumLoops; loop++) {
+    for (int32_t i = 0; i < kNumTimestamps; i++) {
+      atc::LocalDateTime ldt = atc::LocalDateTime::forEpochSeconds(stream[i]);
+      sink = ldt.hour();
+    }
+  }
+  double cpp_elapsed = now_nanos() - start;
+
+  print_result("LocalDateTime", c_elapsed, cpp_elapsed,
+      (double) kNumTimestamps * kNumLoops);
+}
+
+static void run_zoned_date_time(void)
+{
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  AtcTimeZone tz = {&kAtcAllZoneAmerica_Los_Angeles, &processor};
+  double start = now_nanos();
+  for (int loop = 0; loop < kNumLoops; loop++) {
+    for (int32_t i = 0; i < kNumTimestamps; i++) {
+      AtcZonedDateTime zdt;
+      atc_zoned_date_time_from_epoch_seconds(&zdt, stream[i], &tz);
+      sink = zdt.hour;
+    }
+  }
+  double c_elapsed = now_nanos() - start;
+
+  atc::TimeZone cpp_tz(&kAtcAllZoneAmerica_Los_Angeles);
+  start = now_nanos();
+  for (int loop = 0; loop < kNumLoops; loop++) {
+    for (int32_t i = 0; i < kNumTimestamps; i++) {
+      atc::ZonedDateTime zdt =
+          atc::ZonedDateTime::forEpochSeconds(stream[i], cpp_tz);
+      sink = zdt.hour();
+    }
+  }
+  double cpp_elapsed = now_nanos() - start;
+
+  print_result("ZonedDateTime(epoch)", c_elapsed, cpp_elapsed,
+      (double) kNumTimestamps * kNumLoops);
+}
+
+static void run_zoned_date_time_from_local(void)
+{
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  AtcTimeZone tz = {&kAtcAllZoneAmerica_Los_Angeles, &processor};
+  double start = now_nanos();
+  for (int loop = 0; loop < kNumLoops; loop++) {
+    for (int32_t i = 0; i < kNumTimestamps; i++) {
+      AtcZonedDateTime zdt;
+      atc_zoned_date_time_from_local_date_time(&zdt, &ldts[i], &tz);
+      sink = zdt.offset_seconds;
+    }
+  }
+  double c_elapsed = now_nanos() - start;
+
+  atc::TimeZone cpp_tz(&kAtcAllZoneAmerica_Los_Angeles);
+  start = now_nanos();
+  for (int loop = 0; loop < kNumLoops; loop++) {
+    for (int32_t i = 0; i < kNumTimestamps; i++) {
+      atc::ZonedDateTime zdt = atc::ZonedDateTime::forLocalDateTime(
+          atc::LocalDateTime(ldts[i]), cpp_tz);
+      sink = zdt.offsetSeconds();
+    }
+  }
+  double cpp_elapsed = now_nanos() - start;
+
+  print_result("ZonedDateTime(local)", c_elapsed, cpp_elapsed,
+      (double) kNumTimestamps * kNumLoops);
+}
+
+//---------------------------------------------------------------------------
+
+static void init_eras(void)
+{
+  for (uint16_t i = 0; i < kAtcAllZoneRegistrySize; i++) {
+    const AtcZoneInfo *info = kAtcAllZoneRegistry[i];
+    for (uint8_t j = 0; j < info->num_eras && num_eras < kMaxEras; j++) {
+      eras[num_eras++] = &info->eras[j];
+    }
+  }
+}
+
+static void init_stream(void)
+{
+  AtcLocalDateTime ldt = {2024, 1, 1, 0, 0, 0, 0 /*fold*/};
+  atc_time_t begin = atc_local_date_time_to_epoch_seconds(&ldt);
+  uint32_t seed = 1;
+  for (int32_t i = 0; i < kNumTimestamps; i++) {
+    seed = seed * 1103515245 + 12345;
+    stream[i] = begin + (atc_time_t) (seed % (366 * 86400));
+    atc_local_date_time_from_epoch_seconds(&ldts[i], stream[i]);
+  }
+}
+
+int main(void)
+{
+  init_eras();
+  init_stream();
+
+  printf("Eras: %d, timestamps: %d\n", (int) num_eras, kNumTimestamps);
+  run_days_in_year_month();
+  run_zone_era_seconds();
+  run_local_date_time();
+  run_zoned_date_time();
+  run_zoned_date_time_from_local();
+  return 0;
+}
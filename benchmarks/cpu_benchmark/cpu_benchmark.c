@@ -0,0 +1,295 @@
+/*
+ * A repeatable CPU benchmark of the main operations of the library, over every
+ * zone and link in kAtcAllZoneAndLinkRegistry. Each benchmark measures one
+ * sample per zone, the average ns/op of a batch of operations in that zone
+ * (the fastest of kNumRepeats runs of the batch, to filter out interruptions).
+ * The mean and the p50, p90, p99 and max of the samples are reported, so that
+ * slow zones are visible, not just the average.
+ *
+ * Usage: cpu_benchmark.out [--json]
+ *
+ * The timestamps are generated from a fixed seed, and the epoch year is the
+ * default, so the runs are comparable between releases. With `--json`, the
+ * results are written to stdout as a JSON object.
+ */
+#include <stdio.h> // printf()
+#include <stdlib.h> // qsort()
+#include <string.h> // strcmp()
+#include <time.h> // clock_gettime()
+#include <acetimec.h>
+
+enum {
+  /** Number of zones and links, one sample per entry. */
+  kNumSamples = kAtcAllZoneAndLinkRegistrySize,
+
+  /** Number of operations in the batch of each sample. */
+  kNumOps = 1000,
+
+  /** Number of times that the batch is run, keeping the fastest. */
+  kNumRepeats = 5,
+
+  /** Range of years of the timestamps, and of init_for_year(). */
+  kStartYear = 2000,
+  kUntilYear = 2050,
+};
+
+/** Summary of the samples of a benchmark, in nanoseconds per operation. */
+typedef struct BenchmarkResult {
+  const char *name;
+  double mean;
+  double p50;
+  double p90;
+  double p99;
+  double max;
+} BenchmarkResult;
+
+/**
+ * Run the batch of operations of the benchmark for the zone at `index` of the
+ * registry, returning the number of operations.
+ */
+typedef uint32_t (*BenchmarkFunc)(uint16_t index);
+
+// Inputs shared by all zones. Sorted by time, with about 50 year boundaries.
+static atc_time_t epoch_seconds[kNumOps];
+static AtcLocalDateTime ldts[kNumOps];
+
+static AtcZoneProcessor processor;
+static AtcZoneRegistrar registrar;
+
+// Prevents the compiler from optimizing away the results.
+static volatile int32_t sink;
+
+static double now_nanos(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Fill the inputs with timestamps in [kStartYear, kUntilYear), in increasing
+// order, with a random jitter from a fixed seed.
+static void fill_inputs(void)
+{
+  AtcLocalDateTime ldt = {kStartYear, 1, 1, 0, 0, 0, 0 /*fold*/};
+  atc_time_t start = atc_local_date_time_to_epoch_seconds(&ldt);
+  ldt.year = kUntilYear;
+  atc_time_t until = atc_local_date_time_to_epoch_seconds(&ldt);
+  atc_time_t step = (until - start) / kNumOps;
+
+  uint32_t state = 1;
+  for (uint32_t i = 0; i < kNumOps; i++) {
+    state = state * 1103515245u + 12345u;
+    epoch_seconds[i] = start + (atc_time_t) i * step
+        + (atc_time_t) ((state >> 8) % (uint32_t) step);
+    atc_local_date_time_from_epoch_seconds(&ldts[i], epoch_seconds[i]);
+  }
+}
+
+//---------------------------------------------------------------------------
+
+static AtcTimeZone time_zone_at(uint16_t index)
+{
+  AtcTimeZone tz = {kAtcAllZoneAndLinkRegistry[index], &processor};
+  return tz;
+}
+
+static uint32_t run_local_date_time_from_epoch_seconds(uint16_t index)
+{
+  (void) index;
+  AtcLocalDateTime ldt;
+  for (uint32_t i = 0; i < kNumOps; i++) {
+    atc_local_date_time_from_epoch_seconds(&ldt, epoch_seconds[i]);
+    sink = ldt.day;
+  }
+  return kNumOps;
+}
+
+static uint32_t run_zoned_date_time_from_epoch_seconds(uint16_t index)
+{
+  AtcTimeZone tz = time_zone_at(index);
+  AtcZonedDateTime zdt;
+  for (uint32_t i = 0; i < kNumOps; i++) {
+    atc_zoned_date_time_from_epoch_seconds(&zdt, epoch_seconds[i], &tz);
+    sink = zdt.offset_seconds;
+  }
+  return kNumOps;
+}
+
+static uint32_t run_zoned_date_time_from_local_date_time(uint16_t index)
+{
+  AtcTimeZone tz = time_zone_at(index);
+  AtcZonedDateTime zdt;
+  for (uint32_t i = 0; i < kNumOps; i++) {
+    atc_zoned_date_time_from_local_date_time(&zdt, &ldts[i], &tz);
+    sink = zdt.offset_seconds;
+  }
+  return kNumOps;
+}
+
+// Every call calculates the transitions of a different year.
+static uint32_t run_processor_init_for_year_cold(uint16_t index)
+{
+  atc_processor_init(&processor);
+  atc_processor_init_for_zone_info(
+      &processor, kAtcAllZoneAndLinkRegistry[index]);
+  for (int16_t year = kStartYear; year < kUntilYear; year++) {
+    sink = atc_processor_init_for_year(&processor, year);
+  }
+  return kUntilYear - kStartYear;
+}
+
+// Every call finds the year already in the cache.
+static uint32_t run_processor_init_for_year_warm(uint16_t index)
+{
+  atc_processor_init_for_zone_info(
+      &processor, kAtcAllZoneAndLinkRegistry[index]);
+  for (uint32_t i = 0; i < kNumOps; i++) {
+    sink = atc_processor_init_for_year(&processor, kStartYear);
+  }
+  return kNumOps;
+}
+
+static uint32_t run_registrar_find_by_name(uint16_t index)
+{
+  const char *name = atc_zone_info_zone_name(kAtcAllZoneAndLinkRegistry[index]);
+  for (uint32_t i = 0; i < kNumOps; i++) {
+    sink = (atc_registrar_find_by_name(&registrar, name) != NULL);
+  }
+  return kNumOps;
+}
+
+static uint32_t run_zoned_date_time_print(uint16_t index)
+{
+  AtcTimeZone tz = time_zone_at(index);
+  char buf[64];
+  AtcStringBuffer sb;
+  atc_buf_init(&sb, buf, sizeof(buf));
+
+  // Print a small set of date times, converted once per batch.
+  enum { kNumZdts = 16 };
+  AtcZonedDateTime zdts[kNumZdts];
+  for (uint32_t i = 0; i < kNumZdts; i++) {
+    atc_zoned_date_time_from_epoch_seconds(
+        &zdts[i], epoch_seconds[i * (kNumOps / kNumZdts)], &tz);
+  }
+
+  for (uint32_t i = 0; i < kNumOps; i++) {
+    atc_buf_reset(&sb);
+    atc_zoned_date_time_print(&sb, &zdts[i % kNumZdts]);
+    atc_buf_close(&sb);
+    sink = sb.size;
+  }
+  return kNumOps;
+}
+
+//---------------------------------------------------------------------------
+
+static int compare_doubles(const void *a, const void *b)
+{
+  double x = *(const double *) a;
+  double y = *(const double *) b;
+  return (x > y) - (x < y);
+}
+
+// Return the percentile `p` in [0,100] of the sorted samples, using the
+// nearest-rank method.
+static double percentile(const double *sorted, uint16_t n, double p)
+{
+  uint16_t rank = (uint16_t) (p / 100 * n + 0.999999);
+  if (rank < 1) rank = 1;
+  if (rank > n) rank = n;
+  return sorted[rank - 1];
+}
+
+static BenchmarkResult run_benchmark(const char *name, BenchmarkFunc func)
+{
+  static double samples[kNumSamples];
+  double sum = 0;
+  for (uint16_t i = 0; i < kNumSamples; i++) {
+    double best = 0;
+    for (uint8_t r = 0; r < kNumRepeats; r++) {
+      double start = now_nanos();
+      uint32_t num_ops = func(i);
+      double elapsed = (now_nanos() - start) / num_ops;
+      if (r == 0 || elapsed < best) best = elapsed;
+    }
+    samples[i] = best;
+    sum += best;
+  }
+  qsort(samples, kNumSamples, sizeof(double), compare_doubles);
+
+  BenchmarkResult result;
+  result.name = name;
+  result.mean = sum / kNumSamples;
+  result.p50 = percentile(samples, kNumSamples, 50);
+  result.p90 = percentile(samples, kNumSamples, 90);
+  result.p99 = percentile(samples, kNumSamples, 99);
+  result.max = samples[kNumSamples - 1];
+  return result;
+}
+
+static void print_text(const BenchmarkResult *results, uint8_t n)
+{
+  printf("acetimec %s: %d zones and links, %d ops/sample, ns/op\n",
+      ACE_TIME_C_VERSION_STRING, kNumSamples, kNumOps);
+  printf("%-38s %8s %8s %8s %8s %8s\n",
+      "benchmark", "mean", "p50", "p90", "p99", "max");
+  for (uint8_t i = 0; i < n; i++) {
+    const BenchmarkResult *r = &results[i];
+    printf("%-38s %8.1f %8.1f %8.1f %8.1f %8.1f\n",
+        r->name, r->mean, r->p50, r->p90, r->p99, r->max);
+  }
+}
+
+static void print_json(const BenchmarkResult *results, uint8_t n)
+{
+  printf("{\n");
+  printf("  \"library\": \"acetimec\",\n");
+  printf("  \"version\": \"%s\",\n", ACE_TIME_C_VERSION_STRING);
+  printf("  \"samples\": %d,\n", kNumSamples);
+  printf("  \"ops_per_sample\": %d,\n", kNumOps);
+  printf("  \"unit\": \"ns/op\",\n");
+  printf("  \"results\": [\n");
+  for (uint8_t i = 0; i < n; i++) {
+    const BenchmarkResult *r = &results[i];
+    printf("    {\"name\": \"%s\", \"mean\": %.1f, \"p50\": %.1f, "
+        "\"p90\": %.1f, \"p99\": %.1f, \"max\": %.1f}%s\n",
+        r->name, r->mean, r->p50, r->p90, r->p99, r->max,
+        (i + 1 < n) ? "," : "");
+  }
+  printf("  ]\n");
+  printf("}\n");
+}
+
+int main(int argc, char **argv)
+{
+  bool json = (argc > 1 && strcmp(argv[1], "--json") == 0);
+
+  fill_inputs();
+  atc_processor_init(&processor);
+  atc_registrar_init(
+      &registrar, kAtcAllZoneAndLinkRegistry, kAtcAllZoneAndLinkRegistrySize);
+
+  BenchmarkResult results[] = {
+    run_benchmark("local_date_time_from_epoch_seconds",
+        run_local_date_time_from_epoch_seconds),
+    run_benchmark("zoned_date_time_from_epoch_seconds",
+        run_zoned_date_time_from_epoch_seconds),
+    run_benchmark("zoned_date_time_from_local_date_time",
+        run_zoned_date_time_from_local_date_time),
+    run_benchmark("processor_init_for_year_cold",
+        run_processor_init_for_year_cold),
+    run_benchmark("processor_init_for_year_warm",
+        run_processor_init_for_year_warm),
+    run_benchmark("registrar_find_by_name", run_registrar_find_by_name),
+    run_benchmark("zoned_date_time_print", run_zoned_date_time_print),
+  };
+  uint8_t n = sizeof(results) / sizeof(results[0]);
+
+  if (json) {
+    print_json(results, n);
+  } else {
+    print_text(results, n);
+  }
+  return 0;
+}
@@ -0,0 +1,81 @@
+/*
+ * A program to compare the speed of atc_convert_from_internal_days_n() and
+ * atc_convert_to_internal_days_n() at each level of SIMD instructions
+ * supported by the CPU, over every day of the years [0,10000].
+ */
+#include <stdio.h> // printf()
+#include <time.h> // clock_gettime()
+#include <acetimec.h>
+
+enum {
+  kNumDays = 3652791, // 0000-01-01 to 10000-12-31
+  kNumLoops = 10,
+};
+
+static int32_t internal_days[kNumDays];
+static int16_t years[kNumDays];
+static uint8_t months[kNumDays];
+static uint8_t days[kNumDays];
+
+static volatile int32_t sink;
+
+static double now_nanos(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void run_benchmark(uint8_t level, const char *label)
+{
+  atc_set_simd_level(level);
+  if (atc_get_simd_level() != level) {
+    printf("%-6s not supported\n", label);
+    return;
+  }
+
+  double start = now_nanos();
+  for (int32_t loop = 0; loop < kNumLoops; loop++) {
+    atc_convert_from_internal_days_n(
+        internal_days, kNumDays, years, months, days);
+    sink = years[loop];
+  }
+  double from_days = now_nanos() - start;
+
+  start = now_nanos();
+  for (int32_t loop = 0; loop < kNumLoops; loop++) {
+    atc_convert_to_internal_days_n(
+        years, months, days, kNumDays, internal_days);
+    sink = internal_days[loop];
+  }
+  double to_days = now_nanos() - start;
+
+  int32_t num_calls = kNumDays * kNumLoops;
+  printf("%-6s from_internal_days %5.2f ns/day, to_internal_days %5.2f ns/day"
+      "\n",
+      label,
+      from_days / num_calls,
+      to_days / num_calls);
+}
+
+int main(void)
+{
+  int32_t begin = atc_convert_to_internal_days(0, 1, 1);
+  for (int32_t i = 0; i < kNumDays; i++) {
+    internal_days[i] = begin + i;
+  }
+
+  printf("Days: %d, loops: %d\n", kNumDays, kNumLoops);
+  run_benchmark(kAtcSimdNone, "scalar");
+  run_benchmark(kAtcSimdSse41, "sse4.1");
+  run_benchmark(kAtcSimdAvx2, "avx2");
+
+  // Verify the round trip.
+  for (int32_t i = 0; i < kNumDays; i++) {
+    if (internal_days[i] != begin + i) {
+      printf("ERROR: Mismatch at index %d\n", i);
+      return 1;
+    }
+  }
+  return 0;
+}
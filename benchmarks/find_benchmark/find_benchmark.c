@@ -0,0 +1,126 @@
+/*
+ * A program to measure the speed of atc_processor_find_by_epoch_seconds() and
+ * atc_processor_find_by_local_date_time() on a monotone stream of timestamps
+ * (e.g. a log file), and on timestamps in random order within a single year.
+ * It also measures the time to calculate the transitions of a year
+ * (atc_processor_init_for_year()), which is incurred on every cache miss, and
+ * the lookups in a zone with a constant UTC offset.
+ */
+#include <stdio.h> // printf()
+#include <time.h> // clock_gettime()
+#include <acetimec.h>
+
+enum { kNumElements = 1000000 };
+
+static atc_time_t epoch_seconds[kNumElements];
+static AtcLocalDateTime ldts[kNumElements];
+
+// Prevents the compiler from optimizing away the lookups.
+static volatile int32_t sink;
+
+static double now_nanos(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Fill epoch_seconds and ldts with timestamps in the year 2022, every 30
+// seconds if `sorted` is true, or in random order otherwise.
+static void fill(bool sorted)
+{
+  AtcLocalDateTime ldt = {2022, 1, 1, 0, 0, 0, 0 /*fold*/};
+  atc_time_t start = atc_local_date_time_to_epoch_seconds(&ldt);
+  const int32_t range = 365 * 86400;
+  uint32_t state = 1;
+  for (int32_t i = 0; i < kNumElements; i++) {
+    if (sorted) {
+      epoch_seconds[i] = start + (atc_time_t) i * 30;
+    } else {
+      state = state * 1103515245u + 12345u;
+      epoch_seconds[i] = start + (atc_time_t) (state % range);
+    }
+    atc_local_date_time_from_epoch_seconds(&ldts[i], epoch_seconds[i]);
+  }
+}
+
+static void run_benchmark(AtcZoneProcessor *processor, const char *label)
+{
+  AtcFindResult result;
+  double start = now_nanos();
+  for (int32_t i = 0; i < kNumElements; i++) {
+    atc_processor_find_by_epoch_seconds(processor, epoch_seconds[i], &result);
+    sink = result.std_offset_seconds;
+  }
+  double by_seconds = now_nanos() - start;
+
+  start = now_nanos();
+  for (int32_t i = 0; i < kNumElements; i++) {
+    atc_processor_find_by_local_date_time(processor, &ldts[i], &result);
+    sink = result.std_offset_seconds;
+  }
+  double by_local = now_nanos() - start;
+
+  printf("%-8s epoch_seconds %6.1f ns/call, local_date_time %6.1f ns/call\n",
+      label,
+      by_seconds / kNumElements,
+      by_local / kNumElements);
+}
+
+// Calculate the transitions of every zone for every year in [2000,2050).
+static void run_init_benchmark(void)
+{
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  uint32_t count = 0;
+  double start = now_nanos();
+  for (uint16_t i = 0; i < kAtcZoneRegistrySize; i++) {
+    atc_processor_init_for_zone_info(&processor, kAtcZoneRegistry[i]);
+    for (int16_t year = 2000; year < 2050; year++) {
+      atc_processor_init_for_year(&processor, year);
+      count++;
+    }
+  }
+  double elapsed = now_nanos() - start;
+  printf("init_for_year, all zones 2000-2050: %6.1f ns/call\n",
+      elapsed / count);
+}
+
+// Look up random timestamps in [2000,2050) in a zone with a constant UTC
+// offset, so that almost every lookup falls in a different year than the
+// previous one.
+static void run_fixed_offset_benchmark(void)
+{
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  atc_processor_init_for_zone_info(&processor, &kAtcZoneAsia_Kolkata);
+
+  AtcLocalDateTime ldt = {2000, 1, 1, 0, 0, 0, 0 /*fold*/};
+  atc_time_t start = atc_local_date_time_to_epoch_seconds(&ldt);
+  const uint32_t range = (uint32_t) 18262 * 86400;
+  uint32_t state = 1;
+  for (int32_t i = 0; i < kNumElements; i++) {
+    state = state * 1103515245u + 12345u;
+    epoch_seconds[i] = start + (atc_time_t) (state % range);
+    atc_local_date_time_from_epoch_seconds(&ldts[i], epoch_seconds[i]);
+  }
+
+  printf("Zone: Asia/Kolkata, %d lookups in 2000-2050\n", kNumElements);
+  run_benchmark(&processor, "fixed");
+}
+
+int main(void)
+{
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  atc_processor_init_for_zone_info(&processor, &kAtcZoneAmerica_Los_Angeles);
+
+  printf("Zone: America/Los_Angeles, %d lookups in 2022\n", kNumElements);
+  fill(true);
+  run_benchmark(&processor, "sorted");
+  fill(false);
+  run_benchmark(&processor, "random");
+  run_init_benchmark();
+  run_fixed_offset_benchmark();
+  return 0;
+}
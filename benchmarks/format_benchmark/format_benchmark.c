@@ -0,0 +1,110 @@
+/*
+ * A program to compare the speed of formatting a batch of log timestamps
+ * using gmtime_r() and strftime(), using atc_local_date_time_print() into an
+ * AtcStringBuffer, and using atc_large_print_epoch_seconds_n() into a single
+ * AtcLargeStringBuffer. The timestamps increase by a pseudo-random number of
+ * milliseconds, like those of a busy log.
+ */
+#include <stdio.h> // printf()
+#include <string.h> // memcpy()
+#include <time.h> // clock_gettime(), gmtime_r(), strftime()
+#include <acetimec.h>
+
+enum {
+  kNumTimestamps = 1000000,
+  kBufSize = kNumTimestamps * (kAtcTimestampOffsetLength + 1),
+};
+
+static atc_time_t epoch_seconds[kNumTimestamps];
+static char output[kBufSize + 1];
+
+static volatile char sink;
+
+static double now_nanos(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void print_result(const char *label, double elapsed, size_t bytes)
+{
+  printf("%-22s %6.1f ns/timestamp %7.1f MB/s\n",
+      label,
+      elapsed / kNumTimestamps,
+      bytes / elapsed * 1e3);
+}
+
+static void run_strftime(void)
+{
+  int64_t unix_offset = atc_unix_seconds_from_epoch_seconds(0);
+  double start = now_nanos();
+  size_t size = 0;
+  for (int32_t i = 0; i < kNumTimestamps; i++) {
+    time_t t = (time_t) (epoch_seconds[i] + unix_offset);
+    struct tm tm;
+    gmtime_r(&t, &tm);
+    size += strftime(&output[size], kBufSize - size,
+        "%Y-%m-%dT%H:%M:%SZ\n", &tm);
+  }
+  double elapsed = now_nanos() - start;
+  sink = output[size - 2];
+  print_result("gmtime_r+strftime", elapsed, size);
+}
+
+static void run_string_buffer(void)
+{
+  double start = now_nanos();
+  size_t size = 0;
+  for (int32_t i = 0; i < kNumTimestamps; i++) {
+    AtcLocalDateTime ldt;
+    atc_local_date_time_from_epoch_seconds(&ldt, epoch_seconds[i]);
+    char buf[32];
+    AtcStringBuffer sb;
+    atc_buf_init(&sb, buf, sizeof(buf));
+    atc_local_date_time_print(&sb, &ldt);
+    atc_print_char(&sb, 'Z');
+    atc_print_char(&sb, '\n');
+    memcpy(&output[size], sb.p, sb.size);
+    size += sb.size;
+  }
+  double elapsed = now_nanos() - start;
+  sink = output[size - 2];
+  print_result("AtcStringBuffer", elapsed, size);
+}
+
+static void run_batch(const AtcTimeZone *tz, const char *label)
+{
+  AtcLargeStringBuffer sb;
+  atc_large_buf_init(&sb, output, sizeof(output));
+  double start = now_nanos();
+  size_t n = atc_large_print_epoch_seconds_n(
+      &sb, epoch_seconds, kNumTimestamps, tz, '\n');
+  double elapsed = now_nanos() - start;
+  if (n != kNumTimestamps) printf("ERROR: printed %lu\n", (unsigned long) n);
+  sink = output[sb.size - 2];
+  print_result(label, elapsed, sb.size);
+}
+
+int main(void)
+{
+  uint32_t state = 1;
+  uint32_t millis = 0;
+  atc_time_t base = atc_epoch_seconds_from_unix_seconds(1704067200); // 2024
+  for (int32_t i = 0; i < kNumTimestamps; i++) {
+    state = state * 1103515245u + 12345u;
+    millis += (state >> 16) % 200;
+    epoch_seconds[i] = base + millis / 1000;
+  }
+
+  printf("Timestamps: %d\n", kNumTimestamps);
+  run_strftime();
+  run_string_buffer();
+  run_batch(NULL, "batch UTC");
+
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  AtcTimeZone tz = {&kAtcAllZoneAmerica_Los_Angeles, &processor};
+  run_batch(&tz, "batch Los_Angeles");
+  return 0;
+}
@@ -0,0 +1,133 @@
+/*
+ * A program to measure the throughput in MB/s of atc_offset_date_time_parse()
+ * and atc_zoned_date_time_parse(), with and without the SSE4.1 instructions,
+ * compared to sscanf(). The inputs are pseudo-random RFC 3339 strings such as
+ * "2031-07-14T09:26:53+05:30".
+ */
+#include <stdio.h> // printf(), sscanf(), snprintf()
+#include <string.h> // strlen()
+#include <time.h> // clock_gettime()
+#include <acetimec.h>
+
+enum {
+  kNumStrings = 200000,
+  kStringSize = 64,
+  kNumLoops = 10,
+};
+
+static char strings[kNumStrings][kStringSize];
+static size_t lengths[kNumStrings];
+static size_t total_bytes;
+
+static volatile int32_t sink;
+
+static double now_nanos(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Fill the strings with "YYYY-MM-DDThh:mm:ss+hh:mm" and the given suffix.
+static void fill(const char *suffix)
+{
+  uint32_t state = 1;
+  total_bytes = 0;
+  for (int32_t i = 0; i < kNumStrings; i++) {
+    state = state * 1103515245u + 12345u;
+    uint32_t r = state >> 4;
+    snprintf(strings[i], kStringSize,
+        "%04u-%02u-%02uT%02u:%02u:%02u%c%02u:%02u%s",
+        2000 + r % 50, 1 + (r >> 6) % 12, 1 + (r >> 10) % 28,
+        (r >> 15) % 24, (r >> 20) % 60, (r >> 3) % 60,
+        (r & 1) ? '-' : '+', (r >> 8) % 12, ((r >> 12) % 2) * 30,
+        suffix);
+    lengths[i] = strlen(strings[i]);
+    total_bytes += lengths[i];
+  }
+}
+
+static void print_result(const char *label, double elapsed, int32_t errors)
+{
+  double bytes = (double) total_bytes * kNumLoops;
+  double calls = (double) kNumStrings * kNumLoops;
+  printf("%-22s %7.1f MB/s %6.1f ns/call%s\n",
+      label,
+      bytes / elapsed * 1e3,
+      elapsed / calls,
+      errors ? " ERROR" : "");
+}
+
+static void run_sscanf(void)
+{
+  int32_t errors = 0;
+  double start = now_nanos();
+  for (int32_t loop = 0; loop < kNumLoops; loop++) {
+    for (int32_t i = 0; i < kNumStrings; i++) {
+      int year, month, day, hour, minute, second, oh, om;
+      char sign;
+      int n = sscanf(strings[i], "%4d-%2d-%2dT%2d:%2d:%2d%c%2d:%2d",
+          &year, &month, &day, &hour, &minute, &second, &sign, &oh, &om);
+      errors += (n != 9);
+      sink = second;
+    }
+  }
+  print_result("sscanf", now_nanos() - start, errors);
+}
+
+static void run_offset(uint8_t level, const char *label)
+{
+  atc_set_simd_level(level);
+  int32_t errors = 0;
+  double start = now_nanos();
+  for (int32_t loop = 0; loop < kNumLoops; loop++) {
+    for (int32_t i = 0; i < kNumStrings; i++) {
+      AtcOffsetDateTime odt;
+      errors += atc_offset_date_time_parse(&odt, strings[i], lengths[i]);
+      sink = odt.second;
+    }
+  }
+  print_result(label, now_nanos() - start, errors);
+}
+
+static void run_zoned(
+    uint8_t level,
+    const char *label,
+    const AtcZoneRegistrar *registrar,
+    AtcZoneProcessor *processor)
+{
+  atc_set_simd_level(level);
+  int32_t errors = 0;
+  double start = now_nanos();
+  for (int32_t loop = 0; loop < kNumLoops; loop++) {
+    for (int32_t i = 0; i < kNumStrings; i++) {
+      AtcZonedDateTime zdt;
+      errors += atc_zoned_date_time_parse(
+          &zdt, strings[i], lengths[i], registrar, processor);
+      sink = zdt.second;
+    }
+  }
+  print_result(label, now_nanos() - start, errors);
+}
+
+int main(void)
+{
+  fill("");
+  printf("Strings: %d, %lu bytes\n",
+      kNumStrings, (unsigned long) total_bytes);
+  run_sscanf();
+  run_offset(kAtcSimdNone, "offset scalar");
+  run_offset(kAtcSimdSse41, "offset sse4.1");
+
+  AtcZoneRegistrar registrar;
+  atc_registrar_init(&registrar,
+      kAtcAllZoneAndLinkRegistry, kAtcAllZoneAndLinkRegistrySize);
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  fill("[America/Los_Angeles]");
+  printf("Strings: %d, %lu bytes\n",
+      kNumStrings, (unsigned long) total_bytes);
+  run_zoned(kAtcSimdNone, "zoned scalar", &registrar, &processor);
+  run_zoned(kAtcSimdSse41, "zoned sse4.1", &registrar, &processor);
+  return 0;
+}
@@ -0,0 +1,158 @@
+/*
+ * A program to compare the speed of atc_registrar_find_by_name() and
+ * atc_registrar_find_by_id() over kAtcAllZoneAndLinkRegistry, using the
+ * binary search of the sorted registry, and using the perfect hash index
+ * built by atc_registrar_build_index(). The names are looked up in random
+ * order, so that successive lookups touch different zones. It also compares
+ * the prefix search of the name index built by
+ * atc_registrar_build_name_index() with a linear scan of the registry.
+ */
+#include <stdio.h> // printf()
+#include <string.h> // strncmp(), strlen()
+#include <time.h> // clock_gettime()
+#include <acetimec.h>
+
+enum {
+  kSize = kAtcAllZoneAndLinkRegistrySize,
+  kNumLookups = 1000000,
+};
+
+static uint16_t seeds[ATC_REGISTRY_INDEX_NUM_BUCKETS(kSize)];
+static uint32_t ids[kSize];
+static uint16_t indexes[kSize];
+static uint16_t name_indexes[kSize];
+
+// Names and ids to look up, in random order. Every 8th entry is not found.
+static const char *names[kNumLookups];
+static uint32_t zone_ids[kNumLookups];
+
+// Prevents the compiler from optimizing away the lookups.
+static const AtcZoneInfo * volatile sink;
+
+static double now_nanos(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void fill(void)
+{
+  uint32_t state = 1;
+  for (int32_t i = 0; i < kNumLookups; i++) {
+    state = state * 1103515245u + 12345u;
+    if (i % 8 == 7) {
+      names[i] = "Unknown/Zone";
+      zone_ids[i] = state;
+    } else {
+      uint16_t index = (uint16_t) ((state >> 8) % kSize);
+      const AtcZoneInfo *info = kAtcAllZoneAndLinkRegistry[index];
+      names[i] = info->name;
+      zone_ids[i] = info->zone_id;
+    }
+  }
+}
+
+static void run_benchmark(const AtcZoneRegistrar *registrar, const char *label)
+{
+  double start = now_nanos();
+  for (int32_t i = 0; i < kNumLookups; i++) {
+    sink = atc_registrar_find_by_name(registrar, names[i]);
+  }
+  double by_name = now_nanos() - start;
+
+  start = now_nanos();
+  for (int32_t i = 0; i < kNumLookups; i++) {
+    sink = atc_registrar_find_by_id(registrar, zone_ids[i]);
+  }
+  double by_id = now_nanos() - start;
+
+  printf("%-8s find_by_name %6.1f ns/call, find_by_id %6.1f ns/call\n",
+      label,
+      by_name / kNumLookups,
+      by_id / kNumLookups);
+}
+
+// Prefixes typed by a user, one keystroke at a time.
+static const char * const prefixes[] = {
+  "A", "Am", "Ame", "Amer", "Ameri", "Americ", "America", "America/",
+  "America/N", "America/Ne", "America/New", "E", "Eu", "Europe/", "Europe/L",
+};
+enum {
+  kNumPrefixes = sizeof(prefixes) / sizeof(prefixes[0]),
+  kNumPrefixLoops = 10000,
+};
+
+static volatile uint16_t count_sink;
+
+static void run_prefix_benchmark(const AtcZoneRegistrar *registrar)
+{
+  double start = now_nanos();
+  for (int32_t loop = 0; loop < kNumPrefixLoops; loop++) {
+    for (uint16_t p = 0; p < kNumPrefixes; p++) {
+      const char *prefix = prefixes[p];
+      size_t n = strlen(prefix);
+      uint16_t count = 0;
+      for (uint16_t i = 0; i < kSize; i++) {
+        if (strncmp(kAtcAllZoneAndLinkRegistry[i]->name, prefix, n) == 0) {
+          count++;
+        }
+      }
+      count_sink = count;
+    }
+  }
+  double scan = now_nanos() - start;
+
+  start = now_nanos();
+  for (int32_t loop = 0; loop < kNumPrefixLoops; loop++) {
+    for (uint16_t p = 0; p < kNumPrefixes; p++) {
+      uint16_t first;
+      count_sink = atc_registrar_find_by_prefix(registrar, prefixes[p], &first);
+    }
+  }
+  double search = now_nanos() - start;
+
+  int32_t num_calls = kNumPrefixLoops * kNumPrefixes;
+  printf("prefix   scan %8.1f ns/call, name_index %6.1f ns/call\n",
+      scan / num_calls,
+      search / num_calls);
+}
+
+int main(void)
+{
+  fill();
+
+  AtcZoneRegistrar registrar;
+  atc_registrar_init(&registrar, kAtcAllZoneAndLinkRegistry, kSize);
+
+  double start = now_nanos();
+  AtcZoneRegistryIndex index;
+  int8_t err = atc_registrar_build_index(
+      &index, kAtcAllZoneAndLinkRegistry, kSize, seeds, ids, indexes);
+  double build = now_nanos() - start;
+  if (err) {
+    printf("ERROR: Unable to build the index\n");
+    return 1;
+  }
+
+  printf("Registry: kAtcAllZoneAndLinkRegistry (%d zones), %d lookups\n",
+      kSize, kNumLookups);
+  printf("build_index %.1f us, %lu bytes\n",
+      build / 1000,
+      (unsigned long) (sizeof(seeds) + sizeof(ids) + sizeof(indexes)));
+  run_benchmark(&registrar, "binary");
+  atc_registrar_set_index(&registrar, &index);
+  run_benchmark(&registrar, "index");
+
+  start = now_nanos();
+  AtcZoneNameIndex name_index;
+  atc_registrar_build_name_index(
+      &name_index, kAtcAllZoneAndLinkRegistry, kSize, true, name_indexes);
+  build = now_nanos() - start;
+  printf("build_name_index %.1f us, %lu bytes\n",
+      build / 1000,
+      (unsigned long) sizeof(name_indexes));
+  atc_registrar_set_name_index(&registrar, &name_index);
+  run_prefix_benchmark(&registrar);
+  return 0;
+}
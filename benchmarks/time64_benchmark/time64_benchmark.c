@@ -0,0 +1,122 @@
+/*
+ * A program to compare the speed of the default 32-bit atc_time_t with the
+ * 64-bit atc_time_t selected by ATC_TIME64=1. The same source is compiled
+ * twice by the Makefile. It measures the conversions between
+ * AtcLocalDateTime and epoch seconds, the lookup of the UTC offset of a time
+ * zone, and the calculation of the transitions of a year.
+ */
+#include <stdio.h> // printf()
+#include <time.h> // clock_gettime()
+#include <acetimec.h>
+
+enum { kNumElements = 1000000 };
+
+static atc_time_t epoch_seconds[kNumElements];
+static AtcLocalDateTime ldts[kNumElements];
+static AtcOffsetDateTime odts[kNumElements];
+
+// Prevents the compiler from optimizing away the results.
+static volatile int64_t sink;
+
+static double now_nanos(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Fill epoch_seconds and ldts with a monotone stream of timestamps every 2000
+// seconds, from 2000 to about 2063.
+static void fill(void)
+{
+  AtcLocalDateTime ldt = {2000, 1, 1, 0, 0, 0, 0 /*fold*/};
+  atc_time_t start = atc_local_date_time_to_epoch_seconds(&ldt);
+  for (int32_t i = 0; i < kNumElements; i++) {
+    epoch_seconds[i] = start + (atc_time_t) i * 2000;
+    atc_local_date_time_from_epoch_seconds(&ldts[i], epoch_seconds[i]);
+  }
+}
+
+static void print_result(const char *label, double elapsed, uint32_t count)
+{
+  printf("  %-38s %6.1f ns/call\n", label, elapsed / count);
+}
+
+static void run_conversion_benchmark(void)
+{
+  double start = now_nanos();
+  for (int32_t i = 0; i < kNumElements; i++) {
+    sink = atc_local_date_time_to_epoch_seconds(&ldts[i]);
+  }
+  print_result("local_date_time_to_epoch_seconds",
+      now_nanos() - start, kNumElements);
+
+  AtcLocalDateTime ldt;
+  start = now_nanos();
+  for (int32_t i = 0; i < kNumElements; i++) {
+    atc_local_date_time_from_epoch_seconds(&ldt, epoch_seconds[i]);
+    sink = ldt.day;
+  }
+  print_result("local_date_time_from_epoch_seconds",
+      now_nanos() - start, kNumElements);
+}
+
+static void run_time_zone_benchmark(void)
+{
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  AtcTimeZone tz = {&kAtcZoneAmerica_Los_Angeles, &processor};
+
+  AtcOffsetDateTime odt;
+  double start = now_nanos();
+  for (int32_t i = 0; i < kNumElements; i++) {
+    atc_time_zone_offset_date_time_from_epoch_seconds(
+        &tz, epoch_seconds[i], &odt);
+    sink = odt.offset_seconds;
+  }
+  print_result("offset_date_time_from_epoch_seconds",
+      now_nanos() - start, kNumElements);
+
+  start = now_nanos();
+  for (int32_t i = 0; i < kNumElements; i++) {
+    atc_time_zone_offset_date_time_from_local_date_time(&tz, &ldts[i], &odt);
+    sink = odt.offset_seconds;
+  }
+  print_result("offset_date_time_from_local_date_time",
+      now_nanos() - start, kNumElements);
+
+  start = now_nanos();
+  atc_time_zone_offset_date_times_from_epoch_seconds(
+      &tz, epoch_seconds, kNumElements, odts);
+  sink = odts[kNumElements - 1].offset_seconds;
+  print_result("offset_date_times_from_epoch_seconds",
+      now_nanos() - start, kNumElements);
+}
+
+// Calculate the transitions of every zone for every year in [2000,2050).
+static void run_init_benchmark(void)
+{
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  uint32_t count = 0;
+  double start = now_nanos();
+  for (uint16_t i = 0; i < kAtcZoneRegistrySize; i++) {
+    atc_processor_init_for_zone_info(&processor, kAtcZoneRegistry[i]);
+    for (int16_t year = 2000; year < 2050; year++) {
+      atc_processor_init_for_year(&processor, year);
+      count++;
+    }
+  }
+  print_result("processor_init_for_year", now_nanos() - start, count);
+}
+
+int main(void)
+{
+  printf("sizeof(atc_time_t)=%d, %d timestamps from 2000\n",
+      (int) sizeof(atc_time_t), kNumElements);
+  fill();
+  run_conversion_benchmark();
+  run_time_zone_benchmark();
+  run_init_benchmark();
+  return 0;
+}
@@ -0,0 +1,187 @@
+/*
+ * A program to compare the speed of rendering zoned timestamps such as
+ * "2024-03-10 01:59:59 PST" using strftime(), using the pattern compiled by
+ * atc_zoned_format_compile() on every call, and using a pattern compiled once.
+ * The AtcZonedDateTime and AtcZonedExtra are calculated before the timing
+ * loops, so that only the formatting is measured.
+ *
+ * Then it compares the rendering of a stream of log timestamps, which increase
+ * by a pseudo-random number of milliseconds, by converting each one to an
+ * AtcZonedDateTime and AtcZonedExtra, and by using an AtcTimestampRenderer.
+ */
+#include <stdio.h> // printf()
+#include <string.h> // memcpy(), memset(), strlen()
+#include <time.h> // clock_gettime(), strftime()
+#include <acetimec.h>
+
+enum {
+  kNumTimestamps = 100000,
+  kNumLoops = 10,
+  kLineSize = 32,
+};
+
+static const char kPattern[] = "%Y-%m-%d %H:%M:%S %Z";
+
+static atc_time_t stream[kNumTimestamps];
+static AtcZonedDateTime zdts[kNumTimestamps];
+static AtcZonedExtra extras[kNumTimestamps];
+static char output[kNumTimestamps * kLineSize];
+
+static volatile char sink;
+
+static double now_nanos(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void print_result(const char *label, double elapsed)
+{
+  printf("%-22s %6.1f ns/timestamp\n",
+      label, elapsed / ((double) kNumTimestamps * kNumLoops));
+}
+
+static void run_strftime(void)
+{
+  double start = now_nanos();
+  for (int loop = 0; loop < kNumLoops; loop++) {
+    char *p = output;
+    for (int32_t i = 0; i < kNumTimestamps; i++) {
+      const AtcZonedDateTime *zdt = &zdts[i];
+      struct tm tm;
+      memset(&tm, 0, sizeof(tm));
+      tm.tm_year = zdt->year - 1900;
+      tm.tm_mon = zdt->month - 1;
+      tm.tm_mday = zdt->day;
+      tm.tm_hour = zdt->hour;
+      tm.tm_min = zdt->minute;
+      tm.tm_sec = zdt->second;
+      // The %Z of strftime() uses a non-standard field of struct tm, so
+      // append the abbreviation explicitly.
+      size_t n = strftime(p, kLineSize, "%Y-%m-%d %H:%M:%S ", &tm);
+      size_t len = strlen(extras[i].abbrev);
+      memcpy(p + n, extras[i].abbrev, len);
+      p += kLineSize;
+    }
+  }
+  double elapsed = now_nanos() - start;
+  sink = output[0];
+  print_result("strftime", elapsed);
+}
+
+static void run_compile_each(void)
+{
+  double start = now_nanos();
+  for (int loop = 0; loop < kNumLoops; loop++) {
+    char *p = output;
+    for (int32_t i = 0; i < kNumTimestamps; i++) {
+      AtcZonedFormat fmt;
+      atc_zoned_format_compile(&fmt, kPattern);
+      AtcStringBuffer sb;
+      atc_buf_init(&sb, p, kLineSize);
+      atc_zoned_format_print(&sb, &fmt, &zdts[i], &extras[i]);
+      p += kLineSize;
+    }
+  }
+  double elapsed = now_nanos() - start;
+  sink = output[0];
+  print_result("compile+print", elapsed);
+}
+
+static void run_compiled(void)
+{
+  AtcZonedFormat fmt;
+  atc_zoned_format_compile(&fmt, kPattern);
+
+  double start = now_nanos();
+  for (int loop = 0; loop < kNumLoops; loop++) {
+    char *p = output;
+    for (int32_t i = 0; i < kNumTimestamps; i++) {
+      AtcStringBuffer sb;
+      atc_buf_init(&sb, p, kLineSize);
+      atc_zoned_format_print(&sb, &fmt, &zdts[i], &extras[i]);
+      p += kLineSize;
+    }
+  }
+  double elapsed = now_nanos() - start;
+  sink = output[0];
+  print_result("precompiled print", elapsed);
+}
+
+static void run_stream_convert(const AtcTimeZone *tz)
+{
+  AtcZonedFormat fmt;
+  atc_zoned_format_compile(&fmt, kPattern);
+
+  double start = now_nanos();
+  for (int loop = 0; loop < kNumLoops; loop++) {
+    char *p = output;
+    for (int32_t i = 0; i < kNumTimestamps; i++) {
+      AtcZonedDateTime zdt;
+      AtcZonedExtra extra;
+      atc_zoned_date_time_from_epoch_seconds(&zdt, stream[i], tz);
+      atc_zoned_extra_from_epoch_seconds(&extra, stream[i], tz);
+      AtcStringBuffer sb;
+      atc_buf_init(&sb, p, kLineSize);
+      atc_zoned_format_print(&sb, &fmt, &zdt, &extra);
+      p += kLineSize;
+    }
+  }
+  double elapsed = now_nanos() - start;
+  sink = output[0];
+  print_result("stream convert+print", elapsed);
+}
+
+static void run_stream_renderer(const AtcTimeZone *tz)
+{
+  AtcZonedFormat fmt;
+  atc_zoned_format_compile(&fmt, kPattern);
+  AtcTimestampRenderer renderer;
+  atc_timestamp_renderer_init(&renderer, &fmt, tz);
+
+  double start = now_nanos();
+  for (int loop = 0; loop < kNumLoops; loop++) {
+    char *p = output;
+    for (int32_t i = 0; i < kNumTimestamps; i++) {
+      AtcStringBuffer sb;
+      atc_buf_init(&sb, p, kLineSize);
+      atc_timestamp_renderer_print(&renderer, &sb, stream[i]);
+      p += kLineSize;
+    }
+  }
+  double elapsed = now_nanos() - start;
+  sink = output[0];
+  print_result("stream renderer", elapsed);
+}
+
+int main(void)
+{
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  AtcTimeZone tz = {&kAtcAllZoneAmerica_Los_Angeles, &processor};
+
+  // Spread the timestamps over 2 years, to cover both PST and PDT.
+  atc_time_t base = atc_epoch_seconds_from_unix_seconds(1704067200); // 2024
+  for (int32_t i = 0; i < kNumTimestamps; i++) {
+    atc_time_t es = base + (atc_time_t) i * 631;
+    atc_zoned_date_time_from_epoch_seconds(&zdts[i], es, &tz);
+    atc_zoned_extra_from_epoch_seconds(&extras[i], es, &tz);
+  }
+
+  printf("Timestamps: %d x %d\n", kNumTimestamps, kNumLoops);
+  run_strftime();
+  run_compile_each();
+  run_compiled();
+
+  uint32_t state = 1;
+  uint32_t millis = 0;
+  for (int32_t i = 0; i < kNumTimestamps; i++) {
+    state = state * 1103515245u + 12345u;
+    millis += (state >> 16) % 200;
+    stream[i] = base + millis / 1000;
+  }
+  run_stream_convert(&tz);
+  run_stream_renderer(&tz);
+  return 0;
+}
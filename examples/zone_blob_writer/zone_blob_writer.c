@@ -0,0 +1,92 @@
+/*
+ * Write all the zones and links of the zonedball database into a binary blob
+ * file, then read the file back using atc_zone_blob_open() to verify it.
+ *
+ * Usage: zone_blob_writer.out <file>
+ */
+
+#include <stdlib.h> // exit()
+#include <stdio.h>
+#include <acetimec.h>
+
+// Declared as uint32_t for the 4-byte alignment required by the blob.
+static uint32_t buffer[256 * 1024 / sizeof(uint32_t)];
+
+void write_blob(const char *path)
+{
+  size_t written;
+  int8_t err = atc_zone_blob_write(
+      kAtcAllZoneAndLinkRegistry, kAtcAllZoneAndLinkRegistrySize,
+      (uint8_t *) buffer, sizeof(buffer), &written);
+  if (err) {
+    printf("ERROR: Unable to serialize the zone registry\n");
+    exit(1);
+  }
+
+  FILE *f = fopen(path, "wb");
+  if (f == NULL) {
+    printf("ERROR: Unable to open %s\n", path);
+    exit(1);
+  }
+  if (fwrite(buffer, 1, written, f) != written) {
+    printf("ERROR: Unable to write %s\n", path);
+    exit(1);
+  }
+  fclose(f);
+  printf("Wrote %s: %lu bytes\n", path, (unsigned long) written);
+}
+
+void read_blob(const char *path)
+{
+#if ATC_ENABLE_ZONE_BLOB_MMAP
+  AtcZoneBlob blob;
+  int8_t err = atc_zone_blob_open(&blob, path);
+  if (err) {
+    printf("ERROR: Unable to load %s\n", path);
+    exit(1);
+  }
+  printf("TZ version: %s\n", blob.context.tz_version);
+  printf("Zones and links: %u\n", atc_zone_blob_num_zones(&blob));
+
+  // Use a zone of the blob.
+  AtcZoneBlobView view;
+  err = atc_zone_blob_find_by_name(&blob, "America/Los_Angeles", &view);
+  if (err) {
+    printf("ERROR: America/Los_Angeles not found\n");
+    exit(1);
+  }
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  AtcTimeZone tz = {&view.info, &processor};
+  AtcZonedDateTime zdt;
+  AtcLocalDateTime ldt = {2024, 7, 1, 12, 0, 0, 0 /*fold*/};
+  atc_zoned_date_time_from_local_date_time(&zdt, &ldt, &tz);
+  if (atc_zoned_date_time_is_error(&zdt)) {
+    printf("ERROR: Unable to create ZonedDateTime\n");
+    exit(1);
+  }
+
+  char buf[80];
+  AtcStringBuffer sb;
+  atc_buf_init(&sb, buf, sizeof(buf));
+  atc_zoned_date_time_print(&sb, &zdt);
+  atc_buf_close(&sb);
+  printf("Los Angeles: %s\n", sb.p);
+
+  atc_zone_blob_close(&blob);
+#else
+  (void) path;
+  printf("Reading the blob requires ATC_ENABLE_ZONE_BLOB_MMAP\n");
+#endif
+}
+
+int main(int argc, char **argv)
+{
+  if (argc != 2) {
+    printf("Usage: zone_blob_writer.out <file>\n");
+    exit(1);
+  }
+  write_blob(argv[1]);
+  read_blob(argv[1]);
+  return 0;
+}
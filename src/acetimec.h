@@ -20,10 +20,19 @@
 #include "acetimec/offset_date_time.h"
 #include "acetimec/transition.h"
 #include "acetimec/zone_processor.h"
+#include "acetimec/zone_processor_cache.h"
+#include "acetimec/compiled_zone.h"
+#include "acetimec/shared_cache.h"
+#include "acetimec/clock_service.h"
 #include "acetimec/time_zone.h"
+#include "acetimec/tzif.h"
 #include "acetimec/zoned_date_time.h"
 #include "acetimec/zone_registrar.h"
+#include "acetimec/zone_transitions.h"
+#include "acetimec/zone_blob.h"
 #include "acetimec/zoned_extra.h"
+#include "acetimec/timestamp_format.h"
+#include "acetimec/zoned_format.h"
 #include "zonedb/zone_infos.h"
 #include "zonedb/zone_policies.h"
 #include "zonedb/zone_registry.h"
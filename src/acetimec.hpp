@@ -0,0 +1,428 @@
+/*
+ * MIT License
+ * Copyright (c) 2024 Brian T. Park
+ */
+
+/**
+ * @file acetimec.hpp
+ *
+ * A header-only C++ wrapper of the acetimec library. It provides the value
+ * types LocalDateTime and ZonedDateTime which are returned by value instead of
+ * through out-parameters, a ZoneProcessor which owns the AtcZoneProcessor
+ * storage, and a TimeZone which binds an AtcZoneInfo to its ZoneProcessor.
+ *
+ * The small helpers of zone_info_utils.c and local_date.c are duplicated here
+ * as inline functions, so that they can be inlined into the C++ code which
+ * calls them, instead of going through a function call into the library. All
+ * other operations call the C functions directly, and the wrappers add no
+ * overhead of their own.
+ *
+ * The wrapped C structs are available through the raw() methods, so that the
+ * rest of the C API can be used with these types.
+ */
+
+#ifndef ACE_TIME_C_HPP
+#define ACE_TIME_C_HPP
+
+#include <stdint.h>
+#include <utility> // std::move()
+#include "acetimec.h"
+
+namespace atc {
+
+//---------------------------------------------------------------------------
+// Inline versions of the helpers of local_date.c and zone_info_utils.c.
+//---------------------------------------------------------------------------
+
+/** Same as atc_is_leap_year(). */
+inline bool isLeapYear(int16_t year)
+{
+  return ((year % 4 == 0) && (year % 100 != 0)) || (year % 400 == 0);
+}
+
+/** Same as atc_local_date_days_in_year_month(). */
+inline uint8_t daysInYearMonth(int16_t year, uint8_t month)
+{
+  static const uint8_t kDaysInMonth[12] = {
+    31 /*Jan=31*/,
+    28 /*Feb=28*/,
+    31 /*Mar=31*/,
+    30 /*Apr=30*/,
+    31 /*May=31*/,
+    30 /*Jun=30*/,
+    31 /*Jul=31*/,
+    31 /*Aug=31*/,
+    30 /*Sep=30*/,
+    31 /*Oct=31*/,
+    30 /*Nov=30*/,
+    31 /*Dec=31*/,
+  };
+  uint8_t days = kDaysInMonth[month - 1];
+  return (month == 2 && isLeapYear(year)) ? days + 1 : days;
+}
+
+#if ATC_HIRES_ZONEDB
+
+/** Same as atc_zone_era_std_offset_seconds(). */
+inline int32_t zoneEraStdOffsetSeconds(const AtcZoneEra &era)
+{
+  return (int32_t)era.offset_code * 15 + era.offset_remainder;
+}
+
+/** Same as atc_zone_era_dst_offset_seconds(). */
+inline int32_t zoneEraDstOffsetSeconds(const AtcZoneEra &era)
+{
+  return (int32_t)era.delta_minutes * 60;
+}
+
+/** Same as atc_zone_era_until_seconds(). */
+inline int32_t zoneEraUntilSeconds(const AtcZoneEra &era)
+{
+  return era.until_time_code * (int32_t)15 + (era.until_time_modifier & 0x0f);
+}
+
+/** Same as atc_zone_rule_at_seconds(). */
+inline int32_t zoneRuleAtSeconds(const AtcZoneRule &rule)
+{
+  return (int32_t)rule.at_time_code * 15 + (rule.at_time_modifier & 0x0f);
+}
+
+/** Same as atc_zone_rule_dst_offset_seconds(). */
+inline int32_t zoneRuleDstOffsetSeconds(const AtcZoneRule &rule)
+{
+  return (int32_t)rule.delta_minutes * 60;
+}
+
+#else
+
+inline int32_t zoneEraStdOffsetSeconds(const AtcZoneEra &era)
+{
+  return ((era.offset_code * (int32_t)15)
+      + ((era.delta_code & 0xf0) >> 4)) * 60;
+}
+
+inline int32_t zoneEraDstOffsetSeconds(const AtcZoneEra &era)
+{
+  return ((int32_t)(era.delta_code & 0x0f) - 4) * 15 * 60;
+}
+
+inline int32_t zoneEraUntilSeconds(const AtcZoneEra &era)
+{
+  return ((int32_t)era.until_time_code * 15
+      + (era.until_time_modifier & 0x0f)) * 60;
+}
+
+inline int32_t zoneRuleAtSeconds(const AtcZoneRule &rule)
+{
+  return (rule.at_time_code * (int32_t)15
+      + (rule.at_time_modifier & 0x0f)) * 60;
+}
+
+inline int32_t zoneRuleDstOffsetSeconds(const AtcZoneRule &rule)
+{
+  return ((int32_t)(rule.delta_code & 0x0f) - 4) * 15 * 60;
+}
+
+#endif
+
+/** Same as atc_zone_era_until_suffix(). */
+inline uint8_t zoneEraUntilSuffix(const AtcZoneEra &era)
+{
+  return era.until_time_modifier & 0xf0;
+}
+
+/** Same as atc_zone_rule_at_suffix(). */
+inline uint8_t zoneRuleAtSuffix(const AtcZoneRule &rule)
+{
+  return rule.at_time_modifier & 0xf0;
+}
+
+//---------------------------------------------------------------------------
+// ZoneProcessor and TimeZone
+//---------------------------------------------------------------------------
+
+/**
+ * Owner of an AtcZoneProcessor, initialized by the constructor. It cannot be
+ * copied. The AtcZoneProcessor contains pointers into itself, so a move does
+ * not transfer its cached transitions. The new processor starts empty instead,
+ * and is bound to its zone again when it is next used.
+ */
+class ZoneProcessor {
+  public:
+    ZoneProcessor() { atc_processor_init(&processor_); }
+
+    ZoneProcessor(ZoneProcessor &&) noexcept {
+      atc_processor_init(&processor_);
+    }
+
+    ZoneProcessor &operator=(ZoneProcessor &&) noexcept {
+      atc_processor_init(&processor_);
+      return *this;
+    }
+
+    ZoneProcessor(const ZoneProcessor &) = delete;
+    ZoneProcessor &operator=(const ZoneProcessor &) = delete;
+
+    /** Return the wrapped AtcZoneProcessor. */
+    AtcZoneProcessor *raw() { return &processor_; }
+
+  private:
+    AtcZoneProcessor processor_;
+};
+
+/**
+ * A time zone which owns its ZoneProcessor. The processor is only a cache, so
+ * the conversions are const methods. A ZonedDateTime refers to the processor
+ * of its TimeZone, so the TimeZone must not be moved or destroyed while the
+ * ZonedDateTime is used. A TimeZone is not thread-safe.
+ */
+class TimeZone {
+  public:
+    /** Create the time zone of the given zone_info, or UTC if NULL. */
+    explicit TimeZone(const AtcZoneInfo *zone_info = nullptr) :
+        zone_info_(zone_info) {}
+
+    TimeZone(TimeZone &&other) noexcept :
+        zone_info_(other.zone_info_),
+        processor_(std::move(other.processor_)) {}
+
+    TimeZone &operator=(TimeZone &&other) noexcept {
+      zone_info_ = other.zone_info_;
+      processor_ = std::move(other.processor_);
+      return *this;
+    }
+
+    TimeZone(const TimeZone &) = delete;
+    TimeZone &operator=(const TimeZone &) = delete;
+
+    /** Return the zone_info, or NULL for UTC. */
+    const AtcZoneInfo *zoneInfo() const { return zone_info_; }
+
+    /** Return true if this is UTC. */
+    bool isUtc() const { return zone_info_ == nullptr; }
+
+    /** Return the AtcTimeZone used by the C functions. */
+    AtcTimeZone raw() const {
+      AtcTimeZone tz = {zone_info_, processor_.raw()};
+      return tz;
+    }
+
+    /** Return the AtcZonedExtra at the given epoch seconds. */
+    AtcZonedExtra zonedExtra(atc_time_t epoch_seconds) const {
+      AtcTimeZone tz = raw();
+      AtcZonedExtra extra;
+      atc_time_zone_zoned_extra_from_epoch_seconds(&tz, epoch_seconds, &extra);
+      return extra;
+    }
+
+    /** Print the name of the time zone. */
+    void print(AtcStringBuffer *sb) const {
+      AtcTimeZone tz = raw();
+      atc_time_zone_print(sb, &tz);
+    }
+
+  private:
+    const AtcZoneInfo *zone_info_;
+    mutable ZoneProcessor processor_;
+};
+
+//---------------------------------------------------------------------------
+// LocalDateTime and ZonedDateTime
+//---------------------------------------------------------------------------
+
+/**
+ * A value type which wraps an AtcLocalDateTime. The default constructor
+ * creates the error value.
+ */
+class LocalDateTime {
+  public:
+    /** Create from the date time components. */
+    static LocalDateTime forComponents(
+        int16_t year, uint8_t month, uint8_t day,
+        uint8_t hour, uint8_t minute, uint8_t second, uint8_t fold = 0) {
+      LocalDateTime ldt;
+      ldt.ldt_.year = year;
+      ldt.ldt_.month = month;
+      ldt.ldt_.day = day;
+      ldt.ldt_.hour = hour;
+      ldt.ldt_.minute = minute;
+      ldt.ldt_.second = second;
+      ldt.ldt_.fold = fold;
+      return ldt;
+    }
+
+    /** Create from the epoch seconds. Returns an error upon failure. */
+    static LocalDateTime forEpochSeconds(atc_time_t epoch_seconds) {
+      LocalDateTime ldt((Uninitialized()));
+      atc_local_date_time_from_epoch_seconds(&ldt.ldt_, epoch_seconds);
+      return ldt;
+    }
+
+    /** Create from the unix seconds. Returns an error upon failure. */
+    static LocalDateTime forUnixSeconds(int64_t unix_seconds) {
+      LocalDateTime ldt((Uninitialized()));
+      atc_local_date_time_from_unix_seconds(&ldt.ldt_, unix_seconds);
+      return ldt;
+    }
+
+    LocalDateTime() : ldt_() {}
+
+    explicit LocalDateTime(const AtcLocalDateTime &ldt) : ldt_(ldt) {}
+
+    /** Same as atc_local_date_time_is_error(). */
+    bool isError() const { return ldt_.month == 0; }
+
+    int16_t year() const { return ldt_.year; }
+    uint8_t month() const { return ldt_.month; }
+    uint8_t day() const { return ldt_.day; }
+    uint8_t hour() const { return ldt_.hour; }
+    uint8_t minute() const { return ldt_.minute; }
+    uint8_t second() const { return ldt_.second; }
+    uint8_t fold() const { return ldt_.fold; }
+
+    /** Return the ISO day of week, Monday=1 to Sunday=7. */
+    uint8_t dayOfWeek() const {
+      return atc_local_date_day_of_week(ldt_.year, ldt_.month, ldt_.day);
+    }
+
+    /** Return kAtcInvalidEpochSeconds upon failure. */
+    atc_time_t toEpochSeconds() const {
+      return atc_local_date_time_to_epoch_seconds(&ldt_);
+    }
+
+    /** Return kAtcInvalidUnixSeconds upon failure. */
+    int64_t toUnixSeconds() const {
+      return atc_local_date_time_to_unix_seconds(&ldt_);
+    }
+
+    /** Print in ISO 8601 format. */
+    void print(AtcStringBuffer *sb) const {
+      atc_local_date_time_print(sb, &ldt_);
+    }
+
+    /** Return the wrapped AtcLocalDateTime. */
+    const AtcLocalDateTime &raw() const { return ldt_; }
+
+    /** Compare all components, including the fold. */
+    bool operator==(const LocalDateTime &other) const {
+      return ldt_.year == other.ldt_.year
+          && ldt_.month == other.ldt_.month
+          && ldt_.day == other.ldt_.day
+          && ldt_.hour == other.ldt_.hour
+          && ldt_.minute == other.ldt_.minute
+          && ldt_.second == other.ldt_.second
+          && ldt_.fold == other.ldt_.fold;
+    }
+
+    bool operator!=(const LocalDateTime &other) const {
+      return !(*this == other);
+    }
+
+  private:
+    /** Tag of the constructor which leaves the fields uninitialized. */
+    struct Uninitialized {};
+
+    explicit LocalDateTime(Uninitialized) {}
+
+    AtcLocalDateTime ldt_;
+};
+
+/**
+ * A value type which wraps an AtcZonedDateTime. It refers to the
+ * ZoneProcessor of the TimeZone which created it, so it must not outlive that
+ * TimeZone. The default constructor creates the error value.
+ */
+class ZonedDateTime {
+  public:
+    /** Create from the epoch seconds. Returns an error upon failure. */
+    static ZonedDateTime forEpochSeconds(
+        atc_time_t epoch_seconds, const TimeZone &tz) {
+      ZonedDateTime zdt((Uninitialized()));
+      AtcTimeZone atz = tz.raw();
+      atc_zoned_date_time_from_epoch_seconds(&zdt.zdt_, epoch_seconds, &atz);
+      return zdt;
+    }
+
+    /** Create from the unix seconds. Returns an error upon failure. */
+    static ZonedDateTime forUnixSeconds(
+        int64_t unix_seconds, const TimeZone &tz) {
+      ZonedDateTime zdt((Uninitialized()));
+      AtcTimeZone atz = tz.raw();
+      atc_zoned_date_time_from_unix_seconds(&zdt.zdt_, unix_seconds, &atz);
+      return zdt;
+    }
+
+    /**
+     * Create from the local date time in the time zone. The fold of the ldt
+     * selects the occurrence during a gap or an overlap. Returns an error upon
+     * failure.
+     */
+    static ZonedDateTime forLocalDateTime(
+        const LocalDateTime &ldt, const TimeZone &tz) {
+      ZonedDateTime zdt((Uninitialized()));
+      AtcTimeZone atz = tz.raw();
+      atc_zoned_date_time_from_local_date_time(&zdt.zdt_, &ldt.raw(), &atz);
+      return zdt;
+    }
+
+    ZonedDateTime() : zdt_() {}
+
+    explicit ZonedDateTime(const AtcZonedDateTime &zdt) : zdt_(zdt) {}
+
+    /** Same as atc_zoned_date_time_is_error(). */
+    bool isError() const { return zdt_.month == 0; }
+
+    int16_t year() const { return zdt_.year; }
+    uint8_t month() const { return zdt_.month; }
+    uint8_t day() const { return zdt_.day; }
+    uint8_t hour() const { return zdt_.hour; }
+    uint8_t minute() const { return zdt_.minute; }
+    uint8_t second() const { return zdt_.second; }
+    uint8_t fold() const { return zdt_.fold; }
+    int32_t offsetSeconds() const { return zdt_.offset_seconds; }
+
+    /** Return the local date time fields. */
+    LocalDateTime localDateTime() const {
+      return LocalDateTime::forComponents(
+          zdt_.year, zdt_.month, zdt_.day,
+          zdt_.hour, zdt_.minute, zdt_.second, zdt_.fold);
+    }
+
+    /** Return kAtcInvalidEpochSeconds upon failure. */
+    atc_time_t toEpochSeconds() const {
+      return atc_zoned_date_time_to_epoch_seconds(&zdt_);
+    }
+
+    /** Return kAtcInvalidUnixSeconds upon failure. */
+    int64_t toUnixSeconds() const {
+      return atc_zoned_date_time_to_unix_seconds(&zdt_);
+    }
+
+    /** Return the same instant in the time zone `tz`. */
+    ZonedDateTime convert(const TimeZone &tz) const {
+      ZonedDateTime zdt((Uninitialized()));
+      AtcTimeZone atz = tz.raw();
+      atc_zoned_date_time_convert(&zdt_, &atz, &zdt.zdt_);
+      return zdt;
+    }
+
+    /** Print in ISO 8601 format. */
+    void print(AtcStringBuffer *sb) const {
+      atc_zoned_date_time_print(sb, &zdt_);
+    }
+
+    /** Return the wrapped AtcZonedDateTime. */
+    const AtcZonedDateTime &raw() const { return zdt_; }
+
+  private:
+    /** Tag of the constructor which leaves the fields uninitialized. */
+    struct Uninitialized {};
+
+    explicit ZonedDateTime(Uninitialized) {}
+
+    AtcZonedDateTime zdt_;
+};
+
+} // namespace atc
+
+#endif
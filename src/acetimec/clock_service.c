@@ -0,0 +1,105 @@
+/*
+ * MIT License
+ * Copyright (c) 2024 Brian T. Park
+ */
+
+#include "clock_service.h"
+
+#if ATC_ENABLE_CLOCK_SERVICE
+
+#include "common.h" // atc_cpu_relax()
+#include "time_zone.h" // AtcTimeZone
+
+void atc_clock_service_init(
+    AtcClockService *service,
+    AtcClockEntry *entries,
+    uint16_t size)
+{
+  service->entries = entries;
+  service->size = size;
+  service->num_zones = 0;
+  service->num_updates = 0;
+}
+
+int8_t atc_clock_service_add_zone(
+    AtcClockService *service,
+    const AtcZoneInfo *zone_info,
+    uint16_t *index)
+{
+  if (service->num_zones >= service->size) return kAtcErrGeneric;
+
+  AtcClockEntry *entry = &service->entries[service->num_zones];
+  entry->seq = 0;
+  entry->snapshot.epoch_seconds = kAtcInvalidEpochSeconds;
+  atc_zoned_date_time_set_error(&entry->snapshot.zdt);
+  atc_zoned_extra_set_error(&entry->snapshot.extra);
+  atc_processor_init(&entry->processor);
+  entry->tz.zone_info = zone_info;
+  entry->tz.zone_processor = (zone_info == NULL) ? NULL : &entry->processor;
+
+  *index = service->num_zones++;
+  return kAtcErrOk;
+}
+
+void atc_clock_service_update(
+    AtcClockService *service,
+    atc_time_t epoch_seconds)
+{
+  for (uint16_t i = 0; i < service->num_zones; i++) {
+    AtcClockEntry *entry = &service->entries[i];
+    // Only this thread writes the snapshot, so it can be read directly.
+    if (entry->snapshot.epoch_seconds == epoch_seconds) continue;
+
+    // Calculate the next snapshot outside of the critical section, so that
+    // the readers retry only during the copy.
+    AtcClockSnapshot next;
+    next.epoch_seconds = epoch_seconds;
+    atc_zoned_date_time_from_epoch_seconds(
+        &next.zdt, epoch_seconds, &entry->tz);
+    atc_zoned_extra_from_epoch_seconds(
+        &next.extra, epoch_seconds, &entry->tz);
+    next.zdt.tz.zone_processor = NULL;
+
+    uint32_t seq = __atomic_load_n(&entry->seq, __ATOMIC_RELAXED);
+    __atomic_store_n(&entry->seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    entry->snapshot = next;
+    __atomic_store_n(&entry->seq, seq + 2, __ATOMIC_RELEASE);
+    service->num_updates++;
+  }
+}
+
+int8_t atc_clock_service_get(
+    const AtcClockService *service,
+    uint16_t index,
+    AtcClockSnapshot *snapshot)
+{
+  if (index >= service->num_zones) return kAtcErrGeneric;
+
+  const AtcClockEntry *entry = &service->entries[index];
+  for (;;) {
+    uint32_t seq = __atomic_load_n(&entry->seq, __ATOMIC_ACQUIRE);
+    if (seq & 1) {
+      // The updater is copying the snapshot.
+      atc_cpu_relax();
+      continue;
+    }
+
+    *snapshot = entry->snapshot;
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if (__atomic_load_n(&entry->seq, __ATOMIC_RELAXED) == seq) break;
+  }
+
+  if (atc_zoned_date_time_is_error(&snapshot->zdt)
+      || atc_zoned_extra_is_error(&snapshot->extra)) {
+    return kAtcErrGeneric;
+  }
+  return kAtcErrOk;
+}
+
+#else
+
+// ISO C forbids an empty translation unit.
+typedef int atc_clock_service_disabled;
+
+#endif
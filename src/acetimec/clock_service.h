@@ -0,0 +1,162 @@
+/*
+ * MIT License
+ * Copyright (c) 2024 Brian T. Park
+ */
+
+/**
+ * @file clock_service.h
+ *
+ * A service which keeps the current AtcZonedDateTime and AtcZonedExtra of a
+ * set of time zones, so that many threads can read the current date and time
+ * of a zone without reading the clock and converting it themselves. Each
+ * AtcTimeZone needs its own AtcZoneProcessor, which cannot be shared by
+ * threads, so this also avoids an AtcZoneProcessor for every (thread, zone)
+ * combination.
+ *
+ * A single updater thread calls atc_clock_service_update() with the current
+ * epoch seconds, typically once per second. The zones whose snapshot is
+ * already at that second are skipped. Each snapshot is protected by a
+ * sequence lock:
+ *
+ *  * The updater calculates the new snapshot using the AtcZoneProcessor of the
+ *    zone, changes the sequence number from even to odd, copies the snapshot
+ *    in place, then stores the next even sequence number with release
+ *    semantics.
+ *  * Readers never write to the service. They read the sequence number, copy
+ *    the snapshot, then read the sequence number again. If the sequence number
+ *    was odd (update in progress) or changed, the copy is retried.
+ *
+ * Readers never touch an AtcZoneProcessor, and receive a copy of the snapshot
+ * whose `zdt.tz.zone_processor` is NULL, because the processor belongs to the
+ * updater.
+ *
+ * This requires the GCC/Clang `__atomic` builtins. The feature is enabled by
+ * default on hosted GCC or Clang targets except AVR, and can be controlled
+ * explicitly by defining ATC_ENABLE_CLOCK_SERVICE to 0 or 1.
+ */
+
+#ifndef ACE_TIME_C_CLOCK_SERVICE_H
+#define ACE_TIME_C_CLOCK_SERVICE_H
+
+#ifndef ATC_ENABLE_CLOCK_SERVICE
+  #if (defined(__GNUC__) || defined(__clang__)) && !defined(__AVR__)
+    #define ATC_ENABLE_CLOCK_SERVICE 1
+  #else
+    #define ATC_ENABLE_CLOCK_SERVICE 0
+  #endif
+#endif
+
+#if ATC_ENABLE_CLOCK_SERVICE
+
+#include <stdint.h>
+#include "common.h" // atc_time_t
+#include "../zoneinfo/zone_info.h"
+#include "zone_processor.h" // AtcZoneProcessor
+#include "zoned_date_time.h" // AtcZonedDateTime
+#include "zoned_extra.h" // AtcZonedExtra
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** The date and time of a zone at a given epoch seconds. */
+typedef struct AtcClockSnapshot {
+  /** The epoch seconds of the snapshot. */
+  atc_time_t epoch_seconds;
+
+  /** The date and time at epoch_seconds. */
+  AtcZonedDateTime zdt;
+
+  /** The offsets and abbreviation at epoch_seconds. */
+  AtcZonedExtra extra;
+} AtcClockSnapshot;
+
+/** A single zone of the AtcClockService. The fields are private. */
+typedef struct AtcClockEntry {
+  /**
+   * Sequence number of the snapshot, accessed only through atomic operations.
+   * An odd value means that the snapshot is being updated.
+   */
+  uint32_t seq;
+
+  /** The snapshot read by the readers. */
+  AtcClockSnapshot snapshot;
+
+  /** The time zone, used only by the updater. */
+  AtcTimeZone tz;
+
+  /** The processor of `tz`, used only by the updater. */
+  AtcZoneProcessor processor;
+} AtcClockEntry;
+
+/**
+ * The current date and time of a set of zones, updated by a single thread and
+ * read by any number of threads. The array of entries is allocated by the
+ * caller, and is usually a global.
+ */
+typedef struct AtcClockService {
+  /** Array of zones, allocated by the caller. */
+  AtcClockEntry *entries;
+
+  /** Number of elements in `entries`. */
+  uint16_t size;
+
+  /** Number of zones added to the service. */
+  uint16_t num_zones;
+
+  /** Number of snapshots updated by atc_clock_service_update(). */
+  uint32_t num_updates;
+} AtcClockService;
+
+/**
+ * Initialize the AtcClockService with an array of `size` entries. This must be
+ * called once, before the service is shared with other threads.
+ */
+void atc_clock_service_init(
+    AtcClockService *service,
+    AtcClockEntry *entries,
+    uint16_t size);
+
+/**
+ * Add the zone_info to the service, and set `index` to its index for
+ * atc_clock_service_get(). A NULL zone_info means UTC. The snapshot of the
+ * zone is an error until the next atc_clock_service_update(). This must be
+ * called before the service is shared with other threads.
+ *
+ * Returns kAtcErrGeneric if there is no room for the zone.
+ */
+int8_t atc_clock_service_add_zone(
+    AtcClockService *service,
+    const AtcZoneInfo *zone_info,
+    uint16_t *index);
+
+/**
+ * Update the snapshots of all zones to the given epoch_seconds. The zones
+ * which are already at epoch_seconds are skipped, so this can be called more
+ * often than once a second. This must be called by a single thread at a time.
+ */
+void atc_clock_service_update(
+    AtcClockService *service,
+    atc_time_t epoch_seconds);
+
+/**
+ * Copy a consistent snapshot of the zone at `index` into `snapshot`. This can
+ * be called by any number of threads, concurrently with
+ * atc_clock_service_update().
+ *
+ * Returns kAtcErrGeneric if the index is out of range, or if the snapshot is
+ * an error because the zone has not been updated yet, or because the
+ * epoch_seconds could not be converted.
+ */
+int8_t atc_clock_service_get(
+    const AtcClockService *service,
+    uint16_t index,
+    AtcClockSnapshot *snapshot);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+#endif
@@ -5,6 +5,38 @@
 
 #include "common.h"
 
+// The highest instruction set allowed by atc_set_simd_level().
+static uint8_t atc_simd_level_limit = kAtcSimdAvx2;
+
+uint8_t atc_get_simd_level(void)
+{
+#if ATC_ENABLE_SIMD
+  uint8_t level = kAtcSimdNone;
+  if (__builtin_cpu_supports("avx2")) {
+    level = kAtcSimdAvx2;
+  } else if (__builtin_cpu_supports("sse4.1")) {
+    level = kAtcSimdSse41;
+  }
+  return (level < atc_simd_level_limit) ? level : atc_simd_level_limit;
+#else
+  return kAtcSimdNone;
+#endif
+}
+
+void atc_set_simd_level(uint8_t level)
+{
+  atc_simd_level_limit = level;
+}
+
+void atc_cpu_relax(void)
+{
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__) && defined(__GNUC__)
+  __asm__ __volatile__("yield");
+#endif
+}
+
 void atc_copy_replace_string(char *dst, size_t dst_size, const char *src,
     char old_char, const char *new_string)
 {
@@ -13,18 +13,61 @@
 #define ACE_TIME_C_COMMON_H
 
 #include <stddef.h> // size_t
-#include <stdint.h> // INT32_MIN
+#include <stdint.h> // INT32_MIN, INT64_MIN
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * Select the size of `atc_time_t`. By default (ATC_TIME64=0), it is an
+ * `int32_t`, which covers only about +/- 68 years around the current epoch
+ * year. If ATC_TIME64 is defined to 1, it is an `int64_t`, which covers all
+ * years supported by the library, so that the current epoch year no longer
+ * limits the range of valid years. The flag must be the same for the library
+ * and the application.
+ */
+#ifndef ATC_TIME64
+  #define ATC_TIME64 0
+#endif
+
+/**
+ * Select the Neri-Schneider algorithms for the conversions between dates and
+ * days (atc_convert_to_internal_days(), atc_convert_from_internal_days()) and
+ * for splitting the epoch seconds into date and time fields, instead of the
+ * algorithms of AceTime (Hinnant). They use only unsigned arithmetic, with
+ * multiplications and shifts in place of most divisions, and no branches.
+ * The results are identical. Disabled by default.
+ */
+#ifndef ATC_ENABLE_NERI_SCHNEIDER
+  #define ATC_ENABLE_NERI_SCHNEIDER 0
+#endif
+
+/**
+ * Enable the SIMD implementations of the array functions (e.g.
+ * atc_convert_from_internal_days_n()). They use the SSE4.1 or AVX2
+ * instructions on x86 processors, selected at runtime, and require the GCC or
+ * Clang compilers. They are enabled by default where supported, and can be
+ * disabled by defining ATC_ENABLE_SIMD to 0.
+ */
+#ifndef ATC_ENABLE_SIMD
+  #if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+    #define ATC_ENABLE_SIMD 1
+  #else
+    #define ATC_ENABLE_SIMD 0
+  #endif
+#endif
+
 /**
  * The number of seconds from the current epoch. The current epoch is
  * 2050-01-01 00:00:00 UTC by default, but can be adjusted using
  * `atc_set_current_epoch_year()`.
  */
+#if ATC_TIME64
+typedef int64_t atc_time_t;
+#else
 typedef int32_t atc_time_t;
+#endif
 
 enum {
   /** Error code to indicate success. */
@@ -67,11 +110,18 @@ enum {
   kAtcInvalidYear = INT16_MIN,
 
   /** Invalid epoch seconds. */
+#if ATC_TIME64
+  kAtcInvalidEpochSeconds = INT64_MIN,
+#else
   kAtcInvalidEpochSeconds = INT32_MIN,
+#endif
 
   /** Invalid Unix seconds. */
   kAtcInvalidUnixSeconds = INT64_MIN,
 
+  /** Invalid UTC offset seconds. */
+  kAtcInvalidOffsetSeconds = INT32_MIN,
+
   /**
    * Minimum year reasonablly supported by the functions in `local_date.h`.
    * It might be more strict to make this 1, but those functions need to handle
@@ -88,6 +138,40 @@ enum {
   kAtcMaxYear = 10000,
 };
 
+/** The instruction sets used by the array functions. */
+enum {
+  /** Portable C. */
+  kAtcSimdNone = 0,
+
+  /** SSE4.1, 4 lanes of 32 bits. */
+  kAtcSimdSse41 = 1,
+
+  /** AVX2, 8 lanes of 32 bits. */
+  kAtcSimdAvx2 = 2,
+};
+
+/**
+ * Return the instruction set used by the array functions: the best one
+ * supported by the processor, but not above the limit set by
+ * atc_set_simd_level().
+ */
+uint8_t atc_get_simd_level(void);
+
+/**
+ * Limit the instruction set used by the array functions to `level` (e.g.
+ * kAtcSimdNone to use only portable C). This is intended for testing and
+ * benchmarking, and is not thread-safe.
+ */
+void atc_set_simd_level(uint8_t level);
+
+/**
+ * Tell the processor that the calling thread is in a spin-wait loop, using the
+ * `pause` instruction on x86 or `yield` on ARM64, so that it saves power and
+ * yields its execution resources to a sibling hyperthread, which may be the
+ * thread being waited for. Does nothing on other processors.
+ */
+void atc_cpu_relax(void);
+
 /**
  * Copy at most dst_size characters from src to dst, while replacing all
  * occurrence of old_char with new_string. If new_string is "", then replace
@@ -0,0 +1,287 @@
+/*
+ * MIT License
+ * Copyright (c) 2024 Brian T. Park
+ */
+
+#include <string.h> // strcmp(), memcpy()
+#include "common.h" // kAtcErrOk
+#include "epoch.h" // atc_get_current_epoch_year()
+#include "local_date.h" // atc_local_date_to_epoch_days()
+#include "local_time.h" // atc_local_time_to_seconds()
+#include "transition.h"
+#include "zone_processor.h"
+#include "compiled_zone.h"
+
+// Return the index of the given abbreviation in zone->abbrevs, adding it if
+// necessary. Return kAtcCompiledZoneMaxAbbrevs if there is no more room.
+static uint8_t atc_compiled_zone_find_abbrev(
+    AtcCompiledZone *zone,
+    const char *abbrev)
+{
+  for (uint8_t i = 0; i < zone->num_abbrevs; i++) {
+    if (strcmp(zone->abbrevs[i], abbrev) == 0) return i;
+  }
+  if (zone->num_abbrevs >= kAtcCompiledZoneMaxAbbrevs) {
+    return kAtcCompiledZoneMaxAbbrevs;
+  }
+  memcpy(zone->abbrevs[zone->num_abbrevs], abbrev, kAtcAbbrevSize);
+  zone->abbrevs[zone->num_abbrevs][kAtcAbbrevSize - 1] = '\0';
+  return zone->num_abbrevs++;
+}
+
+int8_t atc_compiled_zone_init(
+    AtcCompiledZone *zone,
+    const AtcZoneInfo *zone_info,
+    int16_t start_year,
+    int16_t until_year,
+    AtcCompiledTransition *transitions,
+    uint16_t capacity)
+{
+  zone->zone_info = zone_info;
+  zone->start_year = start_year;
+  zone->until_year = until_year;
+  zone->epoch_year = atc_get_current_epoch_year();
+  zone->transitions = transitions;
+  zone->capacity = capacity;
+  zone->num_transitions = 0;
+  zone->num_abbrevs = 0;
+
+  if (start_year >= until_year
+      || start_year < atc_epoch_valid_year_lower()
+      || until_year > atc_epoch_valid_year_upper()) {
+    return kAtcErrGeneric;
+  }
+  zone->start_epoch_seconds = (atc_time_t) 86400
+      * atc_local_date_to_epoch_days(start_year, 1, 1);
+  zone->until_epoch_seconds = (atc_time_t) 86400
+      * atc_local_date_to_epoch_days(until_year, 1, 1);
+
+  // The 14-month windows of adjacent years overlap, so the same transition
+  // can appear more than once. Transitions which do not change the offsets or
+  // the abbreviation (e.g. the anchor at the start of each window) are merged
+  // into the previous one.
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  atc_processor_init_for_zone_info(&processor, zone_info);
+  uint16_t n = 0;
+  for (int16_t year = start_year; year < until_year; year++) {
+    int8_t err = atc_processor_init_for_year(&processor, year);
+    if (err) return err;
+    atc_processor_calc_all_abbreviations(&processor);
+
+    AtcTransitionStorage *ts = &processor.transition_storage;
+    AtcTransition **begin = atc_transition_storage_get_active_pool_begin(ts);
+    AtcTransition **end = atc_transition_storage_get_active_pool_end(ts);
+    for (AtcTransition **iter = begin; iter != end; ++iter) {
+      const AtcTransition *t = *iter;
+      if (n > 0
+          && t->start_epoch_seconds <= transitions[n - 1].start_epoch_seconds) {
+        continue;
+      }
+
+      uint8_t abbrev_index = atc_compiled_zone_find_abbrev(zone, t->abbrev);
+      if (abbrev_index >= kAtcCompiledZoneMaxAbbrevs) return kAtcErrGeneric;
+      if (n > 0
+          && transitions[n - 1].std_offset_seconds == t->offset_seconds
+          && transitions[n - 1].dst_offset_seconds == t->delta_seconds
+          && transitions[n - 1].abbrev_index == abbrev_index) {
+        continue;
+      }
+
+      if (n >= capacity) return kAtcErrGeneric;
+      AtcCompiledTransition *ct = &transitions[n];
+      ct->start_epoch_seconds = t->start_epoch_seconds;
+      ct->std_offset_seconds = t->offset_seconds;
+      ct->dst_offset_seconds = t->delta_seconds;
+      ct->abbrev_index = abbrev_index;
+      n++;
+    }
+  }
+  zone->num_transitions = n;
+
+  return kAtcErrOk;
+}
+
+//---------------------------------------------------------------------------
+
+static int32_t atc_compiled_transition_offset(const AtcCompiledTransition *t)
+{
+  return t->std_offset_seconds + t->dst_offset_seconds;
+}
+
+// Return the index of the last transition whose start_epoch_seconds is <=
+// epoch_seconds, or -1 if there is none.
+static int32_t atc_compiled_zone_search_epoch_seconds(
+    const AtcCompiledZone *zone,
+    atc_time_t epoch_seconds)
+{
+  const AtcCompiledTransition *transitions = zone->transitions;
+  int32_t a = 0;
+  int32_t b = zone->num_transitions;
+  while (a < b) {
+    int32_t c = a + (b - a) / 2;
+    if (transitions[c].start_epoch_seconds <= epoch_seconds) {
+      a = c + 1;
+    } else {
+      b = c;
+    }
+  }
+  return a - 1;
+}
+
+// Return the index of the last transition whose start time, expressed in the
+// local time of that transition, is <= local_seconds, or -1 if there is none.
+// The local start times are sorted because the offset changes are always much
+// smaller than the interval between transitions.
+static int32_t atc_compiled_zone_search_local_seconds(
+    const AtcCompiledZone *zone,
+    int64_t local_seconds)
+{
+  const AtcCompiledTransition *transitions = zone->transitions;
+  int32_t a = 0;
+  int32_t b = zone->num_transitions;
+  while (a < b) {
+    int32_t c = a + (b - a) / 2;
+    const AtcCompiledTransition *t = &transitions[c];
+    int64_t start = (int64_t) t->start_epoch_seconds
+        + atc_compiled_transition_offset(t);
+    if (start <= local_seconds) {
+      a = c + 1;
+    } else {
+      b = c;
+    }
+  }
+  return a - 1;
+}
+
+static bool atc_compiled_zone_is_valid(const AtcCompiledZone *zone)
+{
+  return zone->num_transitions > 0
+      && zone->epoch_year == atc_get_current_epoch_year();
+}
+
+void atc_compiled_zone_find_by_epoch_seconds(
+    const AtcCompiledZone *zone,
+    atc_time_t epoch_seconds,
+    AtcFindResult *result)
+{
+  if (! atc_compiled_zone_is_valid(zone)
+      || epoch_seconds == kAtcInvalidEpochSeconds
+      || epoch_seconds < zone->start_epoch_seconds
+      || epoch_seconds >= zone->until_epoch_seconds) {
+    result->type = kAtcFindResultNotFound;
+    return;
+  }
+
+  int32_t i = atc_compiled_zone_search_epoch_seconds(zone, epoch_seconds);
+  if (i < 0) {
+    result->type = kAtcFindResultNotFound;
+    return;
+  }
+
+  // Determine if epoch_seconds falls in the overlap shadow of the previous
+  // transition (fold=1), or of the next transition (fold=0). Same logic as
+  // atc_transition_storage_find_for_seconds().
+  const AtcCompiledTransition *curr = &zone->transitions[i];
+  int32_t curr_offset = atc_compiled_transition_offset(curr);
+  uint8_t fold = 0;
+  uint8_t num = 1;
+  if (i > 0) {
+    int32_t shift = curr_offset
+        - atc_compiled_transition_offset(&zone->transitions[i - 1]);
+    if (shift < 0 && epoch_seconds - curr->start_epoch_seconds < -shift) {
+      fold = 1;
+      num = 2;
+    }
+  }
+  if (num == 1 && i + 1 < zone->num_transitions) {
+    const AtcCompiledTransition *next = &zone->transitions[i + 1];
+    int32_t shift = atc_compiled_transition_offset(next) - curr_offset;
+    if (shift < 0 && next->start_epoch_seconds - epoch_seconds <= -shift) {
+      fold = 0;
+      num = 2;
+    }
+  }
+
+  result->type = (num == 2) ? kAtcFindResultOverlap : kAtcFindResultExact;
+  result->fold = fold;
+  result->std_offset_seconds = curr->std_offset_seconds;
+  result->dst_offset_seconds = curr->dst_offset_seconds;
+  result->req_std_offset_seconds = curr->std_offset_seconds;
+  result->req_dst_offset_seconds = curr->dst_offset_seconds;
+  result->abbrev = zone->abbrevs[curr->abbrev_index];
+}
+
+void atc_compiled_zone_find_by_local_date_time(
+    const AtcCompiledZone *zone,
+    const AtcLocalDateTime *ldt,
+    AtcFindResult *result)
+{
+  if (! atc_compiled_zone_is_valid(zone)
+      || atc_local_date_time_is_error(ldt)
+      || ldt->year < zone->start_year
+      || ldt->year >= zone->until_year) {
+    result->type = kAtcFindResultNotFound;
+    return;
+  }
+
+  // The local date time as if it were UTC.
+  int64_t local_seconds = (int64_t) 86400
+      * atc_local_date_to_epoch_days(ldt->year, ldt->month, ldt->day)
+      + atc_local_time_to_seconds(ldt->hour, ldt->minute, ldt->second);
+
+  int32_t i = atc_compiled_zone_search_local_seconds(zone, local_seconds);
+  if (i < 0) {
+    result->type = kAtcFindResultNotFound;
+    return;
+  }
+
+  // Transition 'i' matches if local_seconds is before its local until time.
+  // Transition 'i-1' also matches if local_seconds is within its overlap.
+  const AtcCompiledTransition *transitions = zone->transitions;
+  const AtcCompiledTransition *curr = &transitions[i];
+  const AtcCompiledTransition *prev = (i > 0) ? &transitions[i - 1] : NULL;
+  const AtcCompiledTransition *next = (i + 1 < zone->num_transitions)
+      ? &transitions[i + 1] : NULL;
+  int32_t curr_offset = atc_compiled_transition_offset(curr);
+  bool curr_matches = (next == NULL)
+      || local_seconds < (int64_t) next->start_epoch_seconds + curr_offset;
+  bool prev_matches = (prev != NULL)
+      && local_seconds < (int64_t) curr->start_epoch_seconds
+          + atc_compiled_transition_offset(prev);
+
+  const AtcCompiledTransition *transition;
+  if (curr_matches && prev_matches) {
+    // Overlap
+    transition = (ldt->fold == 0) ? prev : curr;
+    result->type = kAtcFindResultOverlap;
+    result->fold = ldt->fold;
+    result->req_std_offset_seconds = transition->std_offset_seconds;
+    result->req_dst_offset_seconds = transition->dst_offset_seconds;
+  } else if (curr_matches) {
+    // Exact
+    transition = curr;
+    result->type = kAtcFindResultExact;
+    result->fold = 0;
+    result->req_std_offset_seconds = transition->std_offset_seconds;
+    result->req_dst_offset_seconds = transition->dst_offset_seconds;
+  } else {
+    // Gap between 'curr' and 'next'. Same logic as
+    // atc_processor_find_by_local_date_time().
+    result->type = kAtcFindResultGap;
+    result->fold = 0;
+    if (ldt->fold == 0) {
+      result->req_std_offset_seconds = curr->std_offset_seconds;
+      result->req_dst_offset_seconds = curr->dst_offset_seconds;
+      transition = next;
+    } else {
+      result->req_std_offset_seconds = next->std_offset_seconds;
+      result->req_dst_offset_seconds = next->dst_offset_seconds;
+      transition = curr;
+    }
+  }
+
+  result->std_offset_seconds = transition->std_offset_seconds;
+  result->dst_offset_seconds = transition->dst_offset_seconds;
+  result->abbrev = zone->abbrevs[transition->abbrev_index];
+}
@@ -0,0 +1,138 @@
+/*
+ * MIT License
+ * Copyright (c) 2024 Brian T. Park
+ */
+
+/**
+ * @file compiled_zone.h
+ *
+ * A read-only, flattened table of the UTC offset transitions of a single time
+ * zone over a range of years. The table is built once from an AtcZoneInfo
+ * using the AtcZoneProcessor, then queries by epoch seconds or by
+ * AtcLocalDateTime are answered using a binary search over the table, without
+ * regenerating the transitions of each year.
+ *
+ * This is useful for applications which perform a large number of lookups
+ * over a known range of years, and can afford the memory needed to hold every
+ * transition in that range.
+ */
+
+#ifndef ACE_TIME_C_COMPILED_ZONE_H
+#define ACE_TIME_C_COMPILED_ZONE_H
+
+#include <stdint.h>
+#include "common.h" // atc_time_t
+#include "../zoneinfo/zone_info.h"
+#include "local_date_time.h" // AtcLocalDateTime
+#include "transition.h" // kAtcAbbrevSize
+#include "zone_processor.h" // AtcFindResult
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+  /** Maximum number of distinct abbreviations in an AtcCompiledZone. */
+  kAtcCompiledZoneMaxAbbrevs = 16,
+};
+
+/** A single UTC offset transition in an AtcCompiledZone. */
+typedef struct AtcCompiledTransition {
+  /** Epoch seconds when this transition takes effect. */
+  atc_time_t start_epoch_seconds;
+
+  /** The STD offset seconds, not the total effective UTC offset. */
+  int32_t std_offset_seconds;
+
+  /** The DST offset seconds. */
+  int32_t dst_offset_seconds;
+
+  /** Index into AtcCompiledZone.abbrevs. */
+  uint8_t abbrev_index;
+} AtcCompiledTransition;
+
+/**
+ * The flattened transitions of a time zone over the years [start_year,
+ * until_year). The array of transitions is allocated by the caller and given
+ * to atc_compiled_zone_init().
+ */
+typedef struct AtcCompiledZone {
+  /** The time zone described by this table. */
+  const AtcZoneInfo *zone_info;
+
+  /** First year (inclusive) covered by this table. */
+  int16_t start_year;
+
+  /** Last year (exclusive) covered by this table. */
+  int16_t until_year;
+
+  /** Epoch year used to calculate the `start_epoch_seconds` fields. */
+  int16_t epoch_year;
+
+  /** Epoch seconds of {start_year}-01-01T00:00:00 UTC. */
+  atc_time_t start_epoch_seconds;
+
+  /** Epoch seconds of {until_year}-01-01T00:00:00 UTC. */
+  atc_time_t until_epoch_seconds;
+
+  /** Transitions sorted by start_epoch_seconds, allocated by the caller. */
+  AtcCompiledTransition *transitions;
+
+  /** Number of elements allocated in `transitions`. */
+  uint16_t capacity;
+
+  /** Number of valid elements in `transitions`. */
+  uint16_t num_transitions;
+
+  /** Number of valid elements in `abbrevs`. */
+  uint8_t num_abbrevs;
+
+  /** Distinct abbreviations, indexed by AtcCompiledTransition.abbrev_index. */
+  char abbrevs[kAtcCompiledZoneMaxAbbrevs][kAtcAbbrevSize];
+} AtcCompiledZone;
+
+/**
+ * Build the AtcCompiledZone for the given zone_info over the years
+ * [start_year, until_year), using the `transitions` array of size `capacity`
+ * as the storage. The range of years must be within
+ * [atc_epoch_valid_year_lower(), atc_epoch_valid_year_upper()) of the current
+ * epoch year. If the current epoch year is changed, the AtcCompiledZone must
+ * be rebuilt.
+ *
+ * Return non-zero error code upon failure, for example, if the range of years
+ * is invalid, or if the `transitions` array is too small.
+ */
+int8_t atc_compiled_zone_init(
+    AtcCompiledZone *zone,
+    const AtcZoneInfo *zone_info,
+    int16_t start_year,
+    int16_t until_year,
+    AtcCompiledTransition *transitions,
+    uint16_t capacity);
+
+/**
+ * Find the AtcFindResult at the given epoch_seconds, with the result status in
+ * `result.type`. Returns kAtcFindResultNotFound if epoch_seconds is outside of
+ * the range of years of the AtcCompiledZone.
+ */
+void atc_compiled_zone_find_by_epoch_seconds(
+    const AtcCompiledZone *zone,
+    atc_time_t epoch_seconds,
+    AtcFindResult *result);
+
+/**
+ * Find the AtcFindResult at the given LocalDateTime and fold, with the same
+ * semantics as atc_processor_find_by_local_date_time(). Returns
+ * kAtcFindResultNotFound if ldt is outside of the range of years of the
+ * AtcCompiledZone.
+ */
+void atc_compiled_zone_find_by_local_date_time(
+    const AtcCompiledZone *zone,
+    const AtcLocalDateTime *ldt,
+    AtcFindResult *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -34,8 +34,9 @@ atc_time_t atc_date_tuple_subtract(
 
   // Subtract the days, before converting to seconds, to avoid overflowing the
   // int32_t when a.year or b.year is more than 68 years from the
-  // atc_current_epoch_year.
-  return (da - db) * 86400 + (a->seconds - b->seconds);
+  // atc_current_epoch_year. The multiplication is done in atc_time_t so that
+  // it does not overflow when ATC_TIME64 is enabled.
+  return (atc_time_t) (da - db) * 86400 + (a->seconds - b->seconds);
 }
 
 void atc_date_tuple_expand(
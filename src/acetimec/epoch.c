@@ -4,9 +4,14 @@
  */
 
 #include <stdint.h>
+#include <string.h> // memcpy()
 #include "common.h"
 #include "epoch.h"
 
+#if ATC_ENABLE_SIMD
+#include <immintrin.h>
+#endif
+
 // Initialized to the default current epoch. If this is changed, then the
 // atc_days_to_current_epoch_from_internal must be changed as well.
 int16_t atc_current_epoch_year = kAtcDefaultEpochYear;
@@ -27,6 +32,60 @@ void atc_set_current_epoch_year(int16_t year)
       atc_convert_to_internal_days(year, 1, 1);
 }
 
+void atc_epoch_context_init(AtcEpochContext *ctx, int16_t year)
+{
+  ctx->epoch_year = year;
+  ctx->days_to_current_epoch_from_internal_epoch =
+      atc_convert_to_internal_days(year, 1, 1);
+}
+
+void atc_epoch_context_init_from_current(AtcEpochContext *ctx)
+{
+  ctx->epoch_year = atc_current_epoch_year;
+  ctx->days_to_current_epoch_from_internal_epoch =
+      atc_days_to_current_epoch_from_internal_epoch;
+}
+
+#if ATC_TIME64
+
+// A 64-bit atc_time_t cannot overflow over the years supported by
+// atc_processor_init_for_year(), so the valid range does not depend on the
+// epoch year.
+
+int16_t atc_epoch_context_valid_year_lower(const AtcEpochContext *ctx)
+{
+  (void) ctx;
+  return kAtcMinYear + 1;
+}
+
+int16_t atc_epoch_context_valid_year_upper(const AtcEpochContext *ctx)
+{
+  (void) ctx;
+  return kAtcMaxYear;
+}
+
+int16_t atc_epoch_valid_year_lower(void)
+{
+  return kAtcMinYear + 1;
+}
+
+int16_t atc_epoch_valid_year_upper(void)
+{
+  return kAtcMaxYear;
+}
+
+#else
+
+int16_t atc_epoch_context_valid_year_lower(const AtcEpochContext *ctx)
+{
+  return ctx->epoch_year - 50;
+}
+
+int16_t atc_epoch_context_valid_year_upper(const AtcEpochContext *ctx)
+{
+  return ctx->epoch_year + 50;
+}
+
 int16_t atc_epoch_valid_year_lower(void)
 {
   return atc_get_current_epoch_year() - 50;
@@ -37,6 +96,8 @@ int16_t atc_epoch_valid_year_upper(void)
   return atc_get_current_epoch_year() + 50;
 }
 
+#endif
+
 int64_t atc_unix_seconds_from_epoch_seconds(atc_time_t epoch_seconds)
 {
   if (epoch_seconds == kAtcInvalidEpochSeconds) {
@@ -75,6 +136,52 @@ int32_t atc_epoch_days_from_unix_days(int32_t unix_days)
       - atc_days_to_current_epoch_from_internal_epoch;
 }
 
+int64_t atc_unix_seconds_from_epoch_seconds_ctx(
+    const AtcEpochContext *ctx,
+    atc_time_t epoch_seconds)
+{
+  if (epoch_seconds == kAtcInvalidEpochSeconds) {
+    return kAtcInvalidUnixSeconds;
+  } else {
+    return (int64_t) epoch_seconds
+        + (int64_t) 86400
+          * (ctx->days_to_current_epoch_from_internal_epoch
+              + kAtcDaysToInternalEpochFromUnixEpoch);
+  }
+}
+
+atc_time_t atc_epoch_seconds_from_unix_seconds_ctx(
+    const AtcEpochContext *ctx,
+    int64_t unix_seconds)
+{
+  if (unix_seconds == kAtcInvalidUnixSeconds) {
+    return kAtcInvalidEpochSeconds;
+  } else {
+    return (int64_t) unix_seconds
+        - (int64_t) 86400
+          * (ctx->days_to_current_epoch_from_internal_epoch
+              + kAtcDaysToInternalEpochFromUnixEpoch);
+  }
+}
+
+int32_t atc_unix_days_from_epoch_days_ctx(
+    const AtcEpochContext *ctx,
+    int32_t epoch_days)
+{
+  return epoch_days
+      + ctx->days_to_current_epoch_from_internal_epoch
+      + kAtcDaysToInternalEpochFromUnixEpoch;
+}
+
+int32_t atc_epoch_days_from_unix_days_ctx(
+    const AtcEpochContext *ctx,
+    int32_t unix_days)
+{
+  return unix_days
+      - kAtcDaysToInternalEpochFromUnixEpoch
+      - ctx->days_to_current_epoch_from_internal_epoch;
+}
+
 // Return the number days before the given month_prime.
 // See AceTime/src/ace_time/internal/EpochConverterHinnant.h.
 static uint16_t atc_convert_to_days_until_month_prime(uint8_t month_prime)
@@ -82,11 +189,15 @@ static uint16_t atc_convert_to_days_until_month_prime(uint8_t month_prime)
   return (153 * month_prime + 2) / 5;
 }
 
-// See AceTime/src/ace_time/internal/EpochConverterHinnant.h.
-int32_t atc_convert_to_internal_days(int16_t year, uint8_t month, uint8_t day)
+// See AceTime/src/ace_time/internal/EpochConverterHinnant.h. The calculation
+// is shifted by one era (400 years), so that the dates in January and February
+// of year 0 do not produce a negative year_prime.
+int32_t atc_convert_to_internal_days_hinnant(
+    int16_t year, uint8_t month, uint8_t day)
 {
-  int16_t year_prime = year - ((month <= 2) ? 1 : 0); // year begins on Mar 1
-  uint16_t era = year_prime / 400; // [0,24]
+  // year begins on Mar 1
+  int16_t year_prime = year + 400 - ((month <= 2) ? 1 : 0); // [399,10400]
+  uint16_t era = year_prime / 400; // [0,26]
   uint16_t year_of_era = year_prime - 400 * era; // [0,399]
 
   uint8_t month_prime = (month <= 2) ? month + 9 : month - 3; // [0,11]
@@ -96,30 +207,31 @@ int32_t atc_convert_to_internal_days(int16_t year, uint8_t month, uint8_t day)
   uint32_t day_of_era = (uint32_t) 365 * year_of_era + (year_of_era / 4)
       - (year_of_era / 100) + day_of_year_prime; // [0,146096]
 
-  // epoch_prime days is relative to 0000-03-01
+  // epoch_prime days is relative to -0400-03-01
   int32_t day_of_epoch_prime = day_of_era + 146097 * era;
   return day_of_epoch_prime
-          - (kAtcInternalEpochYear / 400) * 146097 // relative to 2000-03-01
+          - (kAtcInternalEpochYear / 400 + 1) * 146097 // relative to 2000-03-01
           + 60; // relative to 2000-01-01, 2000 is a leap year
 }
 
-// See AceTime/src/ace_time/internal/EpochConverterHinnant.h.
-void atc_convert_from_internal_days(
+// See AceTime/src/ace_time/internal/EpochConverterHinnant.h, and the comment
+// of atc_convert_to_internal_days_hinnant().
+void atc_convert_from_internal_days_hinnant(
     int32_t internal_days,
     int16_t *year,
     uint8_t *month,
     uint8_t *day)
 {
-  // epoch_prime days is relative to 0000-03-01
+  // epoch_prime days is relative to -0400-03-01
   int32_t day_of_epoch_prime = internal_days
-      + (kAtcInternalEpochYear / 400) * 146097
+      + (kAtcInternalEpochYear / 400 + 1) * 146097
       - 60;
 
-  uint16_t era = (uint32_t) day_of_epoch_prime / 146097; // [0,24]
+  uint16_t era = (uint32_t) day_of_epoch_prime / 146097; // [0,26]
   uint32_t day_of_era = day_of_epoch_prime - 146097 * era; // [0,146096]
   uint16_t year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524
       - day_of_era / 146096) / 365; // [0,399]
-  uint16_t year_prime = year_of_era + 400 * era; // [0,9999]
+  int16_t year_prime = year_of_era + 400 * era - 400; // [-1,10000]
   uint16_t day_of_year_prime = day_of_era
       - (365 * year_of_era + year_of_era / 4 - year_of_era/100); // [0,365]
   uint8_t month_prime = (5 * day_of_year_prime + 2) / 153;
@@ -128,5 +240,444 @@ void atc_convert_from_internal_days(
 
   *day = day_of_year_prime - days_until_month_prime + 1; // [1,31]
   *month = (month_prime < 10) ? month_prime + 3 : month_prime - 9; // [1,12]
-  *year = year_prime + ((*month <= 2) ? 1 : 0); // [1,9999]
+  *year = year_prime + ((*month <= 2) ? 1 : 0); // [0,10000]
+}
+
+// The Neri-Schneider algorithms count the days from the beginning of a
+// computational calendar whose years begin on March 1. It is shifted by one
+// era (400 years) like the Hinnant algorithms, so that day 0 is -0400-03-01,
+// and all intermediate values are positive. Each division is of an unsigned
+// value, either by a power of 2, or by a constant which the compiler replaces
+// with a multiplication and a shift.
+int32_t atc_convert_to_internal_days_neri_schneider(
+    int16_t year, uint8_t month, uint8_t day)
+{
+  uint32_t is_jan_feb = (month <= 2);
+  uint32_t year_prime = (uint32_t) (year + 400) - is_jan_feb; // [399,10400]
+  uint32_t month_prime = month + 12 * is_jan_feb; // [3,14]
+  uint32_t century = year_prime / 100;
+  uint32_t days_until_year_prime = 1461 * year_prime / 4 - century
+      + century / 4;
+  uint32_t days_until_month_prime = (979 * month_prime - 2919) / 32;
+  uint32_t day_of_epoch_prime = days_until_year_prime + days_until_month_prime
+      + day - 1;
+  return (int32_t) day_of_epoch_prime
+      - ((kAtcInternalEpochYear / 400 + 1) * 146097 - 60);
+}
+
+void atc_convert_from_internal_days_neri_schneider(
+    int32_t internal_days,
+    int16_t *year,
+    uint8_t *month,
+    uint8_t *day)
+{
+  uint32_t day_of_epoch_prime = (uint32_t) (internal_days
+      + (kAtcInternalEpochYear / 400 + 1) * 146097 - 60);
+
+  // Century, and day of the century.
+  uint32_t n1 = 4 * day_of_epoch_prime + 3;
+  uint32_t century = n1 / 146097;
+  uint32_t day_of_century = n1 % 146097 / 4;
+
+  // Year of the century, and day of the year, from a single 64-bit product.
+  uint32_t n2 = 4 * day_of_century + 3;
+  uint64_t p2 = (uint64_t) 2939745 * n2;
+  uint32_t year_of_century = (uint32_t) (p2 >> 32);
+  uint32_t day_of_year_prime = (uint32_t) p2 / 2939745 / 4; // [0,365]
+
+  // Month and day of the month, from a single 32-bit product.
+  uint32_t n3 = 2141 * day_of_year_prime + 197913;
+  uint32_t month_prime = n3 >> 16; // [3,14]
+  uint32_t day_of_month = (n3 & 0xFFFF) / 2141; // [0,30]
+
+  uint32_t is_jan_feb = (day_of_year_prime >= 306);
+  *year = (int16_t) (100 * century + year_of_century + is_jan_feb) - 400;
+  *month = month_prime - 12 * is_jan_feb;
+  *day = day_of_month + 1;
+}
+
+int32_t atc_convert_to_internal_days(int16_t year, uint8_t month, uint8_t day)
+{
+#if ATC_ENABLE_NERI_SCHNEIDER
+  return atc_convert_to_internal_days_neri_schneider(year, month, day);
+#else
+  return atc_convert_to_internal_days_hinnant(year, month, day);
+#endif
+}
+
+void atc_convert_from_internal_days(
+    int32_t internal_days,
+    int16_t *year,
+    uint8_t *month,
+    uint8_t *day)
+{
+#if ATC_ENABLE_NERI_SCHNEIDER
+  atc_convert_from_internal_days_neri_schneider(
+      internal_days, year, month, day);
+#else
+  atc_convert_from_internal_days_hinnant(internal_days, year, month, day);
+#endif
+}
+
+//---------------------------------------------------------------------------
+// Array versions. The SIMD versions use the same algorithm as the Hinnant
+// functions above on 4 (SSE4.1) or 8 (AVX2) lanes of 32 bits, with each
+// division by a constant replaced by a multiplication and a right shift
+// whose products fit in 32 bits. The multipliers were verified to give exact
+// quotients over the range of each step. Where no such multiplier exists (the
+// divisions by 146097 and 365), the quotient can be 1 too large, and is
+// corrected by a comparison.
+//---------------------------------------------------------------------------
+
+#if ATC_ENABLE_SIMD
+
+__attribute__((target("sse4.1")))
+static __m128i atc_convert_to_internal_days_sse41(
+    __m128i year, __m128i month, __m128i day)
+{
+  // year_prime = year + 400 - (month <= 2), as the scalar version.
+  __m128i is_jan_feb = _mm_cmpgt_epi32(_mm_set1_epi32(3), month); // -1 or 0
+  __m128i year_prime = _mm_add_epi32(
+      _mm_add_epi32(year, _mm_set1_epi32(400)), is_jan_feb);
+  __m128i era = _mm_srli_epi32(
+      _mm_mullo_epi32(year_prime, _mm_set1_epi32(5243)), 21); // /400
+  __m128i year_of_era = _mm_sub_epi32(
+      year_prime, _mm_mullo_epi32(era, _mm_set1_epi32(400)));
+
+  __m128i month_prime = _mm_add_epi32(
+      _mm_sub_epi32(month, _mm_set1_epi32(3)),
+      _mm_and_si128(is_jan_feb, _mm_set1_epi32(12)));
+  __m128i days_until_month_prime = _mm_srli_epi32(_mm_mullo_epi32(
+      _mm_add_epi32(
+          _mm_mullo_epi32(month_prime, _mm_set1_epi32(153)),
+          _mm_set1_epi32(2)),
+      _mm_set1_epi32(1639)), 13); // /5
+  __m128i day_of_year_prime = _mm_sub_epi32(
+      _mm_add_epi32(days_until_month_prime, day), _mm_set1_epi32(1));
+  __m128i day_of_era = _mm_add_epi32(
+      _mm_sub_epi32(
+          _mm_add_epi32(
+              _mm_mullo_epi32(year_of_era, _mm_set1_epi32(365)),
+              _mm_srli_epi32(year_of_era, 2)),
+          _mm_srli_epi32(
+              _mm_mullo_epi32(year_of_era, _mm_set1_epi32(41)), 12)), // /100
+      day_of_year_prime);
+
+  return _mm_add_epi32(
+      _mm_add_epi32(day_of_era, _mm_mullo_epi32(era, _mm_set1_epi32(146097))),
+      _mm_set1_epi32(60 - (kAtcInternalEpochYear / 400 + 1) * 146097));
+}
+
+__attribute__((target("sse4.1")))
+static void atc_convert_from_internal_days_sse41(
+    __m128i internal_days, __m128i *year, __m128i *month, __m128i *day)
+{
+  __m128i day_of_epoch_prime = _mm_add_epi32(internal_days,
+      _mm_set1_epi32((kAtcInternalEpochYear / 400 + 1) * 146097 - 60));
+
+  // era = day_of_epoch_prime / 146097
+  __m128i k146097 = _mm_set1_epi32(146097);
+  __m128i era = _mm_srli_epi32(
+      _mm_mullo_epi32(day_of_epoch_prime, _mm_set1_epi32(919)), 27);
+  era = _mm_add_epi32(era, _mm_cmpgt_epi32(
+      _mm_mullo_epi32(era, k146097), day_of_epoch_prime));
+  __m128i day_of_era = _mm_sub_epi32(
+      day_of_epoch_prime, _mm_mullo_epi32(era, k146097));
+
+  // year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524
+  //     - day_of_era / 146096) / 365
+  __m128i quarter = _mm_srli_epi32(day_of_era, 2);
+  __m128i n = _mm_add_epi32(
+      _mm_sub_epi32(day_of_era, _mm_srli_epi32(
+          _mm_mullo_epi32(quarter, _mm_set1_epi32(22983)), 23)), // /365
+      _mm_srli_epi32(
+          _mm_mullo_epi32(quarter, _mm_set1_epi32(29399)), 28)); // /9131
+  n = _mm_add_epi32(n,
+      _mm_cmpeq_epi32(day_of_era, _mm_set1_epi32(146096)));
+  __m128i k365 = _mm_set1_epi32(365);
+  __m128i year_of_era = _mm_srli_epi32(
+      _mm_mullo_epi32(n, _mm_set1_epi32(22983)), 23);
+  year_of_era = _mm_add_epi32(year_of_era, _mm_cmpgt_epi32(
+      _mm_mullo_epi32(year_of_era, k365), n));
+
+  __m128i day_of_year_prime = _mm_sub_epi32(day_of_era, _mm_sub_epi32(
+      _mm_add_epi32(
+          _mm_mullo_epi32(year_of_era, k365),
+          _mm_srli_epi32(year_of_era, 2)),
+      _mm_srli_epi32(
+          _mm_mullo_epi32(year_of_era, _mm_set1_epi32(41)), 12))); // /100
+  __m128i month_prime = _mm_srli_epi32(_mm_mullo_epi32(
+      _mm_add_epi32(
+          _mm_mullo_epi32(day_of_year_prime, _mm_set1_epi32(5)),
+          _mm_set1_epi32(2)),
+      _mm_set1_epi32(857)), 17); // /153
+  __m128i days_until_month_prime = _mm_srli_epi32(_mm_mullo_epi32(
+      _mm_add_epi32(
+          _mm_mullo_epi32(month_prime, _mm_set1_epi32(153)),
+          _mm_set1_epi32(2)),
+      _mm_set1_epi32(1639)), 13); // /5
+
+  *day = _mm_add_epi32(
+      _mm_sub_epi32(day_of_year_prime, days_until_month_prime),
+      _mm_set1_epi32(1));
+  *month = _mm_sub_epi32(
+      _mm_add_epi32(month_prime, _mm_set1_epi32(3)),
+      _mm_and_si128(
+          _mm_cmpgt_epi32(month_prime, _mm_set1_epi32(9)),
+          _mm_set1_epi32(12)));
+  *year = _mm_sub_epi32(
+      _mm_add_epi32(
+          _mm_add_epi32(year_of_era, _mm_mullo_epi32(era, _mm_set1_epi32(400))),
+          _mm_set1_epi32(-400)),
+      _mm_cmpgt_epi32(_mm_set1_epi32(3), *month));
+}
+
+__attribute__((target("avx2")))
+static __m256i atc_convert_to_internal_days_avx2(
+    __m256i year, __m256i month, __m256i day)
+{
+  __m256i is_jan_feb = _mm256_cmpgt_epi32(_mm256_set1_epi32(3), month);
+  __m256i year_prime = _mm256_add_epi32(
+      _mm256_add_epi32(year, _mm256_set1_epi32(400)), is_jan_feb);
+  __m256i era = _mm256_srli_epi32(
+      _mm256_mullo_epi32(year_prime, _mm256_set1_epi32(5243)), 21);
+  __m256i year_of_era = _mm256_sub_epi32(
+      year_prime, _mm256_mullo_epi32(era, _mm256_set1_epi32(400)));
+
+  __m256i month_prime = _mm256_add_epi32(
+      _mm256_sub_epi32(month, _mm256_set1_epi32(3)),
+      _mm256_and_si256(is_jan_feb, _mm256_set1_epi32(12)));
+  __m256i days_until_month_prime = _mm256_srli_epi32(_mm256_mullo_epi32(
+      _mm256_add_epi32(
+          _mm256_mullo_epi32(month_prime, _mm256_set1_epi32(153)),
+          _mm256_set1_epi32(2)),
+      _mm256_set1_epi32(1639)), 13);
+  __m256i day_of_year_prime = _mm256_sub_epi32(
+      _mm256_add_epi32(days_until_month_prime, day), _mm256_set1_epi32(1));
+  __m256i day_of_era = _mm256_add_epi32(
+      _mm256_sub_epi32(
+          _mm256_add_epi32(
+              _mm256_mullo_epi32(year_of_era, _mm256_set1_epi32(365)),
+              _mm256_srli_epi32(year_of_era, 2)),
+          _mm256_srli_epi32(
+              _mm256_mullo_epi32(year_of_era, _mm256_set1_epi32(41)), 12)),
+      day_of_year_prime);
+
+  return _mm256_add_epi32(
+      _mm256_add_epi32(
+          day_of_era, _mm256_mullo_epi32(era, _mm256_set1_epi32(146097))),
+      _mm256_set1_epi32(60 - (kAtcInternalEpochYear / 400 + 1) * 146097));
+}
+
+__attribute__((target("avx2")))
+static void atc_convert_from_internal_days_avx2(
+    __m256i internal_days, __m256i *year, __m256i *month, __m256i *day)
+{
+  __m256i day_of_epoch_prime = _mm256_add_epi32(internal_days,
+      _mm256_set1_epi32((kAtcInternalEpochYear / 400 + 1) * 146097 - 60));
+
+  __m256i k146097 = _mm256_set1_epi32(146097);
+  __m256i era = _mm256_srli_epi32(
+      _mm256_mullo_epi32(day_of_epoch_prime, _mm256_set1_epi32(919)), 27);
+  era = _mm256_add_epi32(era, _mm256_cmpgt_epi32(
+      _mm256_mullo_epi32(era, k146097), day_of_epoch_prime));
+  __m256i day_of_era = _mm256_sub_epi32(
+      day_of_epoch_prime, _mm256_mullo_epi32(era, k146097));
+
+  __m256i quarter = _mm256_srli_epi32(day_of_era, 2);
+  __m256i n = _mm256_add_epi32(
+      _mm256_sub_epi32(day_of_era, _mm256_srli_epi32(
+          _mm256_mullo_epi32(quarter, _mm256_set1_epi32(22983)), 23)),
+      _mm256_srli_epi32(
+          _mm256_mullo_epi32(quarter, _mm256_set1_epi32(29399)), 28));
+  n = _mm256_add_epi32(n,
+      _mm256_cmpeq_epi32(day_of_era, _mm256_set1_epi32(146096)));
+  __m256i k365 = _mm256_set1_epi32(365);
+  __m256i year_of_era = _mm256_srli_epi32(
+      _mm256_mullo_epi32(n, _mm256_set1_epi32(22983)), 23);
+  year_of_era = _mm256_add_epi32(year_of_era, _mm256_cmpgt_epi32(
+      _mm256_mullo_epi32(year_of_era, k365), n));
+
+  __m256i day_of_year_prime = _mm256_sub_epi32(day_of_era, _mm256_sub_epi32(
+      _mm256_add_epi32(
+          _mm256_mullo_epi32(year_of_era, k365),
+          _mm256_srli_epi32(year_of_era, 2)),
+      _mm256_srli_epi32(
+          _mm256_mullo_epi32(year_of_era, _mm256_set1_epi32(41)), 12)));
+  __m256i month_prime = _mm256_srli_epi32(_mm256_mullo_epi32(
+      _mm256_add_epi32(
+          _mm256_mullo_epi32(day_of_year_prime, _mm256_set1_epi32(5)),
+          _mm256_set1_epi32(2)),
+      _mm256_set1_epi32(857)), 17);
+  __m256i days_until_month_prime = _mm256_srli_epi32(_mm256_mullo_epi32(
+      _mm256_add_epi32(
+          _mm256_mullo_epi32(month_prime, _mm256_set1_epi32(153)),
+          _mm256_set1_epi32(2)),
+      _mm256_set1_epi32(1639)), 13);
+
+  *day = _mm256_add_epi32(
+      _mm256_sub_epi32(day_of_year_prime, days_until_month_prime),
+      _mm256_set1_epi32(1));
+  *month = _mm256_sub_epi32(
+      _mm256_add_epi32(month_prime, _mm256_set1_epi32(3)),
+      _mm256_and_si256(
+          _mm256_cmpgt_epi32(month_prime, _mm256_set1_epi32(9)),
+          _mm256_set1_epi32(12)));
+  *year = _mm256_sub_epi32(
+      _mm256_add_epi32(
+          _mm256_add_epi32(
+              year_of_era, _mm256_mullo_epi32(era, _mm256_set1_epi32(400))),
+          _mm256_set1_epi32(-400)),
+      _mm256_cmpgt_epi32(_mm256_set1_epi32(3), *month));
+}
+
+// Convert as many dates as possible using SSE4.1, and return the count.
+__attribute__((target("sse4.1")))
+static size_t atc_convert_to_internal_days_n_sse41(
+    const int16_t *years,
+    const uint8_t *months,
+    const uint8_t *days,
+    size_t n,
+    int32_t *internal_days)
+{
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    int32_t m;
+    int32_t d;
+    memcpy(&m, months + i, sizeof(m));
+    memcpy(&d, days + i, sizeof(d));
+    __m128i result = atc_convert_to_internal_days_sse41(
+        _mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i *) (years + i))),
+        _mm_cvtepu8_epi32(_mm_cvtsi32_si128(m)),
+        _mm_cvtepu8_epi32(_mm_cvtsi32_si128(d)));
+    _mm_storeu_si128((__m128i *) (internal_days + i), result);
+  }
+  return i;
+}
+
+__attribute__((target("avx2")))
+static size_t atc_convert_to_internal_days_n_avx2(
+    const int16_t *years,
+    const uint8_t *months,
+    const uint8_t *days,
+    size_t n,
+    int32_t *internal_days)
+{
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i result = atc_convert_to_internal_days_avx2(
+        _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *) (years + i))),
+        _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *) (months + i))),
+        _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *) (days + i))));
+    _mm256_storeu_si256((__m256i *) (internal_days + i), result);
+  }
+  return i;
+}
+
+__attribute__((target("sse4.1")))
+static size_t atc_convert_from_internal_days_n_sse41(
+    const int32_t *internal_days,
+    size_t n,
+    int16_t *years,
+    uint8_t *months,
+    uint8_t *days)
+{
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128i year;
+    __m128i month;
+    __m128i day;
+    atc_convert_from_internal_days_sse41(
+        _mm_loadu_si128((const __m128i *) (internal_days + i)),
+        &year, &month, &day);
+    _mm_storel_epi64((__m128i *) (years + i), _mm_packs_epi32(year, year));
+    __m128i month16 = _mm_packs_epi32(month, month);
+    __m128i day16 = _mm_packs_epi32(day, day);
+    int32_t m = _mm_cvtsi128_si32(_mm_packus_epi16(month16, month16));
+    int32_t d = _mm_cvtsi128_si32(_mm_packus_epi16(day16, day16));
+    memcpy(months + i, &m, sizeof(m));
+    memcpy(days + i, &d, sizeof(d));
+  }
+  return i;
+}
+
+__attribute__((target("avx2")))
+static size_t atc_convert_from_internal_days_n_avx2(
+    const int32_t *internal_days,
+    size_t n,
+    int16_t *years,
+    uint8_t *months,
+    uint8_t *days)
+{
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i year;
+    __m256i month;
+    __m256i day;
+    atc_convert_from_internal_days_avx2(
+        _mm256_loadu_si256((const __m256i *) (internal_days + i)),
+        &year, &month, &day);
+    // Pack the 8 lanes of 32 bits into 16 bits, then 8 bits.
+    __m128i year16 = _mm_packs_epi32(
+        _mm256_castsi256_si128(year), _mm256_extracti128_si256(year, 1));
+    __m128i month16 = _mm_packs_epi32(
+        _mm256_castsi256_si128(month), _mm256_extracti128_si256(month, 1));
+    __m128i day16 = _mm_packs_epi32(
+        _mm256_castsi256_si128(day), _mm256_extracti128_si256(day, 1));
+    _mm_storeu_si128((__m128i *) (years + i), year16);
+    _mm_storel_epi64((__m128i *) (months + i),
+        _mm_packus_epi16(month16, month16));
+    _mm_storel_epi64((__m128i *) (days + i), _mm_packus_epi16(day16, day16));
+  }
+  return i;
+}
+
+#endif
+
+void atc_convert_to_internal_days_n(
+    const int16_t *years,
+    const uint8_t *months,
+    const uint8_t *days,
+    size_t n,
+    int32_t *internal_days)
+{
+  size_t i = 0;
+#if ATC_ENABLE_SIMD
+  uint8_t level = atc_get_simd_level();
+  if (level == kAtcSimdAvx2) {
+    i = atc_convert_to_internal_days_n_avx2(
+        years, months, days, n, internal_days);
+  } else if (level == kAtcSimdSse41) {
+    i = atc_convert_to_internal_days_n_sse41(
+        years, months, days, n, internal_days);
+  }
+#endif
+  for (; i < n; i++) {
+    internal_days[i] = atc_convert_to_internal_days(
+        years[i], months[i], days[i]);
+  }
+}
+
+void atc_convert_from_internal_days_n(
+    const int32_t *internal_days,
+    size_t n,
+    int16_t *years,
+    uint8_t *months,
+    uint8_t *days)
+{
+  size_t i = 0;
+#if ATC_ENABLE_SIMD
+  uint8_t level = atc_get_simd_level();
+  if (level == kAtcSimdAvx2) {
+    i = atc_convert_from_internal_days_n_avx2(
+        internal_days, n, years, months, days);
+  } else if (level == kAtcSimdSse41) {
+    i = atc_convert_from_internal_days_n_sse41(
+        internal_days, n, years, months, days);
+  }
+#endif
+  for (; i < n; i++) {
+    atc_convert_from_internal_days(
+        internal_days[i], &years[i], &months[i], &days[i]);
+  }
 }
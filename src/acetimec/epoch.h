@@ -18,6 +18,7 @@
 #define ACE_TIME_C_EPOCH_H
 
 #include <stdbool.h>
+#include <stddef.h> // size_t
 #include <stdint.h>
 #include "common.h"
 
@@ -51,6 +52,35 @@ int16_t atc_get_current_epoch_year(void);
  */
 void atc_set_current_epoch_year(int16_t year);
 
+/**
+ * An explicit epoch, carried by value, as an alternative to the global
+ * `atc_current_epoch_year`. Functions with the `_ctx` suffix use the epoch in
+ * the AtcEpochContext instead of the global epoch, so that threads (or
+ * subsystems) using different epochs never share mutable state.
+ */
+typedef struct AtcEpochContext {
+  /** The epoch year, the equivalent of `atc_current_epoch_year`. */
+  int16_t epoch_year;
+
+  /** Number of days from internal epoch (2000-01-01) to the epoch year. */
+  int32_t days_to_current_epoch_from_internal_epoch;
+} AtcEpochContext;
+
+/** Initialize the AtcEpochContext for the given epoch year. */
+void atc_epoch_context_init(AtcEpochContext *ctx, int16_t year);
+
+/**
+ * Initialize the AtcEpochContext from a snapshot of the current global epoch
+ * set by atc_set_current_epoch_year().
+ */
+void atc_epoch_context_init_from_current(AtcEpochContext *ctx);
+
+/** Same as atc_epoch_valid_year_lower() using the given AtcEpochContext. */
+int16_t atc_epoch_context_valid_year_lower(const AtcEpochContext *ctx);
+
+/** Same as atc_epoch_valid_year_upper() using the given AtcEpochContext. */
+int16_t atc_epoch_context_valid_year_upper(const AtcEpochContext *ctx);
+
 /** Convert epoch seconds to the unix seconds from 1970. */
 int64_t atc_unix_seconds_from_epoch_seconds(atc_time_t epoch_seconds);
 
@@ -63,6 +93,26 @@ int32_t atc_unix_days_from_epoch_days(int32_t epoch_days);
 /** Convert unix days to epoch days. */
 int32_t atc_epoch_days_from_unix_days(int32_t unix_days);
 
+/** Convert epoch seconds of the given epoch to the unix seconds from 1970. */
+int64_t atc_unix_seconds_from_epoch_seconds_ctx(
+    const AtcEpochContext *ctx,
+    atc_time_t epoch_seconds);
+
+/** Convert the 64-bit unix seconds to epoch seconds of the given epoch. */
+atc_time_t atc_epoch_seconds_from_unix_seconds_ctx(
+    const AtcEpochContext *ctx,
+    int64_t unix_seconds);
+
+/** Convert epoch days of the given epoch to unix days. */
+int32_t atc_unix_days_from_epoch_days_ctx(
+    const AtcEpochContext *ctx,
+    int32_t epoch_days);
+
+/** Convert unix days to epoch days of the given epoch. */
+int32_t atc_epoch_days_from_unix_days_ctx(
+    const AtcEpochContext *ctx,
+    int32_t unix_days);
+
 /**
  * The smallest year (inclusive) for which calculations involving the 32-bit
  * `epoch_seconds` and time zone transitions are guaranteed to be valid without
@@ -76,6 +126,9 @@ int32_t atc_epoch_days_from_unix_days(int32_t unix_days);
  * this function returns `atc_get_current_epoch_year() - 50`. It may return a
  * smaller value in the future if the internal calculations can be verified to
  * avoid underflow or overflow problems.
+ *
+ * If ATC_TIME64 is enabled, this returns `kAtcMinYear + 1` independent of the
+ * current epoch year.
  */
 int16_t atc_epoch_valid_year_lower(void);
 
@@ -92,18 +145,22 @@ int16_t atc_epoch_valid_year_lower(void);
  * this function returns `atc_get_current_epoch_year() + 50`. It may return a
  * larger value in the future if the internal calculations can be verified to
  * avoid underflow or overflow problems.
+ *
+ * If ATC_TIME64 is enabled, this returns `kAtcMaxYear` independent of the
+ * current epoch year.
  */
 int16_t atc_epoch_valid_year_upper(void);
 
 /**
  * Convert (year, month, day) triple to the number of days since the internal
- * epoch (2000-01-01). This algorithm corresponds to
- * AceTime/src/ace_time/internal/EpochConverterHinnant.h.
+ * epoch (2000-01-01). This calls atc_convert_to_internal_days_neri_schneider()
+ * if ATC_ENABLE_NERI_SCHNEIDER is enabled, otherwise
+ * atc_convert_to_internal_days_hinnant().
  *
  * No input validation is performed. The behavior is undefined if the
  * parameters are outside their expected range.
  *
- * @param year [1,9999]
+ * @param year [0,10000]
  * @param month month integer, [1,12]
  * @param day day of month integer, [1,31]
  */
@@ -111,14 +168,15 @@ int32_t atc_convert_to_internal_days(int16_t year, uint8_t month, uint8_t day);
 
 /**
  * Convert the days from internal epoch (2000-01-01) into (year, month, day)
- * fields. This algorithm corresponds to
- * AceTime/src/ace_time/internal/EpochConverterHinnant.h.
+ * fields. This calls atc_convert_from_internal_days_neri_schneider() if
+ * ATC_ENABLE_NERI_SCHNEIDER is enabled, otherwise
+ * atc_convert_from_internal_days_hinnant().
  *
  * No input validation is performed. The behavior is undefined if the
  * parameters are outside their expected range.
  *
  * @param internal_days number of days from internal epoch of 2000-01-01
- * @param year year [1,9999]
+ * @param year year [0,10000]
  * @param month month integer [1, 12]
  * @param day day of month integer[1, 31]
  */
@@ -128,6 +186,68 @@ void atc_convert_from_internal_days(
     uint8_t *month,
     uint8_t *day);
 
+/**
+ * Version of atc_convert_to_internal_days() which corresponds to
+ * AceTime/src/ace_time/internal/EpochConverterHinnant.h.
+ */
+int32_t atc_convert_to_internal_days_hinnant(
+    int16_t year, uint8_t month, uint8_t day);
+
+/**
+ * Version of atc_convert_from_internal_days() which corresponds to
+ * AceTime/src/ace_time/internal/EpochConverterHinnant.h.
+ */
+void atc_convert_from_internal_days_hinnant(
+    int32_t internal_days,
+    int16_t *year,
+    uint8_t *month,
+    uint8_t *day);
+
+/**
+ * Version of atc_convert_to_internal_days() which uses the algorithm of
+ * C. Neri and L. Schneider, "Euclidean affine functions and their application
+ * to calendar algorithms" (2022).
+ */
+int32_t atc_convert_to_internal_days_neri_schneider(
+    int16_t year, uint8_t month, uint8_t day);
+
+/**
+ * Version of atc_convert_from_internal_days() which uses the algorithm of
+ * C. Neri and L. Schneider (2022).
+ */
+void atc_convert_from_internal_days_neri_schneider(
+    int32_t internal_days,
+    int16_t *year,
+    uint8_t *month,
+    uint8_t *day);
+
+/**
+ * Convert the `n` dates of the arrays `years`, `months` and `days` to the
+ * number of days since the internal epoch, written to `internal_days`. The
+ * results are identical to atc_convert_to_internal_days(). On x86, the SSE4.1
+ * or AVX2 instructions selected by atc_get_simd_level() convert 4 or 8 dates
+ * at a time, using multiply-shift operations instead of divisions.
+ */
+void atc_convert_to_internal_days_n(
+    const int16_t *years,
+    const uint8_t *months,
+    const uint8_t *days,
+    size_t n,
+    int32_t *internal_days);
+
+/**
+ * Convert the `n` days since the internal epoch of the array `internal_days`
+ * to the arrays `years`, `months` and `days`. The results are identical to
+ * atc_convert_from_internal_days(), using the same SIMD instructions as
+ * atc_convert_to_internal_days_n().
+ */
+void atc_convert_from_internal_days_n(
+    const int32_t *internal_days,
+    size_t n,
+    int16_t *years,
+    uint8_t *months,
+    uint8_t *days);
+
 #ifdef __cplusplus
 }
 #endif
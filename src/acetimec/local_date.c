@@ -92,6 +92,28 @@ void atc_local_date_from_epoch_days(
   atc_convert_from_internal_days(internal_days, year, month, day);
 }
 
+int32_t atc_local_date_to_epoch_days_ctx(
+    const AtcEpochContext *ctx,
+    int16_t year,
+    uint8_t month,
+    uint8_t day)
+{
+  int32_t internal_days = atc_convert_to_internal_days(year, month, day);
+  return internal_days - ctx->days_to_current_epoch_from_internal_epoch;
+}
+
+void atc_local_date_from_epoch_days_ctx(
+    const AtcEpochContext *ctx,
+    int32_t epoch_days,
+    int16_t *year,
+    uint8_t *month,
+    uint8_t *day)
+{
+  int32_t internal_days = epoch_days
+      + ctx->days_to_current_epoch_from_internal_epoch;
+  atc_convert_from_internal_days(internal_days, year, month, day);
+}
+
 int32_t atc_local_date_to_unix_days(int16_t year, uint8_t month, uint8_t day)
 {
   int32_t internal_days = atc_convert_to_internal_days(year, month, day);
@@ -19,6 +19,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include "epoch.h" // AtcEpochContext
 
 #ifdef __cplusplus
 extern "C" {
@@ -76,6 +77,27 @@ void atc_local_date_from_epoch_days(
     uint8_t *month,
     uint8_t *day);
 
+/**
+ * Same as atc_local_date_to_epoch_days() but relative to the epoch year of the
+ * given AtcEpochContext instead of the current global epoch year.
+ */
+int32_t atc_local_date_to_epoch_days_ctx(
+    const AtcEpochContext *ctx,
+    int16_t year,
+    uint8_t month,
+    uint8_t day);
+
+/**
+ * Same as atc_local_date_from_epoch_days() but relative to the epoch year of
+ * the given AtcEpochContext instead of the current global epoch year.
+ */
+void atc_local_date_from_epoch_days_ctx(
+    const AtcEpochContext *ctx,
+    int32_t epoch_days,
+    int16_t *year,
+    uint8_t *month,
+    uint8_t *day);
+
 /**
  * Return the number of days from the Unix epoch (1970) to the (year, month,
  * day) triple.
@@ -5,12 +5,27 @@
 
 #include "local_date_time.h"
 
+#include <string.h> // memcpy()
 #include "common.h"
 #include "epoch.h"
 #include "local_date.h"
 #include "local_time.h"
 #include "local_date_time.h"
 
+#if ATC_ENABLE_SIMD
+#include <immintrin.h>
+#endif
+
+#if ATC_TIME64
+enum {
+  /** Number of days from the internal epoch to 0001-01-01. */
+  kAtcMinInternalDays = -730119,
+
+  /** Number of days from the internal epoch to 10001-01-01. */
+  kAtcMaxInternalDays = 2922306,
+};
+#endif
+
 void atc_local_date_time_set_error(AtcLocalDateTime *ldt)
 {
   ldt->month = 0; // year 0 is valid, so can't use year field
@@ -23,17 +38,36 @@ bool atc_local_date_time_is_error(const AtcLocalDateTime *ldt)
 
 atc_time_t atc_local_date_time_to_epoch_seconds(
     const AtcLocalDateTime *ldt)
+{
+  AtcEpochContext ctx;
+  atc_epoch_context_init_from_current(&ctx);
+  return atc_local_date_time_to_epoch_seconds_ctx(&ctx, ldt);
+}
+
+void atc_local_date_time_from_epoch_seconds(
+  AtcLocalDateTime *ldt,
+  atc_time_t epoch_seconds)
+{
+  AtcEpochContext ctx;
+  atc_epoch_context_init_from_current(&ctx);
+  atc_local_date_time_from_epoch_seconds_ctx(&ctx, ldt, epoch_seconds);
+}
+
+atc_time_t atc_local_date_time_to_epoch_seconds_ctx(
+    const AtcEpochContext *ctx,
+    const AtcLocalDateTime *ldt)
 {
   if (atc_local_date_time_is_error(ldt)) return kAtcInvalidEpochSeconds;
 
-  int32_t days = atc_local_date_to_epoch_days(
-      ldt->year, ldt->month, ldt->day);
+  int32_t days = atc_local_date_to_epoch_days_ctx(
+      ctx, ldt->year, ldt->month, ldt->day);
   int32_t seconds = atc_local_time_to_seconds(
       ldt->hour, ldt->minute, ldt->second);
-  return days * 86400 + seconds;
+  return (atc_time_t) days * 86400 + seconds;
 }
 
-void atc_local_date_time_from_epoch_seconds(
+void atc_local_date_time_from_epoch_seconds_ctx(
+  const AtcEpochContext *ctx,
   AtcLocalDateTime *ldt,
   atc_time_t epoch_seconds)
 {
@@ -44,14 +78,69 @@ void atc_local_date_time_from_epoch_seconds(
     return;
   }
 
+#if ATC_ENABLE_NERI_SCHNEIDER
+  // Shift the epoch_seconds to an unsigned value, so that the floor-division
+  // becomes an unsigned division.
+#if ATC_TIME64
+  // A 64-bit epoch_seconds can be far outside of the years supported by
+  // atc_convert_from_internal_days(), and must not be truncated to int32_t.
+  int32_t min_days =
+      kAtcMinInternalDays - ctx->days_to_current_epoch_from_internal_epoch;
+  int32_t max_days =
+      kAtcMaxInternalDays - ctx->days_to_current_epoch_from_internal_epoch;
+  if (epoch_seconds < (atc_time_t) 86400 * min_days
+      || epoch_seconds >= (atc_time_t) 86400 * max_days) {
+    atc_local_date_time_set_error(ldt);
+    return;
+  }
+  uint64_t shifted =
+      (uint64_t) (epoch_seconds - (atc_time_t) 86400 * min_days);
+  int32_t days = (int32_t) (shifted / 86400) + min_days;
+  uint32_t seconds = (uint32_t) (shifted % 86400);
+#else
+  // No multiple of 86400 fits, so shift by 2^31 = 24855 * 86400 + 11648, and
+  // borrow a day if the remainder is less than 11648.
+  uint32_t shifted = (uint32_t) epoch_seconds + (uint32_t) 0x80000000;
+  uint32_t remainder = shifted % 86400;
+  uint32_t borrow = (remainder < 11648);
+  int32_t days = (int32_t) (shifted / 86400) - 24855 - (int32_t) borrow;
+  uint32_t seconds = remainder + 86400 * borrow - 11648;
+#endif
+
+  // Extract (year, month day).
+  atc_local_date_from_epoch_days_ctx(
+      ctx, days, &ldt->year, &ldt->month, &ldt->day);
+
+  // Extract (hour, minute, second). The multipliers give the exact quotients
+  // for seconds in [0,86399] and minutes in [0,1439], with 32-bit products.
+  uint32_t minutes = ((seconds >> 2) * 17477) >> 18; // seconds / 60
+  uint32_t hours = (minutes * 1093) >> 16; // minutes / 60
+  ldt->second = seconds - 60 * minutes;
+  ldt->minute = minutes - 60 * hours;
+  ldt->hour = hours;
+#else
   // Integer floor-division towards -infinity
-  int32_t days = (epoch_seconds < 0)
+  atc_time_t epoch_days = (epoch_seconds < 0)
       ? (epoch_seconds + 1) / 86400 - 1
       : epoch_seconds / 86400;
-  int32_t seconds = epoch_seconds - 86400 * days;
+  int32_t seconds = epoch_seconds - (atc_time_t) 86400 * epoch_days;
+
+#if ATC_TIME64
+  // A 64-bit epoch_seconds can be far outside of the years supported by
+  // atc_convert_from_internal_days(), and must not be truncated to int32_t.
+  atc_time_t internal_days =
+      epoch_days + ctx->days_to_current_epoch_from_internal_epoch;
+  if (internal_days < kAtcMinInternalDays
+      || internal_days >= kAtcMaxInternalDays) {
+    atc_local_date_time_set_error(ldt);
+    return;
+  }
+#endif
+  int32_t days = (int32_t) epoch_days;
 
   // Extract (year, month day).
-  atc_local_date_from_epoch_days(days, &ldt->year, &ldt->month, &ldt->day);
+  atc_local_date_from_epoch_days_ctx(
+      ctx, days, &ldt->year, &ldt->month, &ldt->day);
 
   // Extract (hour, minute, second). The compiler will combine the mod (%) and
   // division (/) operations into a single (dividend, remainder) function call.
@@ -59,16 +148,17 @@ void atc_local_date_time_from_epoch_seconds(
   uint16_t minutes = seconds / 60;
   ldt->minute = minutes % 60;
   ldt->hour = minutes / 60;
+#endif
 }
 
 int64_t atc_local_date_time_to_unix_seconds(const AtcLocalDateTime *ldt) {
   if (atc_local_date_time_is_error(ldt)) return kAtcInvalidUnixSeconds;
 
-  int32_t days = atc_local_date_to_epoch_days(
+  // Bypass the current epoch, so that the result does not depend on it.
+  int32_t unix_days = atc_local_date_to_unix_days(
       ldt->year, ldt->month, ldt->day);
   int32_t seconds = atc_local_time_to_seconds(
       ldt->hour, ldt->minute, ldt->second);
-  int32_t unix_days = atc_unix_days_from_epoch_days(days);
   return unix_days * (int64_t)86400 + seconds;
 }
 
@@ -92,10 +182,8 @@ void atc_local_date_time_from_unix_seconds(
       : unix_seconds / 86400;
   int32_t seconds = unix_seconds - 86400 * unix_days;
 
-  int32_t days = atc_epoch_days_from_unix_days(unix_days);
-
   // Extract (year, month day).
-  atc_local_date_from_epoch_days(days, &ldt->year, &ldt->month, &ldt->day);
+  atc_local_date_from_unix_days(unix_days, &ldt->year, &ldt->month, &ldt->day);
 
   // Extract (hour, minute, second). The compiler will combine the mod (%) and
   // division (/) operations into a single (dividend, remainder) function call.
@@ -121,3 +209,157 @@ void atc_local_date_time_print(
   atc_print_char(sb, ':');
   atc_print_uint16_pad2(sb, ldt->second);
 }
+
+//---------------------------------------------------------------------------
+// Parsing.
+//---------------------------------------------------------------------------
+
+enum {
+  /** Length of "YYYY-MM-DDThh:mm:ss". */
+  kAtcIsoDateTimeLength = 19,
+};
+
+// Return the value of the 2 digits at `s`. Set `bad` if either character is not
+// a digit, without branching.
+static uint8_t parse_digits2(const char *s, uint8_t *bad)
+{
+  uint8_t hi = (uint8_t) (s[0] - '0');
+  uint8_t lo = (uint8_t) (s[1] - '0');
+  *bad |= (hi > 9) | (lo > 9);
+  return hi * 10 + lo;
+}
+
+// Decode "YYYY-MM-DDThh:mm" into the fields [year/100, year%100, month, day,
+// hour, minute]. Return false if the digits or the separators are invalid. The
+// separator at position 10 is checked by the caller.
+static bool parse_core_scalar(const char *s, uint8_t fields[6])
+{
+  uint8_t bad = (s[4] != '-') | (s[7] != '-') | (s[13] != ':');
+  fields[0] = parse_digits2(s, &bad);
+  fields[1] = parse_digits2(s + 2, &bad);
+  fields[2] = parse_digits2(s + 5, &bad);
+  fields[3] = parse_digits2(s + 8, &bad);
+  fields[4] = parse_digits2(s + 11, &bad);
+  fields[5] = parse_digits2(s + 14, &bad);
+  return !bad;
+}
+
+#if ATC_ENABLE_SIMD
+
+// Same as parse_core_scalar() using a single 16-byte load. The digits are
+// validated by an unsigned comparison after subtracting '0', then gathered
+// into adjacent pairs and combined as (10 * hi + lo) by a multiply-add.
+__attribute__((target("sse4.1")))
+static bool parse_core_sse41(const char *s, uint8_t fields[6])
+{
+  const __m128i kDigitMask = _mm_setr_epi8(
+      -1, -1, -1, -1, 0, -1, -1, 0, -1, -1, 0, -1, -1, 0, -1, -1);
+  const __m128i kSeparators = _mm_setr_epi8(
+      0, 0, 0, 0, '-', 0, 0, '-', 0, 0, 0, 0, 0, ':', 0, 0);
+  const __m128i kSeparatorMask = _mm_setr_epi8(
+      0, 0, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0);
+  const __m128i kGather = _mm_setr_epi8(
+      0, 1, 2, 3, 5, 6, 8, 9, 11, 12, 14, 15, -1, -1, -1, -1);
+  const __m128i kWeights = _mm_setr_epi8(
+      10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 0, 0, 0, 0);
+
+  __m128i v = _mm_loadu_si128((const __m128i *) s);
+  __m128i digits = _mm_sub_epi8(v, _mm_set1_epi8('0'));
+  __m128i is_digit = _mm_cmpeq_epi8(
+      _mm_min_epu8(digits, _mm_set1_epi8(9)), digits);
+  // The lane of the 'T' at position 10 never matches kSeparators, and is
+  // accepted through kSeparatorMask instead.
+  __m128i is_separator = _mm_or_si128(
+      _mm_cmpeq_epi8(v, kSeparators),
+      _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -1, 0, 0, 0, 0, 0));
+  __m128i ok = _mm_or_si128(
+      _mm_and_si128(is_digit, kDigitMask),
+      _mm_and_si128(is_separator, kSeparatorMask));
+  if (_mm_movemask_epi8(ok) != 0xFFFF) return false;
+
+  __m128i pairs = _mm_maddubs_epi16(
+      _mm_shuffle_epi8(digits, kGather), kWeights);
+  __m128i packed = _mm_packus_epi16(pairs, pairs);
+  uint8_t buf[16];
+  _mm_storeu_si128((__m128i *) buf, packed);
+  memcpy(fields, buf, 6);
+  return true;
+}
+
+#endif
+
+// Parse the date time at the beginning of `s` into `ldt`. Return the number of
+// characters consumed, or 0 upon error, leaving the ldt unchanged.
+static size_t parse_local_date_time(
+    AtcLocalDateTime *ldt,
+    const char *s,
+    size_t len)
+{
+  if (len < kAtcIsoDateTimeLength) return 0;
+
+  uint8_t fields[6];
+  bool ok;
+#if ATC_ENABLE_SIMD
+  if (atc_get_simd_level() >= kAtcSimdSse41) {
+    ok = parse_core_sse41(s, fields);
+  } else {
+    ok = parse_core_scalar(s, fields);
+  }
+#else
+  ok = parse_core_scalar(s, fields);
+#endif
+  char sep = s[10];
+  uint8_t bad = (sep != 'T') & (sep != 't') & (sep != ' ');
+  bad |= (s[16] != ':');
+  uint8_t second = parse_digits2(s + 17, &bad);
+  if (!ok || bad) return 0;
+
+  int16_t year = fields[0] * 100 + fields[1];
+  uint8_t month = fields[2];
+  uint8_t day = fields[3];
+  if (month < 1 || month > 12
+      || day < 1 || day > atc_local_date_days_in_year_month(year, month)
+      || fields[4] > 23 || fields[5] > 59 || second > 59) {
+    return 0;
+  }
+
+  // Optional fraction of seconds, which is ignored.
+  size_t n = kAtcIsoDateTimeLength;
+  if (n < len && (s[n] == '.' || s[n] == ',')) {
+    size_t start = ++n;
+    while (n < len && (uint8_t) (s[n] - '0') <= 9) n++;
+    if (n == start) return 0;
+  }
+
+  ldt->year = year;
+  ldt->month = month;
+  ldt->day = day;
+  ldt->hour = fields[4];
+  ldt->minute = fields[5];
+  ldt->second = second;
+  ldt->fold = 0;
+  return n;
+}
+
+size_t atc_local_date_time_parse_prefix(
+    AtcLocalDateTime *ldt,
+    const char *s,
+    size_t len)
+{
+  size_t n = parse_local_date_time(ldt, s, len);
+  if (n == 0) atc_local_date_time_set_error(ldt);
+  return n;
+}
+
+int8_t atc_local_date_time_parse(
+    AtcLocalDateTime *ldt,
+    const char *s,
+    size_t len)
+{
+  size_t n = atc_local_date_time_parse_prefix(ldt, s, len);
+  if (n == 0 || n != len) {
+    atc_local_date_time_set_error(ldt);
+    return kAtcErrGeneric;
+  }
+  return kAtcErrOk;
+}
@@ -13,9 +13,11 @@
 #ifndef ACE_TIME_C_LOCAL_DATE_TIME_H
 #define ACE_TIME_C_LOCAL_DATE_TIME_H
 
+#include <stddef.h> // size_t
 #include <stdint.h>
 #include <stdbool.h>
 #include "common.h"
+#include "epoch.h" // AtcEpochContext
 #include "string_buffer.h"
 
 #ifdef __cplusplus
@@ -77,6 +79,23 @@ void atc_local_date_time_from_epoch_seconds(
   AtcLocalDateTime *ldt,
   atc_time_t epoch_seconds);
 
+/**
+ * Same as atc_local_date_time_to_epoch_seconds() but relative to the epoch
+ * year of the given AtcEpochContext.
+ */
+atc_time_t atc_local_date_time_to_epoch_seconds_ctx(
+    const AtcEpochContext *ctx,
+    const AtcLocalDateTime *ldt);
+
+/**
+ * Same as atc_local_date_time_from_epoch_seconds() but relative to the epoch
+ * year of the given AtcEpochContext.
+ */
+void atc_local_date_time_from_epoch_seconds_ctx(
+  const AtcEpochContext *ctx,
+  AtcLocalDateTime *ldt,
+  atc_time_t epoch_seconds);
+
 /**
  * Convert LocalDateTime in UTC to Unix seconds (since 1970).
  * Return kAtcInvalidUnixSeconds upon failure.
@@ -97,6 +116,36 @@ void atc_local_date_time_print(
     AtcStringBuffer *sb,
     const AtcLocalDateTime *ldt);
 
+/**
+ * Parse the ISO 8601 date time `YYYY-MM-DDThh:mm:ss[.fff]` at the beginning of
+ * the string `s` of length `len`, which does not need to be NUL-terminated.
+ * The separator 'T' may also be 't' or a space, as allowed by RFC 3339. The
+ * fraction of seconds may have any number of digits after a '.' or ',', and
+ * is ignored. The fields are validated, including the number of days in the
+ * month, but leap seconds (ss=60) are not supported. The 'fold' is set to 0.
+ *
+ * On x86, the 16 characters `YYYY-MM-DDThh:mm` are validated and decoded
+ * using SSE4.1 instructions, if supported by the processor (see
+ * atc_get_simd_level()).
+ *
+ * Return the number of characters consumed, or 0 upon error, in which case
+ * the ldt is set to its error value.
+ */
+size_t atc_local_date_time_parse_prefix(
+    AtcLocalDateTime *ldt,
+    const char *s,
+    size_t len);
+
+/**
+ * Parse the ISO 8601 date time in the string `s` of length `len` using
+ * atc_local_date_time_parse_prefix(), which must consume the whole string.
+ * Return kAtcErrGeneric upon error, and set ldt to its error value.
+ */
+int8_t atc_local_date_time_parse(
+    AtcLocalDateTime *ldt,
+    const char *s,
+    size_t len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -94,3 +94,46 @@ void atc_offset_date_time_print(
   atc_local_date_time_print(sb, (const AtcLocalDateTime *) odt);
   print_offset_seconds(sb, odt->offset_seconds);
 }
+
+size_t atc_offset_seconds_parse_prefix(
+    const char *s,
+    size_t len,
+    int32_t *offset_seconds)
+{
+  if (len >= 1 && (s[0] == 'Z' || s[0] == 'z')) {
+    *offset_seconds = 0;
+    return 1;
+  }
+  if (len < 6 || (s[0] != '+' && s[0] != '-') || s[3] != ':') return 0;
+
+  uint8_t h1 = (uint8_t) (s[1] - '0');
+  uint8_t h2 = (uint8_t) (s[2] - '0');
+  uint8_t m1 = (uint8_t) (s[4] - '0');
+  uint8_t m2 = (uint8_t) (s[5] - '0');
+  if (h1 > 9 || h2 > 9 || m1 > 9 || m2 > 9) return 0;
+  uint8_t hh = h1 * 10 + h2;
+  uint8_t mm = m1 * 10 + m2;
+  if (hh > 23 || mm > 59) return 0;
+
+  int32_t seconds = ((int32_t) hh * 60 + mm) * 60;
+  *offset_seconds = (s[0] == '-') ? -seconds : seconds;
+  return 6;
+}
+
+int8_t atc_offset_date_time_parse(
+    AtcOffsetDateTime *odt,
+    const char *s,
+    size_t len)
+{
+  AtcLocalDateTime *ldt = (AtcLocalDateTime *) odt;
+  size_t n = atc_local_date_time_parse_prefix(ldt, s, len);
+  if (n == 0) return kAtcErrGeneric;
+
+  size_t m = atc_offset_seconds_parse_prefix(
+      s + n, len - n, &odt->offset_seconds);
+  if (m == 0 || n + m != len) {
+    atc_offset_date_time_set_error(odt);
+    return kAtcErrGeneric;
+  }
+  return kAtcErrOk;
+}
@@ -14,6 +14,7 @@
 #ifndef ACE_TIME_C_OFFSET_DATE_TIME_H
 #define ACE_TIME_C_OFFSET_DATE_TIME_H
 
+#include <stddef.h> // size_t
 #include <stdint.h>
 #include "common.h" // atc_time_t
 #include "string_buffer.h"
@@ -93,6 +94,30 @@ void atc_offset_date_time_print(
     AtcStringBuffer *sb,
     const AtcOffsetDateTime *odt);
 
+/**
+ * Parse the UTC offset 'Z' (or 'z') or `+/-hh:mm` at the beginning of the
+ * string `s` of length `len` into `offset_seconds`. Return the number of
+ * characters consumed, or 0 if there is no valid offset.
+ */
+size_t atc_offset_seconds_parse_prefix(
+    const char *s,
+    size_t len,
+    int32_t *offset_seconds);
+
+/**
+ * Parse the ISO 8601 or RFC 3339 date time
+ * `YYYY-MM-DDThh:mm:ss[.fff](Z|+/-hh:mm)` in the string `s` of length `len`,
+ * which does not need to be NUL-terminated. The date time is parsed using
+ * atc_local_date_time_parse_prefix(), followed by the required UTC offset,
+ * and must consume the whole string.
+ *
+ * Return kAtcErrGeneric upon error, and set odt to its error value.
+ */
+int8_t atc_offset_date_time_parse(
+    AtcOffsetDateTime *odt,
+    const char *s,
+    size_t len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,346 @@
+/*
+ * MIT License
+ * Copyright (c) 2024 Brian T. Park
+ */
+
+#include "shared_cache.h"
+
+#if ATC_ENABLE_SHARED_CACHE
+
+#include <stdbool.h>
+#include <string.h> // memcpy()
+#include "common.h" // kAtcMinYear, kAtcMaxYear, atc_cpu_relax()
+#include "epoch.h" // AtcEpochContext
+#include "local_date_time.h"
+#include "offset_date_time.h" // AtcOffsetDateTime
+#include "transition.h" // kAtcAbbrevSize
+#include "zone_processor.h"
+#include "zoned_extra.h" // AtcZonedExtra
+
+void atc_shared_cache_init(
+    AtcSharedCache *cache,
+    AtcSharedCacheEntry *entries,
+    uint16_t size)
+{
+  if (size == 0) size = 1;
+  cache->entries = entries;
+  cache->size = size;
+  cache->is_counting = false;
+  cache->num_hits = 0;
+  cache->num_misses = 0;
+  for (uint16_t i = 0; i < size; i++) {
+    AtcSharedCacheEntry *entry = &entries[i];
+    entry->seq = 0;
+    entry->zone_info = NULL;
+    entry->zone_id = 0;
+    entry->year = kAtcInvalidYear;
+    entry->epoch_year = kAtcInvalidYear;
+    // Make the transition storage valid for readers, even if it is never
+    // filled.
+    atc_processor_init(&entry->processor);
+    atc_transition_storage_init(&entry->processor.transition_storage, NULL);
+  }
+}
+
+void atc_shared_cache_enable_stats(AtcSharedCache *cache, bool enable)
+{
+  cache->is_counting = enable;
+}
+
+// Return the slot of the given (zone_info, year).
+static AtcSharedCacheEntry *atc_shared_cache_entry(
+    AtcSharedCache *cache,
+    const AtcZoneInfo *zone_info,
+    int16_t year)
+{
+  // The zone_id is already a hash of the zone name, so only the year needs to
+  // be mixed in.
+  uint32_t h = zone_info->zone_id ^ ((uint32_t) (uint16_t) year * 2654435761u);
+  h ^= h >> 16;
+  return &cache->entries[h % cache->size];
+}
+
+// Perform the lookup using the transitions of `processor`, which may be
+// concurrently modified by another thread. The lookup never follows a pointer
+// outside of the processor, and the result is discarded by the caller if the
+// sequence number of the slot has changed.
+static void atc_shared_cache_lookup(
+    const AtcZoneProcessor *processor,
+    const AtcLocalDateTime *ldt,
+    atc_time_t epoch_seconds,
+    AtcFindResult *result,
+    char *abbrev)
+{
+  if (ldt) {
+    atc_processor_lookup_by_local_date_time(processor, ldt, result);
+  } else {
+    atc_processor_lookup_by_epoch_seconds(processor, epoch_seconds, result);
+  }
+  if (result->type != kAtcFindResultNotFound) {
+    memcpy(abbrev, result->abbrev, kAtcAbbrevSize);
+    abbrev[kAtcAbbrevSize - 1] = '\0';
+  } else {
+    abbrev[0] = '\0';
+  }
+  result->abbrev = abbrev;
+}
+
+// Find the result for either the `ldt` (if not NULL) or the `epoch_seconds`,
+// using the slot of (zone_info, year).
+static void atc_shared_cache_find(
+    AtcSharedCache *cache,
+    const AtcEpochContext *ctx,
+    const AtcZoneInfo *zone_info,
+    int16_t year,
+    const AtcLocalDateTime *ldt,
+    atc_time_t epoch_seconds,
+    AtcFindResult *result,
+    char *abbrev)
+{
+  // Same range restriction as atc_processor_init_for_year().
+  if (year <= kAtcMinYear || kAtcMaxYear <= year) {
+    result->type = kAtcFindResultNotFound;
+    return;
+  }
+
+  AtcSharedCacheEntry *entry = atc_shared_cache_entry(cache, zone_info, year);
+  for (;;) {
+    uint32_t seq = __atomic_load_n(&entry->seq, __ATOMIC_ACQUIRE);
+    if (seq & 1) {
+      // Another thread is filling the slot, which takes from hundreds of ns
+      // to a few us.
+      atc_cpu_relax();
+      continue;
+    }
+
+    bool matches =
+        __atomic_load_n(&entry->zone_info, __ATOMIC_RELAXED) == zone_info
+        && __atomic_load_n(&entry->zone_id, __ATOMIC_RELAXED)
+            == zone_info->zone_id
+        && __atomic_load_n(&entry->year, __ATOMIC_RELAXED) == year
+        && __atomic_load_n(&entry->epoch_year, __ATOMIC_RELAXED)
+            == ctx->epoch_year;
+    if (matches) {
+      atc_shared_cache_lookup(
+          &entry->processor, ldt, epoch_seconds, result, abbrev);
+      __atomic_thread_fence(__ATOMIC_ACQUIRE);
+      if (__atomic_load_n(&entry->seq, __ATOMIC_RELAXED) == seq) {
+        if (cache->is_counting) {
+          __atomic_fetch_add(&cache->num_hits, 1, __ATOMIC_RELAXED);
+        }
+        return;
+      }
+      continue; // the slot was replaced during the lookup
+    }
+
+    // Become the only thread which fills this slot, or retry if another
+    // thread got there first.
+    if (! __atomic_compare_exchange_n(&entry->seq, &seq, seq + 1,
+        false /*weak*/, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+      continue;
+    }
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    AtcZoneProcessor *processor = &entry->processor;
+    atc_processor_init(processor);
+    atc_processor_init_for_zone_info(processor, zone_info);
+    int8_t err = atc_processor_init_for_year_ctx(processor, ctx, year);
+    if (err) {
+      __atomic_store_n(&entry->zone_info, NULL, __ATOMIC_RELAXED);
+      result->type = kAtcFindResultNotFound;
+    } else {
+      // Readers cannot calculate the abbreviations on demand.
+      atc_processor_calc_all_abbreviations(processor);
+      __atomic_store_n(&entry->zone_info, zone_info, __ATOMIC_RELAXED);
+      __atomic_store_n(&entry->zone_id, zone_info->zone_id, __ATOMIC_RELAXED);
+      __atomic_store_n(&entry->year, year, __ATOMIC_RELAXED);
+      __atomic_store_n(&entry->epoch_year, ctx->epoch_year, __ATOMIC_RELAXED);
+      atc_shared_cache_lookup(processor, ldt, epoch_seconds, result, abbrev);
+    }
+
+    // Publish the slot.
+    __atomic_store_n(&entry->seq, seq + 2, __ATOMIC_RELEASE);
+    if (cache->is_counting) {
+      __atomic_fetch_add(&cache->num_misses, 1, __ATOMIC_RELAXED);
+    }
+    return;
+  }
+}
+
+void atc_shared_cache_find_by_epoch_seconds(
+    AtcSharedCache *cache,
+    const AtcZoneInfo *zone_info,
+    atc_time_t epoch_seconds,
+    AtcFindResult *result,
+    char *abbrev)
+{
+  AtcEpochContext ctx;
+  atc_epoch_context_init_from_current(&ctx);
+
+  // Select the slot using the same UTC year that
+  // atc_processor_init_for_epoch_seconds() would use.
+  AtcLocalDateTime ldt;
+  atc_local_date_time_from_epoch_seconds_ctx(&ctx, &ldt, epoch_seconds);
+  if (atc_local_date_time_is_error(&ldt)) {
+    result->type = kAtcFindResultNotFound;
+    return;
+  }
+
+  atc_shared_cache_find(
+      cache, &ctx, zone_info, ldt.year, NULL, epoch_seconds, result, abbrev);
+}
+
+void atc_shared_cache_find_by_local_date_time(
+    AtcSharedCache *cache,
+    const AtcZoneInfo *zone_info,
+    const AtcLocalDateTime *ldt,
+    AtcFindResult *result,
+    char *abbrev)
+{
+  AtcEpochContext ctx;
+  atc_epoch_context_init_from_current(&ctx);
+  atc_shared_cache_find(
+      cache, &ctx, zone_info, ldt->year, ldt, 0, result, abbrev);
+}
+
+//---------------------------------------------------------------------------
+
+void atc_shared_cache_offset_date_time_from_epoch_seconds(
+    AtcSharedCache *cache,
+    const AtcZoneInfo *zone_info,
+    atc_time_t epoch_seconds,
+    AtcOffsetDateTime *odt)
+{
+  int32_t offset_seconds;
+  uint8_t fold;
+  if (zone_info) {
+    AtcFindResult result;
+    char abbrev[kAtcAbbrevSize];
+    atc_shared_cache_find_by_epoch_seconds(
+        cache, zone_info, epoch_seconds, &result, abbrev);
+    if (result.type == kAtcFindResultNotFound) {
+      atc_offset_date_time_set_error(odt);
+      return;
+    }
+    offset_seconds = result.std_offset_seconds + result.dst_offset_seconds;
+    fold = result.fold;
+  } else {
+    offset_seconds = 0;
+    fold = 0;
+  }
+
+  atc_offset_date_time_from_epoch_seconds(odt, epoch_seconds, offset_seconds);
+  odt->fold = fold;
+}
+
+void atc_shared_cache_offset_date_time_from_local_date_time(
+    AtcSharedCache *cache,
+    const AtcZoneInfo *zone_info,
+    const AtcLocalDateTime *ldt,
+    AtcOffsetDateTime *odt)
+{
+  odt->year = ldt->year;
+  odt->month = ldt->month;
+  odt->day = ldt->day;
+  odt->hour = ldt->hour;
+  odt->minute = ldt->minute;
+  odt->second = ldt->second;
+  if (! zone_info) {
+    odt->offset_seconds = 0;
+    odt->fold = 0;
+    return;
+  }
+
+  AtcFindResult result;
+  char abbrev[kAtcAbbrevSize];
+  atc_shared_cache_find_by_local_date_time(
+      cache, zone_info, ldt, &result, abbrev);
+  if (result.type == kAtcFindResultNotFound) {
+    atc_offset_date_time_set_error(odt);
+    return;
+  }
+
+  // Same as atc_time_zone_offset_date_time_from_local_date_time().
+  odt->offset_seconds =
+      result.req_std_offset_seconds + result.req_dst_offset_seconds;
+  odt->fold = result.fold;
+  if (result.type == kAtcFindResultGap) {
+    atc_time_t epoch_seconds = atc_offset_date_time_to_epoch_seconds(odt);
+    int32_t target_offset =
+        result.std_offset_seconds + result.dst_offset_seconds;
+    atc_offset_date_time_from_epoch_seconds(
+        odt, epoch_seconds, target_offset);
+  }
+}
+
+// Copy the AtcFindResult into the AtcZonedExtra, or set to UTC if `result` is
+// NULL.
+static void atc_shared_cache_fill_zoned_extra(
+    AtcZonedExtra *extra,
+    const AtcFindResult *result)
+{
+  if (! result) {
+    extra->fold_type = kAtcFindResultExact;
+    extra->std_offset_seconds = 0;
+    extra->dst_offset_seconds = 0;
+    extra->req_std_offset_seconds = 0;
+    extra->req_dst_offset_seconds = 0;
+    memcpy(extra->abbrev, "UTC", sizeof("UTC"));
+    return;
+  }
+
+  extra->fold_type = result->type;
+  if (result->type == kAtcFindResultNotFound) return;
+  extra->std_offset_seconds = result->std_offset_seconds;
+  extra->dst_offset_seconds = result->dst_offset_seconds;
+  extra->req_std_offset_seconds = result->req_std_offset_seconds;
+  extra->req_dst_offset_seconds = result->req_dst_offset_seconds;
+  memcpy(extra->abbrev, result->abbrev, kAtcAbbrevSize);
+}
+
+void atc_shared_cache_zoned_extra_from_epoch_seconds(
+    AtcSharedCache *cache,
+    const AtcZoneInfo *zone_info,
+    atc_time_t epoch_seconds,
+    AtcZonedExtra *extra)
+{
+  if (epoch_seconds == kAtcInvalidEpochSeconds) {
+    atc_zoned_extra_set_error(extra);
+    return;
+  }
+  if (! zone_info) {
+    atc_shared_cache_fill_zoned_extra(extra, NULL);
+    return;
+  }
+
+  AtcFindResult result;
+  char abbrev[kAtcAbbrevSize];
+  atc_shared_cache_find_by_epoch_seconds(
+      cache, zone_info, epoch_seconds, &result, abbrev);
+  atc_shared_cache_fill_zoned_extra(extra, &result);
+}
+
+void atc_shared_cache_zoned_extra_from_local_date_time(
+    AtcSharedCache *cache,
+    const AtcZoneInfo *zone_info,
+    const AtcLocalDateTime *ldt,
+    AtcZonedExtra *extra)
+{
+  if (! zone_info) {
+    atc_shared_cache_fill_zoned_extra(extra, NULL);
+    return;
+  }
+
+  AtcFindResult result;
+  char abbrev[kAtcAbbrevSize];
+  atc_shared_cache_find_by_local_date_time(
+      cache, zone_info, ldt, &result, abbrev);
+  atc_shared_cache_fill_zoned_extra(extra, &result);
+}
+
+#else
+
+// ISO C forbids an empty translation unit.
+typedef int atc_shared_cache_disabled;
+
+#endif
@@ -0,0 +1,207 @@
+/*
+ * MIT License
+ * Copyright (c) 2024 Brian T. Park
+ */
+
+/**
+ * @file shared_cache.h
+ *
+ * A process-wide cache of the transitions of (zone, year) pairs which can be
+ * shared by multiple threads. Each AtcTimeZone normally needs its own
+ * AtcZoneProcessor, and an AtcZoneProcessor cannot be used by more than one
+ * thread at a time, so a multi-threaded application would otherwise need an
+ * AtcZoneProcessor for every (thread, zone) combination, each of which warms up
+ * independently.
+ *
+ * The AtcSharedCache is a direct-mapped table of slots indexed by a hash of
+ * the (zone_id, year). Each slot holds an AtcZoneProcessor and is protected by
+ * a sequence lock:
+ *
+ *  * Readers never write to the slot. They read the sequence number, perform
+ *    the lookup, then read the sequence number again. If the sequence number
+ *    was odd (fill in progress) or changed, the lookup is retried.
+ *  * A missing (zone, year) is filled by exactly one thread, which changes the
+ *    sequence number from even to odd using an atomic compare-and-swap,
+ *    calculates the transitions in place, then publishes the slot by storing
+ *    the next even sequence number with release semantics.
+ *
+ * Because the contents of a slot can be replaced at any time by another
+ * thread, the functions in this file return copies of the results (offsets and
+ * abbreviation) instead of pointers into the cache.
+ *
+ * This requires the GCC/Clang `__atomic` builtins. The feature is enabled by
+ * default on hosted GCC or Clang targets except AVR, and can be controlled
+ * explicitly by defining ATC_ENABLE_SHARED_CACHE to 0 or 1.
+ */
+
+#ifndef ACE_TIME_C_SHARED_CACHE_H
+#define ACE_TIME_C_SHARED_CACHE_H
+
+#ifndef ATC_ENABLE_SHARED_CACHE
+  #if (defined(__GNUC__) || defined(__clang__)) && !defined(__AVR__)
+    #define ATC_ENABLE_SHARED_CACHE 1
+  #else
+    #define ATC_ENABLE_SHARED_CACHE 0
+  #endif
+#endif
+
+#if ATC_ENABLE_SHARED_CACHE
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "common.h" // atc_time_t
+#include "../zoneinfo/zone_info.h"
+#include "local_date_time.h" // AtcLocalDateTime
+#include "zone_processor.h" // AtcZoneProcessor
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Forward declaration for AtcOffsetDateTime. */
+typedef struct AtcOffsetDateTime AtcOffsetDateTime;
+
+/** Forward declaration for AtcZonedExtra. */
+typedef struct AtcZonedExtra AtcZonedExtra;
+
+/** A single slot of the AtcSharedCache. */
+typedef struct AtcSharedCacheEntry {
+  /**
+   * Sequence number of the slot, accessed only through atomic operations. An
+   * odd value means that the slot is being filled.
+   */
+  uint32_t seq;
+
+  /** The time zone of the slot, NULL if the slot is empty. */
+  const AtcZoneInfo *zone_info;
+
+  /** The zone_id of zone_info when the slot was filled. */
+  uint32_t zone_id;
+
+  /** The year of the transitions in the slot. */
+  int16_t year;
+
+  /** The epoch year used to calculate the transitions in the slot. */
+  int16_t epoch_year;
+
+  /** The transitions of (zone_info, year). */
+  AtcZoneProcessor processor;
+} AtcSharedCacheEntry;
+
+/**
+ * A cache of the transitions of (zone, year) pairs which can be read and
+ * filled concurrently by multiple threads. The array of entries is allocated
+ * by the caller, and is usually a global.
+ */
+typedef struct AtcSharedCache {
+  /** Array of slots, allocated by the caller. */
+  AtcSharedCacheEntry *entries;
+
+  /** Number of slots in `entries`. */
+  uint16_t size;
+
+  /**
+   * True if the lookups update `num_hits` and `num_misses`. False by default,
+   * because every thread would otherwise write to the same cache line on
+   * every lookup.
+   */
+  bool is_counting;
+
+  /** Number of lookups which found their (zone, year) in the cache. */
+  uint32_t num_hits;
+
+  /** Number of lookups which required a slot to be filled. */
+  uint32_t num_misses;
+} AtcSharedCache;
+
+/**
+ * Initialize the AtcSharedCache with an array of `size` entries. This must be
+ * called once, before the cache is shared with other threads.
+ */
+void atc_shared_cache_init(
+    AtcSharedCache *cache,
+    AtcSharedCacheEntry *entries,
+    uint16_t size);
+
+/**
+ * Enable or disable the `num_hits` and `num_misses` counters, which are
+ * disabled by atc_shared_cache_init(). The counters are shared by all threads,
+ * so they slow down concurrent lookups, and are intended for tuning the size
+ * of the cache. This must be called before the cache is shared with other
+ * threads.
+ */
+void atc_shared_cache_enable_stats(AtcSharedCache *cache, bool enable);
+
+/**
+ * Find the AtcFindResult of the zone_info at the given epoch_seconds. The
+ * abbreviation is copied into `abbrev`, an array of kAtcAbbrevSize, and
+ * `result.abbrev` points to `abbrev`. Returns kAtcFindResultNotFound in
+ * `result.type` upon failure.
+ */
+void atc_shared_cache_find_by_epoch_seconds(
+    AtcSharedCache *cache,
+    const AtcZoneInfo *zone_info,
+    atc_time_t epoch_seconds,
+    AtcFindResult *result,
+    char *abbrev);
+
+/**
+ * Find the AtcFindResult of the zone_info at the given AtcLocalDateTime. The
+ * abbreviation is copied into `abbrev`, an array of kAtcAbbrevSize, and
+ * `result.abbrev` points to `abbrev`. Returns kAtcFindResultNotFound in
+ * `result.type` upon failure.
+ */
+void atc_shared_cache_find_by_local_date_time(
+    AtcSharedCache *cache,
+    const AtcZoneInfo *zone_info,
+    const AtcLocalDateTime *ldt,
+    AtcFindResult *result,
+    char *abbrev);
+
+/**
+ * Same as atc_time_zone_offset_date_time_from_epoch_seconds() using the
+ * shared cache instead of an AtcZoneProcessor. A NULL zone_info means UTC.
+ */
+void atc_shared_cache_offset_date_time_from_epoch_seconds(
+    AtcSharedCache *cache,
+    const AtcZoneInfo *zone_info,
+    atc_time_t epoch_seconds,
+    AtcOffsetDateTime *odt);
+
+/**
+ * Same as atc_time_zone_offset_date_time_from_local_date_time() using the
+ * shared cache instead of an AtcZoneProcessor. A NULL zone_info means UTC.
+ */
+void atc_shared_cache_offset_date_time_from_local_date_time(
+    AtcSharedCache *cache,
+    const AtcZoneInfo *zone_info,
+    const AtcLocalDateTime *ldt,
+    AtcOffsetDateTime *odt);
+
+/**
+ * Same as atc_time_zone_zoned_extra_from_epoch_seconds() using the shared
+ * cache instead of an AtcZoneProcessor. A NULL zone_info means UTC.
+ */
+void atc_shared_cache_zoned_extra_from_epoch_seconds(
+    AtcSharedCache *cache,
+    const AtcZoneInfo *zone_info,
+    atc_time_t epoch_seconds,
+    AtcZonedExtra *extra);
+
+/**
+ * Same as atc_time_zone_zoned_extra_from_local_date_time() using the shared
+ * cache instead of an AtcZoneProcessor. A NULL zone_info means UTC.
+ */
+void atc_shared_cache_zoned_extra_from_local_date_time(
+    AtcSharedCache *cache,
+    const AtcZoneInfo *zone_info,
+    const AtcLocalDateTime *ldt,
+    AtcZonedExtra *extra);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+#endif
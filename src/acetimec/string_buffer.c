@@ -3,8 +3,32 @@
  * Copyright (c) 2022 Brian T. Park
  */
 
+#include <string.h> // memcpy()
 #include "string_buffer.h"
 
+const char kAtcDigitPairs[200] = {
+  '0','0', '0','1', '0','2', '0','3', '0','4',
+  '0','5', '0','6', '0','7', '0','8', '0','9',
+  '1','0', '1','1', '1','2', '1','3', '1','4',
+  '1','5', '1','6', '1','7', '1','8', '1','9',
+  '2','0', '2','1', '2','2', '2','3', '2','4',
+  '2','5', '2','6', '2','7', '2','8', '2','9',
+  '3','0', '3','1', '3','2', '3','3', '3','4',
+  '3','5', '3','6', '3','7', '3','8', '3','9',
+  '4','0', '4','1', '4','2', '4','3', '4','4',
+  '4','5', '4','6', '4','7', '4','8', '4','9',
+  '5','0', '5','1', '5','2', '5','3', '5','4',
+  '5','5', '5','6', '5','7', '5','8', '5','9',
+  '6','0', '6','1', '6','2', '6','3', '6','4',
+  '6','5', '6','6', '6','7', '6','8', '6','9',
+  '7','0', '7','1', '7','2', '7','3', '7','4',
+  '7','5', '7','6', '7','7', '7','8', '7','9',
+  '8','0', '8','1', '8','2', '8','3', '8','4',
+  '8','5', '8','6', '8','7', '8','8', '8','9',
+  '9','0', '9','1', '9','2', '9','3', '9','4',
+  '9','5', '9','6', '9','7', '9','8', '9','9',
+};
+
 void atc_buf_init(AtcStringBuffer *sb, char *p, uint8_t capacity)
 {
   sb->p = p;
@@ -62,6 +86,13 @@ void atc_print_uint16(AtcStringBuffer *sb, uint16_t n)
 
 void atc_print_uint16_pad2(AtcStringBuffer *sb, uint16_t n)
 {
+  // Fast path: both digits fit, and are copied from the table.
+  if (n < 100 && sb->capacity - sb->size >= 2) {
+    memcpy(&sb->p[sb->size], &kAtcDigitPairs[2 * n], 2);
+    sb->size += 2;
+    return;
+  }
+
   if (n < 10) {
     atc_print_char(sb, '0');
   }
@@ -70,6 +101,14 @@ void atc_print_uint16_pad2(AtcStringBuffer *sb, uint16_t n)
 
 void atc_print_uint16_pad4(AtcStringBuffer *sb, uint16_t n)
 {
+  // Fast path: all 4 digits fit, and are copied from the table.
+  if (n < 10000 && sb->capacity - sb->size >= 4) {
+    memcpy(&sb->p[sb->size], &kAtcDigitPairs[2 * (n / 100)], 2);
+    memcpy(&sb->p[sb->size + 2], &kAtcDigitPairs[2 * (n % 100)], 2);
+    sb->size += 4;
+    return;
+  }
+
   if (n < 10) {
     atc_print_char(sb, '0');
   }
@@ -91,3 +130,41 @@ void atc_print_int16(AtcStringBuffer *sb, int16_t n)
     atc_print_uint16(sb, -n);
   }
 }
+
+//---------------------------------------------------------------------------
+
+void atc_large_buf_init(AtcLargeStringBuffer *sb, char *p, size_t capacity)
+{
+  sb->p = p;
+  sb->capacity = capacity;
+  sb->size = 0;
+}
+
+void atc_large_buf_reset(AtcLargeStringBuffer *sb)
+{
+  sb->size = 0;
+}
+
+void atc_large_buf_close(AtcLargeStringBuffer *sb)
+{
+  if (sb->size >= sb->capacity) {
+    sb->size = sb->capacity - 1;
+  }
+  sb->p[sb->size] = '\0';
+}
+
+void atc_large_print_char(AtcLargeStringBuffer *sb, char c)
+{
+  if (sb->size >= sb->capacity) return;
+  sb->p[sb->size] = c;
+  sb->size++;
+}
+
+void atc_large_print_string(AtcLargeStringBuffer *sb, const char *s)
+{
+  while (sb->size < sb->capacity && *s != '\0') {
+    sb->p[sb->size] = *s;
+    sb->size++;
+    s++;
+  }
+}
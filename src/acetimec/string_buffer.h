@@ -7,6 +7,10 @@
  * @file string_buffer.h
  *
  * A simple set of integer to string conversion functions.
+ *
+ * The AtcStringBuffer holds at most 255 characters. The AtcLargeStringBuffer
+ * uses size_t for its capacity and size, so that it can hold a large batch of
+ * formatted text (see timestamp_format.h).
  */
 
 #ifndef ACE_TIME_C_STRING_BUFFER_H
@@ -56,6 +60,40 @@ void atc_print_uint16_pad4(AtcStringBuffer *sb, uint16_t n);
 /** Print the signed integer. A negative number will print a leading "-". */
 void atc_print_int16(AtcStringBuffer *sb, int16_t n);
 
+/**
+ * The 2-digit representations of the numbers [0,99], without NUL
+ * terminators: "000102...9899". The digits of n are at `kAtcDigitPairs[2*n]`.
+ */
+extern const char kAtcDigitPairs[200];
+
+/** An array of characters whose capacity is not limited to 255. */
+typedef struct AtcLargeStringBuffer {
+  /** Pointer to base of the string buffer. */
+  char *p;
+  /** Total allocated size of buffer. */
+  size_t capacity;
+  /** Current buffer usage. */
+  size_t size;
+} AtcLargeStringBuffer;
+
+/** Initialize the AtcLargeStringBuffer with its char pointer and capacity. */
+void atc_large_buf_init(AtcLargeStringBuffer *sb, char *p, size_t capacity);
+
+/** Reset the buffer to zero length. */
+void atc_large_buf_reset(AtcLargeStringBuffer *sb);
+
+/**
+ * Finalize the AtcLargeStringBuffer by terminating the string with a NUL,
+ * which replaces the last character if the buffer is full.
+ */
+void atc_large_buf_close(AtcLargeStringBuffer *sb);
+
+/** Print one char into the AtcLargeStringBuffer. */
+void atc_large_print_char(AtcLargeStringBuffer *sb, char c);
+
+/** Print the given string into the AtcLargeStringBuffer. */
+void atc_large_print_string(AtcLargeStringBuffer *sb, const char *s);
+
 #ifdef __cplusplus
 }
 #endif
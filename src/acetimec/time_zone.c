@@ -5,11 +5,16 @@
 
 #include <stdbool.h>
 #include <string.h> // memcpy()
-#include "local_date.h" // kAtcInvalidEpochSeconds
+#include "common.h" // kAtcErrOk
+#include "epoch.h" // atc_epoch_valid_year_lower()
+#include "local_date.h" // atc_local_date_to_epoch_days()
+#include "local_date_time.h" // atc_local_date_time_from_epoch_seconds()
+#include "transition.h" // atc_transition_calculate_fold_and_overlap()
 #include "../zoneinfo/zone_info_utils.h" // atc_zone_info_zone_name()
 #include "zone_processor.h"
 #include "offset_date_time.h" // AtcOffsetDateTime
 #include "zoned_extra.h" // AtcZonedExtra
+#include "zone_transitions.h" // atc_zone_transitions_is_change_at()
 #include "time_zone.h"
 
 // A default time zone representing UTC.
@@ -28,7 +33,7 @@ void atc_time_zone_offset_date_time_from_epoch_seconds(
     atc_processor_init_for_zone_info(tz->zone_processor, tz->zone_info);
 
     AtcFindResult result;
-    atc_processor_find_by_epoch_seconds(
+    atc_processor_find_offsets_by_epoch_seconds(
         tz->zone_processor, epoch_seconds, &result);
     if (result.type == kAtcFindResultNotFound) {
       atc_offset_date_time_set_error(odt);
@@ -56,7 +61,8 @@ void atc_time_zone_offset_date_time_from_local_date_time(
     atc_processor_init_for_zone_info(tz->zone_processor, tz->zone_info);
 
     AtcFindResult result;
-    atc_processor_find_by_local_date_time(tz->zone_processor, ldt, &result);
+    atc_processor_find_offsets_by_local_date_time(
+        tz->zone_processor, ldt, &result);
     if (result.type == kAtcFindResultNotFound) {
       atc_offset_date_time_set_error(odt);
       return;
@@ -164,6 +170,227 @@ void atc_time_zone_zoned_extra_from_local_date_time(
   }
 }
 
+//---------------------------------------------------------------------------
+// Batch conversions.
+//---------------------------------------------------------------------------
+
+// State carried from one element to the next by the batch conversions. The
+// [start_seconds, until_seconds) interval is the UTC year whose transitions are
+// held by the AtcZoneProcessor, in 64-bits to avoid overflow near the limits
+// of atc_time_t.
+typedef struct AtcBatchCursor {
+  int64_t start_seconds;
+  int64_t until_seconds;
+  uint8_t index;
+} AtcBatchCursor;
+
+static void atc_batch_cursor_init(AtcBatchCursor *cursor)
+{
+  cursor->start_seconds = 0;
+  cursor->until_seconds = 0; // empty interval, forces the first init
+  cursor->index = 0;
+}
+
+// Find the total UTC offset and fold at epoch_seconds. Returns false if not
+// found. Produces the same result as atc_processor_find_by_epoch_seconds(),
+// but the linear scan of the transitions starts at the transition found by the
+// previous call.
+static bool atc_time_zone_batch_find(
+    AtcZoneProcessor *processor,
+    AtcBatchCursor *cursor,
+    atc_time_t epoch_seconds,
+    int32_t *offset_seconds,
+    uint8_t *fold)
+{
+  if (epoch_seconds == kAtcInvalidEpochSeconds) return false;
+
+  if (epoch_seconds < cursor->start_seconds
+      || epoch_seconds >= cursor->until_seconds) {
+    AtcLocalDateTime ldt;
+    atc_local_date_time_from_epoch_seconds(&ldt, epoch_seconds);
+    if (atc_local_date_time_is_error(&ldt)) return false;
+    int8_t err = atc_processor_init_for_year(processor, ldt.year);
+    if (err) return false;
+    cursor->start_seconds = (int64_t) 86400
+        * atc_local_date_to_epoch_days(ldt.year, 1, 1);
+    cursor->until_seconds = (int64_t) 86400
+        * atc_local_date_to_epoch_days(ldt.year + 1, 1, 1);
+    cursor->index = 0;
+  }
+
+  const AtcTransitionStorage *ts = &processor->transition_storage;
+  AtcTransition * const *transitions = ts->transitions;
+  uint8_t n = ts->index_free;
+  uint8_t i = cursor->index;
+  if (i >= n || transitions[i]->start_epoch_seconds > epoch_seconds) {
+    i = 0; // the input went backwards
+  }
+  while (i + 1 < n
+      && transitions[i + 1]->start_epoch_seconds <= epoch_seconds) {
+    i++;
+  }
+  cursor->index = i;
+  if (n == 0 || transitions[i]->start_epoch_seconds > epoch_seconds) {
+    return false;
+  }
+
+  const AtcTransition *curr = transitions[i];
+  const AtcTransition *prev = (i > 0) ? transitions[i - 1] : NULL;
+  const AtcTransition *next = (i + 1 < n) ? transitions[i + 1] : NULL;
+  uint8_t num;
+  atc_transition_calculate_fold_and_overlap(
+      fold, &num, prev, curr, next, epoch_seconds);
+  *offset_seconds = curr->offset_seconds + curr->delta_seconds;
+  return true;
+}
+
+void atc_time_zone_offset_date_times_from_epoch_seconds(
+  const AtcTimeZone *tz,
+  const atc_time_t *epoch_seconds,
+  size_t n,
+  AtcOffsetDateTime *odts)
+{
+  if (tz->zone_info) {
+    atc_processor_init_for_zone_info(tz->zone_processor, tz->zone_info);
+  }
+
+  AtcBatchCursor cursor;
+  atc_batch_cursor_init(&cursor);
+  for (size_t i = 0; i < n; i++) {
+    int32_t offset_seconds = 0;
+    uint8_t fold = 0;
+    if (tz->zone_info) {
+      bool found = atc_time_zone_batch_find(
+          tz->zone_processor, &cursor, epoch_seconds[i],
+          &offset_seconds, &fold);
+      if (! found) {
+        atc_offset_date_time_set_error(&odts[i]);
+        continue;
+      }
+    }
+    atc_offset_date_time_from_epoch_seconds(
+        &odts[i], epoch_seconds[i], offset_seconds);
+    odts[i].fold = fold;
+  }
+}
+
+void atc_time_zone_offsets_from_epoch_seconds(
+  const AtcTimeZone *tz,
+  const atc_time_t *epoch_seconds,
+  size_t n,
+  int32_t *offsets,
+  uint8_t *folds)
+{
+  if (! tz->zone_info) {
+    for (size_t i = 0; i < n; i++) {
+      bool valid = epoch_seconds[i] != kAtcInvalidEpochSeconds;
+      offsets[i] = valid ? 0 : kAtcInvalidOffsetSeconds;
+      if (folds) folds[i] = 0;
+    }
+    return;
+  }
+
+  atc_processor_init_for_zone_info(tz->zone_processor, tz->zone_info);
+  AtcBatchCursor cursor;
+  atc_batch_cursor_init(&cursor);
+  for (size_t i = 0; i < n; i++) {
+    int32_t offset_seconds;
+    uint8_t fold = 0;
+    bool found = atc_time_zone_batch_find(
+        tz->zone_processor, &cursor, epoch_seconds[i], &offset_seconds, &fold);
+    offsets[i] = found ? offset_seconds : kAtcInvalidOffsetSeconds;
+    if (folds) folds[i] = fold;
+  }
+}
+
+//---------------------------------------------------------------------------
+
+// Calculate the transitions of the given year, with the abbreviations needed
+// by atc_zone_transitions_is_change_at().
+static int8_t atc_time_zone_init_for_year(
+    AtcZoneProcessor *processor,
+    int16_t year)
+{
+  int8_t err = atc_processor_init_for_year(processor, year);
+  if (err) return err;
+  atc_processor_calc_all_abbreviations(processor);
+  return kAtcErrOk;
+}
+
+// Return the UTC year of epoch_seconds, or kAtcInvalidYear.
+static int16_t atc_time_zone_year_of(atc_time_t epoch_seconds)
+{
+  AtcLocalDateTime ldt;
+  atc_local_date_time_from_epoch_seconds(&ldt, epoch_seconds);
+  if (atc_local_date_time_is_error(&ldt)) return kAtcInvalidYear;
+  return ldt.year;
+}
+
+int8_t atc_time_zone_next_transition(
+  const AtcTimeZone *tz,
+  atc_time_t epoch_seconds,
+  AtcZoneTransition *transition)
+{
+  if (tz->zone_info == NULL) return kAtcErrGeneric;
+  if (epoch_seconds == kAtcInvalidEpochSeconds) return kAtcErrGeneric;
+  int16_t year = atc_time_zone_year_of(epoch_seconds);
+  if (year == kAtcInvalidYear) return kAtcErrGeneric;
+
+  AtcZoneProcessor *processor = tz->zone_processor;
+  atc_processor_init_for_zone_info(processor, tz->zone_info);
+  int16_t upper = atc_epoch_valid_year_upper();
+  while (true) {
+    year = atc_processor_next_transition_year(tz->zone_info, year);
+    if (year == kAtcInvalidYear || year >= upper) return kAtcErrGeneric;
+    int8_t err = atc_time_zone_init_for_year(processor, year);
+    if (err) return err;
+
+    AtcTransitionStorage *ts = &processor->transition_storage;
+    AtcTransition **begin = atc_transition_storage_get_active_pool_begin(ts);
+    uint8_t size = ts->index_free;
+    for (uint8_t i = 0; i < size; i++) {
+      if (begin[i]->start_epoch_seconds <= epoch_seconds) continue;
+      if (atc_zone_transitions_is_change_at(processor, i, transition)) {
+        return kAtcErrOk;
+      }
+    }
+    year++;
+  }
+}
+
+int8_t atc_time_zone_prev_transition(
+  const AtcTimeZone *tz,
+  atc_time_t epoch_seconds,
+  AtcZoneTransition *transition)
+{
+  if (tz->zone_info == NULL) return kAtcErrGeneric;
+  if (epoch_seconds == kAtcInvalidEpochSeconds) return kAtcErrGeneric;
+  int16_t year = atc_time_zone_year_of(epoch_seconds);
+  if (year == kAtcInvalidYear) return kAtcErrGeneric;
+
+  AtcZoneProcessor *processor = tz->zone_processor;
+  atc_processor_init_for_zone_info(processor, tz->zone_info);
+  int16_t lower = atc_epoch_valid_year_lower();
+  while (true) {
+    year = atc_processor_prev_transition_year(tz->zone_info, year);
+    if (year == kAtcInvalidYear || year < lower) return kAtcErrGeneric;
+    int8_t err = atc_time_zone_init_for_year(processor, year);
+    if (err) return err;
+
+    AtcTransitionStorage *ts = &processor->transition_storage;
+    AtcTransition **begin = atc_transition_storage_get_active_pool_begin(ts);
+    for (uint8_t i = ts->index_free; i > 0; i--) {
+      if (begin[i - 1]->start_epoch_seconds > epoch_seconds) continue;
+      if (atc_zone_transitions_is_change_at(processor, i - 1, transition)) {
+        return kAtcErrOk;
+      }
+    }
+    year--;
+  }
+}
+
+//---------------------------------------------------------------------------
+
 void atc_time_zone_print(AtcStringBuffer *sb, const AtcTimeZone *tz)
 {
   if (tz->zone_info == NULL) {
@@ -14,8 +14,10 @@
 #ifndef ACE_TIME_C_TIME_ZONE_H
 #define ACE_TIME_C_TIME_ZONE_H
 
+#include <stddef.h> // size_t
 #include "../zoneinfo/zone_info.h"
 #include "zone_processor.h"
+#include "zone_transitions.h" // AtcZoneTransition
 
 #ifdef __cplusplus
 extern "C" {
@@ -90,6 +92,71 @@ void atc_time_zone_zoned_extra_from_local_date_time(
   const AtcLocalDateTime *ldt,
   AtcZonedExtra *extra);
 
+/**
+ * Convert an array of `n` epoch_seconds to an array of AtcOffsetDateTime using
+ * the given time zone. This is equivalent to calling
+ * atc_time_zone_offset_date_time_from_epoch_seconds() on each element, but
+ * the transitions of the current year and the position of the most recent
+ * matching transition are retained from one element to the next, so sorted or
+ * nearly sorted input is processed with a forward walk instead of a new
+ * search for every element.
+ *
+ * Each element of `odts` which cannot be converted is set to an error state.
+ */
+void atc_time_zone_offset_date_times_from_epoch_seconds(
+  const AtcTimeZone *tz,
+  const atc_time_t *epoch_seconds,
+  size_t n,
+  AtcOffsetDateTime *odts);
+
+/**
+ * Same as atc_time_zone_offset_date_times_from_epoch_seconds() but writes only
+ * the total UTC offset (STD + DST) of each element into `offsets`, and its
+ * fold into `folds`, without converting to the date and time components. The
+ * `folds` parameter may be NULL. Each element which cannot be converted is set
+ * to `kAtcInvalidOffsetSeconds`.
+ */
+void atc_time_zone_offsets_from_epoch_seconds(
+  const AtcTimeZone *tz,
+  const atc_time_t *epoch_seconds,
+  size_t n,
+  int32_t *offsets,
+  uint8_t *folds);
+
+/**
+ * Find the first transition of the time zone which occurs strictly after
+ * epoch_seconds, and fill its start time, the UTC offsets before and after,
+ * and its abbreviation into `transition`. Transitions which change neither the
+ * offsets nor the abbreviation are skipped. The `tz.zone_processor` is rebound
+ * to the `zone_info` in case it was previously bound to a different
+ * `zone_info`.
+ *
+ * Years which cannot contain a transition according to the eras and rules of
+ * the zone are skipped without calculating their transitions.
+ *
+ * Returns kAtcErrGeneric if there is no transition before the end of the
+ * valid years of the current epoch (see atc_epoch_valid_year_upper()), or if
+ * the time zone is UTC.
+ */
+int8_t atc_time_zone_next_transition(
+  const AtcTimeZone *tz,
+  atc_time_t epoch_seconds,
+  AtcZoneTransition *transition);
+
+/**
+ * Find the last transition of the time zone which occurs at or before
+ * epoch_seconds, i.e. the transition which defines the UTC offset at
+ * epoch_seconds. Otherwise the same as atc_time_zone_next_transition().
+ *
+ * Returns kAtcErrGeneric if there is no transition after the start of the
+ * valid years of the current epoch (see atc_epoch_valid_year_lower()), or if
+ * the time zone is UTC.
+ */
+int8_t atc_time_zone_prev_transition(
+  const AtcTimeZone *tz,
+  atc_time_t epoch_seconds,
+  AtcZoneTransition *transition);
+
 /** Print the name of the current time zone. */
 void atc_time_zone_print(AtcStringBuffer *sb, const AtcTimeZone *tz);
 
@@ -0,0 +1,152 @@
+/*
+ * MIT License
+ * Copyright (c) 2024 Brian T. Park
+ */
+
+#include <string.h> // memcpy()
+#include "timestamp_format.h"
+
+// Write the 2 digits of n in [0,99], and return the pointer after them.
+static char *write_pad2(char *p, uint8_t n)
+{
+  memcpy(p, &kAtcDigitPairs[2 * n], 2);
+  return p + 2;
+}
+
+// Write "YYYY-MM-DDThh:mm:ss", and return the pointer after it. The year must
+// be in [0,9999].
+static char *write_date_time(
+    char *p,
+    int16_t year, uint8_t month, uint8_t day,
+    uint8_t hour, uint8_t minute, uint8_t second)
+{
+  p = write_pad2(p, (uint8_t) (year / 100));
+  p = write_pad2(p, (uint8_t) (year % 100));
+  *p++ = '-';
+  p = write_pad2(p, month);
+  *p++ = '-';
+  p = write_pad2(p, day);
+  *p++ = 'T';
+  p = write_pad2(p, hour);
+  *p++ = ':';
+  p = write_pad2(p, minute);
+  *p++ = ':';
+  return write_pad2(p, second);
+}
+
+// Write "+hh:mm", ignoring the seconds like atc_offset_date_time_print(), and
+// return the pointer after it.
+static char *write_offset(char *p, int32_t offset_seconds)
+{
+  if (offset_seconds < 0) {
+    *p++ = '-';
+    offset_seconds = -offset_seconds;
+  } else {
+    *p++ = '+';
+  }
+  uint16_t minutes = offset_seconds / 60;
+  p = write_pad2(p, (uint8_t) (minutes / 60));
+  *p++ = ':';
+  return write_pad2(p, (uint8_t) (minutes % 60));
+}
+
+static bool is_printable(const AtcLocalDateTime *ldt)
+{
+  return !atc_local_date_time_is_error(ldt)
+      && ldt->year >= 0 && ldt->year <= 9999;
+}
+
+int8_t atc_large_print_local_date_time(
+    AtcLargeStringBuffer *sb,
+    const AtcLocalDateTime *ldt)
+{
+  if (!is_printable(ldt)) return kAtcErrGeneric;
+  if (sb->capacity - sb->size < kAtcTimestampLocalLength) {
+    return kAtcErrGeneric;
+  }
+
+  char *p = &sb->p[sb->size];
+  write_date_time(p, ldt->year, ldt->month, ldt->day,
+      ldt->hour, ldt->minute, ldt->second);
+  sb->size += kAtcTimestampLocalLength;
+  return kAtcErrOk;
+}
+
+int8_t atc_large_print_offset_date_time(
+    AtcLargeStringBuffer *sb,
+    const AtcOffsetDateTime *odt)
+{
+  if (!is_printable((const AtcLocalDateTime *) odt)) return kAtcErrGeneric;
+  if (sb->capacity - sb->size < kAtcTimestampOffsetLength) {
+    return kAtcErrGeneric;
+  }
+
+  char *p = &sb->p[sb->size];
+  p = write_date_time(p, odt->year, odt->month, odt->day,
+      odt->hour, odt->minute, odt->second);
+  write_offset(p, odt->offset_seconds);
+  sb->size += kAtcTimestampOffsetLength;
+  return kAtcErrOk;
+}
+
+// Print the timestamps in UTC, converting the date only when the day changes.
+static size_t print_utc_n(
+    AtcLargeStringBuffer *sb,
+    const atc_time_t *epoch_seconds,
+    size_t n,
+    char separator)
+{
+  size_t length = kAtcTimestampUtcLength + (separator != '\0');
+  bool has_date = false;
+  atc_time_t date_days = 0;
+  AtcLocalDateTime ldt;
+
+  size_t i;
+  for (i = 0; i < n; i++) {
+    atc_time_t es = epoch_seconds[i];
+    if (es == kAtcInvalidEpochSeconds) break;
+    if (sb->capacity - sb->size < length) break;
+
+    // Integer floor-division towards -infinity
+    atc_time_t days = (es < 0) ? (es + 1) / 86400 - 1 : es / 86400;
+    uint32_t seconds = (uint32_t) (es - (atc_time_t) 86400 * days);
+    if (!has_date || days != date_days) {
+      atc_local_date_time_from_epoch_seconds(&ldt, es);
+      if (!is_printable(&ldt)) break;
+      has_date = true;
+      date_days = days;
+    }
+    uint16_t minutes = seconds / 60;
+
+    char *p = &sb->p[sb->size];
+    p = write_date_time(p, ldt.year, ldt.month, ldt.day,
+        (uint8_t) (minutes / 60), (uint8_t) (minutes % 60),
+        (uint8_t) (seconds % 60));
+    *p++ = 'Z';
+    if (separator != '\0') *p = separator;
+    sb->size += length;
+  }
+  return i;
+}
+
+size_t atc_large_print_epoch_seconds_n(
+    AtcLargeStringBuffer *sb,
+    const atc_time_t *epoch_seconds,
+    size_t n,
+    const AtcTimeZone *tz,
+    char separator)
+{
+  if (tz == NULL) return print_utc_n(sb, epoch_seconds, n, separator);
+
+  size_t length = kAtcTimestampOffsetLength + (separator != '\0');
+  size_t i;
+  for (i = 0; i < n; i++) {
+    if (sb->capacity - sb->size < length) break;
+    AtcOffsetDateTime odt;
+    atc_time_zone_offset_date_time_from_epoch_seconds(
+        tz, epoch_seconds[i], &odt);
+    if (atc_large_print_offset_date_time(sb, &odt)) break;
+    if (separator != '\0') sb->p[sb->size++] = separator;
+  }
+  return i;
+}
@@ -0,0 +1,81 @@
+/*
+ * MIT License
+ * Copyright (c) 2024 Brian T. Park
+ */
+
+/**
+ * @file timestamp_format.h
+ *
+ * Functions which format ISO 8601 timestamps into an AtcLargeStringBuffer at
+ * high throughput, for example to write the timestamps of a batch of log
+ * records. Each timestamp checks the remaining capacity of the buffer once,
+ * then writes its digits 2 at a time from the kAtcDigitPairs table. A
+ * timestamp is either printed completely, or not at all.
+ */
+
+#ifndef ACE_TIME_C_TIMESTAMP_FORMAT_H
+#define ACE_TIME_C_TIMESTAMP_FORMAT_H
+
+#include <stddef.h> // size_t
+#include <stdint.h>
+#include "common.h"
+#include "local_date_time.h"
+#include "offset_date_time.h"
+#include "string_buffer.h"
+#include "time_zone.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+  /** Length of "YYYY-MM-DDThh:mm:ss". */
+  kAtcTimestampLocalLength = 19,
+
+  /** Length of "YYYY-MM-DDThh:mm:ss+hh:mm". */
+  kAtcTimestampOffsetLength = 25,
+
+  /** Length of "YYYY-MM-DDThh:mm:ssZ". */
+  kAtcTimestampUtcLength = 20,
+};
+
+/**
+ * Print the ldt as "YYYY-MM-DDThh:mm:ss". Return kAtcErrGeneric, and print
+ * nothing, if the ldt is an error, if its year is outside of [0,9999], or if
+ * the buffer does not have room.
+ */
+int8_t atc_large_print_local_date_time(
+    AtcLargeStringBuffer *sb,
+    const AtcLocalDateTime *ldt);
+
+/**
+ * Print the odt as "YYYY-MM-DDThh:mm:ss+hh:mm", the same format as
+ * atc_offset_date_time_print(). Return kAtcErrGeneric, and print nothing, upon
+ * the same errors as atc_large_print_local_date_time().
+ */
+int8_t atc_large_print_offset_date_time(
+    AtcLargeStringBuffer *sb,
+    const AtcOffsetDateTime *odt);
+
+/**
+ * Print the `n` timestamps of the array `epoch_seconds`, each followed by the
+ * `separator` (e.g. '\n') unless it is '\0'. If `tz` is NULL, the timestamps
+ * are printed in UTC as "YYYY-MM-DDThh:mm:ssZ", and the date is converted
+ * only when it differs from the previous timestamp. Otherwise, they are
+ * printed as "YYYY-MM-DDThh:mm:ss+hh:mm" in the time zone `tz`.
+ *
+ * Stop at the first timestamp which is invalid or does not fit in the buffer,
+ * and return the number of timestamps printed.
+ */
+size_t atc_large_print_epoch_seconds_n(
+    AtcLargeStringBuffer *sb,
+    const atc_time_t *epoch_seconds,
+    size_t n,
+    const AtcTimeZone *tz,
+    char separator);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -24,6 +24,7 @@ void atc_transition_storage_init(
   ts->index_candidate = 0;
   ts->index_free = 0;
   ts->alloc_size = 0;
+  ts->index_last = 0;
 }
 
 AtcTransition **atc_transition_storage_get_candidate_pool_begin(
@@ -264,7 +265,17 @@ uint8_t atc_transition_compare_to_match_fuzzy(
 
 //---------------------------------------------------------------------------
 
-static void atc_calculate_fold_and_overlap(
+// Return the change of the total UTC offset from transition `a` to the
+// following transition `b`. Equal to `b.start_dt - a.until_dt`.
+static int32_t atc_transition_offset_change(
+    const AtcTransition *a,
+    const AtcTransition *b)
+{
+  return (b->offset_seconds + b->delta_seconds)
+      - (a->offset_seconds + a->delta_seconds);
+}
+
+void atc_transition_calculate_fold_and_overlap(
     uint8_t* fold,
     uint8_t* num,
     const AtcTransition* prev,
@@ -285,9 +296,12 @@ static void atc_calculate_fold_and_overlap(
   } else {
     // Extract the shift from prev transition. Can be 0 in some cases where
     // the zone changed from DST of one zone to the STD into another zone,
-    // causing the overall UTC offset to remain unchanged.
-    atc_time_t shift_seconds = atc_date_tuple_subtract(
-        &curr->start_dt, &prev->until_dt);
+    // causing the overall UTC offset to remain unchanged. The until_dt of
+    // prev is the transition_time of curr, and the start_dt of curr is that
+    // same instant shifted into the UTC offset of curr, so the shift is the
+    // difference of the total UTC offsets, without the need to convert the
+    // AtcDateTuple of each into epoch days.
+    atc_time_t shift_seconds = atc_transition_offset_change(prev, curr);
     if (shift_seconds >= 0) {
       // spring forward, or unchanged
       is_overlap = false;
@@ -305,11 +319,8 @@ static void atc_calculate_fold_and_overlap(
   if (next == NULL) {
     is_overlap = false;
   } else {
-    // Extract the shift to next transition. Can be 0 in some cases where
-    // the zone changed from DST of one zone to the STD into another zone,
-    // causing the overall UTC offset to remain unchanged.
-    atc_time_t shift_seconds = atc_date_tuple_subtract(
-        &next->start_dt, &curr->until_dt);
+    // Extract the shift to next transition, same as above.
+    atc_time_t shift_seconds = atc_transition_offset_change(curr, next);
     if (shift_seconds >= 0) {
       // spring forward, or unchanged
       is_overlap = false;
@@ -329,28 +340,82 @@ static void atc_calculate_fold_and_overlap(
   *num = 1;
 }
 
-AtcTransitionForSeconds atc_transition_storage_find_for_seconds(
+// Return the number of active transitions whose start_epoch_seconds is <=
+// epoch_seconds. The active transitions are sorted by start_epoch_seconds, so
+// the matching transition (if any) is at the returned value minus one.
+static uint8_t atc_transition_storage_search(
     const AtcTransitionStorage *ts,
     atc_time_t epoch_seconds)
 {
-  const AtcTransition *prev = NULL;
-  const AtcTransition *curr = NULL;
-  const AtcTransition *next = NULL;
-  for (uint8_t i = 0; i < ts->index_free; i++) {
-    next = ts->transitions[i];
-    if (next->start_epoch_seconds > epoch_seconds) break;
-    prev = curr;
-    curr = next;
-    next = NULL;
+  uint8_t a = 0;
+  uint8_t b = ts->index_free;
+  while (a < b) {
+    uint8_t c = a + (b - a) / 2;
+    if (ts->transitions[c]->start_epoch_seconds <= epoch_seconds) {
+      a = c + 1;
+    } else {
+      b = c;
+    }
   }
+  return a;
+}
+
+// Return true if epoch_seconds is within [start, next start) of the
+// transition at index i.
+static bool atc_transition_storage_interval_contains(
+    const AtcTransitionStorage *ts,
+    uint8_t i,
+    atc_time_t epoch_seconds)
+{
+  return i < ts->index_free
+      && ts->transitions[i]->start_epoch_seconds <= epoch_seconds
+      && (i + 1 == ts->index_free
+          || epoch_seconds < ts->transitions[i + 1]->start_epoch_seconds);
+}
+
+// Create the AtcTransitionForSeconds from the number `n` of transitions which
+// start at or before epoch_seconds.
+static AtcTransitionForSeconds atc_transition_storage_for_seconds(
+    const AtcTransitionStorage *ts,
+    uint8_t n,
+    atc_time_t epoch_seconds)
+{
+  const AtcTransition *curr = (n > 0) ? ts->transitions[n - 1] : NULL;
+  const AtcTransition *prev = (n > 1) ? ts->transitions[n - 2] : NULL;
+  const AtcTransition *next = (curr != NULL && n < ts->index_free)
+      ? ts->transitions[n] : NULL;
 
   uint8_t fold;
   uint8_t num;
-  atc_calculate_fold_and_overlap(&fold, &num, prev, curr, next, epoch_seconds);
+  atc_transition_calculate_fold_and_overlap(
+      &fold, &num, prev, curr, next, epoch_seconds);
   AtcTransitionForSeconds result = {curr, fold, num};
   return result;
 }
 
+AtcTransitionForSeconds atc_transition_storage_find_for_seconds(
+    const AtcTransitionStorage *ts,
+    atc_time_t epoch_seconds)
+{
+  uint8_t n = atc_transition_storage_search(ts, epoch_seconds);
+  return atc_transition_storage_for_seconds(ts, n, epoch_seconds);
+}
+
+AtcTransitionForSeconds atc_transition_storage_find_for_seconds_memo(
+    AtcTransitionStorage *ts,
+    atc_time_t epoch_seconds)
+{
+  uint8_t n;
+  if (atc_transition_storage_interval_contains(
+      ts, ts->index_last, epoch_seconds)) {
+    n = ts->index_last + 1;
+  } else {
+    n = atc_transition_storage_search(ts, epoch_seconds);
+    if (n > 0) ts->index_last = n - 1;
+  }
+  return atc_transition_storage_for_seconds(ts, n, epoch_seconds);
+}
+
 AtcTransitionForDateTime atc_transition_storage_find_for_date_time(
     const AtcTransitionStorage *ts,
     const AtcLocalDateTime *ldt)
@@ -133,9 +133,15 @@ typedef struct AtcTransition {
   /** The DST delta seconds. */
   int32_t delta_seconds;
 
-  /** The calculated effective time zone abbreviation, e.g. "PST" or "PDT". */
+  /**
+   * The calculated effective time zone abbreviation, e.g. "PST" or "PDT".
+   * Calculated on demand, valid only if `is_abbrev_valid` is set.
+   */
   char abbrev[kAtcAbbrevSize];
 
+  /** Set to 1 if `abbrev` has been calculated, 0 otherwise. */
+  uint8_t is_abbrev_valid;
+
   /** Storage for the single letter 'letter' field if 'rule' is not null. */
   const char *letter;
 
@@ -179,6 +185,13 @@ typedef struct AtcTransitionStorage {
 
   /** Number of allocated transitions. */
   uint8_t alloc_size;
+
+  /**
+   * Index of the active transition found by the most recent call to
+   * atc_transition_storage_find_for_seconds_memo(). Used as a hint for the
+   * next search.
+   */
+  uint8_t index_last;
 } AtcTransitionStorage;
 
 /** Initialize the Transition Storage. Should be called once for a given app. */
@@ -354,6 +367,32 @@ AtcTransitionForSeconds atc_transition_storage_find_for_seconds(
     const AtcTransitionStorage *ts,
     atc_time_t epoch_seconds);
 
+/**
+ * Same as atc_transition_storage_find_for_seconds(), but first checks whether
+ * epoch_seconds falls in the interval of the transition found by the previous
+ * call, which is the common case for a monotone stream of timestamps. The
+ * index of the matching transition is saved in `ts->index_last` for the next
+ * call.
+ */
+AtcTransitionForSeconds atc_transition_storage_find_for_seconds_memo(
+    AtcTransitionStorage *ts,
+    atc_time_t epoch_seconds);
+
+/**
+ * Calculate the `fold` and the number of occurrences `num` of the local date
+ * time at epoch_seconds, given the matching transition `curr` and its
+ * neighbors `prev` and `next` (each of which may be NULL). This is the second
+ * half of atc_transition_storage_find_for_seconds(), exposed for callers which
+ * locate the `curr` transition by other means.
+ */
+void atc_transition_calculate_fold_and_overlap(
+    uint8_t* fold,
+    uint8_t* num,
+    const AtcTransition* prev,
+    const AtcTransition* curr,
+    const AtcTransition* next,
+    atc_time_t epoch_seconds);
+
 /**
  * The result returned by atc_transition_storage_find_for_date_time() when
  * searching for transitions by local date time. There are 5 possibilities:
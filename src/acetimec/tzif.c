@@ -0,0 +1,775 @@
+/*
+ * MIT License
+ * Copyright (c) 2024 Brian T. Park
+ */
+
+// Needed for open(), fstat() and mmap() with -std=c11. Must appear before any
+// system header.
+#if !defined(_POSIX_C_SOURCE)
+  #define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "tzif.h"
+
+#include <string.h> // memcmp(), memcpy(), strcmp(), strlen(), strstr()
+#include "common.h" // kAtcErrOk
+#include "epoch.h" // atc_unix_seconds_from_epoch_seconds()
+#include "local_date.h" // atc_local_date_to_unix_days()
+#include "local_date_time.h" // atc_local_date_time_to_unix_seconds()
+
+#if ATC_ENABLE_TZIF_MMAP
+#include <fcntl.h> // open()
+#include <stdio.h> // snprintf()
+#include <sys/mman.h> // mmap(), munmap()
+#include <sys/stat.h> // fstat()
+#include <unistd.h> // close()
+#endif
+
+enum {
+  /** Size of the header of each data block. */
+  kAtcTzifHeaderSize = 44,
+
+  /** Size of each local time type record. */
+  kAtcTzifTypeSize = 6,
+
+  /** Maximum number of entries collected around the target time. */
+  kAtcTzifWindowSize = 12,
+
+  /**
+   * Half-width of the interval of transitions collected around the target
+   * time. Must be larger than the largest UTC offset, and the largest shift
+   * of a transition.
+   */
+  kAtcTzifWindowMarginSeconds = 3 * 86400,
+};
+
+//---------------------------------------------------------------------------
+// Decoding of big-endian integers.
+//---------------------------------------------------------------------------
+
+static uint32_t atc_tzif_read_u32(const uint8_t *p)
+{
+  return ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16)
+      | ((uint32_t) p[2] << 8) | (uint32_t) p[3];
+}
+
+static int32_t atc_tzif_read_i32(const uint8_t *p)
+{
+  uint32_t u = atc_tzif_read_u32(p);
+  return (u & 0x80000000u) ? -(int32_t) (~u) - 1 : (int32_t) u;
+}
+
+static int64_t atc_tzif_read_i64(const uint8_t *p)
+{
+  uint64_t u = ((uint64_t) atc_tzif_read_u32(p) << 32)
+      | atc_tzif_read_u32(p + 4);
+  return (u >> 63) ? -(int64_t) (~u) - 1 : (int64_t) u;
+}
+
+//---------------------------------------------------------------------------
+// Parsing of the POSIX TZ string in the footer.
+//---------------------------------------------------------------------------
+
+typedef struct AtcTzifScanner {
+  const char *p;
+  const char *end;
+} AtcTzifScanner;
+
+static bool atc_tzif_scan_is_at(const AtcTzifScanner *s, char c)
+{
+  return s->p < s->end && *s->p == c;
+}
+
+static bool atc_tzif_scan_is_digit(const AtcTzifScanner *s)
+{
+  return s->p < s->end && *s->p >= '0' && *s->p <= '9';
+}
+
+static bool atc_tzif_scan_is_alpha(const AtcTzifScanner *s)
+{
+  return s->p < s->end
+      && ((*s->p >= 'a' && *s->p <= 'z') || (*s->p >= 'A' && *s->p <= 'Z'));
+}
+
+// Parse an unsigned integer of at most 3 digits.
+static bool atc_tzif_scan_number(AtcTzifScanner *s, uint16_t *value)
+{
+  if (! atc_tzif_scan_is_digit(s)) return false;
+  uint16_t v = 0;
+  for (uint8_t i = 0; i < 3 && atc_tzif_scan_is_digit(s); i++) {
+    v = v * 10 + (uint16_t) (*s->p++ - '0');
+  }
+  *value = v;
+  return true;
+}
+
+// Parse an abbreviation, either alphabetic ("PST") or quoted ("<+0530>"). A
+// name longer than kAtcAbbrevSize-1 is truncated.
+static bool atc_tzif_scan_name(AtcTzifScanner *s, char *name)
+{
+  const char *begin;
+  const char *end;
+  if (atc_tzif_scan_is_at(s, '<')) {
+    begin = ++s->p;
+    while (s->p < s->end && *s->p != '>') s->p++;
+    if (s->p >= s->end) return false;
+    end = s->p++;
+  } else {
+    begin = s->p;
+    while (atc_tzif_scan_is_alpha(s)) s->p++;
+    end = s->p;
+  }
+  size_t len = (size_t) (end - begin);
+  if (len < 3) return false;
+  if (len > kAtcAbbrevSize - 1) len = kAtcAbbrevSize - 1;
+  memcpy(name, begin, len);
+  name[len] = '\0';
+  return true;
+}
+
+// Parse [+-]hh[:mm[:ss]] into seconds, with hh <= max_hours.
+static bool atc_tzif_scan_time(
+    AtcTzifScanner *s,
+    uint16_t max_hours,
+    int32_t *seconds)
+{
+  int32_t sign = 1;
+  if (atc_tzif_scan_is_at(s, '+')) {
+    s->p++;
+  } else if (atc_tzif_scan_is_at(s, '-')) {
+    s->p++;
+    sign = -1;
+  }
+  uint16_t hours;
+  uint16_t minutes = 0;
+  uint16_t secs = 0;
+  if (! atc_tzif_scan_number(s, &hours) || hours > max_hours) return false;
+  if (atc_tzif_scan_is_at(s, ':')) {
+    s->p++;
+    if (! atc_tzif_scan_number(s, &minutes) || minutes > 59) return false;
+    if (atc_tzif_scan_is_at(s, ':')) {
+      s->p++;
+      if (! atc_tzif_scan_number(s, &secs) || secs > 59) return false;
+    }
+  }
+  *seconds = sign * ((int32_t) hours * 3600 + minutes * 60 + secs);
+  return true;
+}
+
+// Parse a rule date "Mm.w.d", "Jn" or "n", followed by an optional "/time".
+static bool atc_tzif_scan_rule_date(AtcTzifScanner *s, AtcTzifRuleDate *r)
+{
+  uint16_t v;
+  r->month = 0;
+  r->week = 0;
+  r->day_of_week = 0;
+  r->day_of_year = 0;
+  if (atc_tzif_scan_is_at(s, 'M')) {
+    s->p++;
+    r->form = kAtcTzifRuleMonthWeekDay;
+    if (! atc_tzif_scan_number(s, &v) || v < 1 || v > 12) return false;
+    r->month = (uint8_t) v;
+    if (! atc_tzif_scan_is_at(s, '.')) return false;
+    s->p++;
+    if (! atc_tzif_scan_number(s, &v) || v < 1 || v > 5) return false;
+    r->week = (uint8_t) v;
+    if (! atc_tzif_scan_is_at(s, '.')) return false;
+    s->p++;
+    if (! atc_tzif_scan_number(s, &v) || v > 6) return false;
+    r->day_of_week = (uint8_t) v;
+  } else if (atc_tzif_scan_is_at(s, 'J')) {
+    s->p++;
+    r->form = kAtcTzifRuleJulian1;
+    if (! atc_tzif_scan_number(s, &v) || v < 1 || v > 365) return false;
+    r->day_of_year = v;
+  } else {
+    r->form = kAtcTzifRuleJulian0;
+    if (! atc_tzif_scan_number(s, &v) || v > 365) return false;
+    r->day_of_year = v;
+  }
+
+  r->time_seconds = 2 * 3600;
+  if (atc_tzif_scan_is_at(s, '/')) {
+    s->p++;
+    if (! atc_tzif_scan_time(s, 167, &r->time_seconds)) return false;
+  }
+  return true;
+}
+
+int8_t atc_tzif_parse_posix_tz(
+    AtcTzifFooter *footer,
+    const char *str,
+    size_t len)
+{
+  AtcTzifScanner scanner = {str, str + len};
+  AtcTzifScanner *s = &scanner;
+  footer->is_valid = false;
+  footer->has_dst = false;
+  footer->dst_offset_seconds = 0;
+  footer->dst_abbrev[0] = '\0';
+
+  // The POSIX offsets are positive west of UTC.
+  int32_t offset;
+  if (! atc_tzif_scan_name(s, footer->std_abbrev)) return kAtcErrGeneric;
+  if (! atc_tzif_scan_time(s, 24, &offset)) return kAtcErrGeneric;
+  footer->std_offset_seconds = -offset;
+
+  if (s->p < s->end) {
+    footer->has_dst = true;
+    if (! atc_tzif_scan_name(s, footer->dst_abbrev)) return kAtcErrGeneric;
+    footer->dst_offset_seconds = 3600;
+    if (! atc_tzif_scan_is_at(s, ',')) {
+      if (! atc_tzif_scan_time(s, 24, &offset)) return kAtcErrGeneric;
+      footer->dst_offset_seconds = -offset - footer->std_offset_seconds;
+    }
+    // A DST rule without dates is implementation-defined, and never generated
+    // by zic.
+    if (! atc_tzif_scan_is_at(s, ',')) return kAtcErrGeneric;
+    s->p++;
+    if (! atc_tzif_scan_rule_date(s, &footer->start)) return kAtcErrGeneric;
+    if (! atc_tzif_scan_is_at(s, ',')) return kAtcErrGeneric;
+    s->p++;
+    if (! atc_tzif_scan_rule_date(s, &footer->end)) return kAtcErrGeneric;
+  }
+
+  if (s->p != s->end) return kAtcErrGeneric;
+  footer->is_valid = true;
+  return kAtcErrOk;
+}
+
+//---------------------------------------------------------------------------
+// Parsing of the TZif header and data block.
+//---------------------------------------------------------------------------
+
+typedef struct AtcTzifCounts {
+  uint32_t isutcnt;
+  uint32_t isstdcnt;
+  uint32_t leapcnt;
+  uint32_t timecnt;
+  uint32_t typecnt;
+  uint32_t charcnt;
+} AtcTzifCounts;
+
+static bool atc_tzif_read_header(
+    const uint8_t *data,
+    uint64_t size,
+    uint64_t offset,
+    AtcTzifCounts *counts)
+{
+  if (offset + kAtcTzifHeaderSize > size) return false;
+  const uint8_t *p = data + offset;
+  if (memcmp(p, "TZif", 4) != 0) return false;
+  counts->isutcnt = atc_tzif_read_u32(p + 20);
+  counts->isstdcnt = atc_tzif_read_u32(p + 24);
+  counts->leapcnt = atc_tzif_read_u32(p + 28);
+  counts->timecnt = atc_tzif_read_u32(p + 32);
+  counts->typecnt = atc_tzif_read_u32(p + 36);
+  counts->charcnt = atc_tzif_read_u32(p + 40);
+  return true;
+}
+
+static uint64_t atc_tzif_block_size(
+    const AtcTzifCounts *counts,
+    uint8_t time_size)
+{
+  return (uint64_t) counts->timecnt * (time_size + 1)
+      + (uint64_t) counts->typecnt * kAtcTzifTypeSize
+      + counts->charcnt
+      + (uint64_t) counts->leapcnt * (time_size + 4)
+      + counts->isstdcnt
+      + counts->isutcnt;
+}
+
+int8_t atc_tzif_init(AtcTzif *tzif, const uint8_t *data, size_t size)
+{
+  tzif->data = data;
+  tzif->size = size;
+  tzif->is_mapped = false;
+  tzif->num_transitions = 0;
+  tzif->footer.is_valid = false;
+
+  AtcTzifCounts counts;
+  if (! atc_tzif_read_header(data, size, 0, &counts)) return kAtcErrGeneric;
+  uint8_t version = data[4];
+  uint64_t block = kAtcTzifHeaderSize;
+  uint8_t time_size = 4;
+  if (version >= '2') {
+    // Skip the version 1 data block, and use the 64-bit data block.
+    block += atc_tzif_block_size(&counts, 4);
+    if (! atc_tzif_read_header(data, size, block, &counts)) {
+      return kAtcErrGeneric;
+    }
+    block += kAtcTzifHeaderSize;
+    time_size = 8;
+  }
+  uint64_t block_end = block + atc_tzif_block_size(&counts, time_size);
+  if (block_end > size) return kAtcErrGeneric;
+  if (counts.typecnt == 0 || counts.typecnt > 256) return kAtcErrGeneric;
+  if (counts.charcnt == 0) return kAtcErrGeneric;
+  if (counts.leapcnt != 0) return kAtcErrGeneric;
+
+  tzif->time_size = time_size;
+  tzif->num_types = counts.typecnt;
+  tzif->num_chars = counts.charcnt;
+  tzif->times = data + block;
+  tzif->type_indexes = tzif->times + (size_t) counts.timecnt * time_size;
+  tzif->types = tzif->type_indexes + counts.timecnt;
+  tzif->abbrevs = (const char *) (tzif->types
+      + (size_t) counts.typecnt * kAtcTzifTypeSize);
+
+  // Validate the indexes, so that the lookups never read outside the data.
+  if (tzif->abbrevs[counts.charcnt - 1] != '\0') return kAtcErrGeneric;
+  for (uint32_t i = 0; i < counts.typecnt; i++) {
+    const uint8_t *type = tzif->types + (size_t) i * kAtcTzifTypeSize;
+    if (type[5] >= counts.charcnt) return kAtcErrGeneric;
+  }
+  for (uint32_t i = 0; i < counts.timecnt; i++) {
+    if (tzif->type_indexes[i] >= counts.typecnt) return kAtcErrGeneric;
+  }
+
+  // The footer is "\n<POSIX TZ string>\n". An empty string means that the
+  // times after the last transition cannot be represented.
+  if (version >= '2') {
+    const char *p = (const char *) data + block_end;
+    const char *end = (const char *) data + size;
+    if (p >= end || *p != '\n') return kAtcErrGeneric;
+    const char *begin = ++p;
+    while (p < end && *p != '\n') p++;
+    if (p >= end) return kAtcErrGeneric;
+    if (p > begin) {
+      int8_t err = atc_tzif_parse_posix_tz(
+          &tzif->footer, begin, (size_t) (p - begin));
+      if (err) return err;
+    }
+  }
+
+  tzif->num_transitions = counts.timecnt;
+  return kAtcErrOk;
+}
+
+#if ATC_ENABLE_TZIF_MMAP
+
+int8_t atc_tzif_open(AtcTzif *tzif, const char *dir, const char *name)
+{
+  tzif->data = NULL;
+  tzif->size = 0;
+  tzif->is_mapped = false;
+
+  // Reject names which could escape from `dir`.
+  if (name[0] == '/' || strstr(name, "..") != NULL) return kAtcErrGeneric;
+  char path[256];
+  int n = snprintf(path, sizeof(path), "%s/%s", dir, name);
+  if (n < 0 || (size_t) n >= sizeof(path)) return kAtcErrGeneric;
+
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) return kAtcErrGeneric;
+  struct stat st;
+  if (fstat(fd, &st) != 0 || ! S_ISREG(st.st_mode)
+      || st.st_size < kAtcTzifHeaderSize) {
+    close(fd);
+    return kAtcErrGeneric;
+  }
+  size_t size = (size_t) st.st_size;
+  void *p = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (p == MAP_FAILED) return kAtcErrGeneric;
+
+  int8_t err = atc_tzif_init(tzif, (const uint8_t *) p, size);
+  if (err) {
+    munmap(p, size);
+    tzif->data = NULL;
+    tzif->size = 0;
+    return err;
+  }
+  tzif->is_mapped = true;
+  return kAtcErrOk;
+}
+
+void atc_tzif_close(AtcTzif *tzif)
+{
+  if (tzif->is_mapped) {
+    munmap((void *) tzif->data, tzif->size);
+  }
+  tzif->data = NULL;
+  tzif->size = 0;
+  tzif->is_mapped = false;
+  tzif->num_transitions = 0;
+  tzif->footer.is_valid = false;
+}
+
+#endif
+
+//---------------------------------------------------------------------------
+// Collection of the entries around a given time. Internally, all times are in
+// unix seconds, so that the results do not depend on the current epoch.
+//---------------------------------------------------------------------------
+
+// A span of time with constant UTC offsets, from a transition of the table or
+// from the footer.
+typedef struct AtcTzifEntry {
+  int64_t start;
+  int32_t std_offset_seconds;
+  int32_t dst_offset_seconds;
+  const char *abbrev;
+} AtcTzifEntry;
+
+typedef struct AtcTzifWindow {
+  AtcTzifEntry entries[kAtcTzifWindowSize];
+  uint8_t num_entries;
+} AtcTzifWindow;
+
+static int64_t atc_tzif_time(const AtcTzif *tzif, uint32_t i)
+{
+  const uint8_t *p = tzif->times + (size_t) i * tzif->time_size;
+  return (tzif->time_size == 4) ? atc_tzif_read_i32(p) : atc_tzif_read_i64(p);
+}
+
+static const uint8_t *atc_tzif_type(const AtcTzif *tzif, uint8_t index)
+{
+  return tzif->types + (size_t) index * kAtcTzifTypeSize;
+}
+
+// Return the STD offset of the DST local time type used by transition `i`.
+// TZif files contain only the total UTC offset, so this is the UTC offset of
+// the nearest non-DST type, searching backwards first.
+static int32_t atc_tzif_std_offset_for_dst(
+    const AtcTzif *tzif,
+    int64_t i,
+    int32_t utoff)
+{
+  for (int64_t j = i - 1; j >= 0 && j >= i - 16; j--) {
+    const uint8_t *type = atc_tzif_type(tzif, tzif->type_indexes[j]);
+    if (! type[4]) return atc_tzif_read_i32(type);
+  }
+  for (int64_t j = i + 1; j < tzif->num_transitions && j <= i + 16; j++) {
+    const uint8_t *type = atc_tzif_type(tzif, tzif->type_indexes[j]);
+    if (! type[4]) return atc_tzif_read_i32(type);
+  }
+  return utoff - 3600;
+}
+
+// Fill the entry of transition `i`, or of the time before the first
+// transition if `i` is -1.
+static void atc_tzif_table_entry(
+    const AtcTzif *tzif,
+    int64_t i,
+    AtcTzifEntry *entry)
+{
+  uint8_t type_index = (i < 0) ? 0 : tzif->type_indexes[i];
+  const uint8_t *type = atc_tzif_type(tzif, type_index);
+  int32_t utoff = atc_tzif_read_i32(type);
+  entry->start = (i < 0) ? INT64_MIN : atc_tzif_time(tzif, (uint32_t) i);
+  entry->std_offset_seconds = type[4]
+      ? atc_tzif_std_offset_for_dst(tzif, i, utoff)
+      : utoff;
+  entry->dst_offset_seconds = utoff - entry->std_offset_seconds;
+  entry->abbrev = tzif->abbrevs + type[5];
+}
+
+static void atc_tzif_footer_entry(
+    const AtcTzifFooter *footer,
+    int64_t start,
+    bool is_dst,
+    AtcTzifEntry *entry)
+{
+  entry->start = start;
+  entry->std_offset_seconds = footer->std_offset_seconds;
+  entry->dst_offset_seconds = is_dst ? footer->dst_offset_seconds : 0;
+  entry->abbrev = is_dst ? footer->dst_abbrev : footer->std_abbrev;
+}
+
+// Return the unix seconds of the rule date in the given year, whose time is
+// expressed in the local time with the given UTC offset.
+static int64_t atc_tzif_rule_seconds(
+    const AtcTzifRuleDate *r,
+    int16_t year,
+    int32_t offset_seconds)
+{
+  int32_t days;
+  if (r->form == kAtcTzifRuleMonthWeekDay) {
+    // POSIX day of week is Sunday=0, ISO is Sunday=7.
+    uint8_t first = atc_local_date_day_of_week(year, r->month, 1) % 7;
+    uint8_t day = 1 + (7 + r->day_of_week - first) % 7 + (r->week - 1) * 7;
+    uint8_t days_in_month = atc_local_date_days_in_year_month(year, r->month);
+    while (day > days_in_month) day -= 7;
+    days = atc_local_date_to_unix_days(year, r->month, day);
+  } else {
+    uint16_t day_of_year = r->day_of_year; // 0-based
+    if (r->form == kAtcTzifRuleJulian1) {
+      day_of_year--;
+      if (atc_is_leap_year(year) && day_of_year >= 59) day_of_year++;
+    }
+    days = atc_local_date_to_unix_days(year, 1, 1) + day_of_year;
+  }
+  return (int64_t) days * 86400 + r->time_seconds - offset_seconds;
+}
+
+// Return the UTC year of the given unix seconds, clamped to the years which
+// can be handled by the footer rules.
+static int16_t atc_tzif_year_of(int64_t unix_seconds)
+{
+  // Unix seconds of 0002-01-01 and 9998-01-01.
+  const int64_t lower = -62104060800;
+  const int64_t upper = 253339228800;
+  if (unix_seconds < lower) return kAtcMinYear + 1;
+  if (unix_seconds >= upper) return kAtcMaxYear - 1;
+  int64_t days = (unix_seconds < 0)
+      ? (unix_seconds + 1) / 86400 - 1
+      : unix_seconds / 86400;
+  int16_t year;
+  uint8_t month;
+  uint8_t day;
+  atc_local_date_from_unix_days((int32_t) days, &year, &month, &day);
+  return year;
+}
+
+static void atc_tzif_window_add(AtcTzifWindow *w, const AtcTzifEntry *entry)
+{
+  if (w->num_entries < kAtcTzifWindowSize) {
+    w->entries[w->num_entries++] = *entry;
+  }
+}
+
+// Add the transitions of the footer which are after `after`. Those at or
+// before `lo` replace the first entry, those after `hi` are dropped.
+static void atc_tzif_window_add_footer(
+    const AtcTzifFooter *footer,
+    int64_t after,
+    int64_t lo,
+    int64_t hi,
+    AtcTzifWindow *w)
+{
+  int16_t start_year = atc_tzif_year_of((lo > after) ? lo : after) - 1;
+  int16_t until_year = atc_tzif_year_of(hi) + 1;
+  for (int16_t year = start_year; year <= until_year; year++) {
+    int64_t dst_start = atc_tzif_rule_seconds(
+        &footer->start, year, footer->std_offset_seconds);
+    int64_t dst_end = atc_tzif_rule_seconds(
+        &footer->end, year,
+        footer->std_offset_seconds + footer->dst_offset_seconds);
+    bool start_first = dst_start <= dst_end;
+    for (uint8_t k = 0; k < 2; k++) {
+      bool is_dst = (k == 0) == start_first;
+      int64_t start = is_dst ? dst_start : dst_end;
+      if (start <= after) continue;
+      if (start > hi) return;
+
+      AtcTzifEntry entry;
+      atc_tzif_footer_entry(footer, start, is_dst, &entry);
+      if (start <= lo || w->num_entries == 0) {
+        w->entries[0] = entry;
+        if (w->num_entries == 0) w->num_entries = 1;
+      } else if (w->entries[w->num_entries - 1].start == start) {
+        // e.g. year-round DST: the end of DST and the start of the next DST
+        // occur at the same instant.
+        w->entries[w->num_entries - 1] = entry;
+      } else {
+        atc_tzif_window_add(w, &entry);
+      }
+    }
+  }
+}
+
+// Collect the entry in effect at `lo`, followed by the entries which start in
+// (lo, hi], merging entries which do not change anything.
+static void atc_tzif_collect(
+    const AtcTzif *tzif,
+    int64_t lo,
+    int64_t hi,
+    AtcTzifWindow *w)
+{
+  w->num_entries = 0;
+  uint32_t n = tzif->num_transitions;
+  const AtcTzifFooter *footer = &tzif->footer;
+  AtcTzifEntry entry;
+
+  // Binary search for the last transition at or before lo.
+  uint32_t a = 0;
+  uint32_t b = n;
+  while (a < b) {
+    uint32_t c = a + (b - a) / 2;
+    if (atc_tzif_time(tzif, c) <= lo) {
+      a = c + 1;
+    } else {
+      b = c;
+    }
+  }
+  int64_t i = (int64_t) a - 1;
+  if (n > 0 || ! footer->is_valid) {
+    atc_tzif_table_entry(tzif, i, &entry);
+    atc_tzif_window_add(w, &entry);
+    for (i++; i < n && atc_tzif_time(tzif, (uint32_t) i) <= hi; i++) {
+      atc_tzif_table_entry(tzif, i, &entry);
+      atc_tzif_window_add(w, &entry);
+    }
+  }
+
+  int64_t last = (n > 0) ? atc_tzif_time(tzif, n - 1) : INT64_MIN;
+  if (footer->is_valid && hi > last) {
+    if (footer->has_dst) {
+      atc_tzif_window_add_footer(footer, last, lo, hi, w);
+    } else if (n == 0) {
+      atc_tzif_footer_entry(footer, INT64_MIN, false, &entry);
+      atc_tzif_window_add(w, &entry);
+    }
+  }
+
+  // Merge the entries which do not change the offsets or the abbreviation.
+  uint8_t m = 0;
+  for (uint8_t k = 0; k < w->num_entries; k++) {
+    const AtcTzifEntry *e = &w->entries[k];
+    if (m > 0) {
+      const AtcTzifEntry *prev = &w->entries[m - 1];
+      if (prev->std_offset_seconds == e->std_offset_seconds
+          && prev->dst_offset_seconds == e->dst_offset_seconds
+          && strcmp(prev->abbrev, e->abbrev) == 0) {
+        continue;
+      }
+    }
+    w->entries[m++] = *e;
+  }
+  w->num_entries = m;
+
+  // Avoid overflows when adding the UTC offset to the first entry.
+  if (m > 0 && w->entries[0].start < lo) w->entries[0].start = lo;
+}
+
+//---------------------------------------------------------------------------
+// Lookups. Same logic as atc_compiled_zone_find_by_epoch_seconds() and
+// atc_compiled_zone_find_by_local_date_time().
+//---------------------------------------------------------------------------
+
+static int32_t atc_tzif_entry_offset(const AtcTzifEntry *e)
+{
+  return e->std_offset_seconds + e->dst_offset_seconds;
+}
+
+void atc_tzif_find_by_epoch_seconds(
+    const AtcTzif *tzif,
+    atc_time_t epoch_seconds,
+    AtcFindResult *result)
+{
+  if (epoch_seconds == kAtcInvalidEpochSeconds) {
+    result->type = kAtcFindResultNotFound;
+    return;
+  }
+  int64_t t = atc_unix_seconds_from_epoch_seconds(epoch_seconds);
+  AtcTzifWindow w;
+  atc_tzif_collect(
+      tzif,
+      t - kAtcTzifWindowMarginSeconds,
+      t + kAtcTzifWindowMarginSeconds,
+      &w);
+  if (w.num_entries == 0) {
+    result->type = kAtcFindResultNotFound;
+    return;
+  }
+
+  int32_t i = w.num_entries - 1;
+  while (i > 0 && w.entries[i].start > t) i--;
+
+  const AtcTzifEntry *curr = &w.entries[i];
+  int32_t curr_offset = atc_tzif_entry_offset(curr);
+  uint8_t fold = 0;
+  uint8_t num = 1;
+  if (i > 0) {
+    int32_t shift = curr_offset - atc_tzif_entry_offset(&w.entries[i - 1]);
+    if (shift < 0 && t - curr->start < -shift) {
+      fold = 1;
+      num = 2;
+    }
+  }
+  if (num == 1 && i + 1 < w.num_entries) {
+    const AtcTzifEntry *next = &w.entries[i + 1];
+    int32_t shift = atc_tzif_entry_offset(next) - curr_offset;
+    if (shift < 0 && next->start - t <= -shift) {
+      fold = 0;
+      num = 2;
+    }
+  }
+
+  result->type = (num == 2) ? kAtcFindResultOverlap : kAtcFindResultExact;
+  result->fold = fold;
+  result->std_offset_seconds = curr->std_offset_seconds;
+  result->dst_offset_seconds = curr->dst_offset_seconds;
+  result->req_std_offset_seconds = curr->std_offset_seconds;
+  result->req_dst_offset_seconds = curr->dst_offset_seconds;
+  result->abbrev = curr->abbrev;
+}
+
+void atc_tzif_find_by_local_date_time(
+    const AtcTzif *tzif,
+    const AtcLocalDateTime *ldt,
+    AtcFindResult *result)
+{
+  if (atc_local_date_time_is_error(ldt)) {
+    result->type = kAtcFindResultNotFound;
+    return;
+  }
+
+  // The local date time as if it were UTC.
+  int64_t local_seconds = atc_local_date_time_to_unix_seconds(ldt);
+  AtcTzifWindow w;
+  atc_tzif_collect(
+      tzif,
+      local_seconds - kAtcTzifWindowMarginSeconds,
+      local_seconds + kAtcTzifWindowMarginSeconds,
+      &w);
+  if (w.num_entries == 0) {
+    result->type = kAtcFindResultNotFound;
+    return;
+  }
+
+  int32_t i = w.num_entries - 1;
+  while (i > 0
+      && w.entries[i].start + atc_tzif_entry_offset(&w.entries[i])
+          > local_seconds) {
+    i--;
+  }
+
+  // Entry 'i' matches if local_seconds is before its local until time.
+  // Entry 'i-1' also matches if local_seconds is within its overlap.
+  const AtcTzifEntry *curr = &w.entries[i];
+  const AtcTzifEntry *prev = (i > 0) ? &w.entries[i - 1] : NULL;
+  const AtcTzifEntry *next = (i + 1 < w.num_entries)
+      ? &w.entries[i + 1] : NULL;
+  int32_t curr_offset = atc_tzif_entry_offset(curr);
+  bool curr_matches = (next == NULL)
+      || local_seconds < next->start + curr_offset;
+  bool prev_matches = (prev != NULL)
+      && local_seconds < curr->start + atc_tzif_entry_offset(prev);
+
+  const AtcTzifEntry *entry;
+  if (curr_matches && prev_matches) {
+    // Overlap
+    entry = (ldt->fold == 0) ? prev : curr;
+    result->type = kAtcFindResultOverlap;
+    result->fold = ldt->fold;
+    result->req_std_offset_seconds = entry->std_offset_seconds;
+    result->req_dst_offset_seconds = entry->dst_offset_seconds;
+  } else if (curr_matches) {
+    // Exact
+    entry = curr;
+    result->type = kAtcFindResultExact;
+    result->fold = 0;
+    result->req_std_offset_seconds = entry->std_offset_seconds;
+    result->req_dst_offset_seconds = entry->dst_offset_seconds;
+  } else {
+    // Gap between 'curr' and 'next'.
+    result->type = kAtcFindResultGap;
+    result->fold = 0;
+    if (ldt->fold == 0) {
+      result->req_std_offset_seconds = curr->std_offset_seconds;
+      result->req_dst_offset_seconds = curr->dst_offset_seconds;
+      entry = next;
+    } else {
+      result->req_std_offset_seconds = next->std_offset_seconds;
+      result->req_dst_offset_seconds = next->dst_offset_seconds;
+      entry = curr;
+    }
+  }
+
+  result->std_offset_seconds = entry->std_offset_seconds;
+  result->dst_offset_seconds = entry->dst_offset_seconds;
+  result->abbrev = entry->abbrev;
+}
@@ -0,0 +1,220 @@
+/*
+ * MIT License
+ * Copyright (c) 2024 Brian T. Park
+ */
+
+/**
+ * @file tzif.h
+ *
+ * A time zone source which reads the binary TZif files (RFC 8536) produced by
+ * the IANA `zic` compiler, for example the files under /usr/share/zoneinfo,
+ * instead of the AtcZoneInfo data compiled into the program. A new TZ release
+ * can then be picked up by updating the TZif files, without regenerating the
+ * `zonedb` files and redeploying the binary.
+ *
+ * The TZif data is used in place, without copying. The AtcTzif holds only
+ * the counts and the locations of the arrays in the data, and the lookups
+ * decode the big-endian transition times on the fly with a binary search.
+ * Times after the last transition of the table are calculated from the POSIX
+ * TZ string in the footer of version 2+ files (e.g.
+ * "PST8PDT,M3.2.0,M11.1.0").
+ *
+ * The data can come from any buffer (e.g. a file embedded into the program)
+ * using atc_tzif_init(). On POSIX systems, atc_tzif_open() maps a file into
+ * memory with mmap(), so that pages are loaded lazily on first access and
+ * shared by all processes which map the same file. This is enabled by
+ * default on Unix-like systems, and can be controlled explicitly by defining
+ * ATC_ENABLE_TZIF_MMAP to 0 or 1.
+ *
+ * TZif files with leap seconds (e.g. the "right/" directory) are not
+ * supported.
+ */
+
+#ifndef ACE_TIME_C_TZIF_H
+#define ACE_TIME_C_TZIF_H
+
+#ifndef ATC_ENABLE_TZIF_MMAP
+  #if defined(__unix__) || defined(__APPLE__)
+    #define ATC_ENABLE_TZIF_MMAP 1
+  #else
+    #define ATC_ENABLE_TZIF_MMAP 0
+  #endif
+#endif
+
+#include <stdbool.h>
+#include <stddef.h> // size_t
+#include <stdint.h>
+#include "common.h" // atc_time_t
+#include "local_date_time.h" // AtcLocalDateTime
+#include "transition.h" // kAtcAbbrevSize
+#include "zone_processor.h" // AtcFindResult
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Default directory of the TZif files on most Unix-like systems. */
+#define ATC_TZIF_DEFAULT_DIR "/usr/share/zoneinfo"
+
+enum {
+  /** Form of the date of an AtcTzifRuleDate: "Mm.w.d". */
+  kAtcTzifRuleMonthWeekDay = 0,
+
+  /** Form of the date of an AtcTzifRuleDate: "Jn", Feb 29 not counted. */
+  kAtcTzifRuleJulian1 = 1,
+
+  /** Form of the date of an AtcTzifRuleDate: "n", Feb 29 counted. */
+  kAtcTzifRuleJulian0 = 2,
+};
+
+/** The start or end date of the DST rule of a POSIX TZ string. */
+typedef struct AtcTzifRuleDate {
+  /** One of the kAtcTzifRuleXxx enums. */
+  uint8_t form;
+
+  /** Month [1,12] of the "Mm.w.d" form. */
+  uint8_t month;
+
+  /** Week [1,5] of the "Mm.w.d" form, 5 meaning the last week. */
+  uint8_t week;
+
+  /** Day of week [0,6] of the "Mm.w.d" form, 0 meaning Sunday. */
+  uint8_t day_of_week;
+
+  /** Day of year of the "Jn" [1,365] or "n" [0,365] forms. */
+  uint16_t day_of_year;
+
+  /** Local wall time of the transition, in [-167h, 167h]. */
+  int32_t time_seconds;
+} AtcTzifRuleDate;
+
+/** The parsed POSIX TZ string in the footer of a TZif file. */
+typedef struct AtcTzifFooter {
+  /** False if there is no footer, or if it could not be parsed. */
+  bool is_valid;
+
+  /** True if the TZ string defines a DST rule. */
+  bool has_dst;
+
+  /** The STD offset, positive east of UTC (i.e. -8h for "PST8"). */
+  int32_t std_offset_seconds;
+
+  /** The DST offset, i.e. the DST UTC offset minus the STD UTC offset. */
+  int32_t dst_offset_seconds;
+
+  /** Abbreviation of standard time. */
+  char std_abbrev[kAtcAbbrevSize];
+
+  /** Abbreviation of daylight saving time. */
+  char dst_abbrev[kAtcAbbrevSize];
+
+  /** Start of DST, in local standard time. */
+  AtcTzifRuleDate start;
+
+  /** End of DST, in local daylight saving time. */
+  AtcTzifRuleDate end;
+} AtcTzifFooter;
+
+/**
+ * A time zone backed by the data of a TZif file. The fields are private. The
+ * data must remain valid while the AtcTzif is used.
+ */
+typedef struct AtcTzif {
+  /** The TZif data. */
+  const uint8_t *data;
+
+  /** Size of the TZif data. */
+  size_t size;
+
+  /** True if `data` was mapped by atc_tzif_open(). */
+  bool is_mapped;
+
+  /** Size of each transition time: 4 for version 1, 8 for version 2+. */
+  uint8_t time_size;
+
+  /** Number of transitions. */
+  uint32_t num_transitions;
+
+  /** Number of local time types. */
+  uint32_t num_types;
+
+  /** Number of characters of the abbreviations. */
+  uint32_t num_chars;
+
+  /** Big-endian transition times, in unix seconds. */
+  const uint8_t *times;
+
+  /** Local time type of each transition. */
+  const uint8_t *type_indexes;
+
+  /** Local time types of 6 bytes each: utoff (4), isdst (1), desigidx (1). */
+  const uint8_t *types;
+
+  /** NUL-separated abbreviations. */
+  const char *abbrevs;
+
+  /** The POSIX TZ string for times after the last transition. */
+  AtcTzifFooter footer;
+} AtcTzif;
+
+/**
+ * Initialize the AtcTzif from the TZif data in the given buffer, which is used
+ * in place and must remain valid while the AtcTzif is used. Only the header,
+ * the local time types, and the footer are parsed.
+ *
+ * Return kAtcErrGeneric if the data is not a valid TZif file, or if it
+ * contains leap seconds.
+ */
+int8_t atc_tzif_init(AtcTzif *tzif, const uint8_t *data, size_t size);
+
+#if ATC_ENABLE_TZIF_MMAP
+
+/**
+ * Map the TZif file `dir/name` (e.g. ATC_TZIF_DEFAULT_DIR and
+ * "America/Los_Angeles") into memory, and initialize the AtcTzif using
+ * atc_tzif_init(). The mapping must be released with atc_tzif_close().
+ *
+ * Return kAtcErrGeneric if the file cannot be opened or mapped, or if it is
+ * not a valid TZif file.
+ */
+int8_t atc_tzif_open(AtcTzif *tzif, const char *dir, const char *name);
+
+/** Unmap the file mapped by atc_tzif_open(). Does nothing otherwise. */
+void atc_tzif_close(AtcTzif *tzif);
+
+#endif
+
+/**
+ * Find the UTC offsets and abbreviation at the given epoch_seconds. Same as
+ * atc_processor_find_by_epoch_seconds(). The `result.abbrev` points into the
+ * TZif data or into the `tzif.footer`.
+ */
+void atc_tzif_find_by_epoch_seconds(
+    const AtcTzif *tzif,
+    atc_time_t epoch_seconds,
+    AtcFindResult *result);
+
+/**
+ * Find the UTC offsets and abbreviation at the given AtcLocalDateTime, taking
+ * into account gaps and overlaps. Same as
+ * atc_processor_find_by_local_date_time().
+ */
+void atc_tzif_find_by_local_date_time(
+    const AtcTzif *tzif,
+    const AtcLocalDateTime *ldt,
+    AtcFindResult *result);
+
+/**
+ * Parse the POSIX TZ string `s` (e.g. "PST8PDT,M3.2.0,M11.1.0") into the
+ * footer. Exported for testing. Returns kAtcErrGeneric if it cannot be parsed.
+ */
+int8_t atc_tzif_parse_posix_tz(
+    AtcTzifFooter *footer,
+    const char *s,
+    size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,789 @@
+/*
+ * MIT License
+ * Copyright (c) 2024 Brian T. Park
+ */
+
+// Needed for open(), fstat() and mmap() with -std=c11. Must appear before any
+// system header.
+#if !defined(_POSIX_C_SOURCE)
+  #define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "zone_blob.h"
+
+#include <string.h> // memcmp(), memcpy(), memset(), strcmp(), strlen()
+#include "common.h" // kAtcErrOk, atc_djb2()
+#include "zone_registrar.h" // atc_registrar_is_registry_sorted()
+
+#if ATC_ENABLE_ZONE_BLOB_MMAP
+#include <fcntl.h> // open()
+#include <sys/mman.h> // mmap(), munmap()
+#include <sys/stat.h> // fstat()
+#include <unistd.h> // close()
+#endif
+
+//---------------------------------------------------------------------------
+// Layout of the blob. All records are in the byte order of the writer, and
+// all sections start at a multiple of 4 bytes:
+//
+//  header | letters | fragments | zones | eras | policies | rules | strings
+//
+// The letters and fragments are arrays of uint32_t offsets into the strings.
+// The rules are the AtcZoneRule records themselves, which contain no
+// pointers. The strings are NUL-terminated and deduplicated.
+//---------------------------------------------------------------------------
+
+/** Value of the string offset or record index which represents NULL. */
+#define ATC_ZONE_BLOB_NONE UINT32_MAX
+
+/** Value of the record index of 16 bits which represents NULL. */
+#define ATC_ZONE_BLOB_NONE16 UINT16_MAX
+
+static const char kAtcZoneBlobMagic[8] = "ATCZDB1";
+
+enum {
+  /** Written in the byte order of the writer, to detect a mismatch. */
+  kAtcZoneBlobByteOrder = 0x01020304,
+};
+
+typedef struct AtcZoneBlobHeader {
+  char magic[8];
+  uint32_t byte_order;
+  uint32_t size;
+  uint16_t rule_size;
+  uint8_t hires;
+  uint8_t is_sorted;
+  int16_t start_year;
+  int16_t until_year;
+  int16_t start_year_accurate;
+  int16_t until_year_accurate;
+  int16_t max_transitions;
+  uint16_t reserved;
+  uint32_t tz_version;
+  uint32_t num_letters;
+  uint32_t letters;
+  uint32_t num_fragments;
+  uint32_t fragments;
+  uint32_t num_zones;
+  uint32_t zones;
+  uint32_t num_eras;
+  uint32_t eras;
+  uint32_t num_policies;
+  uint32_t policies;
+  uint32_t num_rules;
+  uint32_t rules;
+  uint32_t strings_size;
+  uint32_t strings;
+} AtcZoneBlobHeader;
+
+typedef struct AtcZoneBlobZone {
+  uint32_t name;
+  uint32_t zone_id;
+  uint32_t first_era;
+  uint16_t num_eras;
+  /** Index of the target zone of a link, or ATC_ZONE_BLOB_NONE16. */
+  uint16_t target;
+} AtcZoneBlobZone;
+
+/** A superset of the fields of AtcZoneEra for both ATC_HIRES_ZONEDB modes. */
+typedef struct AtcZoneBlobEra {
+  uint32_t format;
+  /** Index of the policy, or ATC_ZONE_BLOB_NONE16. */
+  uint16_t policy;
+  int16_t offset_code;
+  int16_t until_year;
+  uint16_t until_time_code;
+  uint8_t offset_remainder;
+  int8_t delta_minutes;
+  uint8_t delta_code;
+  uint8_t until_month;
+  uint8_t until_day;
+  uint8_t until_time_modifier;
+  uint8_t reserved[2];
+} AtcZoneBlobEra;
+
+typedef struct AtcZoneBlobPolicy {
+  uint32_t first_rule;
+  uint32_t num_rules;
+} AtcZoneBlobPolicy;
+
+static uint32_t atc_zone_blob_align(uint32_t n)
+{
+  return (n + 3) & ~(uint32_t) 3;
+}
+
+//---------------------------------------------------------------------------
+// Writer.
+//---------------------------------------------------------------------------
+
+typedef struct AtcZoneBlobWriter {
+  const AtcZoneInfo * const *registry;
+  uint16_t size;
+  uint8_t *buf;
+  size_t capacity;
+  AtcZoneBlobHeader header;
+} AtcZoneBlobWriter;
+
+// Return the index of the first era of zone `index` in the eras section. Only
+// the zones which are not links own their eras.
+static uint32_t atc_zone_blob_first_era(
+    const AtcZoneBlobWriter *w,
+    uint16_t index)
+{
+  uint32_t first = 0;
+  for (uint16_t i = 0; i < index; i++) {
+    const AtcZoneInfo *info = w->registry[i];
+    if (info->target_info == NULL) first += info->num_eras;
+  }
+  return first;
+}
+
+// Return the index of the target of the link `info` in the registry, or
+// ATC_ZONE_BLOB_NONE16 if it is not in the registry.
+static uint16_t atc_zone_blob_target_index(
+    const AtcZoneBlobWriter *w,
+    const AtcZoneInfo *info)
+{
+  for (uint16_t i = 0; i < w->size; i++) {
+    if (w->registry[i] == info->target_info) return i;
+  }
+  return ATC_ZONE_BLOB_NONE16;
+}
+
+// Return the index in the eras section of the first era which uses the
+// given policy.
+static uint32_t atc_zone_blob_first_use(
+    const AtcZoneBlobWriter *w,
+    const AtcZonePolicy *policy)
+{
+  uint32_t era_index = 0;
+  for (uint16_t i = 0; i < w->size; i++) {
+    const AtcZoneInfo *info = w->registry[i];
+    if (info->target_info != NULL) continue;
+    for (uint8_t j = 0; j < info->num_eras; j++, era_index++) {
+      if (info->eras[j].zone_policy == policy) return era_index;
+    }
+  }
+  return ATC_ZONE_BLOB_NONE;
+}
+
+// Append the string `s` to the strings section, unless it is already there,
+// and return its offset.
+static uint32_t atc_zone_blob_add_string(AtcZoneBlobWriter *w, const char *s)
+{
+  if (s == NULL) return ATC_ZONE_BLOB_NONE;
+
+  AtcZoneBlobHeader *h = &w->header;
+  const char *strings = (const char *) w->buf + h->strings;
+  for (uint32_t offset = 0; offset < h->strings_size; ) {
+    const char *t = strings + offset;
+    if (strcmp(s, t) == 0) return offset;
+    offset += (uint32_t) strlen(t) + 1;
+  }
+
+  size_t len = strlen(s) + 1;
+  if (h->strings + h->strings_size + len > w->capacity) {
+    return ATC_ZONE_BLOB_NONE;
+  }
+  memcpy(w->buf + h->strings + h->strings_size, s, len);
+  uint32_t offset = h->strings_size;
+  h->strings_size += (uint32_t) len;
+  return offset;
+}
+
+// Add the strings and write the array of their offsets at `array`.
+static int8_t atc_zone_blob_write_strings(
+    AtcZoneBlobWriter *w,
+    uint32_t array,
+    const char * const *strings,
+    uint32_t num_strings)
+{
+  for (uint32_t i = 0; i < num_strings; i++) {
+    uint32_t offset = atc_zone_blob_add_string(w, strings[i]);
+    if (offset == ATC_ZONE_BLOB_NONE && strings[i] != NULL) {
+      return kAtcErrGeneric;
+    }
+    memcpy(w->buf + array + i * sizeof(uint32_t), &offset, sizeof(uint32_t));
+  }
+  return kAtcErrOk;
+}
+
+// Write the eras of the zone `info`, starting at the era `era_index`, along
+// with the policies and rules used for the first time.
+static int8_t atc_zone_blob_write_eras(
+    AtcZoneBlobWriter *w,
+    const AtcZoneInfo *info,
+    uint32_t era_index)
+{
+  AtcZoneBlobHeader *h = &w->header;
+  for (uint8_t j = 0; j < info->num_eras; j++, era_index++) {
+    const AtcZoneEra *era = &info->eras[j];
+    AtcZoneBlobEra r;
+    memset(&r, 0, sizeof(r));
+
+    r.policy = ATC_ZONE_BLOB_NONE16;
+    const AtcZonePolicy *policy = era->zone_policy;
+    if (policy != NULL) {
+      uint32_t first_use = atc_zone_blob_first_use(w, policy);
+      if (first_use < era_index) {
+        // Reuse the policy of the earlier era.
+        AtcZoneBlobEra prev;
+        memcpy(&prev, w->buf + h->eras + first_use * sizeof(prev),
+            sizeof(prev));
+        r.policy = prev.policy;
+      } else {
+        AtcZoneBlobPolicy p = {h->num_rules, policy->num_rules};
+        r.policy = (uint16_t) h->num_policies;
+        memcpy(w->buf + h->policies + h->num_policies * sizeof(p), &p,
+            sizeof(p));
+        memcpy(w->buf + h->rules + h->num_rules * sizeof(AtcZoneRule),
+            policy->rules, policy->num_rules * sizeof(AtcZoneRule));
+        h->num_policies++;
+        h->num_rules += policy->num_rules;
+      }
+    }
+
+    r.format = atc_zone_blob_add_string(w, era->format);
+    if (r.format == ATC_ZONE_BLOB_NONE && era->format != NULL) {
+      return kAtcErrGeneric;
+    }
+    r.offset_code = era->offset_code;
+#if ATC_HIRES_ZONEDB
+    r.offset_remainder = era->offset_remainder;
+    r.delta_minutes = era->delta_minutes;
+#else
+    r.delta_code = era->delta_code;
+#endif
+    r.until_year = era->until_year;
+    r.until_month = era->until_month;
+    r.until_day = era->until_day;
+    r.until_time_code = era->until_time_code;
+    r.until_time_modifier = era->until_time_modifier;
+    memcpy(w->buf + h->eras + era_index * sizeof(r), &r, sizeof(r));
+  }
+  return kAtcErrOk;
+}
+
+int8_t atc_zone_blob_write(
+    const AtcZoneInfo * const *registry,
+    uint16_t size,
+    uint8_t *buf,
+    size_t capacity,
+    size_t *written)
+{
+  *written = 0;
+  if (size == 0 || size == ATC_ZONE_BLOB_NONE16) return kAtcErrGeneric;
+
+  AtcZoneBlobWriter w;
+  w.registry = registry;
+  w.size = size;
+  w.buf = buf;
+  w.capacity = capacity;
+  AtcZoneBlobHeader *h = &w.header;
+  memset(h, 0, sizeof(*h));
+
+  // Count the records, and validate the registry.
+  const AtcZoneContext *context = registry[0]->zone_context;
+  if (context->num_letters > kAtcZoneBlobMaxStrings) return kAtcErrGeneric;
+  if (context->num_fragments > kAtcZoneBlobMaxStrings) return kAtcErrGeneric;
+  uint32_t num_eras = 0;
+  uint32_t num_policies = 0;
+  uint32_t num_rules = 0;
+  for (uint16_t i = 0; i < size; i++) {
+    const AtcZoneInfo *info = registry[i];
+    if (info->zone_context != context) return kAtcErrGeneric;
+    if (info->num_eras > kAtcZoneBlobMaxEras) return kAtcErrGeneric;
+    if (info->target_info != NULL) {
+      uint16_t target = atc_zone_blob_target_index(&w, info);
+      if (target == ATC_ZONE_BLOB_NONE16) return kAtcErrGeneric;
+      if (registry[target]->target_info != NULL) return kAtcErrGeneric;
+      continue;
+    }
+    for (uint8_t j = 0; j < info->num_eras; j++, num_eras++) {
+      const AtcZonePolicy *policy = info->eras[j].zone_policy;
+      if (policy == NULL) continue;
+      if (atc_zone_blob_first_use(&w, policy) == num_eras) {
+        num_policies++;
+        num_rules += policy->num_rules;
+      }
+    }
+  }
+  if (num_policies >= ATC_ZONE_BLOB_NONE16) return kAtcErrGeneric;
+
+  // Lay out the sections.
+  uint32_t offset = atc_zone_blob_align(sizeof(AtcZoneBlobHeader));
+  h->letters = offset;
+  offset += context->num_letters * sizeof(uint32_t);
+  h->fragments = offset;
+  offset += context->num_fragments * sizeof(uint32_t);
+  h->zones = offset;
+  offset += size * sizeof(AtcZoneBlobZone);
+  h->eras = offset;
+  offset += num_eras * sizeof(AtcZoneBlobEra);
+  h->policies = offset;
+  offset += num_policies * sizeof(AtcZoneBlobPolicy);
+  h->rules = atc_zone_blob_align(offset);
+  offset = h->rules + num_rules * sizeof(AtcZoneRule);
+  h->strings = atc_zone_blob_align(offset);
+  if (h->strings > capacity) return kAtcErrGeneric;
+  memset(buf, 0, h->strings);
+
+  // Write the records. The policies and rules are counted again as they are
+  // written.
+  h->num_letters = context->num_letters;
+  h->num_fragments = context->num_fragments;
+  h->num_zones = size;
+  h->num_eras = num_eras;
+  int8_t err = atc_zone_blob_write_strings(
+      &w, h->letters, context->letters, context->num_letters);
+  if (err) return err;
+  err = atc_zone_blob_write_strings(
+      &w, h->fragments, context->fragments, context->num_fragments);
+  if (err) return err;
+  h->tz_version = atc_zone_blob_add_string(&w, context->tz_version);
+  if (h->tz_version == ATC_ZONE_BLOB_NONE && context->tz_version != NULL) {
+    return kAtcErrGeneric;
+  }
+
+  for (uint16_t i = 0; i < size; i++) {
+    const AtcZoneInfo *info = registry[i];
+    AtcZoneBlobZone z;
+    z.name = atc_zone_blob_add_string(&w, info->name);
+    if (z.name == ATC_ZONE_BLOB_NONE) return kAtcErrGeneric;
+    z.zone_id = info->zone_id;
+    z.num_eras = info->num_eras;
+    if (info->target_info != NULL) {
+      z.target = atc_zone_blob_target_index(&w, info);
+      z.first_era = atc_zone_blob_first_era(&w, z.target);
+    } else {
+      z.target = ATC_ZONE_BLOB_NONE16;
+      z.first_era = atc_zone_blob_first_era(&w, i);
+      err = atc_zone_blob_write_eras(&w, info, z.first_era);
+      if (err) return err;
+    }
+    memcpy(buf + h->zones + i * sizeof(z), &z, sizeof(z));
+  }
+
+  memcpy(h->magic, kAtcZoneBlobMagic, sizeof(h->magic));
+  h->byte_order = kAtcZoneBlobByteOrder;
+  h->rule_size = sizeof(AtcZoneRule);
+  h->hires = ATC_HIRES_ZONEDB;
+  h->is_sorted = atc_registrar_is_registry_sorted(registry, size);
+  h->start_year = context->start_year;
+  h->until_year = context->until_year;
+  h->start_year_accurate = context->start_year_accurate;
+  h->until_year_accurate = context->until_year_accurate;
+  h->max_transitions = context->max_transitions;
+  h->size = atc_zone_blob_align(h->strings + h->strings_size);
+  if (h->size > capacity) return kAtcErrGeneric;
+  memset(buf + h->strings + h->strings_size, 0,
+      h->size - h->strings - h->strings_size);
+  memcpy(buf, h, sizeof(*h));
+  *written = h->size;
+  return kAtcErrOk;
+}
+
+//---------------------------------------------------------------------------
+// Loader.
+//---------------------------------------------------------------------------
+
+static void atc_zone_blob_read_header(
+    const AtcZoneBlob *blob,
+    AtcZoneBlobHeader *h)
+{
+  memcpy(h, blob->data, sizeof(*h));
+}
+
+static void atc_zone_blob_read_zone(
+    const AtcZoneBlob *blob,
+    const AtcZoneBlobHeader *h,
+    uint16_t index,
+    AtcZoneBlobZone *z)
+{
+  memcpy(z, blob->data + h->zones + index * sizeof(*z), sizeof(*z));
+}
+
+// Return true if the section of `count` records of `record_size` bytes at
+// `offset` lies within the blob.
+static bool atc_zone_blob_is_section_valid(
+    const AtcZoneBlobHeader *h,
+    uint32_t offset,
+    uint32_t count,
+    size_t record_size)
+{
+  if (offset % 4 != 0 || offset > h->size) return false;
+  return count <= (h->size - offset) / record_size;
+}
+
+static bool atc_zone_blob_is_string_valid(
+    const AtcZoneBlobHeader *h,
+    uint32_t offset)
+{
+  return offset == ATC_ZONE_BLOB_NONE || offset < h->strings_size;
+}
+
+static const char *atc_zone_blob_string(
+    const AtcZoneBlob *blob,
+    const AtcZoneBlobHeader *h,
+    uint32_t offset)
+{
+  if (offset == ATC_ZONE_BLOB_NONE) return NULL;
+  return (const char *) blob->data + h->strings + offset;
+}
+
+// Read the string offsets at `array` into `strings`.
+static int8_t atc_zone_blob_read_strings(
+    const AtcZoneBlob *blob,
+    const AtcZoneBlobHeader *h,
+    uint32_t array,
+    uint32_t num_strings,
+    const char **strings)
+{
+  if (num_strings > kAtcZoneBlobMaxStrings) return kAtcErrGeneric;
+  if (! atc_zone_blob_is_section_valid(h, array, num_strings,
+      sizeof(uint32_t))) {
+    return kAtcErrGeneric;
+  }
+  for (uint32_t i = 0; i < num_strings; i++) {
+    uint32_t offset;
+    memcpy(&offset, blob->data + array + i * sizeof(offset), sizeof(offset));
+    if (! atc_zone_blob_is_string_valid(h, offset)) return kAtcErrGeneric;
+    strings[i] = atc_zone_blob_string(blob, h, offset);
+  }
+  return kAtcErrOk;
+}
+
+static bool atc_zone_blob_is_header_valid(
+    const AtcZoneBlobHeader *h,
+    size_t size)
+{
+  if (memcmp(h->magic, kAtcZoneBlobMagic, sizeof(h->magic)) != 0) return false;
+  if (h->byte_order != kAtcZoneBlobByteOrder) return false;
+  if (h->rule_size != sizeof(AtcZoneRule)) return false;
+  if (h->hires != ATC_HIRES_ZONEDB) return false;
+  if (h->size > size) return false;
+  if (h->num_zones >= ATC_ZONE_BLOB_NONE16) return false;
+  if (h->num_policies >= ATC_ZONE_BLOB_NONE16) return false;
+
+  if (! atc_zone_blob_is_section_valid(
+      h, h->zones, h->num_zones, sizeof(AtcZoneBlobZone))) return false;
+  if (! atc_zone_blob_is_section_valid(
+      h, h->eras, h->num_eras, sizeof(AtcZoneBlobEra))) return false;
+  if (! atc_zone_blob_is_section_valid(
+      h, h->policies, h->num_policies, sizeof(AtcZoneBlobPolicy))) {
+    return false;
+  }
+  if (! atc_zone_blob_is_section_valid(
+      h, h->rules, h->num_rules, sizeof(AtcZoneRule))) return false;
+  if (! atc_zone_blob_is_section_valid(h, h->strings, h->strings_size, 1)) {
+    return false;
+  }
+  return atc_zone_blob_is_string_valid(h, h->tz_version);
+}
+
+// Return true if the suffix of the AT or UNTIL time is 'w', 's' or 'u', and
+// the remainder is within the 15 minutes (or seconds) of the time code.
+static bool atc_zone_blob_is_modifier_valid(uint8_t modifier)
+{
+  uint8_t suffix = modifier & 0xf0;
+  if (suffix != kAtcSuffixW && suffix != kAtcSuffixS && suffix != kAtcSuffixU) {
+    return false;
+  }
+  return (modifier & 0x0f) < 15;
+}
+
+// Return true if the fields used by the zone processor to find the
+// transitions of the rule are within range.
+static bool atc_zone_blob_is_rule_valid(
+    const AtcZoneRule *rule,
+    uint32_t num_letters)
+{
+  if (rule->letter_index >= num_letters) return false;
+  if (rule->in_month < 1 || rule->in_month > 12) return false;
+  if (rule->on_day_of_week > 7) return false;
+  if (rule->on_day_of_month < -31 || rule->on_day_of_month > 31) return false;
+  if (rule->on_day_of_week == 0 && rule->on_day_of_month < 1) return false;
+  return atc_zone_blob_is_modifier_valid(rule->at_time_modifier);
+}
+
+// Validate all the records, so that the lookups can use them without checks.
+static bool atc_zone_blob_are_records_valid(
+    const AtcZoneBlob *blob,
+    const AtcZoneBlobHeader *h)
+{
+  // All strings must be terminated within the strings section.
+  if (h->strings_size > 0 && blob->data[h->strings + h->strings_size - 1]) {
+    return false;
+  }
+
+  for (uint32_t i = 0; i < h->num_policies; i++) {
+    AtcZoneBlobPolicy p;
+    memcpy(&p, blob->data + h->policies + i * sizeof(p), sizeof(p));
+    if (p.num_rules > UINT8_MAX) return false;
+    if (p.first_rule > h->num_rules) return false;
+    if (p.num_rules > h->num_rules - p.first_rule) return false;
+  }
+
+  const AtcZoneRule *rules = (const AtcZoneRule *) (blob->data + h->rules);
+  for (uint32_t i = 0; i < h->num_rules; i++) {
+    if (! atc_zone_blob_is_rule_valid(&rules[i], h->num_letters)) return false;
+  }
+
+  for (uint32_t i = 0; i < h->num_eras; i++) {
+    AtcZoneBlobEra r;
+    memcpy(&r, blob->data + h->eras + i * sizeof(r), sizeof(r));
+    if (! atc_zone_blob_is_string_valid(h, r.format)) return false;
+    if (r.policy != ATC_ZONE_BLOB_NONE16 && r.policy >= h->num_policies) {
+      return false;
+    }
+    if (r.until_month < 1 || r.until_month > 12) return false;
+    if (r.until_day < 1 || r.until_day > 31) return false;
+    if (! atc_zone_blob_is_modifier_valid(r.until_time_modifier)) return false;
+  }
+
+  uint32_t prev_zone_id = 0;
+  for (uint16_t i = 0; i < h->num_zones; i++) {
+    AtcZoneBlobZone z;
+    atc_zone_blob_read_zone(blob, h, i, &z);
+    if (z.name >= h->strings_size) return false;
+    if (z.num_eras > kAtcZoneBlobMaxEras) return false;
+    if (z.first_era > h->num_eras) return false;
+    if (z.num_eras > h->num_eras - z.first_era) return false;
+    if (z.target != ATC_ZONE_BLOB_NONE16) {
+      if (z.target >= h->num_zones) return false;
+      AtcZoneBlobZone target;
+      atc_zone_blob_read_zone(blob, h, z.target, &target);
+      if (target.target != ATC_ZONE_BLOB_NONE16) return false;
+    }
+    if (h->is_sorted && i > 0 && z.zone_id < prev_zone_id) return false;
+    prev_zone_id = z.zone_id;
+  }
+  return true;
+}
+
+int8_t atc_zone_blob_init(AtcZoneBlob *blob, const uint8_t *data, size_t size)
+{
+  blob->data = data;
+  blob->size = size;
+  blob->is_mapped = false;
+  blob->is_sorted = false;
+  blob->num_zones = 0;
+
+  if (data == NULL || (uintptr_t) data % 4 != 0) return kAtcErrGeneric;
+  if (size < sizeof(AtcZoneBlobHeader)) return kAtcErrGeneric;
+  AtcZoneBlobHeader h;
+  atc_zone_blob_read_header(blob, &h);
+  if (! atc_zone_blob_is_header_valid(&h, size)) return kAtcErrGeneric;
+  if (! atc_zone_blob_are_records_valid(blob, &h)) return kAtcErrGeneric;
+
+  int8_t err = atc_zone_blob_read_strings(
+      blob, &h, h.letters, h.num_letters, blob->letters);
+  if (err) return err;
+  err = atc_zone_blob_read_strings(
+      blob, &h, h.fragments, h.num_fragments, blob->fragments);
+  if (err) return err;
+
+  AtcZoneContext *context = &blob->context;
+  context->start_year = h.start_year;
+  context->until_year = h.until_year;
+  context->start_year_accurate = h.start_year_accurate;
+  context->until_year_accurate = h.until_year_accurate;
+  context->max_transitions = h.max_transitions;
+  context->tz_version = atc_zone_blob_string(blob, &h, h.tz_version);
+  context->num_fragments = (uint8_t) h.num_fragments;
+  context->num_letters = (uint8_t) h.num_letters;
+  context->fragments = blob->fragments;
+  context->letters = blob->letters;
+
+  blob->is_sorted = h.is_sorted;
+  blob->num_zones = (uint16_t) h.num_zones;
+  return kAtcErrOk;
+}
+
+#if ATC_ENABLE_ZONE_BLOB_MMAP
+
+int8_t atc_zone_blob_open(AtcZoneBlob *blob, const char *path)
+{
+  blob->data = NULL;
+  blob->size = 0;
+  blob->is_mapped = false;
+  blob->num_zones = 0;
+
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) return kAtcErrGeneric;
+  struct stat st;
+  if (fstat(fd, &st) != 0 || ! S_ISREG(st.st_mode)
+      || (size_t) st.st_size < sizeof(AtcZoneBlobHeader)) {
+    close(fd);
+    return kAtcErrGeneric;
+  }
+  size_t size = (size_t) st.st_size;
+  void *p = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (p == MAP_FAILED) return kAtcErrGeneric;
+
+  int8_t err = atc_zone_blob_init(blob, (const uint8_t *) p, size);
+  if (err) {
+    munmap(p, size);
+    blob->data = NULL;
+    blob->size = 0;
+    return err;
+  }
+  blob->is_mapped = true;
+  return kAtcErrOk;
+}
+
+void atc_zone_blob_close(AtcZoneBlob *blob)
+{
+  if (blob->is_mapped) {
+    munmap((void *) blob->data, blob->size);
+  }
+  blob->data = NULL;
+  blob->size = 0;
+  blob->is_mapped = false;
+  blob->num_zones = 0;
+}
+
+#endif
+
+uint16_t atc_zone_blob_num_zones(const AtcZoneBlob *blob)
+{
+  return blob->num_zones;
+}
+
+// Materialize the eras of zone `z` and their policies into the view.
+static void atc_zone_blob_fill_eras(
+    const AtcZoneBlob *blob,
+    const AtcZoneBlobHeader *h,
+    const AtcZoneBlobZone *z,
+    AtcZoneBlobView *view)
+{
+  const AtcZoneRule *rules = (const AtcZoneRule *) (blob->data + h->rules);
+  for (uint16_t i = 0; i < z->num_eras; i++) {
+    AtcZoneBlobEra r;
+    memcpy(&r, blob->data + h->eras + (z->first_era + i) * sizeof(r),
+        sizeof(r));
+
+    // The records have const fields, so they are initialized in a temporary
+    // and copied into the view.
+    const AtcZonePolicy *zone_policy = NULL;
+    if (r.policy != ATC_ZONE_BLOB_NONE16) {
+      AtcZoneBlobPolicy p;
+      memcpy(&p, blob->data + h->policies + r.policy * sizeof(p), sizeof(p));
+      AtcZonePolicy policy = {&rules[p.first_rule], (uint8_t) p.num_rules};
+      memcpy(&view->policies[i], &policy, sizeof(policy));
+      zone_policy = &view->policies[i];
+    }
+
+    AtcZoneEra era = {
+      zone_policy,
+      atc_zone_blob_string(blob, h, r.format),
+#if ATC_HIRES_ZONEDB
+      r.offset_code,
+      r.offset_remainder,
+      r.delta_minutes,
+#else
+      (int8_t) r.offset_code,
+      r.delta_code,
+#endif
+      r.until_year,
+      r.until_month,
+      r.until_day,
+#if ATC_HIRES_ZONEDB
+      r.until_time_code,
+#else
+      (uint8_t) r.until_time_code,
+#endif
+      r.until_time_modifier,
+    };
+    memcpy(&view->eras[i], &era, sizeof(era));
+  }
+}
+
+int8_t atc_zone_blob_get(
+    const AtcZoneBlob *blob,
+    uint16_t index,
+    AtcZoneBlobView *view)
+{
+  if (index >= blob->num_zones) return kAtcErrGeneric;
+
+  AtcZoneBlobHeader h;
+  atc_zone_blob_read_header(blob, &h);
+  AtcZoneBlobZone z;
+  atc_zone_blob_read_zone(blob, &h, index, &z);
+  atc_zone_blob_fill_eras(blob, &h, &z, view);
+
+  const AtcZoneInfo *target_info = NULL;
+  if (z.target != ATC_ZONE_BLOB_NONE16) {
+    AtcZoneBlobZone target;
+    atc_zone_blob_read_zone(blob, &h, z.target, &target);
+    AtcZoneInfo info = {
+      atc_zone_blob_string(blob, &h, target.name),
+      target.zone_id,
+      &blob->context,
+      (uint8_t) target.num_eras,
+      view->eras,
+      NULL,
+    };
+    memcpy(&view->target, &info, sizeof(info));
+    target_info = &view->target;
+  }
+
+  AtcZoneInfo info = {
+    atc_zone_blob_string(blob, &h, z.name),
+    z.zone_id,
+    &blob->context,
+    (uint8_t) z.num_eras,
+    view->eras,
+    target_info,
+  };
+  memcpy(&view->info, &info, sizeof(info));
+  return kAtcErrOk;
+}
+
+int8_t atc_zone_blob_find_by_name(
+    const AtcZoneBlob *blob,
+    const char *name,
+    AtcZoneBlobView *view)
+{
+  uint32_t zone_id = atc_djb2(name);
+  int8_t err = atc_zone_blob_find_by_id(blob, zone_id, view);
+  if (err) return err;
+
+  // Verify that the name actually matches, in case of hash collision.
+  if (strcmp(name, view->info.name) != 0) return kAtcErrGeneric;
+
+  return kAtcErrOk;
+}
+
+int8_t atc_zone_blob_find_by_id(
+    const AtcZoneBlob *blob,
+    uint32_t zone_id,
+    AtcZoneBlobView *view)
+{
+  if (blob->num_zones == 0) return kAtcErrGeneric;
+
+  AtcZoneBlobHeader h;
+  atc_zone_blob_read_header(blob, &h);
+  AtcZoneBlobZone z;
+  if (blob->is_sorted) {
+    uint16_t a = 0;
+    uint16_t b = blob->num_zones;
+    while (a < b) {
+      uint16_t c = a + (b - a) / 2;
+      atc_zone_blob_read_zone(blob, &h, c, &z);
+      if (z.zone_id == zone_id) return atc_zone_blob_get(blob, c, view);
+      if (z.zone_id < zone_id) {
+        a = c + 1;
+      } else {
+        b = c;
+      }
+    }
+  } else {
+    for (uint16_t i = 0; i < blob->num_zones; i++) {
+      atc_zone_blob_read_zone(blob, &h, i, &z);
+      if (z.zone_id == zone_id) return atc_zone_blob_get(blob, i, view);
+    }
+  }
+  return kAtcErrGeneric;
+}
@@ -0,0 +1,189 @@
+/*
+ * MIT License
+ * Copyright (c) 2024 Brian T. Park
+ */
+
+/**
+ * @file zone_blob.h
+ *
+ * A serialized form of a zone registry as a single position-independent
+ * binary blob, and a loader which reads the zone data from the blob at
+ * runtime. The blob contains the AtcZoneContext, and the AtcZoneInfo,
+ * AtcZoneEra, AtcZonePolicy and AtcZoneRule records of every zone of the
+ * registry, with offsets in place of the pointers. The blob can be written to
+ * a file (see examples/zone_blob_writer), so that the TZ data can be updated
+ * without relinking the program.
+ *
+ * The blob is used in place. The AtcZoneRule records and all the strings are
+ * referenced directly inside the blob. The AtcZoneInfo, AtcZoneEra and
+ * AtcZonePolicy records contain pointers, so the few records of a single zone
+ * are materialized into a caller-allocated AtcZoneBlobView when the zone is
+ * looked up. On POSIX systems, atc_zone_blob_open() maps a file into memory
+ * with mmap(), so that many processes can share a single copy of the zone
+ * data in the page cache. This is enabled by default on Unix-like systems,
+ * and can be controlled explicitly by defining ATC_ENABLE_ZONE_BLOB_MMAP to 0
+ * or 1.
+ *
+ * The blob uses the byte order and the ATC_HIRES_ZONEDB setting of the
+ * program which wrote it, and is rejected by a program which uses different
+ * ones.
+ */
+
+#ifndef ACE_TIME_C_ZONE_BLOB_H
+#define ACE_TIME_C_ZONE_BLOB_H
+
+#ifndef ATC_ENABLE_ZONE_BLOB_MMAP
+  #if defined(__unix__) || defined(__APPLE__)
+    #define ATC_ENABLE_ZONE_BLOB_MMAP 1
+  #else
+    #define ATC_ENABLE_ZONE_BLOB_MMAP 0
+  #endif
+#endif
+
+#include <stdbool.h>
+#include <stddef.h> // size_t
+#include <stdint.h>
+#include "../zoneinfo/zone_info.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+  /** Maximum number of eras of a zone in the blob. */
+  kAtcZoneBlobMaxEras = 32,
+
+  /** Maximum number of letters or fragments of the blob. */
+  kAtcZoneBlobMaxStrings = 64,
+};
+
+/**
+ * A zone database backed by a binary blob. The fields are private. The blob
+ * data must remain valid, and the AtcZoneBlob must not be moved, while the
+ * zones found in it are used.
+ */
+typedef struct AtcZoneBlob {
+  /** The blob data. */
+  const uint8_t *data;
+
+  /** Size of the blob data. */
+  size_t size;
+
+  /** True if `data` was mapped by atc_zone_blob_open(). */
+  bool is_mapped;
+
+  /** True if the zones are sorted by zone_id. */
+  bool is_sorted;
+
+  /** Number of zones and links. */
+  uint16_t num_zones;
+
+  /** The zone context shared by all zones of the blob. */
+  AtcZoneContext context;
+
+  /** Storage of AtcZoneContext::letters. */
+  const char *letters[kAtcZoneBlobMaxStrings];
+
+  /** Storage of AtcZoneContext::fragments. */
+  const char *fragments[kAtcZoneBlobMaxStrings];
+} AtcZoneBlob;
+
+/**
+ * Storage for the AtcZoneInfo of a single zone found in an AtcZoneBlob. The
+ * `info` is the result. The other fields are private.
+ *
+ * The view can be refilled with another zone while an AtcTimeZone refers to
+ * it, because the AtcZoneProcessor compares the zone_id of the `info` as well
+ * as its address. Refilling it with the same zone from a different blob
+ * requires atc_processor_init() to discard the cached transitions.
+ */
+typedef struct AtcZoneBlobView {
+  /** The zone. */
+  AtcZoneInfo info;
+
+  /** The target zone, if `info` is a link. */
+  AtcZoneInfo target;
+
+  /** The eras of the zone. */
+  AtcZoneEra eras[kAtcZoneBlobMaxEras];
+
+  /** The policy of each era. */
+  AtcZonePolicy policies[kAtcZoneBlobMaxEras];
+} AtcZoneBlobView;
+
+/**
+ * Serialize the given zone registry into the buffer `buf` of size `capacity`,
+ * and set `written` to the size of the blob. The buffer should be aligned to
+ * 4 bytes. All zones must share the same AtcZoneContext, and the target of
+ * each link must also be in the registry.
+ *
+ * Return kAtcErrGeneric if the buffer is too small, or if the registry cannot
+ * be serialized.
+ */
+int8_t atc_zone_blob_write(
+    const AtcZoneInfo * const *registry,
+    uint16_t size,
+    uint8_t *buf,
+    size_t capacity,
+    size_t *written);
+
+/**
+ * Initialize the AtcZoneBlob from the blob in the given buffer, which is used
+ * in place and must remain valid while the AtcZoneBlob is used. The buffer
+ * must be aligned to 4 bytes. All records are validated, so that the lookups
+ * do not need to check them again.
+ *
+ * Return kAtcErrGeneric if the data is not a valid blob.
+ */
+int8_t atc_zone_blob_init(AtcZoneBlob *blob, const uint8_t *data, size_t size);
+
+#if ATC_ENABLE_ZONE_BLOB_MMAP
+
+/**
+ * Map the blob file at `path` into memory, and initialize the AtcZoneBlob
+ * using atc_zone_blob_init(). The mapping must be released with
+ * atc_zone_blob_close().
+ *
+ * Return kAtcErrGeneric if the file cannot be opened or mapped, or if it is
+ * not a valid blob.
+ */
+int8_t atc_zone_blob_open(AtcZoneBlob *blob, const char *path);
+
+/** Unmap the file mapped by atc_zone_blob_open(). Does nothing otherwise. */
+void atc_zone_blob_close(AtcZoneBlob *blob);
+
+#endif
+
+/** Return the number of zones and links in the blob. */
+uint16_t atc_zone_blob_num_zones(const AtcZoneBlob *blob);
+
+/**
+ * Fill the view with the zone at `index`, in the order of the registry which
+ * was serialized. Return kAtcErrGeneric if the index is out of range.
+ */
+int8_t atc_zone_blob_get(
+    const AtcZoneBlob *blob,
+    uint16_t index,
+    AtcZoneBlobView *view);
+
+/**
+ * Fill the view with the zone 'name'. Return kAtcErrGeneric if not found.
+ */
+int8_t atc_zone_blob_find_by_name(
+    const AtcZoneBlob *blob,
+    const char *name,
+    AtcZoneBlobView *view);
+
+/**
+ * Fill the view with the zone 'id'. Return kAtcErrGeneric if not found.
+ */
+int8_t atc_zone_blob_find_by_id(
+    const AtcZoneBlob *blob,
+    uint32_t zone_id,
+    AtcZoneBlobView *view);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
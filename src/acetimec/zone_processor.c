@@ -7,8 +7,9 @@
 #include <string.h> // memcpy(), strncpy()
 #include "../zoneinfo/zone_info_utils.h"
 #include "common.h" // atc_copy_replace_string()
-#include "epoch.h" // atc_get_current_epoch_year()
+#include "epoch.h" // AtcEpochContext
 #include "local_date.h" // atc_local_date_days_in_year_month()
+#include "local_time.h" // atc_local_time_to_seconds()
 #include "date_tuple.h" // AtcDateTuple
 #include "transition.h" // AtcTransition, AtcTransitionStorage
 #include "zone_processor.h"
@@ -484,6 +485,16 @@ void atc_processor_create_transitions(
 void atc_processor_generate_start_until_times(
     AtcTransition **begin,
     AtcTransition **end)
+{
+  AtcEpochContext ctx;
+  atc_epoch_context_init_from_current(&ctx);
+  atc_processor_generate_start_until_times_ctx(&ctx, begin, end);
+}
+
+void atc_processor_generate_start_until_times_ctx(
+    const AtcEpochContext *ctx,
+    AtcTransition **begin,
+    AtcTransition **end)
 {
   AtcTransition *prev = *begin;
   bool is_after_first = false;
@@ -524,7 +535,7 @@ void atc_processor_generate_start_until_times(
     const atc_time_t offset_seconds = (atc_time_t)
         (st->seconds - (t->offset_seconds + t->delta_seconds));
     atc_time_t epoch_seconds = (atc_time_t) 86400
-        * atc_local_date_to_epoch_days(st->year, st->month, st->day);
+        * atc_local_date_to_epoch_days_ctx(ctx, st->year, st->month, st->day);
     t->start_epoch_seconds = epoch_seconds + offset_seconds;
 
     prev = t;
@@ -590,21 +601,37 @@ void atc_processor_create_abbreviation(
   }
 }
 
-void atc_processor_calc_abbreviations(
-    AtcTransition **begin,
-    AtcTransition **end)
+// Calculate the abbreviation of the transition if necessary.
+static const char *atc_processor_transition_abbrev(AtcTransition *t)
 {
-  for (AtcTransition **iter = begin; iter != end; ++iter) {
-    AtcTransition * const t = *iter;
+  if (! t->is_abbrev_valid) {
     atc_processor_create_abbreviation(
         t->abbrev,
         kAtcAbbrevSize,
         t->match->era->format,
         t->delta_seconds,
         t->letter);
+    t->is_abbrev_valid = 1;
+  }
+  return t->abbrev;
+}
+
+void atc_processor_calc_abbreviations(
+    AtcTransition **begin,
+    AtcTransition **end)
+{
+  for (AtcTransition **iter = begin; iter != end; ++iter) {
+    atc_processor_transition_abbrev(*iter);
   }
 }
 
+void atc_processor_calc_all_abbreviations(AtcZoneProcessor *processor)
+{
+  AtcTransitionStorage *ts = &processor->transition_storage;
+  atc_processor_calc_abbreviations(
+      &ts->transitions[0], &ts->transitions[ts->index_free]);
+}
+
 //---------------------------------------------------------------------------
 // Initialization of AtcZoneProcessor.
 //---------------------------------------------------------------------------
@@ -612,31 +639,225 @@ void atc_processor_calc_abbreviations(
 void atc_processor_init(AtcZoneProcessor *processor)
 {
   processor->zone_info = NULL;
+  processor->zone_id = 0;
   processor->epoch_year = kAtcInvalidYear;
   processor->year = kAtcInvalidYear;
   processor->num_matches = 0;
+  processor->fixed_offset.start_year = kAtcInvalidYear;
+}
+
+int16_t atc_processor_fixed_offset_start_year(const AtcZoneInfo *zone_info)
+{
+  uint8_t num_eras = zone_info->num_eras;
+  if (num_eras == 0) return kAtcInvalidYear;
+  const AtcZoneEra *last = &zone_info->eras[num_eras - 1];
+  if (last->zone_policy != NULL) return kAtcInvalidYear;
+  if (num_eras == 1) return kAtcMinYear;
+
+  // The previous era is skipped by atc_processor_find_matches() if it ends
+  // before the window [(year-1)-12, (year+1)-02) begins.
+  const AtcZoneEra *prev = &zone_info->eras[num_eras - 2];
+  int16_t year = prev->until_year + 1;
+  if (atc_compare_era_to_year_month(prev, year - 1, 12) > 0) year++;
+  return year;
+}
+
+bool atc_processor_is_fixed_offset_zone(const AtcZoneInfo *zone_info)
+{
+  return atc_processor_fixed_offset_start_year(zone_info) == kAtcMinYear;
+}
+
+// The transitions of an era boundary or an AtcZoneRule in the local year Y
+// can start in the UTC years [Y-1, Y+1], so the candidate years below are
+// widened by one year on each side. The arithmetic is done in int32_t, because
+// the until_year of the last era is kAtcZoneInfoMaxUntilYear.
+
+int16_t atc_processor_next_transition_year(
+    const AtcZoneInfo *zone_info,
+    int16_t year)
+{
+  int32_t best = INT32_MAX;
+  int32_t prev_until = kAtcZoneInfoMinYear;
+  for (uint8_t i = 0; i < zone_info->num_eras; i++) {
+    const AtcZoneEra *era = &zone_info->eras[i];
+    int32_t until = era->until_year;
+    bool is_last = (i + 1 == zone_info->num_eras);
+
+    // Transition at the end of this era.
+    if (! is_last && until + 1 >= year) {
+      int32_t candidate = (until - 1 > year) ? until - 1 : year;
+      if (candidate < best) best = candidate;
+    }
+
+    // Transitions of the rules which are active within this era.
+    const AtcZonePolicy *policy = era->zone_policy;
+    if (policy != NULL) {
+      for (uint8_t j = 0; j < policy->num_rules; j++) {
+        const AtcZoneRule *rule = &policy->rules[j];
+        int32_t lo = (rule->from_year > prev_until)
+            ? rule->from_year : prev_until;
+        int32_t hi = (rule->to_year < until) ? rule->to_year : until;
+        if (lo < year - 1) lo = year - 1;
+        if (lo > hi) continue;
+        int32_t candidate = (lo - 1 > year) ? lo - 1 : year;
+        if (candidate < best) best = candidate;
+      }
+    }
+    prev_until = until;
+  }
+
+  return (best == INT32_MAX) ? kAtcInvalidYear : (int16_t) best;
+}
+
+int16_t atc_processor_prev_transition_year(
+    const AtcZoneInfo *zone_info,
+    int16_t year)
+{
+  int32_t best = INT32_MIN;
+  int32_t prev_until = kAtcZoneInfoMinYear;
+  for (uint8_t i = 0; i < zone_info->num_eras; i++) {
+    const AtcZoneEra *era = &zone_info->eras[i];
+    int32_t until = era->until_year;
+    bool is_last = (i + 1 == zone_info->num_eras);
+
+    // Transition at the end of this era.
+    if (! is_last && until - 1 <= year) {
+      int32_t candidate = (until + 1 < year) ? until + 1 : year;
+      if (candidate > best) best = candidate;
+    }
+
+    // Transitions of the rules which are active within this era.
+    const AtcZonePolicy *policy = era->zone_policy;
+    if (policy != NULL) {
+      for (uint8_t j = 0; j < policy->num_rules; j++) {
+        const AtcZoneRule *rule = &policy->rules[j];
+        int32_t lo = (rule->from_year > prev_until)
+            ? rule->from_year : prev_until;
+        int32_t hi = (rule->to_year < until) ? rule->to_year : until;
+        if (hi > year + 1) hi = year + 1;
+        if (lo > hi) continue;
+        int32_t candidate = (hi + 1 < year) ? hi + 1 : year;
+        if (candidate > best) best = candidate;
+      }
+    }
+    prev_until = until;
+  }
+
+  return (best == INT32_MIN) ? kAtcInvalidYear : (int16_t) best;
+}
+
+// Fill the offsets and abbreviation of the last era, which are the same as the
+// single transition created by
+// atc_processor_create_transitions_from_simple_match().
+static void atc_processor_init_fixed_offset(
+  AtcFixedOffset *fixed,
+  const AtcZoneInfo *zone_info)
+{
+  fixed->start_year = atc_processor_fixed_offset_start_year(zone_info);
+  fixed->epoch_year = kAtcInvalidYear;
+  if (fixed->start_year == kAtcInvalidYear) return;
+
+  const AtcZoneEra *era = &zone_info->eras[zone_info->num_eras - 1];
+  fixed->std_offset_seconds = atc_zone_era_std_offset_seconds(era);
+  fixed->dst_offset_seconds = atc_zone_era_dst_offset_seconds(era);
+  atc_processor_create_abbreviation(
+      fixed->abbrev,
+      kAtcAbbrevSize,
+      era->format,
+      fixed->dst_offset_seconds,
+      "" /*letter*/);
 }
 
 void atc_processor_init_for_zone_info(
   AtcZoneProcessor *processor,
   const AtcZoneInfo *zone_info)
 {
-  if (processor->zone_info == zone_info) return;
+  if (processor->zone_info == zone_info
+      && (zone_info == NULL || processor->zone_id == zone_info->zone_id)) {
+    return;
+  }
   atc_processor_init(processor);
   processor->zone_info = zone_info;
+  if (zone_info) {
+    processor->zone_id = zone_info->zone_id;
+    atc_processor_init_fixed_offset(&processor->fixed_offset, zone_info);
+  }
+}
+
+// Return true if the UTC offset at the given epoch seconds is the constant
+// offset of the zone. The UTC years supported by the processor are
+// [max(start_year, 1), 9999], the same as atc_processor_init_for_year().
+static bool atc_processor_fixed_offset_contains_seconds(
+  AtcFixedOffset *fixed,
+  const AtcEpochContext *ctx,
+  atc_time_t epoch_seconds)
+{
+  if (fixed->start_year == kAtcInvalidYear) return false;
+  if (epoch_seconds == kAtcInvalidEpochSeconds) return false;
+
+  if (fixed->epoch_year != ctx->epoch_year) {
+    int16_t start_year = (fixed->start_year <= kAtcMinYear)
+        ? kAtcMinYear + 1
+        : fixed->start_year;
+    fixed->epoch_year = ctx->epoch_year;
+    fixed->start_epoch_seconds = (int64_t) 86400
+        * atc_local_date_to_epoch_days_ctx(ctx, start_year, 1, 1);
+    fixed->until_epoch_seconds = (int64_t) 86400
+        * atc_local_date_to_epoch_days_ctx(ctx, kAtcMaxYear, 1, 1);
+  }
+  return fixed->start_epoch_seconds <= epoch_seconds
+      && epoch_seconds < fixed->until_epoch_seconds;
+}
+
+// Return true if the UTC offset at the given local date time is the constant
+// offset of the zone.
+static bool atc_processor_fixed_offset_contains_date_time(
+  const AtcFixedOffset *fixed,
+  const AtcLocalDateTime *ldt)
+{
+  return fixed->start_year != kAtcInvalidYear
+      && ! atc_local_date_time_is_error(ldt)
+      && fixed->start_year <= ldt->year
+      && kAtcMinYear < ldt->year
+      && ldt->year < kAtcMaxYear;
+}
+
+// Fill the AtcFindResult with the constant offset of the zone.
+static void atc_processor_fill_result_for_fixed_offset(
+  const AtcFixedOffset *fixed,
+  AtcFindResult *result)
+{
+  result->type = kAtcFindResultExact;
+  result->fold = 0;
+  result->std_offset_seconds = fixed->std_offset_seconds;
+  result->dst_offset_seconds = fixed->dst_offset_seconds;
+  result->req_std_offset_seconds = fixed->std_offset_seconds;
+  result->req_dst_offset_seconds = fixed->dst_offset_seconds;
+  result->abbrev = NULL;
 }
 
 static bool atc_processor_is_valid_for_year(
-  AtcZoneProcessor *processor,
+  const AtcZoneProcessor *processor,
+  const AtcEpochContext *ctx,
   int16_t year)
 {
   return (year == processor->year)
-      && (processor->epoch_year == atc_get_current_epoch_year());
+      && (processor->epoch_year == ctx->epoch_year);
 }
 
 int8_t atc_processor_init_for_year(
   AtcZoneProcessor *processor,
   int16_t year)
+{
+  AtcEpochContext ctx;
+  atc_epoch_context_init_from_current(&ctx);
+  return atc_processor_init_for_year_ctx(processor, &ctx, year);
+}
+
+int8_t atc_processor_init_for_year_ctx(
+  AtcZoneProcessor *processor,
+  const AtcEpochContext *ctx,
+  int16_t year)
 {
   // Restrict to [1,9999], even though `local_date.h` should be able to handle
   // [0,10000].
@@ -644,10 +865,14 @@ int8_t atc_processor_init_for_year(
     return kAtcErrGeneric;
   }
 
-  if (atc_processor_is_valid_for_year(processor, year)) return kAtcErrOk;
+  if (atc_processor_is_valid_for_year(processor, ctx, year)) return kAtcErrOk;
 
-  processor->epoch_year = atc_get_current_epoch_year();
+  processor->epoch_year = ctx->epoch_year;
   processor->year = year;
+  processor->year_start_epoch_seconds = (int64_t) 86400
+      * atc_local_date_to_epoch_days_ctx(ctx, year, 1, 1);
+  processor->year_until_epoch_seconds = (int64_t) 86400
+      * atc_local_date_to_epoch_days_ctx(ctx, year + 1, 1, 1);
   processor->num_matches = 0;
   atc_transition_storage_init(
     &processor->transition_storage, processor->zone_info);
@@ -677,10 +902,13 @@ int8_t atc_processor_init_for_year(
   atc_transition_fix_times(begin, end);
 
   // Step 4: Generate start and until times.
-  atc_processor_generate_start_until_times(begin, end);
+  atc_processor_generate_start_until_times_ctx(ctx, begin, end);
 
-  // Step 5: Calc abbreviations.
-  atc_processor_calc_abbreviations(begin, end);
+  // Step 5: Abbreviations are calculated on demand by the find functions, or
+  // by atc_processor_calc_all_abbreviations().
+  for (AtcTransition **iter = begin; iter != end; ++iter) {
+    (*iter)->is_abbrev_valid = 0;
+  }
 
   return kAtcErrOk;
 }
@@ -688,11 +916,22 @@ int8_t atc_processor_init_for_year(
 int8_t atc_processor_init_for_epoch_seconds(
   AtcZoneProcessor *processor,
   atc_time_t epoch_seconds)
+{
+  AtcEpochContext ctx;
+  atc_epoch_context_init_from_current(&ctx);
+  return atc_processor_init_for_epoch_seconds_ctx(
+      processor, &ctx, epoch_seconds);
+}
+
+int8_t atc_processor_init_for_epoch_seconds_ctx(
+  AtcZoneProcessor *processor,
+  const AtcEpochContext *ctx,
+  atc_time_t epoch_seconds)
 {
   AtcLocalDateTime ldt;
-  atc_local_date_time_from_epoch_seconds(&ldt, epoch_seconds);
+  atc_local_date_time_from_epoch_seconds_ctx(ctx, &ldt, epoch_seconds);
   if (atc_local_date_time_is_error(&ldt)) return kAtcErrGeneric;
-  return atc_processor_init_for_year(processor, ldt.year);
+  return atc_processor_init_for_year_ctx(processor, ctx, ldt.year);
 }
 
 //---------------------------------------------------------------------------
@@ -705,49 +944,161 @@ void atc_processor_find_by_epoch_seconds(
     atc_time_t epoch_seconds,
     AtcFindResult *result)
 {
-  int8_t err = atc_processor_init_for_epoch_seconds(processor, epoch_seconds);
-  if (err) {
-    result->type = kAtcFindResultNotFound;
-    return;
-  }
+  AtcEpochContext ctx;
+  atc_epoch_context_init_from_current(&ctx);
+  atc_processor_find_by_epoch_seconds_ctx(
+      processor, &ctx, epoch_seconds, result);
+}
 
-  AtcTransitionForSeconds tfs = atc_transition_storage_find_for_seconds(
-      &processor->transition_storage, epoch_seconds);
-  const AtcTransition *t = tfs.curr;
+void atc_processor_find_offsets_by_epoch_seconds(
+    AtcZoneProcessor *processor,
+    atc_time_t epoch_seconds,
+    AtcFindResult *result)
+{
+  AtcEpochContext ctx;
+  atc_epoch_context_init_from_current(&ctx);
+  atc_processor_find_offsets_by_epoch_seconds_ctx(
+      processor, &ctx, epoch_seconds, result);
+}
+
+// Convert the AtcTransitionForSeconds into the AtcFindResult, except for the
+// abbreviation. Return the target transition, or NULL if not found.
+static const AtcTransition *atc_processor_fill_result_for_seconds(
+    const AtcTransitionForSeconds *tfs,
+    AtcFindResult *result)
+{
+  const AtcTransition *t = tfs->curr;
+  result->abbrev = NULL;
   if (! t) {
     result->type = kAtcFindResultNotFound;
-    return;
+    return NULL;
   }
 
   result->std_offset_seconds = t->offset_seconds;
   result->dst_offset_seconds = t->delta_seconds;
   result->req_std_offset_seconds = t->offset_seconds;
   result->req_dst_offset_seconds = t->delta_seconds;
-  result->abbrev = t->abbrev;
-  result->fold = tfs.fold;
-  if (tfs.num == 2) {
+  result->fold = tfs->fold;
+  if (tfs->num == 2) {
     result->type = kAtcFindResultOverlap;
   } else {
     result->type = kAtcFindResultExact;
   }
+  return t;
 }
 
-// Adapted from ExtendedZoneProcessor::findByLocalDateTime() in the AceTime
-// library.
-void atc_processor_find_by_local_date_time(
+// Same as atc_processor_find_offsets_by_epoch_seconds_ctx(), returning the
+// target transition, or NULL if not found.
+static const AtcTransition *atc_processor_find_transition_by_epoch_seconds(
     AtcZoneProcessor *processor,
-    const AtcLocalDateTime *ldt,
+    const AtcEpochContext *ctx,
+    atc_time_t epoch_seconds,
     AtcFindResult *result)
 {
+  // Skip the calculation of the UTC year of epoch_seconds if it falls within
+  // the cached year.
+  bool is_cached = processor->year != kAtcInvalidYear
+      && processor->epoch_year == ctx->epoch_year
+      && epoch_seconds != kAtcInvalidEpochSeconds
+      && processor->year_start_epoch_seconds <= epoch_seconds
+      && epoch_seconds < processor->year_until_epoch_seconds;
+  if (! is_cached) {
+    int8_t err = atc_processor_init_for_epoch_seconds_ctx(
+        processor, ctx, epoch_seconds);
+    if (err) {
+      result->type = kAtcFindResultNotFound;
+      result->abbrev = NULL;
+      return NULL;
+    }
+  }
 
-  int8_t err = atc_processor_init_for_year(processor, ldt->year);
-  if (err) {
-    result->type = kAtcFindResultNotFound;
+  AtcTransitionForSeconds tfs = atc_transition_storage_find_for_seconds_memo(
+      &processor->transition_storage, epoch_seconds);
+  return atc_processor_fill_result_for_seconds(&tfs, result);
+}
+
+void atc_processor_find_by_epoch_seconds_ctx(
+    AtcZoneProcessor *processor,
+    const AtcEpochContext *ctx,
+    atc_time_t epoch_seconds,
+    AtcFindResult *result)
+{
+  AtcFixedOffset *fixed = &processor->fixed_offset;
+  if (atc_processor_fixed_offset_contains_seconds(fixed, ctx, epoch_seconds)) {
+    atc_processor_fill_result_for_fixed_offset(fixed, result);
+    result->abbrev = fixed->abbrev;
+    return;
+  }
+
+  const AtcTransition *t = atc_processor_find_transition_by_epoch_seconds(
+      processor, ctx, epoch_seconds, result);
+  if (t) {
+    // The transition is owned by the (non-const) processor.
+    result->abbrev = atc_processor_transition_abbrev((AtcTransition *) t);
+  }
+}
+
+void atc_processor_find_offsets_by_epoch_seconds_ctx(
+    AtcZoneProcessor *processor,
+    const AtcEpochContext *ctx,
+    atc_time_t epoch_seconds,
+    AtcFindResult *result)
+{
+  AtcFixedOffset *fixed = &processor->fixed_offset;
+  if (atc_processor_fixed_offset_contains_seconds(fixed, ctx, epoch_seconds)) {
+    atc_processor_fill_result_for_fixed_offset(fixed, result);
     return;
   }
 
+  atc_processor_find_transition_by_epoch_seconds(
+      processor, ctx, epoch_seconds, result);
+}
+
+void atc_processor_lookup_by_epoch_seconds(
+    const AtcZoneProcessor *processor,
+    atc_time_t epoch_seconds,
+    AtcFindResult *result)
+{
+  AtcTransitionForSeconds tfs = atc_transition_storage_find_for_seconds(
+      &processor->transition_storage, epoch_seconds);
+  const AtcTransition *t = atc_processor_fill_result_for_seconds(&tfs, result);
+  if (t) {
+    result->abbrev = t->is_abbrev_valid ? t->abbrev : "";
+  }
+}
+
+void atc_processor_find_by_local_date_time(
+    AtcZoneProcessor *processor,
+    const AtcLocalDateTime *ldt,
+    AtcFindResult *result)
+{
+  AtcEpochContext ctx;
+  atc_epoch_context_init_from_current(&ctx);
+  atc_processor_find_by_local_date_time_ctx(processor, &ctx, ldt, result);
+}
+
+void atc_processor_find_offsets_by_local_date_time(
+    AtcZoneProcessor *processor,
+    const AtcLocalDateTime *ldt,
+    AtcFindResult *result)
+{
+  AtcEpochContext ctx;
+  atc_epoch_context_init_from_current(&ctx);
+  atc_processor_find_offsets_by_local_date_time_ctx(
+      processor, &ctx, ldt, result);
+}
+
+// Adapted from ExtendedZoneProcessor::findByLocalDateTime() in the AceTime
+// library. Fill the AtcFindResult, except for the abbreviation. Return the
+// target transition, or NULL if not found.
+static const AtcTransition *atc_processor_fill_result_for_date_time(
+    const AtcTransitionStorage *ts,
+    const AtcLocalDateTime *ldt,
+    AtcFindResult *result)
+{
   AtcTransitionForDateTime tfd = atc_transition_storage_find_for_date_time(
-      &processor->transition_storage, ldt);
+      ts, ldt);
+  result->abbrev = NULL;
 
     // Extract the target Transition, depending on the requested fold
     // and the tfd.num.
@@ -797,10 +1148,240 @@ void atc_processor_find_by_local_date_time(
 
     if (! transition) {
       result->type = kAtcFindResultNotFound;
-      return;
+      return NULL;
     }
 
     result->std_offset_seconds = transition->offset_seconds;
     result->dst_offset_seconds = transition->delta_seconds;
-    result->abbrev = transition->abbrev;
+    return transition;
+}
+
+void atc_processor_find_by_local_date_time_ctx(
+    AtcZoneProcessor *processor,
+    const AtcEpochContext *ctx,
+    const AtcLocalDateTime *ldt,
+    AtcFindResult *result)
+{
+  const AtcFixedOffset *fixed = &processor->fixed_offset;
+  if (atc_processor_fixed_offset_contains_date_time(fixed, ldt)) {
+    atc_processor_fill_result_for_fixed_offset(fixed, result);
+    result->abbrev = fixed->abbrev;
+    return;
+  }
+
+  int8_t err = atc_processor_init_for_year_ctx(processor, ctx, ldt->year);
+  if (err) {
+    result->type = kAtcFindResultNotFound;
+    result->abbrev = NULL;
+    return;
+  }
+  const AtcTransition *t = atc_processor_fill_result_for_date_time(
+      &processor->transition_storage, ldt, result);
+  if (t) {
+    // The transition is owned by the (non-const) processor.
+    result->abbrev = atc_processor_transition_abbrev((AtcTransition *) t);
+  }
+}
+
+void atc_processor_find_offsets_by_local_date_time_ctx(
+    AtcZoneProcessor *processor,
+    const AtcEpochContext *ctx,
+    const AtcLocalDateTime *ldt,
+    AtcFindResult *result)
+{
+  const AtcFixedOffset *fixed = &processor->fixed_offset;
+  if (atc_processor_fixed_offset_contains_date_time(fixed, ldt)) {
+    atc_processor_fill_result_for_fixed_offset(fixed, result);
+    return;
+  }
+
+  int8_t err = atc_processor_init_for_year_ctx(processor, ctx, ldt->year);
+  if (err) {
+    result->type = kAtcFindResultNotFound;
+    result->abbrev = NULL;
+    return;
+  }
+  atc_processor_fill_result_for_date_time(
+      &processor->transition_storage, ldt, result);
+}
+
+void atc_processor_lookup_by_local_date_time(
+    const AtcZoneProcessor *processor,
+    const AtcLocalDateTime *ldt,
+    AtcFindResult *result)
+{
+  const AtcTransition *t = atc_processor_fill_result_for_date_time(
+      &processor->transition_storage, ldt, result);
+  if (t) {
+    result->abbrev = t->is_abbrev_valid ? t->abbrev : "";
+  }
+}
+
+//---------------------------------------------------------------------------
+// Batch resolution of an array of AtcLocalDateTime.
+//---------------------------------------------------------------------------
+
+// Return an integer which sorts in the same order as atc_date_tuple_compare().
+// The AtcDateTuple of a transition is not always normalized (the seconds can
+// be negative, or equal to 24:00), so the fields are packed instead of being
+// converted to seconds since an epoch. The seconds are assumed to be within
+// +/- 2^19 (about 6 days).
+static int64_t atc_processor_date_tuple_key(
+    int16_t year,
+    uint8_t month,
+    uint8_t day,
+    int32_t seconds)
+{
+  return ((((int64_t) year * 16 + month) * 32 + day) * ((int64_t) 1 << 20))
+      + seconds;
+}
+
+// The integer keys of the start and until times of the active transitions, and
+// the epoch days of the first day of each month of the year.
+typedef struct AtcTransitionKeys {
+  int16_t year;
+  uint8_t num;
+  int64_t start[kAtcTransitionStorageSize];
+  int64_t until[kAtcTransitionStorageSize];
+  int32_t month_epoch_days[12];
+} AtcTransitionKeys;
+
+static void atc_transition_keys_init(
+    AtcTransitionKeys *keys,
+    const AtcEpochContext *ctx,
+    const AtcTransitionStorage *ts,
+    int16_t year)
+{
+  keys->year = year;
+  int32_t days = atc_local_date_to_epoch_days_ctx(ctx, year, 1, 1);
+  for (uint8_t month = 1; month <= 12; month++) {
+    keys->month_epoch_days[month - 1] = days;
+    days += atc_local_date_days_in_year_month(year, month);
+  }
+  keys->num = ts->index_free;
+  for (uint8_t i = 0; i < ts->index_free; i++) {
+    const AtcDateTuple *s = &ts->transitions[i]->start_dt;
+    const AtcDateTuple *u = &ts->transitions[i]->until_dt;
+    keys->start[i] = atc_processor_date_tuple_key(
+        s->year, s->month, s->day, s->seconds);
+    keys->until[i] = atc_processor_date_tuple_key(
+        u->year, u->month, u->day, u->seconds);
+  }
+}
+
+// Same as atc_processor_lookup_by_local_date_time(), using the integer keys
+// of the transitions.
+static void atc_processor_resolve_one(
+    const AtcTransitionStorage *ts,
+    const AtcTransitionKeys *keys,
+    const AtcLocalDateTime *ldt,
+    AtcLocalResolution *resolution)
+{
+  int32_t seconds = atc_local_time_to_seconds(
+      ldt->hour, ldt->minute, ldt->second);
+  int64_t key = atc_processor_date_tuple_key(
+      ldt->year, ldt->month, ldt->day, seconds);
+
+  // Same loop as atc_transition_storage_find_for_date_time().
+  int8_t iprev = -1;
+  int8_t icurr = -1;
+  uint8_t num = 0;
+  for (uint8_t i = 0; i < keys->num; i++) {
+    icurr = (int8_t) i;
+    if (keys->start[i] <= key && key < keys->until[i]) {
+      if (num == 1) {
+        num++;
+        break;
+      }
+      num = 1;
+    } else if (keys->start[i] > key) {
+      break;
+    }
+    iprev = icurr;
+    icurr = -1;
+  }
+  if (num == 1) icurr = iprev;
+
+  const AtcTransition *prev = (iprev >= 0) ? ts->transitions[iprev] : NULL;
+  const AtcTransition *curr = (icurr >= 0) ? ts->transitions[icurr] : NULL;
+  const AtcTransition *req;
+  const AtcTransition *target;
+  if (num == 1) {
+    req = target = curr;
+    resolution->type = kAtcFindResultExact;
+    resolution->fold = 0;
+  } else if (prev == NULL || curr == NULL) {
+    resolution->type = kAtcFindResultNotFound;
+    resolution->epoch_seconds = kAtcInvalidEpochSeconds;
+    return;
+  } else if (num == 0) {
+    // Gap, see atc_processor_lookup_by_local_date_time().
+    resolution->type = kAtcFindResultGap;
+    resolution->fold = 0;
+    req = (ldt->fold == 0) ? prev : curr;
+    target = (ldt->fold == 0) ? curr : prev;
+  } else {
+    // Overlap
+    req = target = (ldt->fold == 0) ? prev : curr;
+    resolution->type = kAtcFindResultOverlap;
+    resolution->fold = ldt->fold;
+  }
+
+  resolution->std_offset_seconds = target->offset_seconds;
+  resolution->dst_offset_seconds = target->delta_seconds;
+  resolution->req_std_offset_seconds = req->offset_seconds;
+  resolution->req_dst_offset_seconds = req->delta_seconds;
+  int32_t days = keys->month_epoch_days[ldt->month - 1] + ldt->day - 1;
+  resolution->epoch_seconds = (atc_time_t) 86400 * days + seconds
+      - (req->offset_seconds + req->delta_seconds);
+}
+
+void atc_processor_resolve_local_date_times(
+    AtcZoneProcessor *processor,
+    const AtcLocalDateTime *ldts,
+    size_t n,
+    AtcLocalResolution *resolutions)
+{
+  AtcEpochContext ctx;
+  atc_epoch_context_init_from_current(&ctx);
+  atc_processor_resolve_local_date_times_ctx(
+      processor, &ctx, ldts, n, resolutions);
+}
+
+void atc_processor_resolve_local_date_times_ctx(
+    AtcZoneProcessor *processor,
+    const AtcEpochContext *ctx,
+    const AtcLocalDateTime *ldts,
+    size_t n,
+    AtcLocalResolution *resolutions)
+{
+  AtcTransitionKeys keys;
+  keys.year = kAtcInvalidYear;
+  keys.num = 0;
+
+  for (size_t i = 0; i < n; i++) {
+    const AtcLocalDateTime *ldt = &ldts[i];
+    AtcLocalResolution *resolution = &resolutions[i];
+    if (atc_local_date_time_is_error(ldt)
+        || ldt->month < 1 || ldt->month > 12) {
+      resolution->type = kAtcFindResultNotFound;
+      resolution->epoch_seconds = kAtcInvalidEpochSeconds;
+      continue;
+    }
+
+    if (ldt->year != keys.year) {
+      int8_t err = atc_processor_init_for_year_ctx(processor, ctx, ldt->year);
+      if (err) {
+        keys.year = kAtcInvalidYear;
+        resolution->type = kAtcFindResultNotFound;
+        resolution->epoch_seconds = kAtcInvalidEpochSeconds;
+        continue;
+      }
+      atc_transition_keys_init(
+          &keys, ctx, &processor->transition_storage, ldt->year);
+    }
+
+    atc_processor_resolve_one(
+        &processor->transition_storage, &keys, ldt, resolution);
+  }
 }
@@ -16,7 +16,9 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h> // size_t
 #include "common.h" // atc_time_t
+#include "epoch.h" // AtcEpochContext
 #include "../zoneinfo/zone_info.h"
 #include "local_date_time.h" // AtcLocalDateTime
 #include "date_tuple.h" // AtcDateTuple
@@ -103,6 +105,38 @@ uint8_t atc_processor_calc_interior_years(
 // matching Transitions at a gien epoch_seconds or LocalDatetime.
 //---------------------------------------------------------------------------
 
+/**
+ * The constant UTC offset of a zone whose last AtcZoneEra has no
+ * AtcZonePolicy. The AtcZoneProcessor uses it to answer queries on or after
+ * `start_year` without calculating the transitions of the year.
+ */
+typedef struct AtcFixedOffset {
+  /**
+   * First year of the constant UTC offset, kAtcMinYear if the offset is
+   * constant in all years, or kAtcInvalidYear if the zone has no constant
+   * offset.
+   */
+  int16_t start_year;
+
+  /** Epoch year used to calculate the epoch seconds below. */
+  int16_t epoch_year;
+
+  /** Epoch seconds of the start of `start_year`, in 64-bits like `year`. */
+  int64_t start_epoch_seconds;
+
+  /** Epoch seconds of the end of the last year supported by the processor. */
+  int64_t until_epoch_seconds;
+
+  /** STD offset of the last era. */
+  int32_t std_offset_seconds;
+
+  /** DST offset of the last era. */
+  int32_t dst_offset_seconds;
+
+  /** Abbreviation of the last era. */
+  char abbrev[kAtcAbbrevSize];
+} AtcFixedOffset;
+
 /**
  * Zone processor work space. One of these should be created for each active
  * timezone. It can be reused among multiple timezones but a change of timezone
@@ -112,6 +146,13 @@ typedef struct AtcZoneProcessor {
   /** The time zone attached to this Processor workspace. */
   const AtcZoneInfo *zone_info;
 
+  /**
+   * The zone_id of zone_info when it was attached. An AtcZoneInfo which is
+   * refilled in place (e.g. an AtcZoneBlobView) keeps its address, so the id
+   * is compared as well to detect a change of timezone.
+   */
+  uint32_t zone_id;
+
   /**
    * Epoch year used to generate the internal cache. The
    * atc_processor_init_for_year() function invalidates and regenerates the
@@ -122,6 +163,13 @@ typedef struct AtcZoneProcessor {
   /** Cached year, [0,9999] or kAtcInvalidYear to indicate invalid cache. */
   int16_t year;
 
+  /**
+   * The epoch seconds of the start and end of the cached UTC year, in 64-bits
+   * because a year near the limits of [0,9999] can overflow an atc_time_t.
+   */
+  int64_t year_start_epoch_seconds;
+  int64_t year_until_epoch_seconds;
+
   /** Number of valid matches in the array. */
   uint8_t num_matches;
 
@@ -130,6 +178,9 @@ typedef struct AtcZoneProcessor {
 
   /** Pool of transitions relevant for the current zone and year */
   AtcTransitionStorage transition_storage;
+
+  /** Constant UTC offset of the zone, set by init_for_zone_info(). */
+  AtcFixedOffset fixed_offset;
 } AtcZoneProcessor;
 
 /**
@@ -231,6 +282,48 @@ void atc_processor_init_for_zone_info(
   AtcZoneProcessor *processor,
   const AtcZoneInfo *zone_info);
 
+/**
+ * Return the first year from which the UTC offset of the given zone is
+ * constant, because its last AtcZoneEra has no AtcZonePolicy and no other era
+ * overlaps the transitions of the year. Returns kAtcMinYear if the offset is
+ * constant in all years, or kAtcInvalidYear if the zone has no constant
+ * offset.
+ *
+ * The find_by_xxx() functions of an AtcZoneProcessor return the constant
+ * offset of these years directly, without calculating the transitions of the
+ * year.
+ */
+int16_t atc_processor_fixed_offset_start_year(const AtcZoneInfo *zone_info);
+
+/**
+ * Return true if the given zone has the same UTC offset in all years, for
+ * example "Etc/GMT+5".
+ */
+bool atc_processor_is_fixed_offset_zone(const AtcZoneInfo *zone_info);
+
+/**
+ * Return the smallest year >= `year` whose transitions, calculated by
+ * atc_processor_init_for_year(), may contain a transition which starts in that
+ * UTC year. All years in between are known to contain no transitions, because
+ * they are not the boundary of an AtcZoneEra, and no AtcZoneRule of the era
+ * is active. The result is conservative: the returned year may turn out to
+ * have no transitions. Returns kAtcInvalidYear if there are no transitions
+ * after `year`.
+ */
+int16_t atc_processor_next_transition_year(
+    const AtcZoneInfo *zone_info,
+    int16_t year);
+
+/**
+ * Return the largest year <= `year` which may contain a transition which
+ * starts in that UTC year, using the same rules as
+ * atc_processor_next_transition_year(). Returns kAtcInvalidYear if there are
+ * no transitions before `year`.
+ */
+int16_t atc_processor_prev_transition_year(
+    const AtcZoneInfo *zone_info,
+    int16_t year);
+
 /**
  * Initialize AtcZoneProcessor for the given year. An internal cache for the
  * given year prevents unnecessary computation if this function is called
@@ -278,6 +371,193 @@ void atc_processor_find_by_local_date_time(
     const AtcLocalDateTime *ldt,
     AtcFindResult *result);
 
+/**
+ * Same as atc_processor_find_by_epoch_seconds(), but only the offsets and the
+ * fold are returned, and `result.abbrev` is set to NULL. The abbreviation of
+ * the transition is not calculated, which saves time for callers which only
+ * need the UTC offset.
+ */
+void atc_processor_find_offsets_by_epoch_seconds(
+    AtcZoneProcessor *processor,
+    atc_time_t epoch_seconds,
+    AtcFindResult *result);
+
+/**
+ * Same as atc_processor_find_by_local_date_time(), but only the offsets and
+ * the fold are returned, and `result.abbrev` is set to NULL.
+ */
+void atc_processor_find_offsets_by_local_date_time(
+    AtcZoneProcessor *processor,
+    const AtcLocalDateTime *ldt,
+    AtcFindResult *result);
+
+/**
+ * Calculate the abbreviations of all the transitions of the current year.
+ * Normally the abbreviation of a transition is calculated on demand the first
+ * time that it is returned by one of the find functions, but the lookup
+ * functions below cannot modify the AtcZoneProcessor, so this must be called
+ * after atc_processor_init_for_year() if the lookup functions need to return
+ * the abbreviation.
+ */
+void atc_processor_calc_all_abbreviations(AtcZoneProcessor *processor);
+
+/**
+ * Same as atc_processor_find_by_epoch_seconds(), but using only the
+ * transitions calculated by a previous call to atc_processor_init_for_year().
+ * The AtcZoneProcessor is never modified, so the caller is responsible for
+ * verifying that `processor.year` and `processor.epoch_year` are correct for
+ * the given epoch_seconds.
+ */
+void atc_processor_lookup_by_epoch_seconds(
+    const AtcZoneProcessor *processor,
+    atc_time_t epoch_seconds,
+    AtcFindResult *result);
+
+/**
+ * Same as atc_processor_find_by_local_date_time(), but using only the
+ * transitions calculated by a previous call to atc_processor_init_for_year().
+ * The AtcZoneProcessor is never modified, so the caller is responsible for
+ * verifying that `processor.year` is equal to `ldt.year`.
+ *
+ * For both lookup functions, `result.abbrev` is an empty string unless
+ * atc_processor_calc_all_abbreviations() was called.
+ */
+void atc_processor_lookup_by_local_date_time(
+    const AtcZoneProcessor *processor,
+    const AtcLocalDateTime *ldt,
+    AtcFindResult *result);
+
+//---------------------------------------------------------------------------
+// Variants of the above which use the epoch of an explicit AtcEpochContext
+// instead of the current global epoch year. The internal cache of the
+// AtcZoneProcessor is regenerated if the epoch year of the AtcEpochContext is
+// different from the one used to generate it. An AtcZoneProcessor which is
+// used only through these functions never reads the global epoch.
+//---------------------------------------------------------------------------
+
+/** Same as atc_processor_init_for_year() using the given AtcEpochContext. */
+int8_t atc_processor_init_for_year_ctx(
+  AtcZoneProcessor *processor,
+  const AtcEpochContext *ctx,
+  int16_t year);
+
+/**
+ * Same as atc_processor_init_for_epoch_seconds() using the given
+ * AtcEpochContext.
+ */
+int8_t atc_processor_init_for_epoch_seconds_ctx(
+  AtcZoneProcessor *processor,
+  const AtcEpochContext *ctx,
+  atc_time_t epoch_seconds);
+
+/**
+ * Same as atc_processor_find_by_epoch_seconds() using the given
+ * AtcEpochContext.
+ */
+void atc_processor_find_by_epoch_seconds_ctx(
+    AtcZoneProcessor *processor,
+    const AtcEpochContext *ctx,
+    atc_time_t epoch_seconds,
+    AtcFindResult *result);
+
+/**
+ * Same as atc_processor_find_by_local_date_time() using the given
+ * AtcEpochContext.
+ */
+void atc_processor_find_by_local_date_time_ctx(
+    AtcZoneProcessor *processor,
+    const AtcEpochContext *ctx,
+    const AtcLocalDateTime *ldt,
+    AtcFindResult *result);
+
+/**
+ * Same as atc_processor_find_offsets_by_epoch_seconds() using the given
+ * AtcEpochContext.
+ */
+void atc_processor_find_offsets_by_epoch_seconds_ctx(
+    AtcZoneProcessor *processor,
+    const AtcEpochContext *ctx,
+    atc_time_t epoch_seconds,
+    AtcFindResult *result);
+
+/**
+ * Same as atc_processor_find_offsets_by_local_date_time() using the given
+ * AtcEpochContext.
+ */
+void atc_processor_find_offsets_by_local_date_time_ctx(
+    AtcZoneProcessor *processor,
+    const AtcEpochContext *ctx,
+    const AtcLocalDateTime *ldt,
+    AtcFindResult *result);
+
+//---------------------------------------------------------------------------
+// Batch resolution of an array of AtcLocalDateTime.
+//---------------------------------------------------------------------------
+
+/**
+ * The resolution of a single AtcLocalDateTime by
+ * atc_processor_resolve_local_date_times(). It contains the same offsets as
+ * AtcFindResult, without the abbreviation which would not survive the
+ * regeneration of the transitions for a different year, plus the epoch seconds
+ * of the AtcLocalDateTime.
+ */
+typedef struct AtcLocalResolution {
+  /**
+   * The epoch seconds of the AtcLocalDateTime using the requested offsets,
+   * which is the same value as the AtcOffsetDateTime returned by
+   * atc_time_zone_offset_date_time_from_local_date_time(). Set to
+   * kAtcInvalidEpochSeconds if `type` is kAtcFindResultNotFound.
+   */
+  atc_time_t epoch_seconds;
+
+  /** The STD offset of the target OffsetDateTime. */
+  int32_t std_offset_seconds;
+
+  /** The DST offset of the target OffsetDateTime. */
+  int32_t dst_offset_seconds;
+
+  /** The STD offset of the requested LocalDateTime. */
+  int32_t req_std_offset_seconds;
+
+  /** The DST offset of the requested LocalDateTime. */
+  int32_t req_dst_offset_seconds;
+
+  /** One of the kAtcFindResultXxx enums. */
+  uint8_t type;
+
+  /** The fold of the resulting OffsetDateTime. */
+  uint8_t fold;
+} AtcLocalResolution;
+
+/**
+ * Resolve an array of `n` AtcLocalDateTime into `resolutions`, classifying
+ * each element as exact, gap, overlap or not found. Each element produces the
+ * same offsets, type and fold as atc_processor_find_by_local_date_time().
+ *
+ * The start and until times of the transitions are converted into integer keys
+ * once per year, so each element is resolved using integer comparisons instead
+ * of atc_date_tuple_compare(). Input which is grouped by year avoids
+ * regenerating the transitions.
+ *
+ * The atc_processor_init_for_zone_info() must have been called before this.
+ */
+void atc_processor_resolve_local_date_times(
+    AtcZoneProcessor *processor,
+    const AtcLocalDateTime *ldts,
+    size_t n,
+    AtcLocalResolution *resolutions);
+
+/**
+ * Same as atc_processor_resolve_local_date_times() using the given
+ * AtcEpochContext.
+ */
+void atc_processor_resolve_local_date_times_ctx(
+    AtcZoneProcessor *processor,
+    const AtcEpochContext *ctx,
+    const AtcLocalDateTime *ldts,
+    size_t n,
+    AtcLocalResolution *resolutions);
+
 //---------------------------------------------------------------------------
 // Functions and data structures related to the creation of the active
 // Transitions of the given time zone at the given year.
@@ -381,7 +661,19 @@ void atc_processor_generate_start_until_times(
     AtcTransition **begin,
     AtcTransition **end);
 
-/** Compute the time zone abbreviation of the specified transitions. */
+/**
+ * Same as atc_processor_generate_start_until_times() using the epoch of the
+ * given AtcEpochContext.
+ */
+void atc_processor_generate_start_until_times_ctx(
+    const AtcEpochContext *ctx,
+    AtcTransition **begin,
+    AtcTransition **end);
+
+/**
+ * Compute the time zone abbreviation of the specified transitions, if not
+ * already calculated.
+ */
 void atc_processor_calc_abbreviations(
     AtcTransition **begin,
     AtcTransition **end);
@@ -0,0 +1,129 @@
+/*
+ * MIT License
+ * Copyright (c) 2024 Brian T. Park
+ */
+
+#include "common.h" // kAtcMinYear, kAtcMaxYear
+#include "epoch.h" // atc_get_current_epoch_year()
+#include "local_date_time.h" // atc_local_date_time_from_epoch_seconds()
+#include "zone_processor.h"
+#include "zone_processor_cache.h"
+
+void atc_processor_cache_init(
+    AtcZoneProcessorCache *cache,
+    AtcZoneProcessor *processors,
+    uint8_t size)
+{
+  if (size == 0) size = 1;
+  if (size > kAtcZoneProcessorCacheMaxSize) {
+    size = kAtcZoneProcessorCacheMaxSize;
+  }
+
+  cache->zone_info = NULL;
+  cache->zone_id = 0;
+  cache->processors = processors;
+  cache->size = size;
+  for (uint8_t i = 0; i < size; i++) {
+    atc_processor_init(&processors[i]);
+    cache->lru[i] = i;
+  }
+  atc_processor_cache_reset_stats(cache);
+}
+
+void atc_processor_cache_init_for_zone_info(
+    AtcZoneProcessorCache *cache,
+    const AtcZoneInfo *zone_info)
+{
+  // Same check as atc_processor_init_for_zone_info().
+  uint32_t zone_id = (zone_info == NULL) ? 0 : zone_info->zone_id;
+  if (cache->zone_info == zone_info && cache->zone_id == zone_id) return;
+  cache->zone_info = zone_info;
+  cache->zone_id = zone_id;
+  for (uint8_t i = 0; i < cache->size; i++) {
+    atc_processor_init(&cache->processors[i]);
+    atc_processor_init_for_zone_info(&cache->processors[i], zone_info);
+  }
+}
+
+void atc_processor_cache_reset_stats(AtcZoneProcessorCache *cache)
+{
+  cache->num_hits = 0;
+  cache->num_misses = 0;
+}
+
+// Move the element at lru[pos] to the front of the lru list.
+static void atc_processor_cache_touch(
+    AtcZoneProcessorCache *cache,
+    uint8_t pos)
+{
+  uint8_t slot = cache->lru[pos];
+  for (; pos > 0; pos--) {
+    cache->lru[pos] = cache->lru[pos - 1];
+  }
+  cache->lru[0] = slot;
+}
+
+AtcZoneProcessor *atc_processor_cache_get_for_year(
+    AtcZoneProcessorCache *cache,
+    int16_t year)
+{
+  // Same range restriction as atc_processor_init_for_year().
+  if (year <= kAtcMinYear || kAtcMaxYear <= year) return NULL;
+
+  int16_t epoch_year = atc_get_current_epoch_year();
+  for (uint8_t pos = 0; pos < cache->size; pos++) {
+    AtcZoneProcessor *processor = &cache->processors[cache->lru[pos]];
+    if (processor->year == year && processor->epoch_year == epoch_year) {
+      cache->num_hits++;
+      atc_processor_cache_touch(cache, pos);
+      return processor;
+    }
+  }
+
+  // Evict the least recently used slot.
+  uint8_t pos = cache->size - 1;
+  AtcZoneProcessor *processor = &cache->processors[cache->lru[pos]];
+  int8_t err = atc_processor_init_for_year(processor, year);
+  if (err) return NULL;
+
+  cache->num_misses++;
+  atc_processor_cache_touch(cache, pos);
+  return processor;
+}
+
+void atc_processor_cache_find_by_epoch_seconds(
+    AtcZoneProcessorCache *cache,
+    atc_time_t epoch_seconds,
+    AtcFindResult *result)
+{
+  // Select the slot using the same UTC year that
+  // atc_processor_init_for_epoch_seconds() would use.
+  AtcLocalDateTime ldt;
+  atc_local_date_time_from_epoch_seconds(&ldt, epoch_seconds);
+  if (atc_local_date_time_is_error(&ldt)) {
+    result->type = kAtcFindResultNotFound;
+    return;
+  }
+
+  AtcZoneProcessor *processor = atc_processor_cache_get_for_year(
+      cache, ldt.year);
+  if (! processor) {
+    result->type = kAtcFindResultNotFound;
+    return;
+  }
+  atc_processor_find_by_epoch_seconds(processor, epoch_seconds, result);
+}
+
+void atc_processor_cache_find_by_local_date_time(
+    AtcZoneProcessorCache *cache,
+    const AtcLocalDateTime *ldt,
+    AtcFindResult *result)
+{
+  AtcZoneProcessor *processor = atc_processor_cache_get_for_year(
+      cache, ldt->year);
+  if (! processor) {
+    result->type = kAtcFindResultNotFound;
+    return;
+  }
+  atc_processor_find_by_local_date_time(processor, ldt, result);
+}
@@ -0,0 +1,122 @@
+/*
+ * MIT License
+ * Copyright (c) 2024 Brian T. Park
+ */
+
+/**
+ * @file zone_processor_cache.h
+ *
+ * A cache of multiple AtcZoneProcessor workspaces for a single time zone, each
+ * holding the transitions of a different year. A single AtcZoneProcessor keeps
+ * the transitions for only one year, so a sequence of requests which alternate
+ * between 2 or more years (e.g. timestamps straddling Dec 31 and Jan 1) will
+ * cause the transitions to be recalculated on almost every request. The
+ * AtcZoneProcessorCache keeps the N most recently used years, and evicts the
+ * least recently used year when a new year is requested.
+ */
+
+#ifndef ACE_TIME_C_ZONE_PROCESSOR_CACHE_H
+#define ACE_TIME_C_ZONE_PROCESSOR_CACHE_H
+
+#include <stdint.h>
+#include "common.h" // atc_time_t
+#include "../zoneinfo/zone_info.h"
+#include "local_date_time.h" // AtcLocalDateTime
+#include "zone_processor.h" // AtcZoneProcessor, AtcFindResult
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+  /** Maximum number of AtcZoneProcessor slots in an AtcZoneProcessorCache. */
+  kAtcZoneProcessorCacheMaxSize = 8,
+};
+
+/**
+ * A cache of AtcZoneProcessor objects for a single time zone, one for each
+ * recently used year. The array of AtcZoneProcessor objects is allocated by the
+ * caller and given to atc_processor_cache_init().
+ */
+typedef struct AtcZoneProcessorCache {
+  /** The time zone attached to every AtcZoneProcessor in the cache. */
+  const AtcZoneInfo *zone_info;
+
+  /** The zone_id of zone_info when it was attached. */
+  uint32_t zone_id;
+
+  /** Array of AtcZoneProcessor slots, allocated by the caller. */
+  AtcZoneProcessor *processors;
+
+  /** Number of slots in `processors`, [1,kAtcZoneProcessorCacheMaxSize]. */
+  uint8_t size;
+
+  /**
+   * Indexes into `processors` in most recently used order. The lru[0] is the
+   * most recently used slot, and lru[size-1] is the next slot to be evicted.
+   */
+  uint8_t lru[kAtcZoneProcessorCacheMaxSize];
+
+  /** Number of requests which found their year in the cache. */
+  uint32_t num_hits;
+
+  /** Number of requests which required a slot to be (re)calculated. */
+  uint32_t num_misses;
+} AtcZoneProcessorCache;
+
+/**
+ * Initialize the AtcZoneProcessorCache with an array of `size`
+ * AtcZoneProcessor objects. The `size` is clamped to the range
+ * [1,kAtcZoneProcessorCacheMaxSize]. This needs to be called only once for
+ * each instance of AtcZoneProcessorCache.
+ */
+void atc_processor_cache_init(
+    AtcZoneProcessorCache *cache,
+    AtcZoneProcessor *processors,
+    uint8_t size);
+
+/**
+ * Bind the AtcZoneProcessorCache to the given zone_info. If the zone_info is
+ * different from the previous one, all slots are invalidated.
+ */
+void atc_processor_cache_init_for_zone_info(
+    AtcZoneProcessorCache *cache,
+    const AtcZoneInfo *zone_info);
+
+/**
+ * Return the AtcZoneProcessor containing the transitions of the given year,
+ * recalculating the least recently used slot if the year is not in the cache.
+ * Returns NULL if the year is out of range.
+ */
+AtcZoneProcessor *atc_processor_cache_get_for_year(
+    AtcZoneProcessorCache *cache,
+    int16_t year);
+
+/**
+ * Find the AtcFindResult at the given epoch_seconds, with the result status in
+ * `result.type`. The `result.abbrev` points into one of the AtcZoneProcessor
+ * slots and remains valid only until that slot is evicted.
+ */
+void atc_processor_cache_find_by_epoch_seconds(
+    AtcZoneProcessorCache *cache,
+    atc_time_t epoch_seconds,
+    AtcFindResult *result);
+
+/**
+ * Find the AtcFindResult at the given LocalDateTime, with the result status in
+ * `result.type`. The `result.abbrev` points into one of the AtcZoneProcessor
+ * slots and remains valid only until that slot is evicted.
+ */
+void atc_processor_cache_find_by_local_date_time(
+    AtcZoneProcessorCache *cache,
+    const AtcLocalDateTime *ldt,
+    AtcFindResult *result);
+
+/** Reset the `num_hits` and `num_misses` counters to 0. */
+void atc_processor_cache_reset_stats(AtcZoneProcessorCache *cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -14,6 +14,15 @@ void atc_registrar_init(
   registrar->registry = registry;
   registrar->size = size;
   registrar->is_sorted = atc_registrar_is_registry_sorted(registry, size);
+  registrar->index = NULL;
+  registrar->name_index = NULL;
+}
+
+void atc_registrar_set_index(
+    AtcZoneRegistrar *registrar,
+    const AtcZoneRegistryIndex *index)
+{
+  registrar->index = index;
 }
 
 bool atc_registrar_is_registry_sorted(
@@ -69,6 +78,335 @@ static uint16_t linear_search(
   return UINT16_MAX;
 }
 
+//---------------------------------------------------------------------------
+// Perfect hash index, using the "hash, displace" method: the zone ids are
+// distributed into buckets of about 2 ids, and for each bucket, from the
+// largest to the smallest, a seed is searched which places all its ids into
+// free slots.
+//---------------------------------------------------------------------------
+
+enum {
+  /** Seeds of the buckets which are not placed yet have this bit set. */
+  kAtcRegistryIndexUnplaced = 0x8000,
+
+  /** Maximum number of zone ids in a bucket. */
+  kAtcRegistryIndexMaxBucketSize = 16,
+};
+
+/** Mix the bits of the zone_id, which is only a djb2 hash of the name. */
+static uint32_t atc_registry_index_mix(uint32_t h)
+{
+  h ^= h >> 16;
+  h *= 0x85ebca6bu;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35u;
+  h ^= h >> 16;
+  return h;
+}
+
+/** Map the hash h into [0, n) without a division. */
+static uint16_t atc_registry_index_reduce(uint32_t h, uint16_t n)
+{
+  return (uint16_t) (((uint64_t) h * n) >> 32);
+}
+
+static uint16_t atc_registry_index_bucket(
+    const AtcZoneRegistryIndex *index,
+    uint32_t zone_id)
+{
+  return atc_registry_index_reduce(
+      atc_registry_index_mix(zone_id), index->num_buckets);
+}
+
+static uint16_t atc_registry_index_slot(
+    const AtcZoneRegistryIndex *index,
+    uint32_t zone_id,
+    uint16_t seed)
+{
+  uint32_t h = atc_registry_index_mix(zone_id ^ (seed * 0x9e3779b9u));
+  return atc_registry_index_reduce(h, index->size);
+}
+
+// Find a seed which places the `n` zones of the bucket into distinct free
+// slots, and place them. Return false if none is found.
+static bool atc_registry_index_place(
+    AtcZoneRegistryIndex *index,
+    const AtcZoneInfo * const * registry,
+    const uint16_t *members,
+    uint8_t n,
+    uint16_t bucket)
+{
+  uint16_t slots[kAtcRegistryIndexMaxBucketSize];
+  for (uint16_t seed = 0; seed < kAtcRegistryIndexUnplaced; seed++) {
+    bool ok = true;
+    for (uint8_t i = 0; i < n && ok; i++) {
+      uint16_t slot = atc_registry_index_slot(
+          index, registry[members[i]]->zone_id, seed);
+      if (index->indexes[slot] != UINT16_MAX) ok = false;
+      for (uint8_t j = 0; j < i && ok; j++) {
+        if (slots[j] == slot) ok = false;
+      }
+      slots[i] = slot;
+    }
+    if (! ok) continue;
+
+    for (uint8_t i = 0; i < n; i++) {
+      index->indexes[slots[i]] = members[i];
+      index->ids[slots[i]] = registry[members[i]]->zone_id;
+    }
+    index->seeds[bucket] = seed;
+    return true;
+  }
+  return false;
+}
+
+int8_t atc_registrar_build_index(
+    AtcZoneRegistryIndex *index,
+    const AtcZoneInfo * const * registry,
+    uint16_t size,
+    uint16_t *seeds,
+    uint32_t *ids,
+    uint16_t *indexes)
+{
+  index->size = 0;
+  index->num_buckets = ATC_REGISTRY_INDEX_NUM_BUCKETS(size);
+  index->seeds = seeds;
+  index->ids = ids;
+  index->indexes = indexes;
+  if (size == UINT16_MAX) return kAtcErrGeneric;
+
+  // The seeds hold the number of zones of each bucket until it is placed.
+  index->size = size;
+  for (uint16_t b = 0; b < index->num_buckets; b++) {
+    seeds[b] = kAtcRegistryIndexUnplaced;
+  }
+  for (uint16_t i = 0; i < size; i++) {
+    indexes[i] = UINT16_MAX;
+    ids[i] = 0;
+    uint16_t b = atc_registry_index_bucket(index, registry[i]->zone_id);
+    seeds[b]++;
+  }
+  uint16_t max_bucket_size = 0;
+  for (uint16_t b = 0; b < index->num_buckets; b++) {
+    uint16_t n = seeds[b] & ~kAtcRegistryIndexUnplaced;
+    if (n > max_bucket_size) max_bucket_size = n;
+  }
+  if (max_bucket_size > kAtcRegistryIndexMaxBucketSize) goto error;
+
+  // Place the largest buckets first, while most slots are still free.
+  uint16_t members[kAtcRegistryIndexMaxBucketSize];
+  for (uint16_t n = max_bucket_size; n > 0; n--) {
+    for (uint16_t b = 0; b < index->num_buckets; b++) {
+      if (seeds[b] != (kAtcRegistryIndexUnplaced | n)) continue;
+
+      uint8_t count = 0;
+      for (uint16_t i = 0; i < size; i++) {
+        uint32_t zone_id = registry[i]->zone_id;
+        if (atc_registry_index_bucket(index, zone_id) != b) continue;
+        // Duplicate zone ids can never be placed into distinct slots.
+        for (uint8_t j = 0; j < count; j++) {
+          if (registry[members[j]]->zone_id == zone_id) goto error;
+        }
+        members[count++] = i;
+      }
+      if (! atc_registry_index_place(index, registry, members, count, b)) {
+        goto error;
+      }
+    }
+  }
+  // Empty buckets are never used.
+  for (uint16_t b = 0; b < index->num_buckets; b++) {
+    if (seeds[b] == kAtcRegistryIndexUnplaced) seeds[b] = 0;
+  }
+  return kAtcErrOk;
+
+error:
+  index->size = 0;
+  return kAtcErrGeneric;
+}
+
+/**
+ * Look up 'zone_id' in the perfect hash index. Return the index into the
+ * registry if found, or UINT16_MAX if not found.
+ */
+static uint16_t index_search(
+    const AtcZoneRegistryIndex *index,
+    uint32_t zone_id)
+{
+  if (index->size == 0) return UINT16_MAX;
+  uint16_t seed = index->seeds[atc_registry_index_bucket(index, zone_id)];
+  uint16_t slot = atc_registry_index_slot(index, zone_id, seed);
+  if (index->ids[slot] != zone_id) return UINT16_MAX;
+  return index->indexes[slot];
+}
+
+//---------------------------------------------------------------------------
+// Name index.
+//---------------------------------------------------------------------------
+
+static char fold(char c, bool fold_case)
+{
+  return (fold_case && c >= 'A' && c <= 'Z') ? (char) (c - 'A' + 'a') : c;
+}
+
+/**
+ * Compare the name `a` with `b`. If `is_prefix` is true, `b` is a prefix, and
+ * the names which start with `b` compare equal.
+ */
+static int compare_names(
+    const char *a,
+    const char *b,
+    bool fold_case,
+    bool is_prefix)
+{
+  for (;; a++, b++) {
+    if (is_prefix && *b == '\0') return 0;
+    uint8_t ca = (uint8_t) fold(*a, fold_case);
+    uint8_t cb = (uint8_t) fold(*b, fold_case);
+    if (ca != cb) return (ca < cb) ? -1 : 1;
+    if (ca == '\0') return 0;
+  }
+}
+
+// Names which are equal when folded are ordered by their exact value, so that
+// the order does not depend on the sort.
+static int compare_entries(
+    const AtcZoneInfo * const * registry,
+    uint16_t i,
+    uint16_t j,
+    bool fold_case)
+{
+  int c = compare_names(registry[i]->name, registry[j]->name, fold_case, false);
+  if (c == 0 && fold_case) {
+    c = compare_names(registry[i]->name, registry[j]->name, false, false);
+  }
+  return c;
+}
+
+static void sift_down(
+    const AtcZoneInfo * const * registry,
+    uint16_t *indexes,
+    uint16_t root,
+    uint16_t size,
+    bool fold_case)
+{
+  for (;;) {
+    uint32_t child = 2 * (uint32_t) root + 1;
+    if (child >= size) break;
+    if (child + 1 < size && compare_entries(
+        registry, indexes[child], indexes[child + 1], fold_case) < 0) {
+      child++;
+    }
+    if (compare_entries(
+        registry, indexes[root], indexes[child], fold_case) >= 0) {
+      break;
+    }
+    uint16_t tmp = indexes[root];
+    indexes[root] = indexes[child];
+    indexes[child] = tmp;
+    root = (uint16_t) child;
+  }
+}
+
+void atc_registrar_build_name_index(
+    AtcZoneNameIndex *index,
+    const AtcZoneInfo * const * registry,
+    uint16_t size,
+    bool fold_case,
+    uint16_t *indexes)
+{
+  index->size = size;
+  index->fold_case = fold_case;
+  index->indexes = indexes;
+  for (uint16_t i = 0; i < size; i++) {
+    indexes[i] = i;
+  }
+
+  // Heap sort, which needs no extra memory.
+  for (uint16_t i = size / 2; i > 0; i--) {
+    sift_down(registry, indexes, i - 1, size, fold_case);
+  }
+  for (uint16_t end = size; end > 1; end--) {
+    uint16_t tmp = indexes[0];
+    indexes[0] = indexes[end - 1];
+    indexes[end - 1] = tmp;
+    sift_down(registry, indexes, 0, end - 1, fold_case);
+  }
+}
+
+void atc_registrar_set_name_index(
+    AtcZoneRegistrar *registrar,
+    const AtcZoneNameIndex *name_index)
+{
+  registrar->name_index = name_index;
+}
+
+const AtcZoneInfo *atc_registrar_get_by_name_order(
+    const AtcZoneRegistrar *registrar,
+    uint16_t i)
+{
+  const AtcZoneNameIndex *index = registrar->name_index;
+  if (index == NULL || i >= index->size) return NULL;
+  return registrar->registry[index->indexes[i]];
+}
+
+/**
+ * Return the first position of the name index whose name compares greater
+ * than or equal to `name` (if `upper` is false), or greater than `name` (if
+ * `upper` is true).
+ */
+static uint16_t name_bound(
+    const AtcZoneRegistrar *registrar,
+    const char *name,
+    bool is_prefix,
+    bool upper)
+{
+  const AtcZoneNameIndex *index = registrar->name_index;
+  uint16_t a = 0;
+  uint16_t b = index->size;
+  while (a < b) {
+    uint16_t c = a + (b - a) / 2;
+    const AtcZoneInfo *info = registrar->registry[index->indexes[c]];
+    int cmp = compare_names(info->name, name, index->fold_case, is_prefix);
+    if (cmp < 0 || (upper && cmp == 0)) {
+      a = c + 1;
+    } else {
+      b = c;
+    }
+  }
+  return a;
+}
+
+uint16_t atc_registrar_find_by_prefix(
+    const AtcZoneRegistrar *registrar,
+    const char *prefix,
+    uint16_t *start)
+{
+  *start = 0;
+  if (registrar->name_index == NULL) return 0;
+  uint16_t lower = name_bound(registrar, prefix, true, false);
+  uint16_t upper = name_bound(registrar, prefix, true, true);
+  *start = lower;
+  return upper - lower;
+}
+
+const AtcZoneInfo *atc_registrar_find_by_name_index(
+    const AtcZoneRegistrar *registrar,
+    const char *name)
+{
+  const AtcZoneNameIndex *index = registrar->name_index;
+  if (index == NULL) return NULL;
+  uint16_t i = name_bound(registrar, name, false, false);
+  if (i >= index->size) return NULL;
+  const AtcZoneInfo *info = registrar->registry[index->indexes[i]];
+  if (compare_names(info->name, name, index->fold_case, false) != 0) {
+    return NULL;
+  }
+  return info;
+}
+
+//---------------------------------------------------------------------------
+
 const AtcZoneInfo *atc_registrar_find_by_name(
     const AtcZoneRegistrar *registrar,
     const char *name)
@@ -87,9 +425,14 @@ const AtcZoneInfo *atc_registrar_find_by_id(
     const AtcZoneRegistrar *registrar,
     uint32_t zone_id)
 {
-  uint16_t index = (registrar->is_sorted)
-      ? binary_search(registrar->registry, registrar->size, zone_id)
-      : linear_search(registrar->registry, registrar->size, zone_id);
+  uint16_t index;
+  if (registrar->index) {
+    index = index_search(registrar->index, zone_id);
+  } else if (registrar->is_sorted) {
+    index = binary_search(registrar->registry, registrar->size, zone_id);
+  } else {
+    index = linear_search(registrar->registry, registrar->size, zone_id);
+  }
   if (index == UINT16_MAX) return NULL;
   const AtcZoneInfo *match = registrar->registry[index];
   return match;
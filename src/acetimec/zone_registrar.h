@@ -22,6 +22,52 @@
 extern "C" {
 #endif
 
+/**
+ * Number of buckets of the AtcZoneRegistryIndex of a registry with `size`
+ * entries, i.e. the size of its `seeds` array.
+ */
+#define ATC_REGISTRY_INDEX_NUM_BUCKETS(size) (((size) + 1) / 2)
+
+/**
+ * A minimal perfect hash of the zone ids of a registry, which finds a zone
+ * with a single probe, without reading the AtcZoneInfo of other zones. The
+ * zone_id selects a bucket, and the seed of the bucket selects the slot of
+ * the zone_id in the `ids` and `indexes` arrays. The arrays are provided by
+ * the caller, and are filled by atc_registrar_build_index().
+ */
+typedef struct AtcZoneRegistryIndex {
+  /** Number of entries of the registry, i.e. the number of slots. */
+  uint16_t size;
+
+  /** Number of buckets. */
+  uint16_t num_buckets;
+
+  /** Seed of the hash of each bucket. */
+  uint16_t *seeds;
+
+  /** The zone_id in each slot. */
+  uint32_t *ids;
+
+  /** The index into the registry of each slot. */
+  uint16_t *indexes;
+} AtcZoneRegistryIndex;
+
+/**
+ * The entries of a registry sorted by name, for alphabetical listings, prefix
+ * searches, and case-insensitive lookups. The array is provided by the
+ * caller, and is filled by atc_registrar_build_name_index().
+ */
+typedef struct AtcZoneNameIndex {
+  /** Number of entries of the registry. */
+  uint16_t size;
+
+  /** True if the names are compared without regard to ASCII case. */
+  bool fold_case;
+
+  /** The indexes into the registry, in the order of the names. */
+  uint16_t *indexes;
+} AtcZoneNameIndex;
+
 /** Data structure used by the registrar to manage a given zone registry. */
 typedef struct AtcZoneRegistrar {
   /** An array of pointers to AtcZoneInfo data structures. */
@@ -32,6 +78,12 @@ typedef struct AtcZoneRegistrar {
 
   /** True if the registry is sorted according by zone_id. */
   bool is_sorted;
+
+  /** Optional perfect hash index of the registry, NULL if not used. */
+  const AtcZoneRegistryIndex *index;
+
+  /** Optional name index of the registry, NULL if not used. */
+  const AtcZoneNameIndex *name_index;
 } AtcZoneRegistrar;
 
 /**Initialize the given registrar data structure with the given registry. */
@@ -45,6 +97,82 @@ bool atc_registrar_is_registry_sorted(
     const AtcZoneInfo * const * registry,
     uint16_t size);
 
+/**
+ * Build the perfect hash index of the given registry into `index`, using the
+ * arrays `seeds` of size ATC_REGISTRY_INDEX_NUM_BUCKETS(size), and `ids` and
+ * `indexes` of size `size`. This is normally done once during setup.
+ *
+ * Return kAtcErrGeneric if the registry contains duplicate zone ids, or if no
+ * perfect hash could be found.
+ */
+int8_t atc_registrar_build_index(
+    AtcZoneRegistryIndex *index,
+    const AtcZoneInfo * const * registry,
+    uint16_t size,
+    uint16_t *seeds,
+    uint32_t *ids,
+    uint16_t *indexes);
+
+/**
+ * Use the given index, built from the same registry by
+ * atc_registrar_build_index(), for atc_registrar_find_by_name() and
+ * atc_registrar_find_by_id(). The index must remain valid while the registrar
+ * is used. Pass NULL to go back to the binary or linear search.
+ */
+void atc_registrar_set_index(
+    AtcZoneRegistrar *registrar,
+    const AtcZoneRegistryIndex *index);
+
+/**
+ * Sort the entries of the given registry by name into `indexes`, an array of
+ * size `size`, and initialize the `index`. If `fold_case` is true, the names
+ * are compared without regard to ASCII case, for example "america/new_york"
+ * matches "America/New_York".
+ */
+void atc_registrar_build_name_index(
+    AtcZoneNameIndex *index,
+    const AtcZoneInfo * const * registry,
+    uint16_t size,
+    bool fold_case,
+    uint16_t *indexes);
+
+/**
+ * Use the given name index, built from the same registry by
+ * atc_registrar_build_name_index(), for the functions below which search by
+ * name. The index must remain valid while the registrar is used.
+ */
+void atc_registrar_set_name_index(
+    AtcZoneRegistrar *registrar,
+    const AtcZoneNameIndex *name_index);
+
+/**
+ * Return the entry at position `i` of the registry sorted by name, or NULL if
+ * `i` is out of range or if there is no name index.
+ */
+const AtcZoneInfo *atc_registrar_get_by_name_order(
+    const AtcZoneRegistrar *registrar,
+    uint16_t i);
+
+/**
+ * Find the range of the entries whose names start with `prefix` (e.g.
+ * "America/N"), using a binary search of the name index. The matches are the
+ * positions [*start, *start + count) of atc_registrar_get_by_name_order().
+ * Return the count, or 0 if there is no name index.
+ */
+uint16_t atc_registrar_find_by_prefix(
+    const AtcZoneRegistrar *registrar,
+    const char *prefix,
+    uint16_t *start);
+
+/**
+ * Search the name index for the zone 'name', without regard to case if the
+ * index was built with `fold_case`. Return NULL if not found, or if there is
+ * no name index.
+ */
+const AtcZoneInfo *atc_registrar_find_by_name_index(
+    const AtcZoneRegistrar *registrar,
+    const char *name);
+
 /**
  * Search the zone registry for the zone 'name'.
  * Return NULL if not found.
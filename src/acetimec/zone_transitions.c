@@ -0,0 +1,154 @@
+/*
+ * MIT License
+ * Copyright (c) 2024 Brian T. Park
+ */
+
+#include <string.h> // strcmp(), memcpy()
+#include "common.h" // kAtcErrOk
+#include "epoch.h" // atc_epoch_context_init_from_current()
+#include "local_date_time.h" // atc_local_date_time_from_epoch_seconds_ctx()
+#include "transition.h"
+#include "zone_processor.h"
+#include "zone_transitions.h"
+
+// Return the UTC year of the given epoch_seconds, or kAtcInvalidYear if it
+// cannot be represented.
+static int16_t atc_zone_transitions_year_of(
+    const AtcEpochContext *ctx,
+    atc_time_t epoch_seconds)
+{
+  AtcLocalDateTime ldt;
+  atc_local_date_time_from_epoch_seconds_ctx(ctx, &ldt, epoch_seconds);
+  if (atc_local_date_time_is_error(&ldt)) return kAtcInvalidYear;
+  return ldt.year;
+}
+
+// Generate the transitions of iter->year, and rewind to the first one.
+static int8_t atc_zone_transitions_init_for_year(AtcZoneTransitions *iter)
+{
+  int8_t err = atc_processor_init_for_year_ctx(
+      &iter->processor, &iter->ctx, iter->year);
+  if (err) return err;
+  atc_processor_calc_all_abbreviations(&iter->processor);
+  iter->index = 0;
+  return kAtcErrOk;
+}
+
+int8_t atc_zone_transitions_begin(
+    AtcZoneTransitions *iter,
+    const AtcZoneInfo *zone_info,
+    atc_time_t start_epoch_seconds,
+    atc_time_t until_epoch_seconds)
+{
+  AtcEpochContext ctx;
+  atc_epoch_context_init_from_current(&ctx);
+  return atc_zone_transitions_begin_ctx(
+      iter, &ctx, zone_info, start_epoch_seconds, until_epoch_seconds);
+}
+
+int8_t atc_zone_transitions_begin_ctx(
+    AtcZoneTransitions *iter,
+    const AtcEpochContext *ctx,
+    const AtcZoneInfo *zone_info,
+    atc_time_t start_epoch_seconds,
+    atc_time_t until_epoch_seconds)
+{
+  iter->ctx = *ctx;
+  iter->start_epoch_seconds = start_epoch_seconds;
+  iter->until_epoch_seconds = until_epoch_seconds;
+  iter->index = 0;
+  // Mark the iteration as finished until everything has been validated.
+  iter->year = 0;
+  iter->last_year = -1;
+
+  if (zone_info == NULL
+      || start_epoch_seconds == kAtcInvalidEpochSeconds
+      || until_epoch_seconds == kAtcInvalidEpochSeconds
+      || start_epoch_seconds >= until_epoch_seconds) {
+    return kAtcErrGeneric;
+  }
+  int16_t start_year = atc_zone_transitions_year_of(ctx, start_epoch_seconds);
+  int16_t last_year = atc_zone_transitions_year_of(
+      ctx, until_epoch_seconds - 1);
+  if (start_year == kAtcInvalidYear || last_year == kAtcInvalidYear) {
+    return kAtcErrGeneric;
+  }
+
+  atc_processor_init(&iter->processor);
+  atc_processor_init_for_zone_info(&iter->processor, zone_info);
+  iter->year = start_year;
+  int8_t err = atc_zone_transitions_init_for_year(iter);
+  if (err) {
+    iter->last_year = -1;
+    return err;
+  }
+  iter->last_year = last_year;
+  return kAtcErrOk;
+}
+
+bool atc_zone_transitions_is_change_at(
+    const AtcZoneProcessor *processor,
+    uint8_t index,
+    AtcZoneTransition *transition)
+{
+  // The first transition of the window starts before the year, so every
+  // transition of the year has a predecessor.
+  const AtcTransitionStorage *ts = &processor->transition_storage;
+  if (index == 0 || index >= ts->index_free) return false;
+  const AtcTransition *prev = ts->transitions[index - 1];
+  const AtcTransition *t = ts->transitions[index];
+  if (t->start_epoch_seconds < processor->year_start_epoch_seconds
+      || t->start_epoch_seconds >= processor->year_until_epoch_seconds) {
+    return false;
+  }
+  if (prev->offset_seconds == t->offset_seconds
+      && prev->delta_seconds == t->delta_seconds
+      && strcmp(prev->abbrev, t->abbrev) == 0) {
+    return false;
+  }
+
+  transition->epoch_seconds = t->start_epoch_seconds;
+  transition->old_offset_seconds = prev->offset_seconds + prev->delta_seconds;
+  transition->new_offset_seconds = t->offset_seconds + t->delta_seconds;
+  transition->std_offset_seconds = t->offset_seconds;
+  transition->dst_offset_seconds = t->delta_seconds;
+  memcpy(transition->abbrev, t->abbrev, kAtcAbbrevSize);
+  transition->abbrev[kAtcAbbrevSize - 1] = '\0';
+  return true;
+}
+
+bool atc_zone_transitions_next(
+    AtcZoneTransitions *iter,
+    AtcZoneTransition *transition)
+{
+  while (iter->year <= iter->last_year) {
+    AtcZoneProcessor *processor = &iter->processor;
+    AtcTransitionStorage *ts = &processor->transition_storage;
+    AtcTransition **begin = atc_transition_storage_get_active_pool_begin(ts);
+    AtcTransition **end = atc_transition_storage_get_active_pool_end(ts);
+    uint8_t size = (uint8_t) (end - begin);
+    while (iter->index < size) {
+      uint8_t index = iter->index;
+      const AtcTransition *t = begin[index];
+      if (t->start_epoch_seconds >= processor->year_until_epoch_seconds) break;
+      iter->index++;
+
+      if (t->start_epoch_seconds < iter->start_epoch_seconds) continue;
+      if (t->start_epoch_seconds >= iter->until_epoch_seconds) {
+        iter->last_year = iter->year - 1;
+        return false;
+      }
+      if (atc_zone_transitions_is_change_at(processor, index, transition)) {
+        return true;
+      }
+    }
+
+    iter->year++;
+    if (iter->year > iter->last_year) break;
+    if (atc_zone_transitions_init_for_year(iter)) {
+      iter->last_year = iter->year - 1;
+      return false;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,147 @@
+/*
+ * MIT License
+ * Copyright (c) 2024 Brian T. Park
+ */
+
+/**
+ * @file zone_transitions.h
+ *
+ * An iterator over the changes of the UTC offset or abbreviation of a time
+ * zone between two instants. The iterator hides the 14-month windows of the
+ * AtcZoneProcessor, and the duplicate transitions created by the overlap of
+ * the windows of adjacent years, so that each change is returned exactly once,
+ * in increasing order of epoch seconds.
+ *
+ * Usage:
+ *
+ * @code
+ * AtcZoneTransitions iter;
+ * AtcZoneTransition t;
+ * int8_t err = atc_zone_transitions_begin(&iter, zone_info, start, until);
+ * if (err) { ... }
+ * while (atc_zone_transitions_next(&iter, &t)) {
+ *   ...
+ * }
+ * @endcode
+ */
+
+#ifndef ACE_TIME_C_ZONE_TRANSITIONS_H
+#define ACE_TIME_C_ZONE_TRANSITIONS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "common.h" // atc_time_t
+#include "../zoneinfo/zone_info.h"
+#include "epoch.h" // AtcEpochContext
+#include "transition.h" // kAtcAbbrevSize
+#include "zone_processor.h" // AtcZoneProcessor
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** A single change of the UTC offset or abbreviation of a time zone. */
+typedef struct AtcZoneTransition {
+  /** Epoch seconds when this transition takes effect. */
+  atc_time_t epoch_seconds;
+
+  /** Total UTC offset (STD + DST) just before the transition. */
+  int32_t old_offset_seconds;
+
+  /** Total UTC offset (STD + DST) starting at the transition. */
+  int32_t new_offset_seconds;
+
+  /** The STD offset seconds starting at the transition. */
+  int32_t std_offset_seconds;
+
+  /** The DST offset seconds starting at the transition. */
+  int32_t dst_offset_seconds;
+
+  /** Abbreviation starting at the transition, e.g. "PDT". */
+  char abbrev[kAtcAbbrevSize];
+} AtcZoneTransition;
+
+/**
+ * The state of the iteration over the transitions of a time zone over the
+ * interval [start, until). It is allocated by the caller, and contains its own
+ * AtcZoneProcessor, so it is large (about the same size as the processor).
+ * The fields are private.
+ */
+typedef struct AtcZoneTransitions {
+  /** Processor which generates the transitions of each year. */
+  AtcZoneProcessor processor;
+
+  /** Epoch used for the whole iteration. */
+  AtcEpochContext ctx;
+
+  /** Transitions before this epoch seconds are not returned. */
+  atc_time_t start_epoch_seconds;
+
+  /** Transitions at or after this epoch seconds are not returned. */
+  atc_time_t until_epoch_seconds;
+
+  /** Year whose transitions are currently being scanned. */
+  int16_t year;
+
+  /** Last year (inclusive) to be scanned. */
+  int16_t last_year;
+
+  /** Index of the next transition in the active pool of the processor. */
+  uint8_t index;
+} AtcZoneTransitions;
+
+/**
+ * Start the iteration over the transitions of the given zone_info over the
+ * interval [start_epoch_seconds, until_epoch_seconds), using the current epoch
+ * year. A transition which occurs exactly at start_epoch_seconds is returned.
+ *
+ * Return kAtcErrGeneric if the interval is empty or invalid, or if it extends
+ * outside of the years supported by the AtcZoneProcessor.
+ */
+int8_t atc_zone_transitions_begin(
+    AtcZoneTransitions *iter,
+    const AtcZoneInfo *zone_info,
+    atc_time_t start_epoch_seconds,
+    atc_time_t until_epoch_seconds);
+
+/** Same as atc_zone_transitions_begin() using the given AtcEpochContext. */
+int8_t atc_zone_transitions_begin_ctx(
+    AtcZoneTransitions *iter,
+    const AtcEpochContext *ctx,
+    const AtcZoneInfo *zone_info,
+    atc_time_t start_epoch_seconds,
+    atc_time_t until_epoch_seconds);
+
+/**
+ * Fill the next transition into `transition` and return true. Return false
+ * when there are no more transitions in the interval. Transitions which do not
+ * change the STD offset, the DST offset, or the abbreviation are skipped.
+ */
+bool atc_zone_transitions_next(
+    AtcZoneTransitions *iter,
+    AtcZoneTransition *transition);
+
+/**
+ * Return true if the transition at `index` of the active pool of the
+ * processor is a change which belongs to the year of the processor, and fill
+ * it into `transition`. A change is a transition which starts within the UTC
+ * year [year_start_epoch_seconds, year_until_epoch_seconds), and which changes
+ * the STD offset, the DST offset, or the abbreviation of the transition before
+ * it. The other transitions of the 14-month window of the processor belong to
+ * the adjacent years, so that each change is found in exactly one year.
+ *
+ * The processor must be initialized by atc_processor_init_for_year() and
+ * atc_processor_calc_all_abbreviations(). This is the rule used by
+ * atc_zone_transitions_next(), atc_time_zone_next_transition() and
+ * atc_time_zone_prev_transition().
+ */
+bool atc_zone_transitions_is_change_at(
+    const AtcZoneProcessor *processor,
+    uint8_t index,
+    AtcZoneTransition *transition);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
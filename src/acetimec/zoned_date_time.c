@@ -3,6 +3,7 @@
  * Copyright (c) 2022 Brian T. Park
  */
 
+#include <string.h> // memcpy(), strcmp()
 #include "epoch.h" // atc_epoch_seconds_from_unix_seconds()
 #include "local_date.h"
 #include "local_date_time.h"
@@ -121,3 +122,63 @@ void atc_zoned_date_time_print(
   atc_time_zone_print(sb, &zdt->tz);
   atc_print_char(sb, ']');
 }
+
+enum {
+  /** Size of the buffer for a zone name, longer than any name in the TZ
+   * database. */
+  kAtcZoneNameBufSize = 64,
+};
+
+// Parse the zoned date time, and return kAtcErrGeneric upon error, leaving
+// the zdt in an unspecified state.
+static int8_t parse_zoned_date_time(
+    AtcZonedDateTime *zdt,
+    const char *s,
+    size_t len,
+    const AtcZoneRegistrar *registrar,
+    AtcZoneProcessor *processor)
+{
+  AtcLocalDateTime ldt;
+  size_t n = atc_local_date_time_parse_prefix(&ldt, s, len);
+  if (n == 0) return kAtcErrGeneric;
+
+  int32_t offset_seconds;
+  size_t m = atc_offset_seconds_parse_prefix(s + n, len - n, &offset_seconds);
+  bool has_offset = (m != 0);
+  n += m;
+
+  // "[Zone/Name]", copied into a NUL-terminated buffer for the registrar.
+  if (n >= len || s[n] != '[' || s[len - 1] != ']') return kAtcErrGeneric;
+  size_t name_len = len - n - 2;
+  if (name_len == 0 || name_len >= kAtcZoneNameBufSize) return kAtcErrGeneric;
+  char name[kAtcZoneNameBufSize];
+  memcpy(name, s + n + 1, name_len);
+  name[name_len] = '\0';
+
+  AtcTimeZone tz;
+  tz.zone_info = atc_registrar_find_by_name(registrar, name);
+  tz.zone_processor = processor;
+  if (tz.zone_info == NULL && strcmp(name, "UTC") != 0) return kAtcErrGeneric;
+
+  if (has_offset) {
+    atc_time_t epoch_seconds = atc_local_date_time_to_epoch_seconds(&ldt);
+    if (epoch_seconds == kAtcInvalidEpochSeconds) return kAtcErrGeneric;
+    atc_zoned_date_time_from_epoch_seconds(
+        zdt, epoch_seconds - offset_seconds, &tz);
+  } else {
+    atc_zoned_date_time_from_local_date_time(zdt, &ldt, &tz);
+  }
+  return atc_zoned_date_time_is_error(zdt) ? kAtcErrGeneric : kAtcErrOk;
+}
+
+int8_t atc_zoned_date_time_parse(
+    AtcZonedDateTime *zdt,
+    const char *s,
+    size_t len,
+    const AtcZoneRegistrar *registrar,
+    AtcZoneProcessor *processor)
+{
+  int8_t err = parse_zoned_date_time(zdt, s, len, registrar, processor);
+  if (err) atc_zoned_date_time_set_error(zdt);
+  return err;
+}
@@ -13,11 +13,13 @@
 #ifndef ACE_TIME_C_ZONED_DATE_TIME_H
 #define ACE_TIME_C_ZONED_DATE_TIME_H
 
+#include <stddef.h> // size_t
 #include <stdint.h>
 #include <stdbool.h>
 #include "../zoneinfo/zone_info.h"
 #include "common.h"
 #include "zone_processor.h"
+#include "zone_registrar.h"
 #include "time_zone.h"
 
 #ifdef __cplusplus
@@ -137,6 +139,28 @@ void atc_zoned_date_time_print(
     AtcStringBuffer *sb,
     const AtcZonedDateTime *zdt);
 
+/**
+ * Parse the date time `YYYY-MM-DDThh:mm:ss[.fff][Z|+/-hh:mm][Zone/Name]` in the
+ * string `s` of length `len`, which does not need to be NUL-terminated. This
+ * is the format printed by atc_zoned_date_time_print(), extended by RFC 9557.
+ * The zone name is looked up in the `registrar`, and the name "UTC" which is
+ * not found selects the UTC time zone. The `processor` becomes part of the
+ * AtcTimeZone of the zdt.
+ *
+ * If the UTC offset is given, it identifies the instant, which is then
+ * converted to the time zone, as done by atc_zoned_date_time_convert().
+ * Otherwise, the date time is interpreted as a local date time in the time
+ * zone, as done by atc_zoned_date_time_from_local_date_time().
+ *
+ * Return kAtcErrGeneric upon error, and set zdt to its error value.
+ */
+int8_t atc_zoned_date_time_parse(
+    AtcZonedDateTime *zdt,
+    const char *s,
+    size_t len,
+    const AtcZoneRegistrar *registrar,
+    AtcZoneProcessor *processor);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,616 @@
+/*
+ * MIT License
+ * Copyright (c) 2024 Brian T. Park
+ */
+
+#include <string.h> // memcpy()
+#include "common.h" // kAtcErrOk
+#include "local_date.h" // atc_local_date_day_of_week()
+#include "zoned_format.h"
+
+// The opcodes of AtcZonedFormatOp.code.
+enum {
+  kAtcZonedFormatOpLiteral,
+  kAtcZonedFormatOpYear, // %Y
+  kAtcZonedFormatOpYearOfCentury, // %y
+  kAtcZonedFormatOpMonth, // %m
+  kAtcZonedFormatOpMonthShortName, // %b
+  kAtcZonedFormatOpMonthName, // %B
+  kAtcZonedFormatOpDay, // %d
+  kAtcZonedFormatOpDaySpace, // %e
+  kAtcZonedFormatOpDayOfYear, // %j
+  kAtcZonedFormatOpWeekdayShortName, // %a
+  kAtcZonedFormatOpWeekdayName, // %A
+  kAtcZonedFormatOpWeekday, // %u
+  kAtcZonedFormatOpHour, // %H
+  kAtcZonedFormatOpHour12, // %I
+  kAtcZonedFormatOpAmPm, // %p
+  kAtcZonedFormatOpMinute, // %M
+  kAtcZonedFormatOpSecond, // %S
+  kAtcZonedFormatOpOffset, // %z
+  kAtcZonedFormatOpOffsetColon, // %:z
+  kAtcZonedFormatOpAbbrev, // %Z
+  kAtcZonedFormatOpDate, // %Y-%m-%d, fused
+  kAtcZonedFormatOpTime, // %H:%M:%S, fused
+};
+
+// Maximum number of characters printed by each opcode, except literals.
+static const uint8_t atc_zoned_format_op_lengths[] = {
+  0 /*Literal*/,
+  4 /*Year*/,
+  2 /*YearOfCentury*/,
+  2 /*Month*/,
+  3 /*MonthShortName*/,
+  9 /*MonthName*/,
+  2 /*Day*/,
+  2 /*DaySpace*/,
+  3 /*DayOfYear*/,
+  3 /*WeekdayShortName*/,
+  9 /*WeekdayName*/,
+  1 /*Weekday*/,
+  2 /*Hour*/,
+  2 /*Hour12*/,
+  2 /*AmPm*/,
+  2 /*Minute*/,
+  2 /*Second*/,
+  5 /*Offset*/,
+  6 /*OffsetColon*/,
+  kAtcAbbrevSize - 1 /*Abbrev*/,
+  10 /*Date*/,
+  8 /*Time*/,
+};
+
+static const char * const atc_month_names[12] = {
+  "January", "February", "March", "April", "May", "June",
+  "July", "August", "September", "October", "November", "December",
+};
+
+// Indexed by the ISO weekday, Monday=1 to Sunday=7.
+static const char * const atc_weekday_names[8] = {
+  "", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday",
+  "Sunday",
+};
+
+// Number of days before the 1st of each month, in a non-leap year.
+static const uint16_t atc_days_before_month[12] = {
+  0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334,
+};
+
+//-----------------------------------------------------------------------------
+// Compiler
+//-----------------------------------------------------------------------------
+
+// Add the literal character `c`, merging it with the previous literal op.
+static int8_t compile_literal(AtcZonedFormat *fmt, char c)
+{
+  if (fmt->num_literals >= kAtcZonedFormatMaxLiterals) return kAtcErrGeneric;
+
+  AtcZonedFormatOp *last = (fmt->num_ops > 0)
+      ? &fmt->ops[fmt->num_ops - 1]
+      : NULL;
+  if (last == NULL || last->code != kAtcZonedFormatOpLiteral) {
+    if (fmt->num_ops >= kAtcZonedFormatMaxOps) return kAtcErrGeneric;
+    last = &fmt->ops[fmt->num_ops++];
+    last->code = kAtcZonedFormatOpLiteral;
+    last->offset = fmt->num_literals;
+    last->length = 0;
+  }
+  fmt->literals[fmt->num_literals++] = c;
+  last->length++;
+  return kAtcErrOk;
+}
+
+// Return true if the op is the single literal character `c`.
+static bool is_separator(
+    const AtcZonedFormat *fmt, const AtcZonedFormatOp *op, char c)
+{
+  return op->code == kAtcZonedFormatOpLiteral
+      && op->length == 1
+      && fmt->literals[op->offset] == c;
+}
+
+// Replace the last 5 ops with the single op `fused`, if they are the ops
+// `op1`, `op3` and `op5`, separated by the literal character `sep`. Each op
+// costs a dispatch when printing, so the common "%Y-%m-%d" and "%H:%M:%S"
+// sequences are printed by a single op. The 2 separators are the last
+// literals, so their storage is released as well.
+static void fuse_ops(
+    AtcZonedFormat *fmt,
+    uint8_t op1, uint8_t op3, uint8_t op5, char sep,
+    uint8_t fused)
+{
+  if (fmt->num_ops < 5) return;
+  AtcZonedFormatOp *ops = &fmt->ops[fmt->num_ops - 5];
+  if (ops[0].code != op1 || ops[2].code != op3 || ops[4].code != op5) return;
+  if (!is_separator(fmt, &ops[1], sep)) return;
+  if (!is_separator(fmt, &ops[3], sep)) return;
+
+  ops[0].code = fused;
+  fmt->num_ops -= 4;
+  fmt->num_literals -= 2;
+}
+
+static int8_t compile_op(AtcZonedFormat *fmt, uint8_t code)
+{
+  if (fmt->num_ops >= kAtcZonedFormatMaxOps) return kAtcErrGeneric;
+  AtcZonedFormatOp *op = &fmt->ops[fmt->num_ops++];
+  op->code = code;
+  op->offset = 0;
+  op->length = 0;
+  if (code == kAtcZonedFormatOpAbbrev) fmt->needs_extra = true;
+
+  if (code == kAtcZonedFormatOpDay) {
+    fuse_ops(fmt, kAtcZonedFormatOpYear, kAtcZonedFormatOpMonth,
+        kAtcZonedFormatOpDay, '-', kAtcZonedFormatOpDate);
+  } else if (code == kAtcZonedFormatOpSecond) {
+    fuse_ops(fmt, kAtcZonedFormatOpHour, kAtcZonedFormatOpMinute,
+        kAtcZonedFormatOpSecond, ':', kAtcZonedFormatOpTime);
+  }
+  return kAtcErrOk;
+}
+
+// Compile the ops of a shortcut, e.g. "%Y-%m-%d" for %F, which are then
+// fused by compile_op().
+static int8_t compile_ops3(
+    AtcZonedFormat *fmt, uint8_t op1, uint8_t op2, uint8_t op3, char sep)
+{
+  int8_t err = compile_op(fmt, op1);
+  if (!err) err = compile_literal(fmt, sep);
+  if (!err) err = compile_op(fmt, op2);
+  if (!err) err = compile_literal(fmt, sep);
+  if (!err) err = compile_op(fmt, op3);
+  return err;
+}
+
+// Compile the conversion which follows a '%'. Return the number of characters
+// consumed, or 0 if the conversion is unsupported.
+static uint8_t compile_conversion(AtcZonedFormat *fmt, const char *s)
+{
+  int8_t err;
+  switch (s[0]) {
+    case 'Y': err = compile_op(fmt, kAtcZonedFormatOpYear); break;
+    case 'y': err = compile_op(fmt, kAtcZonedFormatOpYearOfCentury); break;
+    case 'm': err = compile_op(fmt, kAtcZonedFormatOpMonth); break;
+    case 'b': err = compile_op(fmt, kAtcZonedFormatOpMonthShortName); break;
+    case 'B': err = compile_op(fmt, kAtcZonedFormatOpMonthName); break;
+    case 'd': err = compile_op(fmt, kAtcZonedFormatOpDay); break;
+    case 'e': err = compile_op(fmt, kAtcZonedFormatOpDaySpace); break;
+    case 'j': err = compile_op(fmt, kAtcZonedFormatOpDayOfYear); break;
+    case 'a': err = compile_op(fmt, kAtcZonedFormatOpWeekdayShortName); break;
+    case 'A': err = compile_op(fmt, kAtcZonedFormatOpWeekdayName); break;
+    case 'u': err = compile_op(fmt, kAtcZonedFormatOpWeekday); break;
+    case 'H': err = compile_op(fmt, kAtcZonedFormatOpHour); break;
+    case 'I': err = compile_op(fmt, kAtcZonedFormatOpHour12); break;
+    case 'p': err = compile_op(fmt, kAtcZonedFormatOpAmPm); break;
+    case 'M': err = compile_op(fmt, kAtcZonedFormatOpMinute); break;
+    case 'S': err = compile_op(fmt, kAtcZonedFormatOpSecond); break;
+    case 'z': err = compile_op(fmt, kAtcZonedFormatOpOffset); break;
+    case 'Z': err = compile_op(fmt, kAtcZonedFormatOpAbbrev); break;
+    case '%': err = compile_literal(fmt, '%'); break;
+    case 'F':
+      err = compile_ops3(fmt, kAtcZonedFormatOpYear, kAtcZonedFormatOpMonth,
+          kAtcZonedFormatOpDay, '-');
+      break;
+    case 'T':
+      err = compile_ops3(fmt, kAtcZonedFormatOpHour, kAtcZonedFormatOpMinute,
+          kAtcZonedFormatOpSecond, ':');
+      break;
+    case ':':
+      if (s[1] != 'z') return 0;
+      err = compile_op(fmt, kAtcZonedFormatOpOffsetColon);
+      return err ? 0 : 2;
+    default:
+      return 0;
+  }
+  return err ? 0 : 1;
+}
+
+int8_t atc_zoned_format_compile(AtcZonedFormat *fmt, const char *pattern)
+{
+  fmt->num_ops = 0;
+  fmt->num_literals = 0;
+  fmt->max_length = 0;
+  fmt->needs_extra = false;
+
+  const char *s = pattern;
+  while (*s != '\0') {
+    if (*s != '%') {
+      if (compile_literal(fmt, *s)) return kAtcErrGeneric;
+      s++;
+      continue;
+    }
+    uint8_t consumed = compile_conversion(fmt, s + 1);
+    if (consumed == 0) return kAtcErrGeneric;
+    s += 1 + consumed;
+  }
+
+  // Compute the maximum length once, so that the printer checks the capacity
+  // of the buffer only once.
+  uint16_t max_length = 0;
+  for (uint8_t i = 0; i < fmt->num_ops; i++) {
+    const AtcZonedFormatOp *op = &fmt->ops[i];
+    max_length += (op->code == kAtcZonedFormatOpLiteral)
+        ? op->length
+        : atc_zoned_format_op_lengths[op->code];
+  }
+  if (max_length > UINT8_MAX) return kAtcErrGeneric;
+  fmt->max_length = (uint8_t) max_length;
+  return kAtcErrOk;
+}
+
+uint8_t atc_zoned_format_max_length(const AtcZonedFormat *fmt)
+{
+  return fmt->max_length;
+}
+
+//-----------------------------------------------------------------------------
+// Executor
+//-----------------------------------------------------------------------------
+
+// Write the 2 digits of n in [0,99], and return the pointer after them.
+static char *write_pad2(char *p, uint8_t n)
+{
+  memcpy(p, &kAtcDigitPairs[2 * n], 2);
+  return p + 2;
+}
+
+// Copy the short NUL terminated `name` with a simple loop, which is faster
+// than calling strlen() and memcpy() for a few characters.
+static char *write_name(char *p, const char *name)
+{
+  while (*name != '\0') *p++ = *name++;
+  return p;
+}
+
+// Write "+hhmm" or "+hh:mm", ignoring the seconds.
+static char *write_offset(char *p, int32_t offset_seconds, bool colon)
+{
+  if (offset_seconds < 0) {
+    *p++ = '-';
+    offset_seconds = -offset_seconds;
+  } else {
+    *p++ = '+';
+  }
+  uint16_t minutes = offset_seconds / 60;
+  p = write_pad2(p, (uint8_t) (minutes / 60));
+  if (colon) *p++ = ':';
+  return write_pad2(p, (uint8_t) (minutes % 60));
+}
+
+static uint16_t day_of_year(int16_t year, uint8_t month, uint8_t day)
+{
+  uint16_t days = atc_days_before_month[month - 1] + day;
+  if (month > 2 && atc_is_leap_year(year)) days++;
+  return days;
+}
+
+// Write the fields of an op which depends only on the time of the day, and
+// return the pointer after them. The length written does not depend on the
+// time, so that these fields can be patched in place by the
+// AtcTimestampRenderer.
+static char *write_time_op(
+    char *p, uint8_t code, uint8_t hour, uint8_t minute, uint8_t second)
+{
+  switch (code) {
+    case kAtcZonedFormatOpHour:
+      return write_pad2(p, hour);
+    case kAtcZonedFormatOpHour12: {
+      uint8_t hour12 = hour % 12;
+      return write_pad2(p, (hour12 == 0) ? 12 : hour12);
+    }
+    case kAtcZonedFormatOpAmPm:
+      *p++ = (hour < 12) ? 'A' : 'P';
+      *p++ = 'M';
+      return p;
+    case kAtcZonedFormatOpMinute:
+      return write_pad2(p, minute);
+    case kAtcZonedFormatOpSecond:
+      return write_pad2(p, second);
+    default: // kAtcZonedFormatOpTime
+      p = write_pad2(p, hour);
+      *p++ = ':';
+      p = write_pad2(p, minute);
+      *p++ = ':';
+      return write_pad2(p, second);
+  }
+}
+
+// Execute the program of `fmt` into `p`, which must have room for
+// fmt->max_length characters. Return the number of characters written. If
+// `patches` is not NULL, the code and the position of each op which depends
+// only on the time of the day are recorded in it, and their number in
+// `num_patches`.
+static uint8_t render(
+    char *p,
+    const AtcZonedFormat *fmt,
+    const AtcZonedDateTime *zdt,
+    const AtcZonedExtra *extra,
+    AtcZonedFormatOp *patches,
+    uint8_t *num_patches)
+{
+  // Copy the fields into local variables. Otherwise, every write through `p`
+  // could alias them, and would force the compiler to load them again.
+  int16_t year = zdt->year;
+  uint8_t month = zdt->month;
+  uint8_t day = zdt->day;
+  uint8_t hour = zdt->hour;
+  uint8_t minute = zdt->minute;
+  uint8_t second = zdt->second;
+  int32_t offset_seconds = zdt->offset_seconds;
+  uint8_t num_ops = fmt->num_ops;
+
+  char *start = p;
+  uint8_t n = 0;
+  // Computed lazily, only by the formats which need it.
+  uint8_t weekday = 0;
+
+  for (uint8_t i = 0; i < num_ops; i++) {
+    AtcZonedFormatOp op = fmt->ops[i];
+    switch (op.code) {
+      case kAtcZonedFormatOpLiteral: {
+        // Literals are usually 1 or 2 separators.
+        const char *literal = &fmt->literals[op.offset];
+        for (uint8_t j = 0; j < op.length; j++) p[j] = literal[j];
+        p += op.length;
+        break;
+      }
+      case kAtcZonedFormatOpYear:
+        p = write_pad2(p, (uint8_t) (year / 100));
+        p = write_pad2(p, (uint8_t) (year % 100));
+        break;
+      case kAtcZonedFormatOpYearOfCentury:
+        p = write_pad2(p, (uint8_t) (year % 100));
+        break;
+      case kAtcZonedFormatOpMonth:
+        p = write_pad2(p, month);
+        break;
+      case kAtcZonedFormatOpMonthShortName:
+        memcpy(p, atc_month_names[month - 1], 3);
+        p += 3;
+        break;
+      case kAtcZonedFormatOpMonthName:
+        p = write_name(p, atc_month_names[month - 1]);
+        break;
+      case kAtcZonedFormatOpDay:
+        p = write_pad2(p, day);
+        break;
+      case kAtcZonedFormatOpDaySpace:
+        p = write_pad2(p, day);
+        if (day < 10) p[-2] = ' ';
+        break;
+      case kAtcZonedFormatOpDayOfYear: {
+        uint16_t days = day_of_year(year, month, day);
+        *p++ = (char) ('0' + days / 100);
+        p = write_pad2(p, (uint8_t) (days % 100));
+        break;
+      }
+      case kAtcZonedFormatOpWeekdayShortName:
+      case kAtcZonedFormatOpWeekdayName:
+      case kAtcZonedFormatOpWeekday:
+        if (weekday == 0) {
+          weekday = atc_local_date_day_of_week(year, month, day);
+        }
+        if (op.code == kAtcZonedFormatOpWeekday) {
+          *p++ = (char) ('0' + weekday);
+        } else if (op.code == kAtcZonedFormatOpWeekdayName) {
+          p = write_name(p, atc_weekday_names[weekday]);
+        } else {
+          memcpy(p, atc_weekday_names[weekday], 3);
+          p += 3;
+        }
+        break;
+      case kAtcZonedFormatOpHour:
+      case kAtcZonedFormatOpHour12:
+      case kAtcZonedFormatOpAmPm:
+      case kAtcZonedFormatOpMinute:
+      case kAtcZonedFormatOpSecond:
+      case kAtcZonedFormatOpTime:
+        if (patches != NULL) {
+          AtcZonedFormatOp *patch = &patches[n++];
+          patch->code = op.code;
+          patch->offset = (uint8_t) (p - start);
+          patch->length = 0;
+        }
+        p = write_time_op(p, op.code, hour, minute, second);
+        break;
+      case kAtcZonedFormatOpOffset:
+        p = write_offset(p, offset_seconds, false);
+        break;
+      case kAtcZonedFormatOpOffsetColon:
+        p = write_offset(p, offset_seconds, true);
+        break;
+      case kAtcZonedFormatOpAbbrev:
+        // The abbrev is NUL terminated within kAtcAbbrevSize.
+        p = write_name(p, extra->abbrev);
+        break;
+      case kAtcZonedFormatOpDate:
+        p = write_pad2(p, (uint8_t) (year / 100));
+        p = write_pad2(p, (uint8_t) (year % 100));
+        *p++ = '-';
+        p = write_pad2(p, month);
+        *p++ = '-';
+        p = write_pad2(p, day);
+        break;
+    }
+  }
+  if (num_patches != NULL) *num_patches = n;
+  return (uint8_t) (p - start);
+}
+
+static bool is_printable(
+    const AtcZonedFormat *fmt,
+    const AtcZonedDateTime *zdt,
+    const AtcZonedExtra *extra)
+{
+  if (atc_zoned_date_time_is_error(zdt)) return false;
+  if (zdt->year < 0 || zdt->year > 9999) return false;
+  if (fmt->needs_extra) {
+    if (extra == NULL || atc_zoned_extra_is_error(extra)) return false;
+  }
+  return true;
+}
+
+int8_t atc_zoned_format_print(
+    AtcStringBuffer *sb,
+    const AtcZonedFormat *fmt,
+    const AtcZonedDateTime *zdt,
+    const AtcZonedExtra *extra)
+{
+  if (!is_printable(fmt, zdt, extra)) return kAtcErrGeneric;
+  if (sb->capacity - sb->size < fmt->max_length) return kAtcErrGeneric;
+
+  sb->size += render(&sb->p[sb->size], fmt, zdt, extra, NULL, NULL);
+  return kAtcErrOk;
+}
+
+int8_t atc_zoned_format_print_large(
+    AtcLargeStringBuffer *sb,
+    const AtcZonedFormat *fmt,
+    const AtcZonedDateTime *zdt,
+    const AtcZonedExtra *extra)
+{
+  if (!is_printable(fmt, zdt, extra)) return kAtcErrGeneric;
+  if (sb->capacity - sb->size < fmt->max_length) return kAtcErrGeneric;
+
+  sb->size += render(&sb->p[sb->size], fmt, zdt, extra, NULL, NULL);
+  return kAtcErrOk;
+}
+
+//-----------------------------------------------------------------------------
+// Renderer
+//-----------------------------------------------------------------------------
+
+void atc_timestamp_renderer_init(
+    AtcTimestampRenderer *renderer,
+    const AtcZonedFormat *fmt,
+    const AtcTimeZone *tz)
+{
+  renderer->fmt = fmt;
+  renderer->tz = *tz;
+  renderer->num_second_hits = 0;
+  renderer->num_day_hits = 0;
+  renderer->num_misses = 0;
+  atc_timestamp_renderer_reset(renderer);
+}
+
+void atc_timestamp_renderer_reset(AtcTimestampRenderer *renderer)
+{
+  renderer->is_valid = false;
+}
+
+// Copy the `n` characters of the text. A memcpy() with a variable size which
+// is bounded by the size of the array can be expanded by the compiler into a
+// "rep movs" instruction, which has a large startup cost for short strings.
+// Instead, copy blocks of a constant size, the last one overlapping the
+// previous one.
+static void copy_text(char *dst, const char *src, uint8_t n)
+{
+  if (n >= 16) {
+    for (uint8_t i = 0; i + 16 < n; i += 16) memcpy(&dst[i], &src[i], 16);
+    memcpy(&dst[n - 16], &src[n - 16], 16);
+  } else if (n >= 8) {
+    memcpy(dst, src, 8);
+    memcpy(&dst[n - 8], &src[n - 8], 8);
+  } else {
+    for (uint8_t i = 0; i < n; i++) dst[i] = src[i];
+  }
+}
+
+// Render the epoch_seconds completely, and start a new window which ends at
+// the next local midnight, or at the next transition of the time zone.
+static int8_t renderer_render_full(
+    AtcTimestampRenderer *renderer,
+    atc_time_t epoch_seconds)
+{
+  const AtcZonedFormat *fmt = renderer->fmt;
+  renderer->is_valid = false;
+
+  AtcZonedDateTime zdt;
+  atc_zoned_date_time_from_epoch_seconds(&zdt, epoch_seconds, &renderer->tz);
+  AtcZonedExtra extra;
+  if (fmt->needs_extra) {
+    atc_zoned_extra_from_epoch_seconds(&extra, epoch_seconds, &renderer->tz);
+  }
+  if (!is_printable(fmt, &zdt, &extra)) return kAtcErrGeneric;
+
+  renderer->length = render(renderer->text, fmt, &zdt, &extra,
+      renderer->patches, &renderer->num_patches);
+  renderer->second = epoch_seconds;
+
+  int32_t seconds_of_day = (int32_t) zdt.hour * 3600
+      + (int32_t) zdt.minute * 60 + zdt.second;
+  renderer->window_start = epoch_seconds;
+  renderer->window_seconds_of_day = seconds_of_day;
+  renderer->window_length = 86400 - seconds_of_day;
+
+  AtcZoneTransition transition;
+  int8_t err = atc_time_zone_next_transition(
+      &renderer->tz, epoch_seconds, &transition);
+  if (!err) {
+    int64_t delta = (int64_t) transition.epoch_seconds - epoch_seconds;
+    if (delta < renderer->window_length) {
+      renderer->window_length = (int32_t) delta;
+    }
+  }
+
+  renderer->is_valid = true;
+  renderer->num_misses++;
+  return kAtcErrOk;
+}
+
+// Update the text of the renderer for the epoch_seconds.
+static int8_t renderer_update(
+    AtcTimestampRenderer *renderer,
+    atc_time_t epoch_seconds)
+{
+  if (renderer->is_valid && epoch_seconds == renderer->second) {
+    renderer->num_second_hits++;
+    return kAtcErrOk;
+  }
+
+  int64_t delta = (int64_t) epoch_seconds - renderer->window_start;
+  if (!renderer->is_valid || delta < 0 || delta >= renderer->window_length) {
+    return renderer_render_full(renderer, epoch_seconds);
+  }
+
+  // Same local day and same UTC offset, so only the time fields change.
+  int32_t seconds = renderer->window_seconds_of_day + (int32_t) delta;
+  uint16_t minutes = (uint16_t) (seconds / 60);
+  uint8_t hour = (uint8_t) (minutes / 60);
+  uint8_t minute = (uint8_t) (minutes % 60);
+  uint8_t second = (uint8_t) (seconds % 60);
+  for (uint8_t i = 0; i < renderer->num_patches; i++) {
+    const AtcZonedFormatOp *patch = &renderer->patches[i];
+    write_time_op(&renderer->text[patch->offset], patch->code,
+        hour, minute, second);
+  }
+  renderer->second = epoch_seconds;
+  renderer->num_day_hits++;
+  return kAtcErrOk;
+}
+
+int8_t atc_timestamp_renderer_print(
+    AtcTimestampRenderer *renderer,
+    AtcStringBuffer *sb,
+    atc_time_t epoch_seconds)
+{
+  if (renderer_update(renderer, epoch_seconds)) return kAtcErrGeneric;
+  if (sb->capacity - sb->size < renderer->length) return kAtcErrGeneric;
+
+  copy_text(&sb->p[sb->size], renderer->text, renderer->length);
+  sb->size += renderer->length;
+  return kAtcErrOk;
+}
+
+int8_t atc_timestamp_renderer_print_large(
+    AtcTimestampRenderer *renderer,
+    AtcLargeStringBuffer *sb,
+    atc_time_t epoch_seconds)
+{
+  if (renderer_update(renderer, epoch_seconds)) return kAtcErrGeneric;
+  if (sb->capacity - sb->size < renderer->length) return kAtcErrGeneric;
+
+  copy_text(&sb->p[sb->size], renderer->text, renderer->length);
+  sb->size += renderer->length;
+  return kAtcErrOk;
+}
@@ -0,0 +1,206 @@
+/*
+ * MIT License
+ * Copyright (c) 2024 Brian T. Park
+ */
+
+/**
+ * @file zoned_format.h
+ *
+ * A strftime-style format engine for AtcZonedDateTime. A pattern such as
+ * "%Y-%m-%d %H:%M:%S %Z" is compiled once by atc_zoned_format_compile() into
+ * an AtcZonedFormat, a compact program of opcodes and literal text. The
+ * program is then executed by atc_zoned_format_print() for each timestamp,
+ * without parsing the pattern again. The AtcZonedFormat is self-contained, so
+ * it can be compiled into a static variable and shared by many threads. The
+ * AtcTimestampRenderer memoizes the rendering of a stream of epoch seconds.
+ *
+ * The supported conversions are:
+ *
+ * - %Y year (4 digits), %y year of century (2 digits)
+ * - %m month (01-12), %b month abbreviation (Jan), %B month name (January)
+ * - %d day (01-31), %e day padded with a space ( 1-31), %j day of year
+ *   (001-366)
+ * - %a weekday abbreviation (Mon), %A weekday name (Monday), %u ISO weekday
+ *   (1-7, Monday is 1)
+ * - %H hour (00-23), %I hour (01-12), %p AM or PM
+ * - %M minute (00-59), %S second (00-59)
+ * - %z UTC offset (+hhmm), %:z UTC offset (+hh:mm)
+ * - %Z abbreviation of the time zone (e.g. PST), from the AtcZonedExtra
+ * - %F same as %Y-%m-%d, %T same as %H:%M:%S
+ * - %% the '%' character
+ *
+ * The names are in English, independent of the C locale.
+ */
+
+#ifndef ACE_TIME_C_ZONED_FORMAT_H
+#define ACE_TIME_C_ZONED_FORMAT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "string_buffer.h"
+#include "zoned_date_time.h"
+#include "zoned_extra.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+  /** Maximum number of opcodes of an AtcZonedFormat. */
+  kAtcZonedFormatMaxOps = 32,
+
+  /** Maximum number of characters of literal text of an AtcZonedFormat. */
+  kAtcZonedFormatMaxLiterals = 64,
+};
+
+/**
+ * A single instruction of an AtcZonedFormat. For literal text, `offset` and
+ * `length` locate the text in AtcZonedFormat.literals. Otherwise they are
+ * unused.
+ */
+typedef struct AtcZonedFormatOp {
+  /** The kind of field to print (see zoned_format.c). */
+  uint8_t code;
+  /** Offset of the literal text. */
+  uint8_t offset;
+  /** Length of the literal text. */
+  uint8_t length;
+} AtcZonedFormatOp;
+
+/** A compiled format. The fields are private. */
+typedef struct AtcZonedFormat {
+  /** The instructions. */
+  AtcZonedFormatOp ops[kAtcZonedFormatMaxOps];
+  /** The literal text of all instructions, without NUL terminators. */
+  char literals[kAtcZonedFormatMaxLiterals];
+  /** Number of instructions. */
+  uint8_t num_ops;
+  /** Number of characters used in `literals`. */
+  uint8_t num_literals;
+  /** Upper bound of the number of characters printed. */
+  uint8_t max_length;
+  /** True if the AtcZonedExtra is used (%Z). */
+  bool needs_extra;
+} AtcZonedFormat;
+
+/**
+ * Compile the strftime-style `pattern` into `fmt`. Adjacent literal
+ * characters are merged into a single instruction. Return kAtcErrGeneric if
+ * the pattern contains an unsupported conversion, or if it is too long.
+ */
+int8_t atc_zoned_format_compile(AtcZonedFormat *fmt, const char *pattern);
+
+/**
+ * Return the maximum number of characters printed by the format, which
+ * determines the capacity needed by atc_zoned_format_print().
+ */
+uint8_t atc_zoned_format_max_length(const AtcZonedFormat *fmt);
+
+/**
+ * Print the `zdt` into `sb` using the compiled format. The `extra` is used
+ * only by %Z, and may be NULL otherwise. The capacity of the buffer is checked
+ * once against the maximum length of the format.
+ *
+ * Return kAtcErrGeneric, and print nothing, if the buffer has less room than
+ * atc_zoned_format_max_length(), if the zdt is an error or its year is
+ * outside of [0,9999], or if the `extra` is needed but is NULL or an error.
+ */
+int8_t atc_zoned_format_print(
+    AtcStringBuffer *sb,
+    const AtcZonedFormat *fmt,
+    const AtcZonedDateTime *zdt,
+    const AtcZonedExtra *extra);
+
+/** Same as atc_zoned_format_print() into an AtcLargeStringBuffer. */
+int8_t atc_zoned_format_print_large(
+    AtcLargeStringBuffer *sb,
+    const AtcZonedFormat *fmt,
+    const AtcZonedDateTime *zdt,
+    const AtcZonedExtra *extra);
+
+/**
+ * Renders a stream of epoch seconds in a fixed time zone with a compiled
+ * format, memoizing the work shared by successive timestamps. The text of the
+ * last second is kept, and is copied again if the next timestamp is in the
+ * same second. Within the same local day and the same UTC offset, the date,
+ * the offset and the abbreviation do not change, so only the fields which
+ * depend on the time of the day (%H, %I, %p, %M, %S, %T) are patched in place.
+ * The date and the time zone are calculated again only when the local day
+ * changes, or at the next transition of the time zone. This makes the
+ * rendering of a monotonic stream of log timestamps close to a memcpy().
+ *
+ * The fields are private. The AtcZonedFormat and the AtcTimeZone must remain
+ * valid while the renderer is used. The renderer uses the current epoch year
+ * (see atc_set_current_epoch_year()), so atc_timestamp_renderer_reset() must
+ * be called if it changes.
+ */
+typedef struct AtcTimestampRenderer {
+  /** The compiled format. */
+  const AtcZonedFormat *fmt;
+  /** The time zone. */
+  AtcTimeZone tz;
+
+  /** True if `text` and the window are valid. */
+  bool is_valid;
+  /** Length of `text`. */
+  uint8_t length;
+  /** Number of `patches`. */
+  uint8_t num_patches;
+  /** The code and the position in `text` of the time of day fields. */
+  AtcZonedFormatOp patches[kAtcZonedFormatMaxOps];
+  /** The text of `second`, without a NUL terminator. */
+  char text[UINT8_MAX];
+
+  /** The epoch seconds of `text`. */
+  atc_time_t second;
+  /** The epoch seconds of the last complete rendering. */
+  atc_time_t window_start;
+  /** Number of seconds after window_start where only the time is patched. */
+  int32_t window_length;
+  /** The local seconds of the day at window_start. */
+  int32_t window_seconds_of_day;
+
+  /** Number of timestamps copied from the same second. */
+  uint32_t num_second_hits;
+  /** Number of timestamps patched within the same local day. */
+  uint32_t num_day_hits;
+  /** Number of timestamps rendered completely. */
+  uint32_t num_misses;
+} AtcTimestampRenderer;
+
+/**
+ * Initialize the renderer with the compiled format and the time zone. The
+ * AtcTimeZone is copied, but its zone_info and zone_processor are not.
+ */
+void atc_timestamp_renderer_init(
+    AtcTimestampRenderer *renderer,
+    const AtcZonedFormat *fmt,
+    const AtcTimeZone *tz);
+
+/** Invalidate the memoized text, e.g. after the current epoch year changed. */
+void atc_timestamp_renderer_reset(AtcTimestampRenderer *renderer);
+
+/**
+ * Print the epoch_seconds into `sb`, in the same way as
+ * atc_zoned_format_print() with the AtcZonedDateTime and AtcZonedExtra of the
+ * epoch_seconds in the time zone of the renderer.
+ *
+ * Return kAtcErrGeneric, and print nothing, if the epoch_seconds cannot be
+ * converted or printed, or if `sb` does not have room for the text.
+ */
+int8_t atc_timestamp_renderer_print(
+    AtcTimestampRenderer *renderer,
+    AtcStringBuffer *sb,
+    atc_time_t epoch_seconds);
+
+/** Same as atc_timestamp_renderer_print() into an AtcLargeStringBuffer. */
+int8_t atc_timestamp_renderer_print_large(
+    AtcTimestampRenderer *renderer,
+    AtcLargeStringBuffer *sb,
+    atc_time_t epoch_seconds);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
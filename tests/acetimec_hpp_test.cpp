@@ -0,0 +1,250 @@
+#include <utility> // std::move()
+#include <string.h> // strcmp()
+#include <acunit.h>
+#include <acetimec.hpp>
+
+using atc::LocalDateTime;
+using atc::TimeZone;
+using atc::ZonedDateTime;
+using atc::ZoneProcessor;
+
+//---------------------------------------------------------------------------
+// Inline helpers
+//---------------------------------------------------------------------------
+
+ACU_TEST(test_days_in_year_month)
+{
+  for (int16_t year = 1999; year <= 2101; year++) {
+    ACU_ASSERT(atc::isLeapYear(year) == atc_is_leap_year(year));
+    for (uint8_t month = 1; month <= 12; month++) {
+      ACU_ASSERT(atc::daysInYearMonth(year, month)
+          == atc_local_date_days_in_year_month(year, month));
+    }
+  }
+}
+
+static void assert_zone_helpers(
+    AcuContext *acu_context, const AtcZoneInfo *info)
+{
+  for (uint8_t i = 0; i < info->num_eras; i++) {
+    const AtcZoneEra &era = info->eras[i];
+    ACU_ASSERT(atc::zoneEraStdOffsetSeconds(era)
+        == atc_zone_era_std_offset_seconds(&era));
+    ACU_ASSERT(atc::zoneEraDstOffsetSeconds(era)
+        == atc_zone_era_dst_offset_seconds(&era));
+    ACU_ASSERT(atc::zoneEraUntilSeconds(era)
+        == atc_zone_era_until_seconds(&era));
+    ACU_ASSERT(atc::zoneEraUntilSuffix(era)
+        == atc_zone_era_until_suffix(&era));
+
+    const AtcZonePolicy *policy = era.zone_policy;
+    if (policy == NULL) continue;
+    for (uint8_t j = 0; j < policy->num_rules; j++) {
+      const AtcZoneRule &rule = policy->rules[j];
+      ACU_ASSERT(atc::zoneRuleAtSeconds(rule)
+          == atc_zone_rule_at_seconds(&rule));
+      ACU_ASSERT(atc::zoneRuleDstOffsetSeconds(rule)
+          == atc_zone_rule_dst_offset_seconds(&rule));
+      ACU_ASSERT(atc::zoneRuleAtSuffix(rule)
+          == atc_zone_rule_at_suffix(&rule));
+    }
+  }
+}
+
+ACU_TEST(test_zone_helpers)
+{
+  for (uint16_t i = 0; i < kAtcTestingZoneRegistrySize; i++) {
+    ACU_ASSERT_NO_FATAL_FAILURE(
+        assert_zone_helpers(acu_context, kAtcTestingZoneRegistry[i]));
+  }
+}
+
+//---------------------------------------------------------------------------
+// ZoneProcessor and TimeZone
+//---------------------------------------------------------------------------
+
+ACU_TEST(test_zone_processor_move)
+{
+  ZoneProcessor a;
+  AtcTimeZone tz = {&kAtcTestingZoneAmerica_Los_Angeles, a.raw()};
+  AtcZonedDateTime zdt;
+  atc_zoned_date_time_from_epoch_seconds(&zdt, 0, &tz);
+  ACU_ASSERT(a.raw()->zone_info == &kAtcTestingZoneAmerica_Los_Angeles);
+
+  // The moved-to processor starts empty, and is usable.
+  ZoneProcessor b(std::move(a));
+  ACU_ASSERT(b.raw()->zone_info == NULL);
+  tz.zone_processor = b.raw();
+  atc_zoned_date_time_from_epoch_seconds(&zdt, 0, &tz);
+  ACU_ASSERT(!atc_zoned_date_time_is_error(&zdt));
+  ACU_ASSERT(zdt.offset_seconds == -8 * 3600);
+}
+
+ACU_TEST(test_time_zone)
+{
+  TimeZone utc;
+  ACU_ASSERT(utc.isUtc());
+  ACU_ASSERT(utc.raw().zone_info == NULL);
+
+  TimeZone la(&kAtcTestingZoneAmerica_Los_Angeles);
+  ACU_ASSERT(!la.isUtc());
+  ACU_ASSERT(la.zoneInfo() == &kAtcTestingZoneAmerica_Los_Angeles);
+
+  // Moving keeps the zone_info, and binds a new processor.
+  TimeZone moved(std::move(la));
+  ACU_ASSERT(moved.zoneInfo() == &kAtcTestingZoneAmerica_Los_Angeles);
+  ACU_ASSERT(moved.raw().zone_processor != la.raw().zone_processor);
+
+  char buf[80];
+  AtcStringBuffer sb;
+  atc_buf_init(&sb, buf, sizeof(buf));
+  moved.print(&sb);
+  atc_buf_close(&sb);
+  ACU_ASSERT(strcmp(buf, "America/Los_Angeles") == 0);
+
+  // 2022-11-06T01:30:00-08:00, the second occurrence of 01:30.
+  AtcLocalDateTime ldt = {2022, 11, 6, 9, 30, 0, 0 /*fold*/};
+  atc_time_t es = atc_local_date_time_to_epoch_seconds(&ldt);
+  AtcZonedExtra extra = moved.zonedExtra(es);
+  ACU_ASSERT(extra.fold_type == kAtcFoldTypeOverlap);
+  ACU_ASSERT(extra.std_offset_seconds == -8 * 3600);
+  ACU_ASSERT(extra.dst_offset_seconds == 0);
+  ACU_ASSERT(strcmp(extra.abbrev, "PST") == 0);
+}
+
+//---------------------------------------------------------------------------
+// LocalDateTime
+//---------------------------------------------------------------------------
+
+ACU_TEST(test_local_date_time)
+{
+  LocalDateTime error;
+  ACU_ASSERT(error.isError());
+
+  LocalDateTime ldt = LocalDateTime::forComponents(2050, 1, 2, 3, 4, 5);
+  ACU_ASSERT(!ldt.isError());
+  ACU_ASSERT(ldt.year() == 2050);
+  ACU_ASSERT(ldt.month() == 1);
+  ACU_ASSERT(ldt.day() == 2);
+  ACU_ASSERT(ldt.hour() == 3);
+  ACU_ASSERT(ldt.minute() == 4);
+  ACU_ASSERT(ldt.second() == 5);
+  ACU_ASSERT(ldt.fold() == 0);
+  ACU_ASSERT(ldt.dayOfWeek() == 7); // Sunday
+
+  // Same as the C functions.
+  atc_time_t es = ldt.toEpochSeconds();
+  ACU_ASSERT(es == atc_local_date_time_to_epoch_seconds(&ldt.raw()));
+  ACU_ASSERT(LocalDateTime::forEpochSeconds(es) == ldt);
+  int64_t unix_seconds = ldt.toUnixSeconds();
+  ACU_ASSERT(unix_seconds == 2524705445);
+  ACU_ASSERT(LocalDateTime::forUnixSeconds(unix_seconds) == ldt);
+  ACU_ASSERT(LocalDateTime::forEpochSeconds(kAtcInvalidEpochSeconds)
+      .isError());
+
+  LocalDateTime other = LocalDateTime::forComponents(2050, 1, 2, 3, 4, 5, 1);
+  ACU_ASSERT(other != ldt);
+
+  char buf[80];
+  AtcStringBuffer sb;
+  atc_buf_init(&sb, buf, sizeof(buf));
+  ldt.print(&sb);
+  atc_buf_close(&sb);
+  ACU_ASSERT(strcmp(buf, "2050-01-02T03:04:05") == 0);
+}
+
+//---------------------------------------------------------------------------
+// ZonedDateTime
+//---------------------------------------------------------------------------
+
+ACU_TEST(test_zoned_date_time_for_epoch_seconds)
+{
+  TimeZone tz(&kAtcTestingZoneAmerica_Los_Angeles);
+
+  // Same as the C function over a range of instants.
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  AtcTimeZone ctz = {&kAtcTestingZoneAmerica_Los_Angeles, &processor};
+  for (atc_time_t es = 0; es < 100 * 86400; es += 3599) {
+    ZonedDateTime zdt = ZonedDateTime::forEpochSeconds(es, tz);
+    AtcZonedDateTime czdt;
+    atc_zoned_date_time_from_epoch_seconds(&czdt, es, &ctz);
+    ACU_ASSERT(zdt.year() == czdt.year);
+    ACU_ASSERT(zdt.month() == czdt.month);
+    ACU_ASSERT(zdt.day() == czdt.day);
+    ACU_ASSERT(zdt.hour() == czdt.hour);
+    ACU_ASSERT(zdt.minute() == czdt.minute);
+    ACU_ASSERT(zdt.second() == czdt.second);
+    ACU_ASSERT(zdt.fold() == czdt.fold);
+    ACU_ASSERT(zdt.offsetSeconds() == czdt.offset_seconds);
+    ACU_ASSERT(zdt.toEpochSeconds() == es);
+  }
+
+  ACU_ASSERT(ZonedDateTime().isError());
+  ACU_ASSERT(ZonedDateTime::forEpochSeconds(kAtcInvalidEpochSeconds, tz)
+      .isError());
+}
+
+ACU_TEST(test_zoned_date_time_for_local_date_time)
+{
+  TimeZone tz(&kAtcTestingZoneAmerica_Los_Angeles);
+
+  // 2022-11-06T01:30:00 occurs twice, select the second one.
+  LocalDateTime ldt = LocalDateTime::forComponents(2022, 11, 6, 1, 30, 0, 1);
+  ZonedDateTime zdt = ZonedDateTime::forLocalDateTime(ldt, tz);
+  ACU_ASSERT(!zdt.isError());
+  ACU_ASSERT(zdt.localDateTime() == ldt);
+  ACU_ASSERT(zdt.offsetSeconds() == -8 * 3600);
+  ACU_ASSERT(zdt.raw().tz.zone_info == &kAtcTestingZoneAmerica_Los_Angeles);
+
+  int64_t unix_seconds = zdt.toUnixSeconds();
+  ACU_ASSERT(unix_seconds == 1667727000);
+  ZonedDateTime same = ZonedDateTime::forUnixSeconds(unix_seconds, tz);
+  ACU_ASSERT(same.localDateTime() == ldt);
+
+  char buf[80];
+  AtcStringBuffer sb;
+  atc_buf_init(&sb, buf, sizeof(buf));
+  zdt.print(&sb);
+  atc_buf_close(&sb);
+  ACU_ASSERT(strcmp(buf, "2022-11-06T01:30:00-08:00[America/Los_Angeles]")
+      == 0);
+}
+
+ACU_TEST(test_zoned_date_time_convert)
+{
+  TimeZone la(&kAtcTestingZoneAmerica_Los_Angeles);
+  TimeZone ny(&kAtcTestingZoneAmerica_New_York);
+  TimeZone utc;
+
+  LocalDateTime ldt = LocalDateTime::forComponents(2024, 3, 10, 12, 0, 0);
+  ZonedDateTime zdt = ZonedDateTime::forLocalDateTime(ldt, la);
+
+  ZonedDateTime nyzdt = zdt.convert(ny);
+  ACU_ASSERT(nyzdt.hour() == 15);
+  ACU_ASSERT(nyzdt.offsetSeconds() == -4 * 3600);
+  ACU_ASSERT(nyzdt.toEpochSeconds() == zdt.toEpochSeconds());
+
+  ZonedDateTime utczdt = zdt.convert(utc);
+  ACU_ASSERT(utczdt.hour() == 19);
+  ACU_ASSERT(utczdt.offsetSeconds() == 0);
+
+  ACU_ASSERT(ZonedDateTime().convert(ny).isError());
+}
+
+//---------------------------------------------------------------------------
+
+ACU_CONTEXT();
+
+int main()
+{
+  ACU_RUN_TEST(test_days_in_year_month);
+  ACU_RUN_TEST(test_zone_helpers);
+  ACU_RUN_TEST(test_zone_processor_move);
+  ACU_RUN_TEST(test_time_zone);
+  ACU_RUN_TEST(test_local_date_time);
+  ACU_RUN_TEST(test_zoned_date_time_for_epoch_seconds);
+  ACU_RUN_TEST(test_zoned_date_time_for_local_date_time);
+  ACU_RUN_TEST(test_zoned_date_time_convert);
+  ACU_SUMMARY();
+}
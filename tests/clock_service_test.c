@@ -0,0 +1,181 @@
+#include <pthread.h>
+#include <string.h> // strcmp()
+#include <acunit.h>
+#include <acetimec.h>
+
+#if ATC_ENABLE_CLOCK_SERVICE
+
+enum { kNumEntries = 3 };
+
+static AtcClockEntry entries[kNumEntries];
+static AtcClockService service;
+
+//---------------------------------------------------------------------------
+
+ACU_TEST(test_atc_clock_service_add_zone)
+{
+  atc_clock_service_init(&service, entries, kNumEntries);
+
+  uint16_t index;
+  ACU_ASSERT(atc_clock_service_add_zone(
+      &service, &kAtcTestingZoneAmerica_Los_Angeles, &index) == kAtcErrOk);
+  ACU_ASSERT(index == 0);
+  ACU_ASSERT(atc_clock_service_add_zone(
+      &service, &kAtcTestingZoneEurope_Lisbon, &index) == kAtcErrOk);
+  ACU_ASSERT(index == 1);
+  ACU_ASSERT(atc_clock_service_add_zone(&service, NULL, &index) == kAtcErrOk);
+  ACU_ASSERT(index == 2);
+  ACU_ASSERT(atc_clock_service_add_zone(&service, NULL, &index)
+      == kAtcErrGeneric);
+
+  // Not updated yet.
+  AtcClockSnapshot snapshot;
+  ACU_ASSERT(atc_clock_service_get(&service, 0, &snapshot) == kAtcErrGeneric);
+
+  // Out of range.
+  ACU_ASSERT(atc_clock_service_get(&service, 3, &snapshot) == kAtcErrGeneric);
+}
+
+ACU_TEST(test_atc_clock_service_update)
+{
+  atc_clock_service_init(&service, entries, kNumEntries);
+  uint16_t la;
+  uint16_t lisbon;
+  uint16_t utc;
+  atc_clock_service_add_zone(
+      &service, &kAtcTestingZoneAmerica_Los_Angeles, &la);
+  atc_clock_service_add_zone(&service, &kAtcTestingZoneEurope_Lisbon, &lisbon);
+  atc_clock_service_add_zone(&service, NULL, &utc);
+
+  // 2022-11-06T09:30:00 UTC
+  AtcLocalDateTime ldt = {2022, 11, 6, 9, 30, 0, 0 /*fold*/};
+  atc_time_t es = atc_local_date_time_to_epoch_seconds(&ldt);
+  atc_clock_service_update(&service, es);
+  ACU_ASSERT(service.num_updates == 3);
+
+  AtcClockSnapshot snapshot;
+  ACU_ASSERT(atc_clock_service_get(&service, la, &snapshot) == kAtcErrOk);
+  ACU_ASSERT(snapshot.epoch_seconds == es);
+  ACU_ASSERT(snapshot.zdt.hour == 1);
+  ACU_ASSERT(snapshot.zdt.minute == 30);
+  ACU_ASSERT(snapshot.zdt.fold == 1);
+  ACU_ASSERT(snapshot.zdt.offset_seconds == -8 * 3600);
+  ACU_ASSERT(snapshot.zdt.tz.zone_info == &kAtcTestingZoneAmerica_Los_Angeles);
+  ACU_ASSERT(snapshot.zdt.tz.zone_processor == NULL);
+  ACU_ASSERT(strcmp(snapshot.extra.abbrev, "PST") == 0);
+
+  ACU_ASSERT(atc_clock_service_get(&service, lisbon, &snapshot) == kAtcErrOk);
+  ACU_ASSERT(snapshot.zdt.hour == 9);
+  ACU_ASSERT(strcmp(snapshot.extra.abbrev, "WET") == 0);
+
+  ACU_ASSERT(atc_clock_service_get(&service, utc, &snapshot) == kAtcErrOk);
+  ACU_ASSERT(snapshot.zdt.hour == 9);
+  ACU_ASSERT(snapshot.zdt.offset_seconds == 0);
+  ACU_ASSERT(strcmp(snapshot.extra.abbrev, "UTC") == 0);
+
+  // The same second is skipped.
+  atc_clock_service_update(&service, es);
+  ACU_ASSERT(service.num_updates == 3);
+  atc_clock_service_update(&service, es + 1);
+  ACU_ASSERT(service.num_updates == 6);
+  ACU_ASSERT(atc_clock_service_get(&service, la, &snapshot) == kAtcErrOk);
+  ACU_ASSERT(snapshot.zdt.second == 1);
+}
+
+//---------------------------------------------------------------------------
+
+enum {
+  kNumReaders = 8,
+  kNumUpdates = 20000,
+};
+
+static volatile int updater_done;
+
+// Advance the clock by 1 hour per update, so that the snapshots cross many
+// DST transitions while they are read.
+static void *updater_thread(void *arg)
+{
+  atc_time_t es = *(const atc_time_t *) arg;
+  for (int i = 0; i < kNumUpdates; i++) {
+    atc_clock_service_update(&service, es + (atc_time_t) i * 3600);
+  }
+  __atomic_store_n(&updater_done, 1, __ATOMIC_RELEASE);
+  return NULL;
+}
+
+// Each reader checks that every snapshot is internally consistent. Returns
+// the number of inconsistent snapshots.
+static void *reader_thread(void *arg)
+{
+  uintptr_t id = (uintptr_t) arg;
+  uintptr_t mismatches = 0;
+  uint16_t index = (uint16_t) (id % kNumEntries);
+  while (!__atomic_load_n(&updater_done, __ATOMIC_ACQUIRE)) {
+    AtcClockSnapshot snapshot;
+    if (atc_clock_service_get(&service, index, &snapshot)) continue;
+
+    int32_t offset = snapshot.extra.std_offset_seconds
+        + snapshot.extra.dst_offset_seconds;
+    AtcLocalDateTime ldt;
+    atc_local_date_time_from_epoch_seconds(
+        &ldt, snapshot.epoch_seconds + offset);
+    if (snapshot.zdt.offset_seconds != offset
+        || snapshot.zdt.year != ldt.year
+        || snapshot.zdt.month != ldt.month
+        || snapshot.zdt.day != ldt.day
+        || snapshot.zdt.hour != ldt.hour
+        || snapshot.zdt.minute != ldt.minute
+        || snapshot.zdt.second != ldt.second) {
+      mismatches++;
+    }
+  }
+  return (void *) mismatches;
+}
+
+ACU_TEST(test_atc_clock_service_concurrent)
+{
+  atc_clock_service_init(&service, entries, kNumEntries);
+  uint16_t index;
+  atc_clock_service_add_zone(
+      &service, &kAtcTestingZoneAmerica_Los_Angeles, &index);
+  atc_clock_service_add_zone(&service, &kAtcTestingZoneEurope_Lisbon, &index);
+  atc_clock_service_add_zone(
+      &service, &kAtcTestingZoneAmerica_New_York, &index);
+
+  AtcLocalDateTime ldt = {2020, 1, 1, 0, 0, 0, 0 /*fold*/};
+  atc_time_t es = atc_local_date_time_to_epoch_seconds(&ldt);
+  updater_done = 0;
+
+  pthread_t readers[kNumReaders];
+  for (uintptr_t i = 0; i < kNumReaders; i++) {
+    pthread_create(&readers[i], NULL, reader_thread, (void *) i);
+  }
+  pthread_t updater;
+  pthread_create(&updater, NULL, updater_thread, &es);
+
+  pthread_join(updater, NULL);
+  uintptr_t mismatches = 0;
+  for (int i = 0; i < kNumReaders; i++) {
+    void *ret;
+    pthread_join(readers[i], &ret);
+    mismatches += (uintptr_t) ret;
+  }
+  ACU_ASSERT(mismatches == 0);
+  ACU_ASSERT(service.num_updates == kNumEntries * kNumUpdates);
+}
+
+#endif
+
+//---------------------------------------------------------------------------
+
+ACU_CONTEXT();
+
+int main()
+{
+#if ATC_ENABLE_CLOCK_SERVICE
+  ACU_RUN_TEST(test_atc_clock_service_add_zone);
+  ACU_RUN_TEST(test_atc_clock_service_update);
+  ACU_RUN_TEST(test_atc_clock_service_concurrent);
+#endif
+  ACU_SUMMARY();
+}
@@ -0,0 +1,223 @@
+#include <string.h> // strcmp()
+#include <acunit.h>
+#include <acetimec.h>
+
+enum { kCapacity = 256 };
+
+//---------------------------------------------------------------------------
+
+static bool find_results_equal(const AtcFindResult *a, const AtcFindResult *b)
+{
+  if (a->type != b->type) return false;
+  if (a->type == kAtcFindResultNotFound) return true;
+  return a->fold == b->fold
+      && a->std_offset_seconds == b->std_offset_seconds
+      && a->dst_offset_seconds == b->dst_offset_seconds
+      && a->req_std_offset_seconds == b->req_std_offset_seconds
+      && a->req_dst_offset_seconds == b->req_dst_offset_seconds
+      && strcmp(a->abbrev, b->abbrev) == 0;
+}
+
+// Verify that the AtcCompiledZone returns the same results as the
+// AtcZoneProcessor, sampling every `step` seconds over the given years. If
+// `check_local` is true, the lookups by AtcLocalDateTime are also compared.
+static bool check_against_processor(
+    const AtcZoneInfo *zone_info,
+    int16_t start_year,
+    int16_t until_year,
+    int32_t step,
+    bool check_local)
+{
+  AtcCompiledTransition transitions[kCapacity];
+  AtcCompiledZone zone;
+  int8_t err = atc_compiled_zone_init(
+      &zone, zone_info, start_year, until_year, transitions, kCapacity);
+  if (err) return false;
+
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  atc_processor_init_for_zone_info(&processor, zone_info);
+
+  AtcFindResult expected;
+  AtcFindResult observed;
+  for (atc_time_t es = zone.start_epoch_seconds;
+      es < zone.until_epoch_seconds;
+      es += step) {
+    atc_processor_find_by_epoch_seconds(&processor, es, &expected);
+    atc_compiled_zone_find_by_epoch_seconds(&zone, es, &observed);
+    if (! find_results_equal(&expected, &observed)) return false;
+    if (! check_local) continue;
+
+    // Reuse the UTC date time as a local date time, in both folds.
+    AtcLocalDateTime ldt;
+    atc_local_date_time_from_epoch_seconds(&ldt, es);
+    for (uint8_t fold = 0; fold < 2; fold++) {
+      ldt.fold = fold;
+      atc_processor_find_by_local_date_time(&processor, &ldt, &expected);
+      atc_compiled_zone_find_by_local_date_time(&zone, &ldt, &observed);
+      if (! find_results_equal(&expected, &observed)) return false;
+    }
+  }
+  return true;
+}
+
+//---------------------------------------------------------------------------
+
+ACU_TEST(test_atc_compiled_zone_init)
+{
+  AtcCompiledTransition transitions[kCapacity];
+  AtcCompiledZone zone;
+  int8_t err = atc_compiled_zone_init(
+      &zone, &kAtcTestingZoneAmerica_Los_Angeles, 2000, 2050,
+      transitions, kCapacity);
+  ACU_ASSERT(err == kAtcErrOk);
+  ACU_ASSERT(zone.num_abbrevs == 2);
+  // 2 transitions per year, plus the initial one.
+  ACU_ASSERT(zone.num_transitions == 2 * 50 + 1);
+  for (uint16_t i = 1; i < zone.num_transitions; i++) {
+    ACU_ASSERT(transitions[i - 1].start_epoch_seconds
+        < transitions[i].start_epoch_seconds);
+  }
+}
+
+ACU_TEST(test_atc_compiled_zone_init_errors)
+{
+  AtcCompiledTransition transitions[kCapacity];
+  AtcCompiledZone zone;
+
+  // Invalid range of years.
+  int8_t err = atc_compiled_zone_init(
+      &zone, &kAtcTestingZoneAmerica_Los_Angeles, 2020, 2020,
+      transitions, kCapacity);
+  ACU_ASSERT(err == kAtcErrGeneric);
+  err = atc_compiled_zone_init(
+      &zone, &kAtcTestingZoneAmerica_Los_Angeles,
+      atc_epoch_valid_year_lower() - 1, 2020,
+      transitions, kCapacity);
+  ACU_ASSERT(err == kAtcErrGeneric);
+
+  // Capacity too small.
+  err = atc_compiled_zone_init(
+      &zone, &kAtcTestingZoneAmerica_Los_Angeles, 2000, 2050,
+      transitions, 10);
+  ACU_ASSERT(err == kAtcErrGeneric);
+}
+
+ACU_TEST(test_atc_compiled_zone_find_by_epoch_seconds)
+{
+  AtcCompiledTransition transitions[kCapacity];
+  AtcCompiledZone zone;
+  atc_compiled_zone_init(
+      &zone, &kAtcTestingZoneAmerica_Los_Angeles, 2020, 2030,
+      transitions, kCapacity);
+
+  // 2022-11-06T01:30:00-07:00 is the first occurrence of the overlap.
+  AtcLocalDateTime ldt = {2022, 11, 6, 8, 30, 0, 0 /*fold*/};
+  atc_time_t es = atc_local_date_time_to_epoch_seconds(&ldt);
+  AtcFindResult result;
+  atc_compiled_zone_find_by_epoch_seconds(&zone, es, &result);
+  ACU_ASSERT(result.type == kAtcFindResultOverlap);
+  ACU_ASSERT(result.fold == 0);
+  ACU_ASSERT(result.std_offset_seconds == -8*3600);
+  ACU_ASSERT(result.dst_offset_seconds == 1*3600);
+  ACU_ASSERT(strcmp(result.abbrev, "PDT") == 0);
+
+  // One hour later is the second occurrence.
+  atc_compiled_zone_find_by_epoch_seconds(&zone, es + 3600, &result);
+  ACU_ASSERT(result.type == kAtcFindResultOverlap);
+  ACU_ASSERT(result.fold == 1);
+  ACU_ASSERT(result.std_offset_seconds == -8*3600);
+  ACU_ASSERT(result.dst_offset_seconds == 0);
+  ACU_ASSERT(strcmp(result.abbrev, "PST") == 0);
+
+  // Outside the range of years.
+  atc_compiled_zone_find_by_epoch_seconds(
+      &zone, zone.start_epoch_seconds - 1, &result);
+  ACU_ASSERT(result.type == kAtcFindResultNotFound);
+  atc_compiled_zone_find_by_epoch_seconds(
+      &zone, zone.until_epoch_seconds, &result);
+  ACU_ASSERT(result.type == kAtcFindResultNotFound);
+}
+
+ACU_TEST(test_atc_compiled_zone_find_by_local_date_time)
+{
+  AtcCompiledTransition transitions[kCapacity];
+  AtcCompiledZone zone;
+  atc_compiled_zone_init(
+      &zone, &kAtcTestingZoneAmerica_Los_Angeles, 2020, 2030,
+      transitions, kCapacity);
+
+  // 2022-03-13T02:30:00 is in the gap
+  AtcLocalDateTime ldt = {2022, 3, 13, 2, 30, 0, 0 /*fold*/};
+  AtcFindResult result;
+  atc_compiled_zone_find_by_local_date_time(&zone, &ldt, &result);
+  ACU_ASSERT(result.type == kAtcFindResultGap);
+  ACU_ASSERT(result.std_offset_seconds == -8*3600);
+  ACU_ASSERT(result.dst_offset_seconds == 1*3600);
+  ACU_ASSERT(result.req_std_offset_seconds == -8*3600);
+  ACU_ASSERT(result.req_dst_offset_seconds == 0);
+  ACU_ASSERT(strcmp(result.abbrev, "PDT") == 0);
+
+  // 2022-11-06T01:30:00 is in the overlap
+  AtcLocalDateTime ldt2 = {2022, 11, 6, 1, 30, 0, 1 /*fold*/};
+  atc_compiled_zone_find_by_local_date_time(&zone, &ldt2, &result);
+  ACU_ASSERT(result.type == kAtcFindResultOverlap);
+  ACU_ASSERT(result.fold == 1);
+  ACU_ASSERT(result.std_offset_seconds == -8*3600);
+  ACU_ASSERT(result.dst_offset_seconds == 0);
+  ACU_ASSERT(strcmp(result.abbrev, "PST") == 0);
+
+  // Outside the range of years.
+  AtcLocalDateTime ldt3 = {2030, 1, 1, 0, 0, 0, 0 /*fold*/};
+  atc_compiled_zone_find_by_local_date_time(&zone, &ldt3, &result);
+  ACU_ASSERT(result.type == kAtcFindResultNotFound);
+}
+
+ACU_TEST(test_atc_compiled_zone_epoch_year_changed)
+{
+  AtcCompiledTransition transitions[kCapacity];
+  AtcCompiledZone zone;
+  atc_compiled_zone_init(
+      &zone, &kAtcTestingZoneAmerica_Los_Angeles, 2020, 2030,
+      transitions, kCapacity);
+
+  int16_t saved_epoch_year = atc_get_current_epoch_year();
+  atc_set_current_epoch_year(2100);
+  AtcFindResult result;
+  atc_compiled_zone_find_by_epoch_seconds(&zone, 0, &result);
+  atc_set_current_epoch_year(saved_epoch_year);
+  ACU_ASSERT(result.type == kAtcFindResultNotFound);
+}
+
+ACU_TEST(test_atc_compiled_zone_matches_processor_los_angeles)
+{
+  ACU_ASSERT(check_against_processor(
+      &kAtcTestingZoneAmerica_Los_Angeles, 2000, 2050, 1800, true));
+}
+
+// The AtcZoneProcessor does not detect the overlap of some zones whose
+// transitions occur near midnight (e.g. Pacific/Easter in 2016), so only the
+// lookups by epoch seconds are compared across all zones.
+ACU_TEST(test_atc_compiled_zone_matches_processor_all_zones)
+{
+  for (uint16_t i = 0; i < kAtcAllZoneRegistrySize; i++) {
+    const AtcZoneInfo *zone_info = kAtcAllZoneRegistry[i];
+    ACU_ASSERT(check_against_processor(zone_info, 2000, 2050, 6 * 3600, false));
+  }
+}
+
+//---------------------------------------------------------------------------
+
+ACU_CONTEXT();
+
+int main()
+{
+  ACU_RUN_TEST(test_atc_compiled_zone_init);
+  ACU_RUN_TEST(test_atc_compiled_zone_init_errors);
+  ACU_RUN_TEST(test_atc_compiled_zone_find_by_epoch_seconds);
+  ACU_RUN_TEST(test_atc_compiled_zone_find_by_local_date_time);
+  ACU_RUN_TEST(test_atc_compiled_zone_epoch_year_changed);
+  ACU_RUN_TEST(test_atc_compiled_zone_matches_processor_los_angeles);
+  ACU_RUN_TEST(test_atc_compiled_zone_matches_processor_all_zones);
+  ACU_SUMMARY();
+}
@@ -83,6 +83,15 @@ ACU_TEST(test_atc_date_tuple_subtract_no_overflow)
     atc_time_t diff = atc_date_tuple_subtract(&dta, &dtb);
     ACU_ASSERT((int32_t) -86400 * 29 == diff); // Feb 6000 is leap, 29 days
   }
+
+#if ATC_TIME64
+  {
+    AtcDateTuple dta = {1900, 1, 1, 0, kAtcSuffixW}; // 1900-01-01 00:00
+    AtcDateTuple dtb = {2100, 1, 1, 0, kAtcSuffixW}; // 2100-01-01 00:00
+    atc_time_t diff = atc_date_tuple_subtract(&dta, &dtb);
+    ACU_ASSERT((atc_time_t) -86400 * 73049 == diff); // 200 years, 49 leaps
+  }
+#endif
 }
 
 ACU_TEST(test_atc_date_tuple_normalize)
@@ -1,3 +1,4 @@
+#include <stdbool.h>
 #include <stdint.h> // int64_t
 #include <acunit.h>
 #include <string.h>
@@ -17,6 +18,157 @@ ACU_TEST(test_atc_epoch_seconds_from_unix_seconds)
   ACU_ASSERT(epoch_seconds == -1577923200);
 }
 
+ACU_TEST(test_atc_epoch_context_init)
+{
+  AtcEpochContext ctx;
+  atc_epoch_context_init(&ctx, 2000);
+  ACU_ASSERT(ctx.epoch_year == 2000);
+  ACU_ASSERT(ctx.days_to_current_epoch_from_internal_epoch == 0);
+
+  atc_epoch_context_init(&ctx, kAtcDefaultEpochYear);
+  ACU_ASSERT(ctx.days_to_current_epoch_from_internal_epoch
+      == kAtcDaysToDefaultEpochFromInternalEpoch);
+#if ATC_TIME64
+  ACU_ASSERT(atc_epoch_context_valid_year_lower(&ctx) == kAtcMinYear + 1);
+  ACU_ASSERT(atc_epoch_context_valid_year_upper(&ctx) == kAtcMaxYear);
+#else
+  ACU_ASSERT(atc_epoch_context_valid_year_lower(&ctx) == 2000);
+  ACU_ASSERT(atc_epoch_context_valid_year_upper(&ctx) == 2100);
+#endif
+
+  atc_epoch_context_init_from_current(&ctx);
+  ACU_ASSERT(ctx.epoch_year == atc_get_current_epoch_year());
+  ACU_ASSERT(ctx.days_to_current_epoch_from_internal_epoch
+      == atc_days_to_current_epoch_from_internal_epoch);
+}
+
+ACU_TEST(test_atc_epoch_conversions_ctx)
+{
+  AtcEpochContext ctx;
+  atc_epoch_context_init(&ctx, 2000);
+
+  // The global epoch year is not used.
+  ACU_ASSERT(atc_unix_seconds_from_epoch_seconds_ctx(&ctx, 0) == 946684800);
+  ACU_ASSERT(atc_epoch_seconds_from_unix_seconds_ctx(&ctx, 946684800) == 0);
+  ACU_ASSERT(atc_unix_days_from_epoch_days_ctx(&ctx, 0) == 10957);
+  ACU_ASSERT(atc_epoch_days_from_unix_days_ctx(&ctx, 10957) == 0);
+  ACU_ASSERT(atc_get_current_epoch_year() == kAtcDefaultEpochYear);
+
+  ACU_ASSERT(atc_unix_seconds_from_epoch_seconds_ctx(
+      &ctx, kAtcInvalidEpochSeconds) == kAtcInvalidUnixSeconds);
+  ACU_ASSERT(atc_epoch_seconds_from_unix_seconds_ctx(
+      &ctx, kAtcInvalidUnixSeconds) == kAtcInvalidEpochSeconds);
+}
+
+ACU_TEST(test_atc_convert_internal_days_year_limits)
+{
+  ACU_ASSERT(atc_convert_to_internal_days(0, 1, 1) == -730485);
+  ACU_ASSERT(atc_convert_to_internal_days(0, 2, 29) == -730426);
+  ACU_ASSERT(atc_convert_to_internal_days(10000, 12, 31) == 2922305);
+
+  int16_t year;
+  uint8_t month;
+  uint8_t day;
+  atc_convert_from_internal_days(-730485, &year, &month, &day);
+  ACU_ASSERT(year == 0);
+  ACU_ASSERT(month == 1);
+  ACU_ASSERT(day == 1);
+  atc_convert_from_internal_days(-730426, &year, &month, &day);
+  ACU_ASSERT(year == 0);
+  ACU_ASSERT(month == 2);
+  ACU_ASSERT(day == 29);
+  atc_convert_from_internal_days(2922305, &year, &month, &day);
+  ACU_ASSERT(year == 10000);
+  ACU_ASSERT(month == 12);
+  ACU_ASSERT(day == 31);
+}
+
+// Compare the 2 algorithms over every day of the years [0,10000].
+ACU_TEST(test_atc_convert_internal_days_neri_schneider)
+{
+  int32_t begin = atc_convert_to_internal_days_hinnant(0, 1, 1);
+  int32_t end = atc_convert_to_internal_days_hinnant(10000, 12, 31) + 1;
+  bool equal = true;
+  for (int32_t internal_days = begin; internal_days < end; internal_days++) {
+    int16_t year;
+    uint8_t month;
+    uint8_t day;
+    atc_convert_from_internal_days_hinnant(internal_days, &year, &month, &day);
+    int16_t ns_year;
+    uint8_t ns_month;
+    uint8_t ns_day;
+    atc_convert_from_internal_days_neri_schneider(
+        internal_days, &ns_year, &ns_month, &ns_day);
+    equal = equal && year == ns_year && month == ns_month && day == ns_day;
+    equal = equal && atc_convert_to_internal_days_neri_schneider(
+        year, month, day) == internal_days;
+    if (!equal) break;
+  }
+  ACU_ASSERT(equal);
+}
+
+// Odd, so that the scalar tail of the SIMD loops is used.
+#define NUM_DAYS_CHUNK 1001
+
+static int16_t years[NUM_DAYS_CHUNK];
+static uint8_t months[NUM_DAYS_CHUNK];
+static uint8_t days[NUM_DAYS_CHUNK];
+static int32_t internal_days[NUM_DAYS_CHUNK];
+
+// Convert every day of the years [0,10000] in chunks, and compare with the
+// scalar functions.
+static bool check_convert_internal_days_n(void)
+{
+  int32_t begin = atc_convert_to_internal_days(0, 1, 1);
+  int32_t end = atc_convert_to_internal_days(10000, 12, 31) + 1;
+  for (int32_t start = begin; start < end; start += NUM_DAYS_CHUNK) {
+    size_t n = (end - start < NUM_DAYS_CHUNK)
+        ? (size_t) (end - start) : NUM_DAYS_CHUNK;
+    for (size_t i = 0; i < n; i++) {
+      internal_days[i] = start + (int32_t) i;
+    }
+    atc_convert_from_internal_days_n(internal_days, n, years, months, days);
+    for (size_t i = 0; i < n; i++) {
+      int16_t year;
+      uint8_t month;
+      uint8_t day;
+      atc_convert_from_internal_days(internal_days[i], &year, &month, &day);
+      if (years[i] != year || months[i] != month || days[i] != day) {
+        return false;
+      }
+    }
+
+    atc_convert_to_internal_days_n(years, months, days, n, internal_days);
+    for (size_t i = 0; i < n; i++) {
+      if (internal_days[i] != start + (int32_t) i) return false;
+    }
+  }
+  return true;
+}
+
+ACU_TEST(test_atc_convert_internal_days_n)
+{
+  uint8_t level = atc_get_simd_level();
+
+  atc_set_simd_level(kAtcSimdNone);
+  ACU_ASSERT(atc_get_simd_level() == kAtcSimdNone);
+  ACU_ASSERT(check_convert_internal_days_n());
+
+  // The levels which are not supported by the CPU fall back to the scalar
+  // functions.
+  atc_set_simd_level(kAtcSimdSse41);
+  ACU_ASSERT(atc_get_simd_level() <= kAtcSimdSse41);
+  ACU_ASSERT(check_convert_internal_days_n());
+
+  atc_set_simd_level(kAtcSimdAvx2);
+  ACU_ASSERT(atc_get_simd_level() == level);
+  ACU_ASSERT(check_convert_internal_days_n());
+
+  // Empty arrays.
+  atc_convert_to_internal_days_n(NULL, NULL, NULL, 0, NULL);
+  atc_convert_from_internal_days_n(NULL, 0, NULL, NULL, NULL);
+}
+
 //---------------------------------------------------------------------------
 
 ACU_CONTEXT();
@@ -25,5 +177,10 @@ int main()
 {
   ACU_RUN_TEST(test_atc_unix_seconds_from_epoch_seconds);
   ACU_RUN_TEST(test_atc_epoch_seconds_from_unix_seconds);
+  ACU_RUN_TEST(test_atc_epoch_context_init);
+  ACU_RUN_TEST(test_atc_epoch_conversions_ctx);
+  ACU_RUN_TEST(test_atc_convert_internal_days_year_limits);
+  ACU_RUN_TEST(test_atc_convert_internal_days_neri_schneider);
+  ACU_RUN_TEST(test_atc_convert_internal_days_n);
   ACU_SUMMARY();
 }
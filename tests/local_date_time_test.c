@@ -1,3 +1,4 @@
+#include <string.h> // strlen()
 #include <acunit.h>
 #include <acetimec.h>
 
@@ -90,6 +91,37 @@ ACU_TEST(test_local_date_time_from_epoch_seconds)
   atc_set_current_epoch_year(saved_epoch_year);
 }
 
+// Verify the split of epoch seconds into date and time fields over the whole
+// range of 32-bit epoch seconds, using a stride which is prime to 86400, and
+// every second of the days around the epoch.
+static bool check_from_epoch_seconds(atc_time_t epoch_seconds)
+{
+  AtcLocalDateTime ldt;
+  atc_local_date_time_from_epoch_seconds(&ldt, epoch_seconds);
+  return !atc_local_date_time_is_error(&ldt)
+      && ldt.hour < 24
+      && ldt.minute < 60
+      && ldt.second < 60
+      && atc_local_date_time_to_epoch_seconds(&ldt) == epoch_seconds;
+}
+
+ACU_TEST(test_local_date_time_from_epoch_seconds_round_trip)
+{
+  int16_t saved_epoch_year = atc_get_current_epoch_year();
+  atc_set_current_epoch_year(2000);
+
+  bool ok = true;
+  for (int64_t s = INT32_MIN + 1; ok && s <= INT32_MAX; s += 8191) {
+    ok = check_from_epoch_seconds((atc_time_t) s);
+  }
+  for (int32_t s = -2 * 86400; ok && s < 2 * 86400; s++) {
+    ok = check_from_epoch_seconds(s);
+  }
+  ACU_ASSERT(ok);
+
+  atc_set_current_epoch_year(saved_epoch_year);
+}
+
 //---------------------------------------------------------------------------
 
 ACU_TEST(test_local_date_time_to_epoch_seconds_epoch2050)
@@ -153,6 +185,30 @@ ACU_TEST(test_local_date_time_from_epoch_seconds_epoch2050)
   atc_set_current_epoch_year(saved_epoch_year);
 }
 
+ACU_TEST(test_local_date_time_epoch_seconds_ctx)
+{
+  AtcEpochContext ctx;
+  atc_epoch_context_init(&ctx, 2000);
+
+  // Uses the epoch of ctx, not the global current epoch year (2050).
+  AtcLocalDateTime ldt = {2000, 1, 2, 0, 0, 1, 0 /*fold*/};
+  atc_time_t seconds = atc_local_date_time_to_epoch_seconds_ctx(&ctx, &ldt);
+  ACU_ASSERT(seconds == 86401);
+
+  atc_local_date_time_from_epoch_seconds_ctx(&ctx, &ldt, -1);
+  ACU_ASSERT(!atc_local_date_time_is_error(&ldt));
+  ACU_ASSERT(ldt.year == 1999);
+  ACU_ASSERT(ldt.month == 12);
+  ACU_ASSERT(ldt.day == 31);
+  ACU_ASSERT(ldt.hour == 23);
+  ACU_ASSERT(ldt.minute == 59);
+  ACU_ASSERT(ldt.second == 59);
+
+  atc_local_date_time_from_epoch_seconds_ctx(
+      &ctx, &ldt, kAtcInvalidEpochSeconds);
+  ACU_ASSERT(atc_local_date_time_is_error(&ldt));
+}
+
 //---------------------------------------------------------------------------
 
 ACU_TEST(test_local_date_time_to_unix_seconds)
@@ -213,6 +269,127 @@ ACU_TEST(test_local_date_time_from_unix_seconds)
   ACU_ASSERT(ldt.second == 5);
 }
 
+ACU_TEST(test_local_date_time_epoch_seconds_time64)
+{
+#if ATC_TIME64
+  ACU_ASSERT(sizeof(atc_time_t) == 8);
+
+  // Far outside of the 32-bit range around the default epoch year 2050.
+  AtcLocalDateTime ldt = {1, 1, 1, 0, 0, 0, 0 /*fold*/};
+  atc_time_t seconds = atc_local_date_time_to_epoch_seconds(&ldt);
+  ACU_ASSERT(seconds == (atc_time_t) -86400 * 748382);
+  AtcLocalDateTime back;
+  atc_local_date_time_from_epoch_seconds(&back, seconds);
+  ACU_ASSERT(back.year == 1);
+  ACU_ASSERT(back.month == 1);
+  ACU_ASSERT(back.day == 1);
+
+  ldt = (AtcLocalDateTime) {9999, 12, 31, 23, 59, 59, 0 /*fold*/};
+  seconds = atc_local_date_time_to_epoch_seconds(&ldt);
+  atc_local_date_time_from_epoch_seconds(&back, seconds);
+  ACU_ASSERT(back.year == 9999);
+  ACU_ASSERT(back.month == 12);
+  ACU_ASSERT(back.day == 31);
+  ACU_ASSERT(back.hour == 23);
+  ACU_ASSERT(back.minute == 59);
+  ACU_ASSERT(back.second == 59);
+
+  // Years which cannot be represented are errors, instead of being truncated.
+  atc_local_date_time_from_epoch_seconds(&back, (atc_time_t) -86400 * 748383);
+  ACU_ASSERT(atc_local_date_time_is_error(&back));
+  atc_local_date_time_from_epoch_seconds(&back, INT64_MAX);
+  ACU_ASSERT(atc_local_date_time_is_error(&back));
+#else
+  ACU_ASSERT(sizeof(atc_time_t) == 4);
+#endif
+}
+
+//---------------------------------------------------------------------------
+
+static bool parse_equals(
+    const char *s,
+    int16_t year, uint8_t month, uint8_t day,
+    uint8_t hour, uint8_t minute, uint8_t second)
+{
+  AtcLocalDateTime ldt;
+  int8_t err = atc_local_date_time_parse(&ldt, s, strlen(s));
+  return err == kAtcErrOk
+      && ldt.year == year
+      && ldt.month == month
+      && ldt.day == day
+      && ldt.hour == hour
+      && ldt.minute == minute
+      && ldt.second == second
+      && ldt.fold == 0;
+}
+
+static bool parse_fails(const char *s)
+{
+  AtcLocalDateTime ldt;
+  int8_t err = atc_local_date_time_parse(&ldt, s, strlen(s));
+  return err == kAtcErrGeneric && atc_local_date_time_is_error(&ldt);
+}
+
+static bool check_parse(void)
+{
+  return parse_equals("2024-03-10T02:30:45", 2024, 3, 10, 2, 30, 45)
+      && parse_equals("0000-01-01T00:00:00", 0, 1, 1, 0, 0, 0)
+      && parse_equals("9999-12-31t23:59:59", 9999, 12, 31, 23, 59, 59)
+      && parse_equals("2024-02-29 12:00:00", 2024, 2, 29, 12, 0, 0)
+      && parse_equals("2024-02-29T12:00:00.123", 2024, 2, 29, 12, 0, 0)
+      && parse_equals("2024-02-29T12:00:00,123456789", 2024, 2, 29, 12, 0, 0)
+      // Syntax
+      && parse_fails("")
+      && parse_fails("2024-03-10T02:30")
+      && parse_fails("2024-03-10T02:30:4")
+      && parse_fails("2024-03-10T02:30:45Z")
+      && parse_fails("2024-03-10T02:30:45.")
+      && parse_fails("2024/03-10T02:30:45")
+      && parse_fails("2024-03/10T02:30:45")
+      && parse_fails("2024-03-10_02:30:45")
+      && parse_fails("2024-03-10T02-30:45")
+      && parse_fails("2024-03-10T02:30-45")
+      && parse_fails("2O24-03-10T02:30:45")
+      && parse_fails("2024-0a-10T02:30:45")
+      && parse_fails("2024-03-1/T02:30:45")
+      && parse_fails("2024-03-10T:2:30:45")
+      && parse_fails("2024-03-10T02:3 :45")
+      && parse_fails("2024-03-10T02:30:4x")
+      // Ranges
+      && parse_fails("2024-00-10T02:30:45")
+      && parse_fails("2024-13-10T02:30:45")
+      && parse_fails("2024-03-00T02:30:45")
+      && parse_fails("2024-04-31T02:30:45")
+      && parse_fails("2023-02-29T02:30:45")
+      && parse_fails("2024-03-10T24:00:00")
+      && parse_fails("2024-03-10T02:60:45")
+      && parse_fails("2024-03-10T02:30:60");
+}
+
+ACU_TEST(test_local_date_time_parse)
+{
+  uint8_t level = atc_get_simd_level();
+  atc_set_simd_level(kAtcSimdNone);
+  ACU_ASSERT(check_parse());
+  atc_set_simd_level(kAtcSimdAvx2);
+  ACU_ASSERT(atc_get_simd_level() == level);
+  ACU_ASSERT(check_parse());
+}
+
+ACU_TEST(test_local_date_time_parse_prefix)
+{
+  const char s[] = "2024-03-10T02:30:45.250-08:00";
+  AtcLocalDateTime ldt;
+  size_t n = atc_local_date_time_parse_prefix(&ldt, s, strlen(s));
+  ACU_ASSERT(n == 23);
+  ACU_ASSERT(ldt.second == 45);
+
+  // The length is honored, without a NUL terminator.
+  n = atc_local_date_time_parse_prefix(&ldt, s, 18);
+  ACU_ASSERT(n == 0);
+  ACU_ASSERT(atc_local_date_time_is_error(&ldt));
+}
+
 //---------------------------------------------------------------------------
 
 ACU_CONTEXT();
@@ -222,9 +399,14 @@ int main()
   ACU_RUN_TEST(test_local_date_time_errors);
   ACU_RUN_TEST(test_local_date_time_to_epoch_seconds);
   ACU_RUN_TEST(test_local_date_time_from_epoch_seconds);
+  ACU_RUN_TEST(test_local_date_time_from_epoch_seconds_round_trip);
   ACU_RUN_TEST(test_local_date_time_to_epoch_seconds_epoch2050);
   ACU_RUN_TEST(test_local_date_time_from_epoch_seconds_epoch2050);
+  ACU_RUN_TEST(test_local_date_time_epoch_seconds_ctx);
   ACU_RUN_TEST(test_local_date_time_to_unix_seconds);
   ACU_RUN_TEST(test_local_date_time_from_unix_seconds);
+  ACU_RUN_TEST(test_local_date_time_epoch_seconds_time64);
+  ACU_RUN_TEST(test_local_date_time_parse);
+  ACU_RUN_TEST(test_local_date_time_parse_prefix);
   ACU_SUMMARY();
 }
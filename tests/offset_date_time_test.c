@@ -1,3 +1,4 @@
+#include <string.h> // strlen()
 #include <acunit.h>
 #include <acetimec.h>
 
@@ -252,6 +253,56 @@ ACU_TEST(test_offset_date_time_from_unix_seconds)
 
 //---------------------------------------------------------------------------
 
+ACU_TEST(test_offset_date_time_parse)
+{
+  AtcOffsetDateTime odt;
+  const char *s = "2024-03-10T02:30:45Z";
+  ACU_ASSERT(atc_offset_date_time_parse(&odt, s, strlen(s)) == kAtcErrOk);
+  ACU_ASSERT(odt.year == 2024);
+  ACU_ASSERT(odt.month == 3);
+  ACU_ASSERT(odt.day == 10);
+  ACU_ASSERT(odt.hour == 2);
+  ACU_ASSERT(odt.minute == 30);
+  ACU_ASSERT(odt.second == 45);
+  ACU_ASSERT(odt.fold == 0);
+  ACU_ASSERT(odt.offset_seconds == 0);
+
+  s = "2024-03-10T02:30:45.5+05:30";
+  ACU_ASSERT(atc_offset_date_time_parse(&odt, s, strlen(s)) == kAtcErrOk);
+  ACU_ASSERT(odt.second == 45);
+  ACU_ASSERT(odt.offset_seconds == 5 * 3600 + 30 * 60);
+
+  s = "2024-03-10 02:30:45-08:00";
+  ACU_ASSERT(atc_offset_date_time_parse(&odt, s, strlen(s)) == kAtcErrOk);
+  ACU_ASSERT(odt.offset_seconds == -8 * 3600);
+
+  // Round trip with atc_offset_date_time_print().
+  char buf[64];
+  AtcStringBuffer sb;
+  atc_buf_init(&sb, buf, sizeof(buf));
+  atc_offset_date_time_print(&sb, &odt);
+  atc_buf_close(&sb);
+  ACU_ASSERT(strcmp(sb.p, "2024-03-10T02:30:45-08:00") == 0);
+
+  const char * const errors[] = {
+    "2024-03-10T02:30:45", // missing offset
+    "2024-03-10T02:30:45+08", // short offset
+    "2024-03-10T02:30:45+0800",
+    "2024-03-10T02:30:45+24:00",
+    "2024-03-10T02:30:45+08:60",
+    "2024-03-10T02:30:45+08:00x",
+    "2024-03-10T02:30:45ZZ",
+    "2024-02-30T02:30:45Z",
+  };
+  for (size_t i = 0; i < sizeof(errors) / sizeof(errors[0]); i++) {
+    int8_t err = atc_offset_date_time_parse(&odt, errors[i], strlen(errors[i]));
+    ACU_ASSERT(err == kAtcErrGeneric);
+    ACU_ASSERT(atc_offset_date_time_is_error(&odt));
+  }
+}
+
+//---------------------------------------------------------------------------
+
 ACU_CONTEXT();
 
 int main()
@@ -265,5 +316,6 @@ int main()
   ACU_RUN_TEST(test_offset_date_time_from_epoch_seconds_epoch2050);
   ACU_RUN_TEST(test_offset_date_time_to_unix_seconds);
   ACU_RUN_TEST(test_offset_date_time_from_unix_seconds);
+  ACU_RUN_TEST(test_offset_date_time_parse);
   ACU_SUMMARY();
 }
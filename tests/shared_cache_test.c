@@ -0,0 +1,218 @@
+#include <pthread.h>
+#include <string.h> // strcmp()
+#include <acunit.h>
+#include <acetimec.h>
+
+#if ATC_ENABLE_SHARED_CACHE
+
+enum { kCacheSize = 64 };
+
+static AtcSharedCacheEntry entries[kCacheSize];
+static AtcSharedCache cache;
+
+//---------------------------------------------------------------------------
+
+ACU_TEST(test_atc_shared_cache_find_by_epoch_seconds)
+{
+  atc_shared_cache_init(&cache, entries, kCacheSize);
+  atc_shared_cache_enable_stats(&cache, true);
+
+  // 2022-11-06T01:30:00-08:00, the second occurrence in the overlap
+  AtcLocalDateTime ldt = {2022, 11, 6, 9, 30, 0, 0 /*fold*/};
+  atc_time_t es = atc_local_date_time_to_epoch_seconds(&ldt);
+
+  AtcFindResult result;
+  char abbrev[kAtcAbbrevSize];
+  atc_shared_cache_find_by_epoch_seconds(
+      &cache, &kAtcTestingZoneAmerica_Los_Angeles, es, &result, abbrev);
+  ACU_ASSERT(result.type == kAtcFindResultOverlap);
+  ACU_ASSERT(result.fold == 1);
+  ACU_ASSERT(result.std_offset_seconds == -8*3600);
+  ACU_ASSERT(result.dst_offset_seconds == 0);
+  ACU_ASSERT(result.abbrev == abbrev);
+  ACU_ASSERT(strcmp(abbrev, "PST") == 0);
+  ACU_ASSERT(cache.num_misses == 1);
+  ACU_ASSERT(cache.num_hits == 0);
+
+  atc_shared_cache_find_by_epoch_seconds(
+      &cache, &kAtcTestingZoneAmerica_Los_Angeles, es, &result, abbrev);
+  ACU_ASSERT(result.type == kAtcFindResultOverlap);
+  ACU_ASSERT(cache.num_misses == 1);
+  ACU_ASSERT(cache.num_hits == 1);
+
+  // Out of range
+  atc_shared_cache_find_by_epoch_seconds(
+      &cache, &kAtcTestingZoneAmerica_Los_Angeles, kAtcInvalidEpochSeconds,
+      &result, abbrev);
+  ACU_ASSERT(result.type == kAtcFindResultNotFound);
+}
+
+ACU_TEST(test_atc_shared_cache_find_by_local_date_time)
+{
+  atc_shared_cache_init(&cache, entries, kCacheSize);
+  atc_shared_cache_enable_stats(&cache, true);
+
+  // 2022-03-13T02:30:00 is in the gap
+  AtcLocalDateTime ldt = {2022, 3, 13, 2, 30, 0, 0 /*fold*/};
+  AtcFindResult result;
+  char abbrev[kAtcAbbrevSize];
+  atc_shared_cache_find_by_local_date_time(
+      &cache, &kAtcTestingZoneAmerica_Los_Angeles, &ldt, &result, abbrev);
+  ACU_ASSERT(result.type == kAtcFindResultGap);
+  ACU_ASSERT(result.std_offset_seconds == -8*3600);
+  ACU_ASSERT(result.dst_offset_seconds == 1*3600);
+  ACU_ASSERT(result.req_std_offset_seconds == -8*3600);
+  ACU_ASSERT(result.req_dst_offset_seconds == 0);
+  ACU_ASSERT(strcmp(abbrev, "PDT") == 0);
+
+  // Invalid year is not cached.
+  ldt.year = kAtcMaxYear;
+  atc_shared_cache_find_by_local_date_time(
+      &cache, &kAtcTestingZoneAmerica_Los_Angeles, &ldt, &result, abbrev);
+  ACU_ASSERT(result.type == kAtcFindResultNotFound);
+  ACU_ASSERT(cache.num_misses == 1);
+}
+
+ACU_TEST(test_atc_shared_cache_stats_disabled)
+{
+  atc_shared_cache_init(&cache, entries, kCacheSize);
+  ACU_ASSERT(! cache.is_counting);
+
+  AtcLocalDateTime ldt = {2022, 11, 6, 9, 30, 0, 0 /*fold*/};
+  atc_time_t es = atc_local_date_time_to_epoch_seconds(&ldt);
+  AtcFindResult result;
+  char abbrev[kAtcAbbrevSize];
+  atc_shared_cache_find_by_epoch_seconds(
+      &cache, &kAtcTestingZoneAmerica_Los_Angeles, es, &result, abbrev);
+  atc_shared_cache_find_by_epoch_seconds(
+      &cache, &kAtcTestingZoneAmerica_Los_Angeles, es, &result, abbrev);
+  ACU_ASSERT(result.type == kAtcFindResultOverlap);
+  ACU_ASSERT(cache.num_misses == 0);
+  ACU_ASSERT(cache.num_hits == 0);
+}
+
+ACU_TEST(test_atc_shared_cache_matches_time_zone)
+{
+  atc_shared_cache_init(&cache, entries, kCacheSize);
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  AtcTimeZone tz = {&kAtcTestingZoneAmerica_Los_Angeles, &processor};
+
+  // 2022-03-13T02:30:00 is in the gap, fold=1 normalizes to 01:30-08:00
+  AtcLocalDateTime ldt = {2022, 3, 13, 2, 30, 0, 1 /*fold*/};
+  AtcOffsetDateTime expected;
+  AtcOffsetDateTime observed;
+  atc_time_zone_offset_date_time_from_local_date_time(&tz, &ldt, &expected);
+  atc_shared_cache_offset_date_time_from_local_date_time(
+      &cache, tz.zone_info, &ldt, &observed);
+  ACU_ASSERT(memcmp(&expected, &observed, sizeof(AtcOffsetDateTime)) == 0);
+
+  atc_time_t es = atc_offset_date_time_to_epoch_seconds(&expected);
+  atc_time_zone_offset_date_time_from_epoch_seconds(&tz, es, &expected);
+  atc_shared_cache_offset_date_time_from_epoch_seconds(
+      &cache, tz.zone_info, es, &observed);
+  ACU_ASSERT(memcmp(&expected, &observed, sizeof(AtcOffsetDateTime)) == 0);
+
+  AtcZonedExtra extra;
+  atc_shared_cache_zoned_extra_from_epoch_seconds(
+      &cache, tz.zone_info, es, &extra);
+  ACU_ASSERT(extra.fold_type == kAtcFoldTypeExact);
+  ACU_ASSERT(strcmp(extra.abbrev, "PST") == 0);
+
+  atc_shared_cache_zoned_extra_from_local_date_time(
+      &cache, tz.zone_info, &ldt, &extra);
+  ACU_ASSERT(extra.fold_type == kAtcFoldTypeGap);
+  ACU_ASSERT(strcmp(extra.abbrev, "PST") == 0);
+
+  // NULL zone_info is UTC
+  atc_shared_cache_zoned_extra_from_epoch_seconds(&cache, NULL, es, &extra);
+  ACU_ASSERT(extra.fold_type == kAtcFoldTypeExact);
+  ACU_ASSERT(strcmp(extra.abbrev, "UTC") == 0);
+}
+
+//---------------------------------------------------------------------------
+
+enum {
+  kNumThreads = 8,
+  kNumIterations = 20000,
+};
+
+// A tiny cache shared by all threads to force frequent evictions of the slots
+// which are being read.
+static AtcSharedCacheEntry stress_entries[3];
+static AtcSharedCache stress_cache;
+
+// Each thread compares the shared cache against its own AtcZoneProcessor over
+// a range of zones and years. Returns the number of mismatches.
+static void *stress_thread(void *arg)
+{
+  uintptr_t id = (uintptr_t) arg;
+  uintptr_t mismatches = 0;
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+
+  uint32_t state = 12345 + (uint32_t) id;
+  for (int i = 0; i < kNumIterations; i++) {
+    state = state * 1103515245u + 12345u;
+    const AtcZoneInfo *zone_info =
+        kAtcTestingZoneRegistry[(state >> 8) % kAtcTestingZoneRegistrySize];
+    int16_t year = 2000 + (int16_t) ((state >> 20) % 4);
+    AtcLocalDateTime ldt = {year, 1 + (state >> 4) % 12, 15, 12, 0, 0, 0};
+    atc_time_t es = atc_local_date_time_to_epoch_seconds(&ldt);
+
+    AtcFindResult expected;
+    atc_processor_init_for_zone_info(&processor, zone_info);
+    atc_processor_find_by_epoch_seconds(&processor, es, &expected);
+
+    AtcFindResult observed;
+    char abbrev[kAtcAbbrevSize];
+    atc_shared_cache_find_by_epoch_seconds(
+        &stress_cache, zone_info, es, &observed, abbrev);
+
+    if (expected.type != observed.type
+        || expected.std_offset_seconds != observed.std_offset_seconds
+        || expected.dst_offset_seconds != observed.dst_offset_seconds
+        || strcmp(expected.abbrev, observed.abbrev) != 0) {
+      mismatches++;
+    }
+  }
+  return (void *) mismatches;
+}
+
+ACU_TEST(test_atc_shared_cache_concurrent)
+{
+  atc_shared_cache_init(&stress_cache, stress_entries, 3);
+  atc_shared_cache_enable_stats(&stress_cache, true);
+
+  pthread_t threads[kNumThreads];
+  for (uintptr_t i = 0; i < kNumThreads; i++) {
+    pthread_create(&threads[i], NULL, stress_thread, (void *) i);
+  }
+  uintptr_t mismatches = 0;
+  for (int i = 0; i < kNumThreads; i++) {
+    void *ret;
+    pthread_join(threads[i], &ret);
+    mismatches += (uintptr_t) ret;
+  }
+  ACU_ASSERT(mismatches == 0);
+  ACU_ASSERT(stress_cache.num_hits + stress_cache.num_misses
+      == kNumThreads * kNumIterations);
+}
+
+#endif
+
+//---------------------------------------------------------------------------
+
+ACU_CONTEXT();
+
+int main()
+{
+#if ATC_ENABLE_SHARED_CACHE
+  ACU_RUN_TEST(test_atc_shared_cache_find_by_epoch_seconds);
+  ACU_RUN_TEST(test_atc_shared_cache_find_by_local_date_time);
+  ACU_RUN_TEST(test_atc_shared_cache_stats_disabled);
+  ACU_RUN_TEST(test_atc_shared_cache_matches_time_zone);
+  ACU_RUN_TEST(test_atc_shared_cache_concurrent);
+#endif
+  ACU_SUMMARY();
+}
@@ -114,6 +114,58 @@ ACU_TEST(test_atc_print_int16)
   ACU_ASSERT(strcmp(sb.p, "-123") == 0);
 }
 
+ACU_TEST(test_atc_print_uint16_pad_truncated)
+{
+  // The fast paths are not used if the digits do not fit, and the digits
+  // which fit are printed.
+  atc_buf_init(&sb, buf, 4);
+  atc_print_char(&sb, 'a');
+  atc_print_char(&sb, 'b');
+  atc_print_uint16_pad4(&sb, 1234);
+  atc_buf_close(&sb);
+  ACU_ASSERT(strcmp(sb.p, "ab1") == 0);
+
+  atc_buf_init(&sb, buf, 3);
+  atc_print_char(&sb, 'a');
+  atc_print_uint16_pad2(&sb, 5);
+  atc_buf_close(&sb);
+  ACU_ASSERT(strcmp(sb.p, "a0") == 0);
+}
+
+ACU_TEST(test_atc_large_buf)
+{
+  static char large[1000];
+  AtcLargeStringBuffer lsb;
+  atc_large_buf_init(&lsb, large, sizeof(large));
+  for (int i = 0; i < 100; i++) {
+    atc_large_print_string(&lsb, "0123456789");
+  }
+  ACU_ASSERT(lsb.size == 1000);
+
+  // The buffer is full, so the NUL replaces the last character.
+  atc_large_print_char(&lsb, 'x');
+  ACU_ASSERT(lsb.size == 1000);
+  atc_large_buf_close(&lsb);
+  ACU_ASSERT(lsb.size == 999);
+  ACU_ASSERT(strlen(lsb.p) == 999);
+  ACU_ASSERT(lsb.p[998] == '8');
+
+  atc_large_buf_reset(&lsb);
+  atc_large_print_char(&lsb, 'a');
+  atc_large_print_string(&lsb, "bc");
+  atc_large_buf_close(&lsb);
+  ACU_ASSERT(lsb.size == 3);
+  ACU_ASSERT(strcmp(lsb.p, "abc") == 0);
+}
+
+ACU_TEST(test_atc_digit_pairs)
+{
+  for (int n = 0; n < 100; n++) {
+    ACU_ASSERT(kAtcDigitPairs[2 * n] == '0' + n / 10);
+    ACU_ASSERT(kAtcDigitPairs[2 * n + 1] == '0' + n % 10);
+  }
+}
+
 //---------------------------------------------------------------------------
 
 ACU_CONTEXT();
@@ -127,5 +179,8 @@ int main()
   ACU_RUN_TEST(test_atc_print_uint16_pad2);
   ACU_RUN_TEST(test_atc_print_uint16_pad4);
   ACU_RUN_TEST(test_atc_print_int16);
+  ACU_RUN_TEST(test_atc_print_uint16_pad_truncated);
+  ACU_RUN_TEST(test_atc_large_buf);
+  ACU_RUN_TEST(test_atc_digit_pairs);
   ACU_SUMMARY();
 }
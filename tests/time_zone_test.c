@@ -1,4 +1,4 @@
-#include <string.h> // strcmp()
+#include <string.h> // strcmp(), memcmp()
 #include <acunit.h>
 #include <acetimec.h>
 
@@ -173,6 +173,274 @@ ACU_TEST(test_atc_time_zone_zoned_extra_from_local_date_time_los_angeles)
 
 //---------------------------------------------------------------------------
 
+enum { kNumBatch = 3 * 365 * 48 };
+
+static atc_time_t batch_seconds[kNumBatch];
+static AtcOffsetDateTime batch_odts[kNumBatch];
+static int32_t batch_offsets[kNumBatch];
+static uint8_t batch_folds[kNumBatch];
+
+// Verify that the batch conversions return the same results as
+// atc_time_zone_offset_date_time_from_epoch_seconds() for each element.
+static bool check_batch(const AtcTimeZone *tz, size_t n)
+{
+  atc_time_zone_offset_date_times_from_epoch_seconds(
+      tz, batch_seconds, n, batch_odts);
+  atc_time_zone_offsets_from_epoch_seconds(
+      tz, batch_seconds, n, batch_offsets, batch_folds);
+
+  for (size_t i = 0; i < n; i++) {
+    AtcOffsetDateTime expected;
+    atc_time_zone_offset_date_time_from_epoch_seconds(
+        tz, batch_seconds[i], &expected);
+    // Only the month of an AtcOffsetDateTime in an error state is defined.
+    if (atc_offset_date_time_is_error(&expected)) {
+      if (! atc_offset_date_time_is_error(&batch_odts[i])) return false;
+      if (batch_offsets[i] != kAtcInvalidOffsetSeconds) return false;
+    } else {
+      if (memcmp(&expected, &batch_odts[i], sizeof(expected)) != 0) {
+        return false;
+      }
+      if (batch_offsets[i] != expected.offset_seconds) return false;
+      if (batch_folds[i] != expected.fold) return false;
+    }
+  }
+  return true;
+}
+
+ACU_TEST(test_atc_time_zone_batch_sorted)
+{
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  AtcTimeZone tz = {&kAtcTestingZoneAmerica_Los_Angeles, &processor};
+
+  // Every 30 minutes from 2021 to 2023, which crosses the year boundaries and
+  // the gaps and overlaps of each year.
+  AtcLocalDateTime ldt = {2021, 1, 1, 0, 0, 0, 0 /*fold*/};
+  atc_time_t start = atc_local_date_time_to_epoch_seconds(&ldt);
+  for (size_t i = 0; i < kNumBatch; i++) {
+    batch_seconds[i] = start + (atc_time_t) i * 1800;
+  }
+  ACU_ASSERT(check_batch(&tz, kNumBatch));
+
+  // 2022-11-06T01:30 occurs twice.
+  ldt = (AtcLocalDateTime) {2022, 11, 6, 8, 30, 0, 0 /*fold*/};
+  batch_seconds[0] = atc_local_date_time_to_epoch_seconds(&ldt);
+  batch_seconds[1] = batch_seconds[0] + 3600;
+  atc_time_zone_offsets_from_epoch_seconds(
+      &tz, batch_seconds, 2, batch_offsets, batch_folds);
+  ACU_ASSERT(batch_offsets[0] == -7*3600);
+  ACU_ASSERT(batch_folds[0] == 0);
+  ACU_ASSERT(batch_offsets[1] == -8*3600);
+  ACU_ASSERT(batch_folds[1] == 1);
+}
+
+ACU_TEST(test_atc_time_zone_batch_unsorted)
+{
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  AtcTimeZone tz = {&kAtcTestingZoneAmerica_Los_Angeles, &processor};
+
+  // Pseudo-random timestamps from 2000 to 2050, including invalid ones.
+  uint32_t state = 1;
+  for (size_t i = 0; i < kNumBatch; i++) {
+    state = state * 1103515245u + 12345u;
+    batch_seconds[i] = -1577923200 + (atc_time_t) (state % 1577923200u);
+  }
+  batch_seconds[10] = kAtcInvalidEpochSeconds;
+  ACU_ASSERT(check_batch(&tz, kNumBatch));
+  ACU_ASSERT(batch_offsets[10] == kAtcInvalidOffsetSeconds);
+  ACU_ASSERT(atc_offset_date_time_is_error(&batch_odts[10]));
+
+  // Sorted in reverse.
+  for (size_t i = 0; i < kNumBatch; i++) {
+    batch_seconds[i] = 1000000 - (atc_time_t) i * 1800;
+  }
+  ACU_ASSERT(check_batch(&tz, kNumBatch));
+}
+
+ACU_TEST(test_atc_time_zone_batch_utc)
+{
+  batch_seconds[0] = 0;
+  batch_seconds[1] = kAtcInvalidEpochSeconds;
+  atc_time_zone_offsets_from_epoch_seconds(
+      &atc_time_zone_utc, batch_seconds, 2, batch_offsets, NULL);
+  ACU_ASSERT(batch_offsets[0] == 0);
+  ACU_ASSERT(batch_offsets[1] == kAtcInvalidOffsetSeconds);
+  ACU_ASSERT(check_batch(&atc_time_zone_utc, 2));
+}
+
+ACU_TEST(test_atc_time_zone_batch_all_zones)
+{
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  AtcLocalDateTime ldt = {2000, 1, 1, 0, 0, 0, 0 /*fold*/};
+  atc_time_t start = atc_local_date_time_to_epoch_seconds(&ldt);
+  for (size_t i = 0; i < kNumBatch; i++) {
+    batch_seconds[i] = start + (atc_time_t) i * 6 * 3600;
+  }
+  for (uint16_t i = 0; i < kAtcTestingZoneRegistrySize; i++) {
+    AtcTimeZone tz = {kAtcTestingZoneRegistry[i], &processor};
+    ACU_ASSERT(check_batch(&tz, kNumBatch));
+  }
+}
+
+//---------------------------------------------------------------------------
+
+ACU_TEST(test_atc_time_zone_next_prev_transition_los_angeles)
+{
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  AtcTimeZone tz = {&kAtcTestingZoneAmerica_Los_Angeles, &processor};
+
+  AtcLocalDateTime ldt = {2022, 3, 13, 10, 0, 0, 0 /*fold*/};
+  atc_time_t spring = atc_local_date_time_to_epoch_seconds(&ldt);
+  ldt.month = 11; ldt.day = 6; ldt.hour = 9;
+  atc_time_t fall = atc_local_date_time_to_epoch_seconds(&ldt);
+
+  // Next is strictly after.
+  AtcZoneTransition t;
+  int8_t err = atc_time_zone_next_transition(&tz, spring - 1, &t);
+  ACU_ASSERT(err == kAtcErrOk);
+  ACU_ASSERT(t.epoch_seconds == spring);
+  ACU_ASSERT(t.old_offset_seconds == -8*3600);
+  ACU_ASSERT(t.new_offset_seconds == -7*3600);
+  ACU_ASSERT(strcmp(t.abbrev, "PDT") == 0);
+  err = atc_time_zone_next_transition(&tz, spring, &t);
+  ACU_ASSERT(err == kAtcErrOk);
+  ACU_ASSERT(t.epoch_seconds == fall);
+  ACU_ASSERT(t.old_offset_seconds == -7*3600);
+  ACU_ASSERT(t.new_offset_seconds == -8*3600);
+  ACU_ASSERT(strcmp(t.abbrev, "PST") == 0);
+
+  // Previous is at or before.
+  err = atc_time_zone_prev_transition(&tz, fall, &t);
+  ACU_ASSERT(err == kAtcErrOk);
+  ACU_ASSERT(t.epoch_seconds == fall);
+  err = atc_time_zone_prev_transition(&tz, fall - 1, &t);
+  ACU_ASSERT(err == kAtcErrOk);
+  ACU_ASSERT(t.epoch_seconds == spring);
+  ACU_ASSERT(strcmp(t.abbrev, "PDT") == 0);
+
+  // Across the end of the year.
+  err = atc_time_zone_next_transition(&tz, fall, &t);
+  ACU_ASSERT(err == kAtcErrOk);
+  ACU_ASSERT(t.old_offset_seconds == -8*3600);
+  ACU_ASSERT(strcmp(t.abbrev, "PDT") == 0);
+  AtcLocalDateTime next;
+  atc_local_date_time_from_epoch_seconds(&next, t.epoch_seconds);
+  ACU_ASSERT(next.year == 2023);
+  ACU_ASSERT(next.month == 3);
+  ACU_ASSERT(next.day == 12);
+}
+
+ACU_TEST(test_atc_time_zone_next_prev_transition_skips_years)
+{
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  AtcTimeZone tz = {&kAtcAllZoneAsia_Kolkata, &processor};
+
+  // No transitions since 1945.
+  AtcZoneTransition t;
+  int8_t err = atc_time_zone_next_transition(&tz, 0, &t);
+  ACU_ASSERT(err == kAtcErrGeneric);
+
+  // The transitions of 1945 cannot be represented in the default epoch, so
+  // move the epoch to a year which can.
+  int16_t saved_epoch_year = atc_get_current_epoch_year();
+  atc_set_current_epoch_year(1950);
+  AtcLocalDateTime ldt = {1990, 1, 1, 0, 0, 0, 0 /*fold*/};
+  atc_time_t es = atc_local_date_time_to_epoch_seconds(&ldt);
+  err = atc_time_zone_prev_transition(&tz, es, &t);
+  atc_local_date_time_from_epoch_seconds(&ldt, t.epoch_seconds);
+  atc_set_current_epoch_year(saved_epoch_year);
+  ACU_ASSERT(err == kAtcErrOk);
+  ACU_ASSERT(ldt.year == 1945);
+  ACU_ASSERT(ldt.month == 10);
+  ACU_ASSERT(t.old_offset_seconds == 6*3600 + 30*60);
+  ACU_ASSERT(t.new_offset_seconds == 5*3600 + 30*60);
+  ACU_ASSERT(strcmp(t.abbrev, "IST") == 0);
+}
+
+ACU_TEST(test_atc_time_zone_next_prev_transition_utc)
+{
+  AtcZoneTransition t;
+  ACU_ASSERT(atc_time_zone_next_transition(&atc_time_zone_utc, 0, &t)
+      == kAtcErrGeneric);
+  ACU_ASSERT(atc_time_zone_prev_transition(&atc_time_zone_utc, 0, &t)
+      == kAtcErrGeneric);
+}
+
+static bool transitions_equal(
+    const AtcZoneTransition *a,
+    const AtcZoneTransition *b)
+{
+  return a->epoch_seconds == b->epoch_seconds
+      && a->old_offset_seconds == b->old_offset_seconds
+      && a->new_offset_seconds == b->new_offset_seconds
+      && a->std_offset_seconds == b->std_offset_seconds
+      && a->dst_offset_seconds == b->dst_offset_seconds
+      && strcmp(a->abbrev, b->abbrev) == 0;
+}
+
+// Verify that chaining atc_time_zone_next_transition() forward, and
+// atc_time_zone_prev_transition() backward, returns the same transitions as
+// the AtcZoneTransitions iterator.
+static bool check_next_prev_transition(
+    const AtcTimeZone *tz,
+    atc_time_t start,
+    atc_time_t until)
+{
+  AtcZoneTransitions iter;
+  if (atc_zone_transitions_begin(&iter, tz->zone_info, start, until)) {
+    return false;
+  }
+
+  enum { kMaxTransitions = 128 };
+  AtcZoneTransition expected[kMaxTransitions];
+  uint16_t n = 0;
+  while (n < kMaxTransitions
+      && atc_zone_transitions_next(&iter, &expected[n])) {
+    n++;
+  }
+
+  AtcZoneTransition t;
+  atc_time_t es = start - 1;
+  for (uint16_t i = 0; i < n; i++) {
+    if (atc_time_zone_next_transition(tz, es, &t)) return false;
+    if (! transitions_equal(&t, &expected[i])) return false;
+    es = t.epoch_seconds;
+  }
+  int8_t err = atc_time_zone_next_transition(tz, es, &t);
+  if (err == kAtcErrOk && t.epoch_seconds < until) return false;
+
+  es = until - 1;
+  for (uint16_t i = n; i > 0; i--) {
+    if (atc_time_zone_prev_transition(tz, es, &t)) return false;
+    if (! transitions_equal(&t, &expected[i - 1])) return false;
+    es = t.epoch_seconds - 1;
+  }
+  err = atc_time_zone_prev_transition(tz, es, &t);
+  if (err == kAtcErrOk && t.epoch_seconds >= start) return false;
+  return true;
+}
+
+ACU_TEST(test_atc_time_zone_next_prev_transition_all_zones)
+{
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  AtcLocalDateTime ldt = {2000, 1, 1, 0, 0, 0, 0 /*fold*/};
+  atc_time_t start = atc_local_date_time_to_epoch_seconds(&ldt);
+  ldt.year = 2050;
+  atc_time_t until = atc_local_date_time_to_epoch_seconds(&ldt);
+  for (uint16_t i = 0; i < kAtcAllZoneRegistrySize; i++) {
+    AtcTimeZone tz = {kAtcAllZoneRegistry[i], &processor};
+    ACU_ASSERT(check_next_prev_transition(&tz, start, until));
+  }
+}
+
+//---------------------------------------------------------------------------
+
 ACU_CONTEXT();
 
 int main()
@@ -188,5 +456,14 @@ int main()
   ACU_RUN_TEST(test_atc_time_zone_offset_date_time_from_local_date_time_los_angeles);
   ACU_RUN_TEST(test_atc_time_zone_zoned_extra_from_epoch_seconds_los_angeles);
   ACU_RUN_TEST(test_atc_time_zone_zoned_extra_from_local_date_time_los_angeles);
+
+  ACU_RUN_TEST(test_atc_time_zone_batch_sorted);
+  ACU_RUN_TEST(test_atc_time_zone_batch_unsorted);
+  ACU_RUN_TEST(test_atc_time_zone_batch_utc);
+  ACU_RUN_TEST(test_atc_time_zone_batch_all_zones);
+  ACU_RUN_TEST(test_atc_time_zone_next_prev_transition_los_angeles);
+  ACU_RUN_TEST(test_atc_time_zone_next_prev_transition_skips_years);
+  ACU_RUN_TEST(test_atc_time_zone_next_prev_transition_utc);
+  ACU_RUN_TEST(test_atc_time_zone_next_prev_transition_all_zones);
   ACU_SUMMARY();
 }
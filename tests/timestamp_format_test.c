@@ -0,0 +1,123 @@
+#include <string.h> // strcmp()
+#include <acunit.h>
+#include <acetimec.h>
+
+static char buf[1000];
+
+ACU_TEST(test_atc_large_print_local_date_time)
+{
+  AtcLargeStringBuffer sb;
+  atc_large_buf_init(&sb, buf, sizeof(buf));
+
+  AtcLocalDateTime ldt = {2024, 3, 9, 7, 5, 3, 0 /*fold*/};
+  ACU_ASSERT(atc_large_print_local_date_time(&sb, &ldt) == kAtcErrOk);
+  atc_large_buf_close(&sb);
+  ACU_ASSERT(sb.size == kAtcTimestampLocalLength);
+  ACU_ASSERT(strcmp(sb.p, "2024-03-09T07:05:03") == 0);
+
+  // Errors print nothing.
+  atc_large_buf_reset(&sb);
+  atc_local_date_time_set_error(&ldt);
+  ACU_ASSERT(atc_large_print_local_date_time(&sb, &ldt) == kAtcErrGeneric);
+  AtcLocalDateTime ldt10000 = {10000, 1, 1, 0, 0, 0, 0 /*fold*/};
+  ACU_ASSERT(atc_large_print_local_date_time(&sb, &ldt10000)
+      == kAtcErrGeneric);
+  ACU_ASSERT(sb.size == 0);
+
+  // Does not fit.
+  AtcLocalDateTime ldt0 = {0, 1, 1, 0, 0, 0, 0 /*fold*/};
+  atc_large_buf_init(&sb, buf, kAtcTimestampLocalLength - 1);
+  ACU_ASSERT(atc_large_print_local_date_time(&sb, &ldt0) == kAtcErrGeneric);
+  ACU_ASSERT(sb.size == 0);
+  atc_large_buf_init(&sb, buf, kAtcTimestampLocalLength + 1);
+  ACU_ASSERT(atc_large_print_local_date_time(&sb, &ldt0) == kAtcErrOk);
+  atc_large_buf_close(&sb);
+  ACU_ASSERT(strcmp(sb.p, "0000-01-01T00:00:00") == 0);
+}
+
+ACU_TEST(test_atc_large_print_offset_date_time)
+{
+  AtcLargeStringBuffer sb;
+  AtcOffsetDateTime odt = {2024, 3, 9, 7, 5, 3, 0 /*fold*/, -(8 * 3600 + 1800)};
+
+  // Same as atc_offset_date_time_print().
+  char expected[64];
+  AtcStringBuffer small;
+  atc_buf_init(&small, expected, sizeof(expected));
+  atc_offset_date_time_print(&small, &odt);
+  atc_buf_close(&small);
+
+  atc_large_buf_init(&sb, buf, sizeof(buf));
+  ACU_ASSERT(atc_large_print_offset_date_time(&sb, &odt) == kAtcErrOk);
+  atc_large_buf_close(&sb);
+  ACU_ASSERT(strcmp(sb.p, "2024-03-09T07:05:03-08:30") == 0);
+  ACU_ASSERT(strcmp(sb.p, expected) == 0);
+}
+
+ACU_TEST(test_atc_large_print_epoch_seconds_n_utc)
+{
+  int16_t saved_epoch_year = atc_get_current_epoch_year();
+  atc_set_current_epoch_year(2000);
+
+  // Includes a negative value, and consecutive values on the same day.
+  const atc_time_t epoch_seconds[] = {
+    -1, 0, 59, 3600, 86399, 86400, kAtcInvalidEpochSeconds, 0,
+  };
+  AtcLargeStringBuffer sb;
+  atc_large_buf_init(&sb, buf, sizeof(buf));
+  size_t n = atc_large_print_epoch_seconds_n(
+      &sb, epoch_seconds, 8, NULL /*tz*/, '\n');
+  atc_large_buf_close(&sb);
+  ACU_ASSERT(n == 6);
+  ACU_ASSERT(strcmp(sb.p,
+      "1999-12-31T23:59:59Z\n"
+      "2000-01-01T00:00:00Z\n"
+      "2000-01-01T00:00:59Z\n"
+      "2000-01-01T01:00:00Z\n"
+      "2000-01-01T23:59:59Z\n"
+      "2000-01-02T00:00:00Z\n") == 0);
+
+  // Stops at the first timestamp which does not fit, without a separator.
+  atc_large_buf_init(&sb, buf, 2 * kAtcTimestampUtcLength + 1);
+  n = atc_large_print_epoch_seconds_n(
+      &sb, epoch_seconds, 3, NULL /*tz*/, '\0');
+  atc_large_buf_close(&sb);
+  ACU_ASSERT(n == 2);
+  ACU_ASSERT(strcmp(sb.p, "1999-12-31T23:59:59Z2000-01-01T00:00:00Z") == 0);
+
+  atc_set_current_epoch_year(saved_epoch_year);
+}
+
+ACU_TEST(test_atc_large_print_epoch_seconds_n_time_zone)
+{
+  int16_t saved_epoch_year = atc_get_current_epoch_year();
+  atc_set_current_epoch_year(2000);
+
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  AtcTimeZone tz = {&kAtcTestingZoneAmerica_Los_Angeles, &processor};
+
+  const atc_time_t epoch_seconds[] = {0, 86400 * 181};
+  AtcLargeStringBuffer sb;
+  atc_large_buf_init(&sb, buf, sizeof(buf));
+  size_t n = atc_large_print_epoch_seconds_n(&sb, epoch_seconds, 2, &tz, ' ');
+  atc_large_buf_close(&sb);
+  ACU_ASSERT(n == 2);
+  ACU_ASSERT(strcmp(sb.p,
+      "1999-12-31T16:00:00-08:00 2000-06-29T17:00:00-07:00 ") == 0);
+
+  atc_set_current_epoch_year(saved_epoch_year);
+}
+
+//---------------------------------------------------------------------------
+
+ACU_CONTEXT();
+
+int main()
+{
+  ACU_RUN_TEST(test_atc_large_print_local_date_time);
+  ACU_RUN_TEST(test_atc_large_print_offset_date_time);
+  ACU_RUN_TEST(test_atc_large_print_epoch_seconds_n_utc);
+  ACU_RUN_TEST(test_atc_large_print_epoch_seconds_n_time_zone);
+  ACU_SUMMARY();
+}
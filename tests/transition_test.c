@@ -468,6 +468,129 @@ ACU_TEST(test_atc_transition_storage_reset_candidate_pool)
 
 //---------------------------------------------------------------------------
 
+// The original linear search of atc_transition_storage_find_for_seconds(),
+// which calculated the shift of the UTC offset using the AtcDateTuple.
+static AtcTransitionForSeconds find_for_seconds_linear(
+    const AtcTransitionStorage *ts,
+    atc_time_t epoch_seconds)
+{
+  const AtcTransition *prev = NULL;
+  const AtcTransition *curr = NULL;
+  const AtcTransition *next = NULL;
+  for (uint8_t i = 0; i < ts->index_free; i++) {
+    next = ts->transitions[i];
+    if (next->start_epoch_seconds > epoch_seconds) break;
+    prev = curr;
+    curr = next;
+    next = NULL;
+  }
+
+  AtcTransitionForSeconds result = {curr, 0, 0};
+  if (curr == NULL) return result;
+  result.num = 1;
+  if (prev != NULL) {
+    atc_time_t shift = atc_date_tuple_subtract(
+        &curr->start_dt, &prev->until_dt);
+    if (shift < 0 && epoch_seconds - curr->start_epoch_seconds < -shift) {
+      result.fold = 1;
+      result.num = 2;
+      return result;
+    }
+  }
+  if (next != NULL) {
+    atc_time_t shift = atc_date_tuple_subtract(
+        &next->start_dt, &curr->until_dt);
+    if (shift < 0 && next->start_epoch_seconds - epoch_seconds <= -shift) {
+      result.num = 2;
+    }
+  }
+  return result;
+}
+
+static bool tfs_equal(
+    const AtcTransitionForSeconds *a,
+    const AtcTransitionForSeconds *b)
+{
+  return a->curr == b->curr && a->fold == b->fold && a->num == b->num;
+}
+
+ACU_TEST(test_atc_transition_storage_find_for_seconds_matches_linear)
+{
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  AtcTransitionStorage *ts = &processor.transition_storage;
+
+  for (uint16_t i = 0; i < kAtcAllZoneRegistrySize; i++) {
+    atc_processor_init_for_zone_info(&processor, kAtcAllZoneRegistry[i]);
+    for (int16_t year = 2000; year < 2040; year += 3) {
+      atc_processor_init_for_year(&processor, year);
+
+      // Sample the 14-month window every 3 hours, plus the 2 seconds around
+      // each transition.
+      atc_time_t start = ts->transitions[0]->start_epoch_seconds - 86400;
+      for (atc_time_t es = start; es < start + 430 * 86400; es += 3 * 3600) {
+        AtcTransitionForSeconds expected = find_for_seconds_linear(ts, es);
+        AtcTransitionForSeconds observed =
+            atc_transition_storage_find_for_seconds(ts, es);
+        ACU_ASSERT(tfs_equal(&expected, &observed));
+        observed = atc_transition_storage_find_for_seconds_memo(ts, es);
+        ACU_ASSERT(tfs_equal(&expected, &observed));
+      }
+      for (uint8_t j = 0; j < ts->index_free; j++) {
+        atc_time_t es = ts->transitions[j]->start_epoch_seconds;
+        for (atc_time_t d = -1; d <= 1; d++) {
+          AtcTransitionForSeconds expected =
+              find_for_seconds_linear(ts, es + d);
+          AtcTransitionForSeconds observed =
+              atc_transition_storage_find_for_seconds_memo(ts, es + d);
+          ACU_ASSERT(tfs_equal(&expected, &observed));
+        }
+      }
+    }
+  }
+}
+
+ACU_TEST(test_atc_transition_storage_find_for_seconds_memo)
+{
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  atc_processor_init_for_zone_info(
+      &processor, &kAtcTestingZoneAmerica_Los_Angeles);
+  atc_processor_init_for_year(&processor, 2022);
+  AtcTransitionStorage *ts = &processor.transition_storage;
+  ACU_ASSERT(ts->index_last == 0);
+
+  // 2022-06-01T00:00:00Z is in the PDT interval.
+  AtcLocalDateTime ldt = {2022, 6, 1, 0, 0, 0, 0 /*fold*/};
+  atc_time_t es = atc_local_date_time_to_epoch_seconds(&ldt);
+  AtcTransitionForSeconds tfs =
+      atc_transition_storage_find_for_seconds_memo(ts, es);
+  ACU_ASSERT(tfs.curr == ts->transitions[ts->index_last]);
+  ACU_ASSERT(tfs.curr->delta_seconds == 3600);
+  uint8_t index_pdt = ts->index_last;
+
+  // Same interval.
+  tfs = atc_transition_storage_find_for_seconds_memo(ts, es + 86400);
+  ACU_ASSERT(ts->index_last == index_pdt);
+  ACU_ASSERT(tfs.curr->delta_seconds == 3600);
+
+  // 2022-12-01 is in the next (PST) interval.
+  ldt.month = 12;
+  es = atc_local_date_time_to_epoch_seconds(&ldt);
+  tfs = atc_transition_storage_find_for_seconds_memo(ts, es);
+  ACU_ASSERT(ts->index_last == index_pdt + 1);
+  ACU_ASSERT(tfs.curr->delta_seconds == 0);
+
+  // Going backwards falls back to the binary search.
+  ldt.month = 6;
+  es = atc_local_date_time_to_epoch_seconds(&ldt);
+  tfs = atc_transition_storage_find_for_seconds_memo(ts, es);
+  ACU_ASSERT(ts->index_last == index_pdt);
+  ACU_ASSERT(tfs.curr->delta_seconds == 3600);
+}
+
+//---------------------------------------------------------------------------
+
 ACU_CONTEXT();
 
 int main()
@@ -482,5 +605,7 @@ int main()
   ACU_RUN_TEST(
       test_atc_transition_storage_add_active_candidates_to_active_pool);
   ACU_RUN_TEST(test_atc_transition_storage_reset_candidate_pool);
+  ACU_RUN_TEST(test_atc_transition_storage_find_for_seconds_matches_linear);
+  ACU_RUN_TEST(test_atc_transition_storage_find_for_seconds_memo);
   ACU_SUMMARY();
 }
@@ -0,0 +1,392 @@
+#include <string.h> // strcmp()
+#include <acunit.h>
+#include <acetimec.h>
+
+//---------------------------------------------------------------------------
+// Builder of small TZif files.
+//---------------------------------------------------------------------------
+
+enum { kBufSize = 512 };
+
+typedef struct TzifBuilder {
+  uint8_t buf[kBufSize];
+  size_t size;
+} TzifBuilder;
+
+static void put_u8(TzifBuilder *b, uint8_t v)
+{
+  b->buf[b->size++] = v;
+}
+
+static void put_u32(TzifBuilder *b, uint32_t v)
+{
+  put_u8(b, (uint8_t) (v >> 24));
+  put_u8(b, (uint8_t) (v >> 16));
+  put_u8(b, (uint8_t) (v >> 8));
+  put_u8(b, (uint8_t) v);
+}
+
+static void put_i64(TzifBuilder *b, int64_t v)
+{
+  uint64_t u = (uint64_t) v;
+  put_u32(b, (uint32_t) (u >> 32));
+  put_u32(b, (uint32_t) u);
+}
+
+static void put_bytes(TzifBuilder *b, const void *p, size_t n)
+{
+  memcpy(b->buf + b->size, p, n);
+  b->size += n;
+}
+
+static void put_header(
+    TzifBuilder *b,
+    char version,
+    uint32_t leapcnt,
+    uint32_t timecnt,
+    uint32_t typecnt,
+    uint32_t charcnt)
+{
+  put_bytes(b, "TZif", 4);
+  put_u8(b, (uint8_t) version);
+  for (int i = 0; i < 15; i++) put_u8(b, 0);
+  put_u32(b, 0); // isutcnt
+  put_u32(b, 0); // isstdcnt
+  put_u32(b, leapcnt);
+  put_u32(b, timecnt);
+  put_u32(b, typecnt);
+  put_u32(b, charcnt);
+}
+
+// Unix seconds of the transitions of the table.
+static const int64_t kTimes[] = {
+  -2717640000, // 1883-11-18 20:00 UTC, LMT to PST
+  1583661600, // 2020-03-08 10:00 UTC, PST to PDT
+  1604221200, // 2020-11-01 09:00 UTC, PDT to PST
+};
+static const uint8_t kTypeIndexes[] = {1, 2, 1};
+static const char kAbbrevs[] = "LMT\0PST\0PDT";
+
+// Build a version 2 TZif file similar to America/Los_Angeles, with a table
+// which ends in 2020, followed by the given footer.
+static void build_los_angeles(TzifBuilder *b, const char *footer)
+{
+  b->size = 0;
+
+  // Minimal version 1 data block, ignored by version 2 readers.
+  put_header(b, '2', 0, 0, 1, 4);
+  put_u32(b, 0);
+  put_u8(b, 0);
+  put_u8(b, 0);
+  put_bytes(b, "UTC", 4);
+
+  put_header(b, '2', 0, 3, 3, sizeof(kAbbrevs));
+  for (int i = 0; i < 3; i++) put_i64(b, kTimes[i]);
+  put_bytes(b, kTypeIndexes, 3);
+  put_u32(b, (uint32_t) -28378); put_u8(b, 0); put_u8(b, 0);
+  put_u32(b, (uint32_t) -28800); put_u8(b, 0); put_u8(b, 4);
+  put_u32(b, (uint32_t) -25200); put_u8(b, 1); put_u8(b, 8);
+  put_bytes(b, kAbbrevs, sizeof(kAbbrevs));
+
+  put_u8(b, '\n');
+  put_bytes(b, footer, strlen(footer));
+  put_u8(b, '\n');
+}
+
+static atc_time_t to_epoch_seconds(
+    int16_t year, uint8_t month, uint8_t day,
+    uint8_t hour, uint8_t minute, uint8_t second)
+{
+  AtcLocalDateTime ldt = {year, month, day, hour, minute, second, 0 /*fold*/};
+  return atc_local_date_time_to_epoch_seconds(&ldt);
+}
+
+static bool find_results_equal(const AtcFindResult *a, const AtcFindResult *b)
+{
+  if (a->type != b->type) return false;
+  if (a->type == kAtcFindResultNotFound) return true;
+  return a->fold == b->fold
+      && a->std_offset_seconds == b->std_offset_seconds
+      && a->dst_offset_seconds == b->dst_offset_seconds
+      && a->req_std_offset_seconds == b->req_std_offset_seconds
+      && a->req_dst_offset_seconds == b->req_dst_offset_seconds
+      && strcmp(a->abbrev, b->abbrev) == 0;
+}
+
+//---------------------------------------------------------------------------
+
+ACU_TEST(test_atc_tzif_parse_posix_tz)
+{
+  AtcTzifFooter f;
+  const char *s = "PST8PDT,M3.2.0,M11.1.0";
+  ACU_ASSERT(atc_tzif_parse_posix_tz(&f, s, strlen(s)) == kAtcErrOk);
+  ACU_ASSERT(f.is_valid);
+  ACU_ASSERT(f.has_dst);
+  ACU_ASSERT(f.std_offset_seconds == -8*3600);
+  ACU_ASSERT(f.dst_offset_seconds == 3600);
+  ACU_ASSERT(strcmp(f.std_abbrev, "PST") == 0);
+  ACU_ASSERT(strcmp(f.dst_abbrev, "PDT") == 0);
+  ACU_ASSERT(f.start.form == kAtcTzifRuleMonthWeekDay);
+  ACU_ASSERT(f.start.month == 3);
+  ACU_ASSERT(f.start.week == 2);
+  ACU_ASSERT(f.start.day_of_week == 0);
+  ACU_ASSERT(f.start.time_seconds == 2*3600);
+  ACU_ASSERT(f.end.month == 11);
+  ACU_ASSERT(f.end.week == 1);
+
+  // Quoted names, and minutes.
+  s = "<+0530>-5:30";
+  ACU_ASSERT(atc_tzif_parse_posix_tz(&f, s, strlen(s)) == kAtcErrOk);
+  ACU_ASSERT(! f.has_dst);
+  ACU_ASSERT(f.std_offset_seconds == 5*3600 + 30*60);
+  ACU_ASSERT(strcmp(f.std_abbrev, "+0530") == 0);
+
+  // Negative and extended hours of version 3.
+  s = "<-03>3<-02>,M3.5.0/-2,M10.5.0/-1";
+  ACU_ASSERT(atc_tzif_parse_posix_tz(&f, s, strlen(s)) == kAtcErrOk);
+  ACU_ASSERT(f.std_offset_seconds == -3*3600);
+  ACU_ASSERT(f.dst_offset_seconds == 3600);
+  ACU_ASSERT(f.start.time_seconds == -2*3600);
+  ACU_ASSERT(f.end.time_seconds == -1*3600);
+  s = "IST-2IDT,M3.4.4/26,M10.5.0";
+  ACU_ASSERT(atc_tzif_parse_posix_tz(&f, s, strlen(s)) == kAtcErrOk);
+  ACU_ASSERT(f.start.time_seconds == 26*3600);
+
+  // Explicit DST offset, and the Julian forms.
+  s = "AAA3BBB1,J60/1:30:15,300";
+  ACU_ASSERT(atc_tzif_parse_posix_tz(&f, s, strlen(s)) == kAtcErrOk);
+  ACU_ASSERT(f.dst_offset_seconds == 2*3600);
+  ACU_ASSERT(f.start.form == kAtcTzifRuleJulian1);
+  ACU_ASSERT(f.start.day_of_year == 60);
+  ACU_ASSERT(f.start.time_seconds == 3600 + 30*60 + 15);
+  ACU_ASSERT(f.end.form == kAtcTzifRuleJulian0);
+  ACU_ASSERT(f.end.day_of_year == 300);
+
+  // Errors.
+  s = "PST";
+  ACU_ASSERT(atc_tzif_parse_posix_tz(&f, s, strlen(s)) == kAtcErrGeneric);
+  ACU_ASSERT(! f.is_valid);
+  s = "PST8PDT";
+  ACU_ASSERT(atc_tzif_parse_posix_tz(&f, s, strlen(s)) == kAtcErrGeneric);
+  s = "X8";
+  ACU_ASSERT(atc_tzif_parse_posix_tz(&f, s, strlen(s)) == kAtcErrGeneric);
+  s = "PST8PDT,M13.2.0,M11.1.0";
+  ACU_ASSERT(atc_tzif_parse_posix_tz(&f, s, strlen(s)) == kAtcErrGeneric);
+  s = "PST8PDT,M3.2.0,M11.1.0x";
+  ACU_ASSERT(atc_tzif_parse_posix_tz(&f, s, strlen(s)) == kAtcErrGeneric);
+}
+
+ACU_TEST(test_atc_tzif_init_errors)
+{
+  TzifBuilder b;
+  AtcTzif tzif;
+  build_los_angeles(&b, "PST8PDT,M3.2.0,M11.1.0");
+  ACU_ASSERT(atc_tzif_init(&tzif, b.buf, b.size) == kAtcErrOk);
+
+  // Truncated.
+  ACU_ASSERT(atc_tzif_init(&tzif, b.buf, b.size - 1) == kAtcErrGeneric);
+  ACU_ASSERT(atc_tzif_init(&tzif, b.buf, 20) == kAtcErrGeneric);
+
+  // Bad magic.
+  b.buf[0] = 'X';
+  ACU_ASSERT(atc_tzif_init(&tzif, b.buf, b.size) == kAtcErrGeneric);
+
+  // Bad footer.
+  build_los_angeles(&b, "PST8PDT");
+  ACU_ASSERT(atc_tzif_init(&tzif, b.buf, b.size) == kAtcErrGeneric);
+
+  // Leap seconds.
+  b.size = 0;
+  put_header(&b, '\0', 1, 0, 1, 4);
+  put_u32(&b, 0); put_u8(&b, 0); put_u8(&b, 0);
+  put_bytes(&b, "UTC", 4);
+  put_u32(&b, 78796800); put_u32(&b, 1);
+  ACU_ASSERT(atc_tzif_init(&tzif, b.buf, b.size) == kAtcErrGeneric);
+}
+
+ACU_TEST(test_atc_tzif_find_by_epoch_seconds)
+{
+  TzifBuilder b;
+  AtcTzif tzif;
+  build_los_angeles(&b, "PST8PDT,M3.2.0,M11.1.0");
+  ACU_ASSERT(atc_tzif_init(&tzif, b.buf, b.size) == kAtcErrOk);
+  AtcFindResult result;
+
+  // Before the first transition. Move the epoch so that 1883 can be
+  // represented by a 32-bit atc_time_t.
+  int16_t saved_epoch_year = atc_get_current_epoch_year();
+  atc_set_current_epoch_year(1900);
+  atc_time_t es = atc_epoch_seconds_from_unix_seconds(-2717640000 - 86400);
+  atc_tzif_find_by_epoch_seconds(&tzif, es, &result);
+  atc_set_current_epoch_year(saved_epoch_year);
+  ACU_ASSERT(result.type == kAtcFindResultExact);
+  ACU_ASSERT(result.std_offset_seconds == -28378);
+  ACU_ASSERT(strcmp(result.abbrev, "LMT") == 0);
+
+  // From the table.
+  es = to_epoch_seconds(2020, 6, 1, 0, 0, 0);
+  atc_tzif_find_by_epoch_seconds(&tzif, es, &result);
+  ACU_ASSERT(result.type == kAtcFindResultExact);
+  ACU_ASSERT(result.std_offset_seconds == -8*3600);
+  ACU_ASSERT(result.dst_offset_seconds == 1*3600);
+  ACU_ASSERT(strcmp(result.abbrev, "PDT") == 0);
+
+  // From the footer, first occurrence of 2030-11-03 01:30.
+  es = to_epoch_seconds(2030, 11, 3, 8, 30, 0);
+  atc_tzif_find_by_epoch_seconds(&tzif, es, &result);
+  ACU_ASSERT(result.type == kAtcFindResultOverlap);
+  ACU_ASSERT(result.fold == 0);
+  ACU_ASSERT(result.std_offset_seconds == -8*3600);
+  ACU_ASSERT(result.dst_offset_seconds == 1*3600);
+  ACU_ASSERT(strcmp(result.abbrev, "PDT") == 0);
+
+  // Second occurrence.
+  atc_tzif_find_by_epoch_seconds(&tzif, es + 3600, &result);
+  ACU_ASSERT(result.type == kAtcFindResultOverlap);
+  ACU_ASSERT(result.fold == 1);
+  ACU_ASSERT(result.dst_offset_seconds == 0);
+  ACU_ASSERT(strcmp(result.abbrev, "PST") == 0);
+
+  // The first transition of the footer, right after the table.
+  es = to_epoch_seconds(2021, 3, 14, 10, 0, 0);
+  atc_tzif_find_by_epoch_seconds(&tzif, es - 1, &result);
+  ACU_ASSERT(strcmp(result.abbrev, "PST") == 0);
+  atc_tzif_find_by_epoch_seconds(&tzif, es, &result);
+  ACU_ASSERT(strcmp(result.abbrev, "PDT") == 0);
+
+  atc_tzif_find_by_epoch_seconds(&tzif, kAtcInvalidEpochSeconds, &result);
+  ACU_ASSERT(result.type == kAtcFindResultNotFound);
+}
+
+ACU_TEST(test_atc_tzif_find_by_local_date_time)
+{
+  TzifBuilder b;
+  AtcTzif tzif;
+  build_los_angeles(&b, "PST8PDT,M3.2.0,M11.1.0");
+  ACU_ASSERT(atc_tzif_init(&tzif, b.buf, b.size) == kAtcErrOk);
+  AtcFindResult result;
+
+  // Gap in the table.
+  AtcLocalDateTime ldt = {2020, 3, 8, 2, 30, 0, 0 /*fold*/};
+  atc_tzif_find_by_local_date_time(&tzif, &ldt, &result);
+  ACU_ASSERT(result.type == kAtcFindResultGap);
+  ACU_ASSERT(result.req_dst_offset_seconds == 0);
+  ACU_ASSERT(result.dst_offset_seconds == 3600);
+  ACU_ASSERT(strcmp(result.abbrev, "PDT") == 0);
+
+  // Overlap in the footer.
+  ldt = (AtcLocalDateTime) {2030, 11, 3, 1, 30, 0, 1 /*fold*/};
+  atc_tzif_find_by_local_date_time(&tzif, &ldt, &result);
+  ACU_ASSERT(result.type == kAtcFindResultOverlap);
+  ACU_ASSERT(result.fold == 1);
+  ACU_ASSERT(result.dst_offset_seconds == 0);
+  ACU_ASSERT(strcmp(result.abbrev, "PST") == 0);
+
+  ldt.fold = 0;
+  atc_tzif_find_by_local_date_time(&tzif, &ldt, &result);
+  ACU_ASSERT(result.type == kAtcFindResultOverlap);
+  ACU_ASSERT(result.fold == 0);
+  ACU_ASSERT(strcmp(result.abbrev, "PDT") == 0);
+}
+
+// The synthetic TZif data must give the same results as the AtcZoneProcessor
+// after the last transition of the table.
+ACU_TEST(test_atc_tzif_matches_zone_processor)
+{
+  TzifBuilder b;
+  AtcTzif tzif;
+  build_los_angeles(&b, "PST8PDT,M3.2.0,M11.1.0");
+  ACU_ASSERT(atc_tzif_init(&tzif, b.buf, b.size) == kAtcErrOk);
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  atc_processor_init_for_zone_info(
+      &processor, &kAtcTestingZoneAmerica_Los_Angeles);
+
+  AtcFindResult expected;
+  AtcFindResult observed;
+  atc_time_t until = to_epoch_seconds(2050, 1, 1, 0, 0, 0);
+  for (atc_time_t es = to_epoch_seconds(2020, 1, 1, 0, 0, 0);
+      es < until;
+      es += 3 * 3600 + 7 * 60) {
+    atc_processor_find_by_epoch_seconds(&processor, es, &expected);
+    atc_tzif_find_by_epoch_seconds(&tzif, es, &observed);
+    ACU_ASSERT(find_results_equal(&expected, &observed));
+
+    AtcLocalDateTime ldt;
+    atc_local_date_time_from_epoch_seconds(&ldt, es);
+    for (uint8_t fold = 0; fold < 2; fold++) {
+      ldt.fold = fold;
+      atc_processor_find_by_local_date_time(&processor, &ldt, &expected);
+      atc_tzif_find_by_local_date_time(&tzif, &ldt, &observed);
+      ACU_ASSERT(find_results_equal(&expected, &observed));
+    }
+  }
+}
+
+ACU_TEST(test_atc_tzif_footer_only)
+{
+  // Version 2 file with no transitions, only a footer.
+  TzifBuilder b;
+  b.size = 0;
+  put_header(&b, '2', 0, 0, 1, 4);
+  put_u32(&b, 0); put_u8(&b, 0); put_u8(&b, 0);
+  put_bytes(&b, "UTC", 4);
+  put_header(&b, '2', 0, 0, 1, 6);
+  put_u32(&b, (uint32_t) 19800); put_u8(&b, 0); put_u8(&b, 0);
+  put_bytes(&b, "+0530", 6);
+  put_bytes(&b, "\n<+0530>-5:30\n", 14);
+
+  AtcTzif tzif;
+  ACU_ASSERT(atc_tzif_init(&tzif, b.buf, b.size) == kAtcErrOk);
+  AtcFindResult result;
+  atc_tzif_find_by_epoch_seconds(&tzif, 0, &result);
+  ACU_ASSERT(result.type == kAtcFindResultExact);
+  ACU_ASSERT(result.std_offset_seconds == 19800);
+  ACU_ASSERT(result.dst_offset_seconds == 0);
+  ACU_ASSERT(strcmp(result.abbrev, "+0530") == 0);
+}
+
+#if ATC_ENABLE_TZIF_MMAP
+ACU_TEST(test_atc_tzif_open)
+{
+  AtcTzif tzif;
+  ACU_ASSERT(atc_tzif_open(&tzif, ATC_TZIF_DEFAULT_DIR, "No/Such_Zone")
+      == kAtcErrGeneric);
+  ACU_ASSERT(atc_tzif_open(&tzif, ATC_TZIF_DEFAULT_DIR, "../../etc/passwd")
+      == kAtcErrGeneric);
+
+  // The system files may be missing, or from a different TZ version, so
+  // check only the rules which have been stable since 2007.
+  if (atc_tzif_open(&tzif, ATC_TZIF_DEFAULT_DIR, "America/Los_Angeles")) {
+    return;
+  }
+  ACU_ASSERT(tzif.is_mapped);
+  AtcFindResult result;
+  atc_tzif_find_by_epoch_seconds(
+      &tzif, to_epoch_seconds(2022, 7, 1, 0, 0, 0), &result);
+  ACU_ASSERT(result.type == kAtcFindResultExact);
+  ACU_ASSERT(result.std_offset_seconds + result.dst_offset_seconds
+      == -7*3600);
+  ACU_ASSERT(strcmp(result.abbrev, "PDT") == 0);
+  atc_tzif_close(&tzif);
+  ACU_ASSERT(! tzif.is_mapped);
+}
+#endif
+
+//---------------------------------------------------------------------------
+
+ACU_CONTEXT();
+
+int main()
+{
+  ACU_RUN_TEST(test_atc_tzif_parse_posix_tz);
+  ACU_RUN_TEST(test_atc_tzif_init_errors);
+  ACU_RUN_TEST(test_atc_tzif_find_by_epoch_seconds);
+  ACU_RUN_TEST(test_atc_tzif_find_by_local_date_time);
+  ACU_RUN_TEST(test_atc_tzif_matches_zone_processor);
+  ACU_RUN_TEST(test_atc_tzif_footer_only);
+#if ATC_ENABLE_TZIF_MMAP
+  ACU_RUN_TEST(test_atc_tzif_open);
+#endif
+  ACU_SUMMARY();
+}
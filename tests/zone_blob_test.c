@@ -0,0 +1,426 @@
+#include <stddef.h> // offsetof()
+#include <stdio.h> // fopen(), remove()
+#include <string.h> // strcmp(), memcmp(), memcpy()
+#include <acunit.h>
+#include <acetimec.h>
+
+// Large enough for kAtcAllZoneAndLinkRegistry. Declared as uint32_t for the
+// 4-byte alignment required by the blob.
+enum { kBufferSize = 128 * 1024 };
+static uint32_t buffer[kBufferSize / sizeof(uint32_t)];
+static uint32_t copy[kBufferSize / sizeof(uint32_t)];
+
+//---------------------------------------------------------------------------
+
+static bool strings_equal(const char *a, const char *b)
+{
+  if (a == NULL || b == NULL) return a == b;
+  return strcmp(a, b) == 0;
+}
+
+static bool eras_equal(const AtcZoneEra *a, const AtcZoneEra *b)
+{
+  if ((a->zone_policy == NULL) != (b->zone_policy == NULL)) return false;
+  if (a->zone_policy != NULL) {
+    if (a->zone_policy->num_rules != b->zone_policy->num_rules) return false;
+    if (memcmp(a->zone_policy->rules, b->zone_policy->rules,
+        a->zone_policy->num_rules * sizeof(AtcZoneRule)) != 0) {
+      return false;
+    }
+  }
+  return strings_equal(a->format, b->format)
+      && a->offset_code == b->offset_code
+#if ATC_HIRES_ZONEDB
+      && a->offset_remainder == b->offset_remainder
+      && a->delta_minutes == b->delta_minutes
+#else
+      && a->delta_code == b->delta_code
+#endif
+      && a->until_year == b->until_year
+      && a->until_month == b->until_month
+      && a->until_day == b->until_day
+      && a->until_time_code == b->until_time_code
+      && a->until_time_modifier == b->until_time_modifier;
+}
+
+static bool infos_equal(const AtcZoneInfo *a, const AtcZoneInfo *b)
+{
+  if (! strings_equal(a->name, b->name)) return false;
+  if (a->zone_id != b->zone_id) return false;
+  if (a->num_eras != b->num_eras) return false;
+  for (uint8_t i = 0; i < a->num_eras; i++) {
+    if (! eras_equal(&a->eras[i], &b->eras[i])) return false;
+  }
+  if ((a->target_info == NULL) != (b->target_info == NULL)) return false;
+  if (a->target_info != NULL) {
+    if (! strings_equal(a->target_info->name, b->target_info->name)) {
+      return false;
+    }
+    if (b->target_info->eras != b->eras) return false;
+  }
+  return true;
+}
+
+// Verify that the processor gives the same transitions for both zones.
+static bool processors_equal(
+    const AtcZoneInfo *a,
+    const AtcZoneInfo *b,
+    int16_t start_year,
+    int16_t until_year)
+{
+  AtcZoneProcessor pa;
+  AtcZoneProcessor pb;
+  atc_processor_init(&pa);
+  atc_processor_init(&pb);
+  atc_processor_init_for_zone_info(&pa, a);
+  atc_processor_init_for_zone_info(&pb, b);
+  for (int16_t year = start_year; year < until_year; year++) {
+    atc_processor_init_for_year(&pa, year);
+    atc_processor_init_for_year(&pb, year);
+    atc_processor_calc_all_abbreviations(&pa);
+    atc_processor_calc_all_abbreviations(&pb);
+    AtcTransitionStorage *tsa = &pa.transition_storage;
+    AtcTransitionStorage *tsb = &pb.transition_storage;
+    AtcTransition **ba = atc_transition_storage_get_active_pool_begin(tsa);
+    AtcTransition **ea = atc_transition_storage_get_active_pool_end(tsa);
+    AtcTransition **bb = atc_transition_storage_get_active_pool_begin(tsb);
+    AtcTransition **eb = atc_transition_storage_get_active_pool_end(tsb);
+    if (ea - ba != eb - bb) return false;
+    for (; ba < ea; ba++, bb++) {
+      if ((*ba)->start_epoch_seconds != (*bb)->start_epoch_seconds) {
+        return false;
+      }
+      if ((*ba)->offset_seconds != (*bb)->offset_seconds) return false;
+      if ((*ba)->delta_seconds != (*bb)->delta_seconds) return false;
+      if (strcmp((*ba)->abbrev, (*bb)->abbrev) != 0) return false;
+    }
+  }
+  return true;
+}
+
+static size_t write_all_zones(void)
+{
+  size_t written;
+  int8_t err = atc_zone_blob_write(
+      kAtcAllZoneAndLinkRegistry, kAtcAllZoneAndLinkRegistrySize,
+      (uint8_t *) buffer, sizeof(buffer), &written);
+  return (err == kAtcErrOk) ? written : 0;
+}
+
+//---------------------------------------------------------------------------
+
+ACU_TEST(test_atc_zone_blob_round_trip)
+{
+  size_t written = write_all_zones();
+  ACU_ASSERT(written > 0);
+  ACU_ASSERT(written % 4 == 0);
+
+  AtcZoneBlob blob;
+  int8_t err = atc_zone_blob_init(&blob, (const uint8_t *) buffer, written);
+  ACU_ASSERT(err == kAtcErrOk);
+  ACU_ASSERT(atc_zone_blob_num_zones(&blob) == kAtcAllZoneAndLinkRegistrySize);
+
+  const AtcZoneContext *context = kAtcAllZoneAndLinkRegistry[0]->zone_context;
+  ACU_ASSERT(strcmp(blob.context.tz_version, context->tz_version) == 0);
+  ACU_ASSERT(blob.context.start_year == context->start_year);
+  ACU_ASSERT(blob.context.until_year == context->until_year);
+  ACU_ASSERT(blob.context.max_transitions == context->max_transitions);
+  ACU_ASSERT(blob.context.num_letters == context->num_letters);
+  for (uint8_t i = 0; i < context->num_letters; i++) {
+    ACU_ASSERT(strings_equal(blob.context.letters[i], context->letters[i]));
+  }
+  ACU_ASSERT(blob.context.num_fragments == context->num_fragments);
+  for (uint8_t i = 0; i < context->num_fragments; i++) {
+    ACU_ASSERT(strings_equal(
+        blob.context.fragments[i], context->fragments[i]));
+  }
+
+  AtcZoneBlobView view;
+  for (uint16_t i = 0; i < kAtcAllZoneAndLinkRegistrySize; i++) {
+    const AtcZoneInfo *info = kAtcAllZoneAndLinkRegistry[i];
+    ACU_ASSERT(atc_zone_blob_get(&blob, i, &view) == kAtcErrOk);
+    ACU_ASSERT(infos_equal(info, &view.info));
+    ACU_ASSERT(view.info.zone_context == &blob.context);
+  }
+  ACU_ASSERT(atc_zone_blob_get(&blob, kAtcAllZoneAndLinkRegistrySize, &view)
+      == kAtcErrGeneric);
+}
+
+ACU_TEST(test_atc_zone_blob_find)
+{
+  size_t written = write_all_zones();
+  AtcZoneBlob blob;
+  int8_t err = atc_zone_blob_init(&blob, (const uint8_t *) buffer, written);
+  ACU_ASSERT(err == kAtcErrOk);
+
+  AtcZoneBlobView view;
+  err = atc_zone_blob_find_by_name(&blob, "America/Los_Angeles", &view);
+  ACU_ASSERT(err == kAtcErrOk);
+  ACU_ASSERT(infos_equal(&kAtcAllZoneAmerica_Los_Angeles, &view.info));
+  ACU_ASSERT(view.info.target_info == NULL);
+
+  // A link is found with its target.
+  err = atc_zone_blob_find_by_name(&blob, "US/Pacific", &view);
+  ACU_ASSERT(err == kAtcErrOk);
+  ACU_ASSERT(strcmp(view.info.name, "US/Pacific") == 0);
+  ACU_ASSERT(view.info.target_info != NULL);
+  ACU_ASSERT(strcmp(view.info.target_info->name, "America/Los_Angeles") == 0);
+
+  err = atc_zone_blob_find_by_id(&blob, kAtcAllZoneIdAmerica_New_York, &view);
+  ACU_ASSERT(err == kAtcErrOk);
+  ACU_ASSERT(strcmp(view.info.name, "America/New_York") == 0);
+
+  ACU_ASSERT(atc_zone_blob_find_by_name(&blob, "America/Nowhere", &view)
+      == kAtcErrGeneric);
+  ACU_ASSERT(atc_zone_blob_find_by_id(&blob, 0, &view) == kAtcErrGeneric);
+}
+
+ACU_TEST(test_atc_zone_blob_processor_all_zones)
+{
+  size_t written = write_all_zones();
+  AtcZoneBlob blob;
+  int8_t err = atc_zone_blob_init(&blob, (const uint8_t *) buffer, written);
+  ACU_ASSERT(err == kAtcErrOk);
+
+  AtcZoneBlobView view;
+  for (uint16_t i = 0; i < kAtcAllZoneAndLinkRegistrySize; i++) {
+    const AtcZoneInfo *info = kAtcAllZoneAndLinkRegistry[i];
+    ACU_ASSERT(atc_zone_blob_get(&blob, i, &view) == kAtcErrOk);
+    ACU_ASSERT(processors_equal(info, &view.info, 1970, 2040));
+  }
+}
+
+// A view which is refilled with another zone keeps its address, so the
+// processor bound to it must notice the change of zone.
+ACU_TEST(test_atc_zone_blob_refill_view)
+{
+  size_t written = write_all_zones();
+  AtcZoneBlob blob;
+  int8_t err = atc_zone_blob_init(&blob, (const uint8_t *) buffer, written);
+  ACU_ASSERT(err == kAtcErrOk);
+
+  AtcLocalDateTime ldt = {2024, 1, 15, 12, 0, 0, 0 /*fold*/};
+  atc_time_t epoch_seconds = atc_local_date_time_to_epoch_seconds(&ldt);
+
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  AtcZoneBlobView view;
+  AtcTimeZone tz = {&view.info, &processor};
+  AtcOffsetDateTime odt;
+
+  err = atc_zone_blob_find_by_name(&blob, "America/Los_Angeles", &view);
+  ACU_ASSERT(err == kAtcErrOk);
+  atc_time_zone_offset_date_time_from_epoch_seconds(&tz, epoch_seconds, &odt);
+  ACU_ASSERT(odt.offset_seconds == -8 * 3600);
+
+  err = atc_zone_blob_find_by_name(&blob, "Europe/London", &view);
+  ACU_ASSERT(err == kAtcErrOk);
+  atc_time_zone_offset_date_time_from_epoch_seconds(&tz, epoch_seconds, &odt);
+  ACU_ASSERT(odt.offset_seconds == 0);
+
+  err = atc_zone_blob_find_by_name(&blob, "Asia/Tokyo", &view);
+  ACU_ASSERT(err == kAtcErrOk);
+  atc_time_zone_offset_date_time_from_epoch_seconds(&tz, epoch_seconds, &odt);
+  ACU_ASSERT(odt.offset_seconds == 9 * 3600);
+}
+
+ACU_TEST(test_atc_zone_blob_write_errors)
+{
+  size_t written;
+
+  // Buffer too small.
+  int8_t err = atc_zone_blob_write(
+      kAtcAllZoneAndLinkRegistry, kAtcAllZoneAndLinkRegistrySize,
+      (uint8_t *) buffer, 1024, &written);
+  ACU_ASSERT(err == kAtcErrGeneric);
+  ACU_ASSERT(written == 0);
+
+  // Empty registry.
+  err = atc_zone_blob_write(
+      kAtcAllZoneAndLinkRegistry, 0, (uint8_t *) buffer, sizeof(buffer),
+      &written);
+  ACU_ASSERT(err == kAtcErrGeneric);
+
+  // A link without its target.
+  const AtcZoneInfo * const registry[] = {&kAtcAllZoneUS_Pacific};
+  err = atc_zone_blob_write(
+      registry, 1, (uint8_t *) buffer, sizeof(buffer), &written);
+  ACU_ASSERT(err == kAtcErrGeneric);
+
+  // Zones from different zone databases.
+  const AtcZoneInfo * const mixed[] = {
+    &kAtcAllZoneAmerica_Los_Angeles,
+    &kAtcTestingZoneAmerica_New_York,
+  };
+  err = atc_zone_blob_write(
+      mixed, 2, (uint8_t *) buffer, sizeof(buffer), &written);
+  ACU_ASSERT(err == kAtcErrGeneric);
+
+  // More letters than the loader can hold.
+  static const char *letters[kAtcZoneBlobMaxStrings + 1];
+  for (int i = 0; i <= kAtcZoneBlobMaxStrings; i++) letters[i] = "";
+  AtcZoneContext context = *kAtcAllZoneAmerica_Los_Angeles.zone_context;
+  context.num_letters = kAtcZoneBlobMaxStrings + 1;
+  context.letters = letters;
+  const AtcZoneInfo info = {
+    kAtcAllZoneAmerica_Los_Angeles.name,
+    kAtcAllZoneAmerica_Los_Angeles.zone_id,
+    &context,
+    kAtcAllZoneAmerica_Los_Angeles.num_eras,
+    kAtcAllZoneAmerica_Los_Angeles.eras,
+    NULL /*target_info*/,
+  };
+  const AtcZoneInfo * const many_letters[] = {&info};
+  err = atc_zone_blob_write(
+      many_letters, 1, (uint8_t *) buffer, sizeof(buffer), &written);
+  ACU_ASSERT(err == kAtcErrGeneric);
+}
+
+ACU_TEST(test_atc_zone_blob_init_errors)
+{
+  size_t written = write_all_zones();
+  ACU_ASSERT(written > 0);
+  const uint8_t *data = (const uint8_t *) copy;
+  AtcZoneBlob blob;
+
+  // Truncated.
+  memcpy(copy, buffer, written);
+  ACU_ASSERT(atc_zone_blob_init(&blob, data, written - 4) == kAtcErrGeneric);
+  ACU_ASSERT(atc_zone_blob_init(&blob, data, 16) == kAtcErrGeneric);
+
+  // Misaligned.
+  ACU_ASSERT(atc_zone_blob_init(&blob, data + 1, written) == kAtcErrGeneric);
+
+  // Bad magic.
+  ((uint8_t *) copy)[0] = 'X';
+  ACU_ASSERT(atc_zone_blob_init(&blob, data, written) == kAtcErrGeneric);
+
+  // A corrupted header is either rejected, or still refers to valid records.
+  AtcZoneBlobView view;
+  for (size_t i = 0; i < 96; i++) {
+    memcpy(copy, buffer, written);
+    ((uint8_t *) copy)[i] ^= 0x80;
+    if (atc_zone_blob_init(&blob, data, written) != kAtcErrOk) continue;
+    for (uint16_t j = 0; j < atc_zone_blob_num_zones(&blob); j++) {
+      ACU_ASSERT(atc_zone_blob_get(&blob, j, &view) == kAtcErrOk);
+    }
+  }
+
+  // The original is still valid.
+  memcpy(copy, buffer, written);
+  ACU_ASSERT(atc_zone_blob_init(&blob, data, written) == kAtcErrOk);
+}
+
+// Return the copy of the first rule of the last era of America/Los_Angeles
+// inside the blob in `copy`.
+static AtcZoneRule *find_rule_in_copy(size_t written)
+{
+  const AtcZoneInfo *info = &kAtcAllZoneAmerica_Los_Angeles;
+  const AtcZoneRule *rule =
+      &info->eras[info->num_eras - 1].zone_policy->rules[0];
+  uint8_t *data = (uint8_t *) copy;
+  for (size_t i = 0; i + sizeof(*rule) <= written; i += 2) {
+    if (memcmp(data + i, rule, sizeof(*rule)) == 0) {
+      return (AtcZoneRule *) (data + i);
+    }
+  }
+  return NULL;
+}
+
+// Corrupt the byte of the rule at `offset` in `copy`, and verify that the blob
+// is rejected.
+static void assert_corrupted_rule_rejected(
+    AcuContext *acu_context,
+    size_t written,
+    size_t offset,
+    uint8_t value)
+{
+  memcpy(copy, buffer, written);
+  AtcZoneRule *rule = find_rule_in_copy(written);
+  ACU_ASSERT(rule != NULL);
+  ((uint8_t *) rule)[offset] = value;
+  AtcZoneBlob blob;
+  ACU_ASSERT(atc_zone_blob_init(&blob, (const uint8_t *) copy, written)
+      == kAtcErrGeneric);
+}
+
+ACU_TEST(test_atc_zone_blob_init_corrupted_rule)
+{
+  size_t written = write_all_zones();
+  ACU_ASSERT(written > 0);
+  uint8_t num_letters =
+      kAtcAllZoneAmerica_Los_Angeles.zone_context->num_letters;
+
+  ACU_ASSERT_NO_FATAL_FAILURE(assert_corrupted_rule_rejected(
+      acu_context, written, offsetof(AtcZoneRule, letter_index),
+      num_letters));
+  ACU_ASSERT_NO_FATAL_FAILURE(assert_corrupted_rule_rejected(
+      acu_context, written, offsetof(AtcZoneRule, letter_index), 0xff));
+  ACU_ASSERT_NO_FATAL_FAILURE(assert_corrupted_rule_rejected(
+      acu_context, written, offsetof(AtcZoneRule, in_month), 0));
+  ACU_ASSERT_NO_FATAL_FAILURE(assert_corrupted_rule_rejected(
+      acu_context, written, offsetof(AtcZoneRule, in_month), 13));
+  ACU_ASSERT_NO_FATAL_FAILURE(assert_corrupted_rule_rejected(
+      acu_context, written, offsetof(AtcZoneRule, on_day_of_week), 8));
+  ACU_ASSERT_NO_FATAL_FAILURE(assert_corrupted_rule_rejected(
+      acu_context, written, offsetof(AtcZoneRule, on_day_of_month), 32));
+  ACU_ASSERT_NO_FATAL_FAILURE(assert_corrupted_rule_rejected(
+      acu_context, written, offsetof(AtcZoneRule, at_time_modifier), 0x30));
+  ACU_ASSERT_NO_FATAL_FAILURE(assert_corrupted_rule_rejected(
+      acu_context, written, offsetof(AtcZoneRule, at_time_modifier), 0x0f));
+
+  // The original is still valid.
+  memcpy(copy, buffer, written);
+  AtcZoneBlob blob;
+  ACU_ASSERT(atc_zone_blob_init(&blob, (const uint8_t *) copy, written)
+      == kAtcErrOk);
+}
+
+#if ATC_ENABLE_ZONE_BLOB_MMAP
+ACU_TEST(test_atc_zone_blob_open)
+{
+  size_t written = write_all_zones();
+  ACU_ASSERT(written > 0);
+  const char *path = "zone_blob_test.bin";
+  FILE *f = fopen(path, "wb");
+  ACU_ASSERT(f != NULL);
+  ACU_ASSERT(fwrite(buffer, 1, written, f) == written);
+  fclose(f);
+
+  AtcZoneBlob blob;
+  int8_t err = atc_zone_blob_open(&blob, path);
+  remove(path);
+  ACU_ASSERT(err == kAtcErrOk);
+
+  AtcZoneBlobView view;
+  err = atc_zone_blob_find_by_name(&blob, "Europe/London", &view);
+  ACU_ASSERT(err == kAtcErrOk);
+  ACU_ASSERT(infos_equal(&kAtcAllZoneEurope_London, &view.info));
+  ACU_ASSERT(processors_equal(
+      &kAtcAllZoneEurope_London, &view.info, 2000, 2030));
+  atc_zone_blob_close(&blob);
+  ACU_ASSERT(atc_zone_blob_num_zones(&blob) == 0);
+
+  err = atc_zone_blob_open(&blob, "does_not_exist.bin");
+  ACU_ASSERT(err == kAtcErrGeneric);
+}
+#endif
+
+//---------------------------------------------------------------------------
+
+ACU_CONTEXT();
+
+int main()
+{
+  ACU_RUN_TEST(test_atc_zone_blob_round_trip);
+  ACU_RUN_TEST(test_atc_zone_blob_find);
+  ACU_RUN_TEST(test_atc_zone_blob_processor_all_zones);
+  ACU_RUN_TEST(test_atc_zone_blob_refill_view);
+  ACU_RUN_TEST(test_atc_zone_blob_write_errors);
+  ACU_RUN_TEST(test_atc_zone_blob_init_errors);
+  ACU_RUN_TEST(test_atc_zone_blob_init_corrupted_rule);
+#if ATC_ENABLE_ZONE_BLOB_MMAP
+  ACU_RUN_TEST(test_atc_zone_blob_open);
+#endif
+  ACU_SUMMARY();
+}
@@ -0,0 +1,157 @@
+#include <string.h> // strcmp()
+#include <acunit.h>
+#include <acetimec.h>
+
+//---------------------------------------------------------------------------
+
+ACU_TEST(test_atc_processor_cache_init)
+{
+  AtcZoneProcessor processors[kAtcZoneProcessorCacheMaxSize + 1];
+  AtcZoneProcessorCache cache;
+
+  atc_processor_cache_init(&cache, processors, 3);
+  ACU_ASSERT(cache.size == 3);
+  ACU_ASSERT(cache.num_hits == 0);
+  ACU_ASSERT(cache.num_misses == 0);
+
+  atc_processor_cache_init(&cache, processors, 0);
+  ACU_ASSERT(cache.size == 1);
+
+  atc_processor_cache_init(&cache, processors,
+      kAtcZoneProcessorCacheMaxSize + 1);
+  ACU_ASSERT(cache.size == kAtcZoneProcessorCacheMaxSize);
+}
+
+ACU_TEST(test_atc_processor_cache_get_for_year_lru)
+{
+  AtcZoneProcessor processors[2];
+  AtcZoneProcessorCache cache;
+  atc_processor_cache_init(&cache, processors, 2);
+  atc_processor_cache_init_for_zone_info(
+      &cache, &kAtcTestingZoneAmerica_Los_Angeles);
+
+  AtcZoneProcessor *p2020 = atc_processor_cache_get_for_year(&cache, 2020);
+  ACU_ASSERT(p2020 != NULL);
+  ACU_ASSERT(p2020->year == 2020);
+  AtcZoneProcessor *p2021 = atc_processor_cache_get_for_year(&cache, 2021);
+  ACU_ASSERT(p2021 != NULL);
+  ACU_ASSERT(p2021 != p2020);
+  ACU_ASSERT(cache.num_misses == 2);
+  ACU_ASSERT(cache.num_hits == 0);
+
+  // 2020 is a hit, which makes 2021 the least recently used.
+  ACU_ASSERT(atc_processor_cache_get_for_year(&cache, 2020) == p2020);
+  ACU_ASSERT(cache.num_hits == 1);
+
+  // 2022 evicts 2021.
+  AtcZoneProcessor *p2022 = atc_processor_cache_get_for_year(&cache, 2022);
+  ACU_ASSERT(p2022 == p2021);
+  ACU_ASSERT(p2022->year == 2022);
+  ACU_ASSERT(cache.num_misses == 3);
+
+  // 2020 is still in the cache.
+  ACU_ASSERT(atc_processor_cache_get_for_year(&cache, 2020) == p2020);
+  ACU_ASSERT(cache.num_hits == 2);
+
+  // 2021 must be recalculated, evicting 2022.
+  ACU_ASSERT(atc_processor_cache_get_for_year(&cache, 2021) == p2022);
+  ACU_ASSERT(cache.num_misses == 4);
+
+  atc_processor_cache_reset_stats(&cache);
+  ACU_ASSERT(cache.num_hits == 0);
+  ACU_ASSERT(cache.num_misses == 0);
+}
+
+ACU_TEST(test_atc_processor_cache_get_for_year_invalid)
+{
+  AtcZoneProcessor processors[2];
+  AtcZoneProcessorCache cache;
+  atc_processor_cache_init(&cache, processors, 2);
+  atc_processor_cache_init_for_zone_info(
+      &cache, &kAtcTestingZoneAmerica_Los_Angeles);
+
+  ACU_ASSERT(atc_processor_cache_get_for_year(&cache, kAtcMinYear) == NULL);
+  ACU_ASSERT(atc_processor_cache_get_for_year(&cache, kAtcMaxYear) == NULL);
+  ACU_ASSERT(cache.num_hits == 0);
+  ACU_ASSERT(cache.num_misses == 0);
+}
+
+ACU_TEST(test_atc_processor_cache_find_by_epoch_seconds_straddle_year)
+{
+  AtcZoneProcessor processors[2];
+  AtcZoneProcessorCache cache;
+  atc_processor_cache_init(&cache, processors, 2);
+  atc_processor_cache_init_for_zone_info(
+      &cache, &kAtcTestingZoneAmerica_Los_Angeles);
+
+  // 2022-12-31T23:00:00 UTC and 2023-01-01T01:00:00 UTC
+  AtcLocalDateTime ldt_before = {2022, 12, 31, 23, 0, 0, 0 /*fold*/};
+  AtcLocalDateTime ldt_after = {2023, 1, 1, 1, 0, 0, 0 /*fold*/};
+  atc_time_t before = atc_local_date_time_to_epoch_seconds(&ldt_before);
+  atc_time_t after = atc_local_date_time_to_epoch_seconds(&ldt_after);
+
+  AtcFindResult result;
+  for (int i = 0; i < 10; i++) {
+    atc_processor_cache_find_by_epoch_seconds(&cache, before, &result);
+    ACU_ASSERT(result.type == kAtcFindResultExact);
+    ACU_ASSERT(result.std_offset_seconds == -8*3600);
+    ACU_ASSERT(result.dst_offset_seconds == 0);
+    ACU_ASSERT(strcmp(result.abbrev, "PST") == 0);
+
+    atc_processor_cache_find_by_epoch_seconds(&cache, after, &result);
+    ACU_ASSERT(result.type == kAtcFindResultExact);
+    ACU_ASSERT(result.std_offset_seconds == -8*3600);
+    ACU_ASSERT(result.dst_offset_seconds == 0);
+    ACU_ASSERT(strcmp(result.abbrev, "PST") == 0);
+  }
+
+  // Only the first request for each year is a miss.
+  ACU_ASSERT(cache.num_misses == 2);
+  ACU_ASSERT(cache.num_hits == 18);
+}
+
+ACU_TEST(test_atc_processor_cache_find_by_local_date_time)
+{
+  AtcZoneProcessor processors[2];
+  AtcZoneProcessorCache cache;
+  atc_processor_cache_init(&cache, processors, 2);
+  atc_processor_cache_init_for_zone_info(
+      &cache, &kAtcTestingZoneAmerica_Los_Angeles);
+
+  // 2022-03-13T02:30:00 is in the gap
+  AtcLocalDateTime ldt = {2022, 3, 13, 2, 30, 0, 0 /*fold*/};
+  AtcFindResult result;
+  atc_processor_cache_find_by_local_date_time(&cache, &ldt, &result);
+  ACU_ASSERT(result.type == kAtcFindResultGap);
+  ACU_ASSERT(result.std_offset_seconds == -8*3600);
+  ACU_ASSERT(result.dst_offset_seconds == 1*3600);
+  ACU_ASSERT(result.req_std_offset_seconds == -8*3600);
+  ACU_ASSERT(result.req_dst_offset_seconds == 0);
+  ACU_ASSERT(strcmp(result.abbrev, "PDT") == 0);
+
+  // 2022-11-06T01:30:00 is in the overlap
+  AtcLocalDateTime ldt2 = {2022, 11, 6, 1, 30, 0, 1 /*fold*/};
+  atc_processor_cache_find_by_local_date_time(&cache, &ldt2, &result);
+  ACU_ASSERT(result.type == kAtcFindResultOverlap);
+  ACU_ASSERT(result.fold == 1);
+  ACU_ASSERT(result.std_offset_seconds == -8*3600);
+  ACU_ASSERT(result.dst_offset_seconds == 0);
+  ACU_ASSERT(strcmp(result.abbrev, "PST") == 0);
+
+  ACU_ASSERT(cache.num_misses == 1);
+  ACU_ASSERT(cache.num_hits == 1);
+}
+
+//---------------------------------------------------------------------------
+
+ACU_CONTEXT();
+
+int main()
+{
+  ACU_RUN_TEST(test_atc_processor_cache_init);
+  ACU_RUN_TEST(test_atc_processor_cache_get_for_year_lru);
+  ACU_RUN_TEST(test_atc_processor_cache_get_for_year_invalid);
+  ACU_RUN_TEST(test_atc_processor_cache_find_by_epoch_seconds_straddle_year);
+  ACU_RUN_TEST(test_atc_processor_cache_find_by_local_date_time);
+  ACU_SUMMARY();
+}
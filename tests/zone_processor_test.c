@@ -1132,6 +1132,464 @@ ACU_TEST(test_atc_processor_create_abbreviation)
   ACU_ASSERT(strcmp("PDDT3", dst) == 0);
 }
 
+//---------------------------------------------------------------------------
+// AtcEpochContext
+//---------------------------------------------------------------------------
+
+ACU_TEST(test_atc_processor_find_by_epoch_seconds_ctx)
+{
+  AtcEpochContext ctx;
+  atc_epoch_context_init(&ctx, 2000);
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  atc_processor_init_for_zone_info(
+      &processor, &kAtcTestingZoneAmerica_Los_Angeles);
+
+  // 2000-01-01T00:00:00 UTC
+  AtcFindResult result;
+  atc_processor_find_by_epoch_seconds_ctx(&processor, &ctx, 0, &result);
+  ACU_ASSERT(result.type == kAtcFindResultExact);
+  ACU_ASSERT(result.std_offset_seconds == -8*3600);
+  ACU_ASSERT(result.dst_offset_seconds == 0);
+  ACU_ASSERT(processor.year == 2000);
+  ACU_ASSERT(processor.epoch_year == 2000);
+  ACU_ASSERT(atc_get_current_epoch_year() == kAtcDefaultEpochYear);
+
+  // 2000-04-02T02:00:00-08:00 (10:00 UTC) starts DST.
+  atc_processor_find_by_epoch_seconds_ctx(
+      &processor, &ctx, (31 + 29 + 31 + 1) * 86400 + 10 * 3600, &result);
+  ACU_ASSERT(result.type == kAtcFindResultExact);
+  ACU_ASSERT(result.dst_offset_seconds == 1*3600);
+
+  // Using the global epoch regenerates the transitions.
+  atc_processor_find_by_epoch_seconds(&processor, 0, &result);
+  ACU_ASSERT(result.type == kAtcFindResultExact);
+  ACU_ASSERT(processor.year == 2050);
+  ACU_ASSERT(processor.epoch_year == kAtcDefaultEpochYear);
+}
+
+ACU_TEST(test_atc_processor_find_by_local_date_time_ctx)
+{
+  AtcEpochContext ctx;
+  atc_epoch_context_init(&ctx, 2000);
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  atc_processor_init_for_zone_info(
+      &processor, &kAtcTestingZoneAmerica_Los_Angeles);
+
+  // 2000-10-29T01:30:00 is in the overlap
+  AtcLocalDateTime ldt = {2000, 10, 29, 1, 30, 0, 1 /*fold*/};
+  AtcFindResult result;
+  atc_processor_find_by_local_date_time_ctx(&processor, &ctx, &ldt, &result);
+  ACU_ASSERT(result.type == kAtcFindResultOverlap);
+  ACU_ASSERT(result.fold == 1);
+  ACU_ASSERT(result.std_offset_seconds == -8*3600);
+  ACU_ASSERT(result.dst_offset_seconds == 0);
+  ACU_ASSERT(processor.epoch_year == 2000);
+
+  // The transitions are relative to the epoch of ctx.
+  const AtcTransition *t =
+      processor.transition_storage.transitions[0];
+  atc_time_t start_2000 = atc_local_date_time_to_epoch_seconds_ctx(
+      &ctx, &(AtcLocalDateTime){2000, 1, 1, 0, 0, 0, 0});
+  ACU_ASSERT(t->start_epoch_seconds < start_2000);
+  ACU_ASSERT(t->start_epoch_seconds > start_2000 - 32 * 86400);
+}
+
+static uint8_t count_valid_abbrevs(const AtcZoneProcessor *processor)
+{
+  const AtcTransitionStorage *ts = &processor->transition_storage;
+  uint8_t count = 0;
+  for (uint8_t i = 0; i < ts->index_free; i++) {
+    if (ts->transitions[i]->is_abbrev_valid) count++;
+  }
+  return count;
+}
+
+ACU_TEST(test_atc_processor_lazy_abbreviations)
+{
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  atc_processor_init_for_zone_info(
+      &processor, &kAtcTestingZoneAmerica_Los_Angeles);
+
+  // 2022-06-01T00:00:00 is in PDT.
+  AtcLocalDateTime ldt = {2022, 6, 1, 0, 0, 0, 0 /*fold*/};
+  atc_time_t es = atc_local_date_time_to_epoch_seconds(&ldt);
+
+  // The offsets-only functions never calculate the abbreviations.
+  AtcFindResult result;
+  atc_processor_find_offsets_by_epoch_seconds(&processor, es, &result);
+  ACU_ASSERT(result.type == kAtcFindResultExact);
+  ACU_ASSERT(result.dst_offset_seconds == 3600);
+  ACU_ASSERT(result.abbrev == NULL);
+  atc_processor_find_offsets_by_local_date_time(&processor, &ldt, &result);
+  ACU_ASSERT(result.type == kAtcFindResultExact);
+  ACU_ASSERT(result.abbrev == NULL);
+  ACU_ASSERT(count_valid_abbrevs(&processor) == 0);
+
+  // The lookup functions cannot calculate them.
+  atc_processor_lookup_by_epoch_seconds(&processor, es, &result);
+  ACU_ASSERT(strcmp(result.abbrev, "") == 0);
+
+  // The find functions calculate only the abbreviation of the transition
+  // which is returned.
+  atc_processor_find_by_epoch_seconds(&processor, es, &result);
+  ACU_ASSERT(strcmp(result.abbrev, "PDT") == 0);
+  ACU_ASSERT(count_valid_abbrevs(&processor) == 1);
+  atc_processor_find_by_local_date_time(&processor, &ldt, &result);
+  ACU_ASSERT(strcmp(result.abbrev, "PDT") == 0);
+  ACU_ASSERT(count_valid_abbrevs(&processor) == 1);
+
+  atc_processor_calc_all_abbreviations(&processor);
+  ACU_ASSERT(count_valid_abbrevs(&processor)
+      == processor.transition_storage.index_free);
+  atc_processor_lookup_by_epoch_seconds(&processor, es, &result);
+  ACU_ASSERT(strcmp(result.abbrev, "PDT") == 0);
+
+  // A new year invalidates the abbreviations.
+  atc_processor_init_for_year(&processor, 2023);
+  ACU_ASSERT(count_valid_abbrevs(&processor) == 0);
+}
+
+ACU_TEST(test_atc_processor_resolve_local_date_times)
+{
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  atc_processor_init_for_zone_info(
+      &processor, &kAtcTestingZoneAmerica_Los_Angeles);
+
+  AtcLocalDateTime ldts[] = {
+    {2022, 3, 13, 2, 30, 0, 0 /*fold*/}, // gap
+    {2022, 3, 13, 2, 30, 0, 1 /*fold*/}, // gap
+    {2022, 11, 6, 1, 30, 0, 0 /*fold*/}, // overlap
+    {2022, 11, 6, 1, 30, 0, 1 /*fold*/}, // overlap
+    {2023, 2, 14, 12, 32, 0, 0 /*fold*/}, // exact
+    {kAtcMaxYear, 1, 1, 0, 0, 0, 0 /*fold*/}, // invalid year
+  };
+  AtcLocalResolution resolutions[6];
+  atc_processor_resolve_local_date_times(&processor, ldts, 6, resolutions);
+
+  ACU_ASSERT(resolutions[0].type == kAtcFindResultGap);
+  ACU_ASSERT(resolutions[0].req_dst_offset_seconds == 0);
+  ACU_ASSERT(resolutions[0].dst_offset_seconds == 3600);
+  ACU_ASSERT(resolutions[1].type == kAtcFindResultGap);
+  ACU_ASSERT(resolutions[1].req_dst_offset_seconds == 3600);
+  ACU_ASSERT(resolutions[1].dst_offset_seconds == 0);
+  // 02:30-08:00 is 03:30-07:00, 02:30-07:00 is 01:30-08:00
+  ACU_ASSERT(resolutions[0].epoch_seconds - resolutions[1].epoch_seconds
+      == 3600);
+
+  ACU_ASSERT(resolutions[2].type == kAtcFindResultOverlap);
+  ACU_ASSERT(resolutions[2].fold == 0);
+  ACU_ASSERT(resolutions[2].dst_offset_seconds == 3600);
+  ACU_ASSERT(resolutions[3].type == kAtcFindResultOverlap);
+  ACU_ASSERT(resolutions[3].fold == 1);
+  ACU_ASSERT(resolutions[3].dst_offset_seconds == 0);
+  ACU_ASSERT(resolutions[3].epoch_seconds - resolutions[2].epoch_seconds
+      == 3600);
+
+  ACU_ASSERT(resolutions[4].type == kAtcFindResultExact);
+  ACU_ASSERT(resolutions[4].std_offset_seconds == -8*3600);
+  AtcLocalDateTime utc;
+  atc_local_date_time_from_epoch_seconds(&utc, resolutions[4].epoch_seconds);
+  ACU_ASSERT(utc.day == 14);
+  ACU_ASSERT(utc.hour == 20);
+  ACU_ASSERT(utc.minute == 32);
+
+  ACU_ASSERT(resolutions[5].type == kAtcFindResultNotFound);
+  ACU_ASSERT(resolutions[5].epoch_seconds == kAtcInvalidEpochSeconds);
+}
+
+// Verify that atc_processor_resolve_local_date_times() agrees with
+// atc_processor_find_by_local_date_time() and
+// atc_time_zone_offset_date_time_from_local_date_time().
+static bool check_resolve_against_find(const AtcZoneInfo *zone_info)
+{
+  enum { kNumLdts = 4 * 365 * 4 * 2 };
+  static AtcLocalDateTime ldts[kNumLdts];
+  static AtcLocalResolution resolutions[kNumLdts];
+
+  // At 00:30, 01:30, 02:30 and 03:30 (where most gaps and overlaps occur) of
+  // every day of 4 years, in both folds, grouped by year.
+  size_t n = 0;
+  for (int16_t year = 2000; year < 2040; year += 10) {
+    for (int32_t i = 0; i < 365; i++) {
+      for (uint8_t hour = 0; hour < 4; hour++) {
+        for (uint8_t fold = 0; fold < 2; fold++) {
+          AtcLocalDateTime *ldt = &ldts[n++];
+          int32_t days = atc_local_date_to_epoch_days(year, 1, 1) + i;
+          atc_local_date_from_epoch_days(
+              days, &ldt->year, &ldt->month, &ldt->day);
+          ldt->hour = hour;
+          ldt->minute = 30;
+          ldt->second = 0;
+          ldt->fold = fold;
+        }
+      }
+    }
+  }
+
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  atc_processor_init_for_zone_info(&processor, zone_info);
+  atc_processor_resolve_local_date_times(&processor, ldts, n, resolutions);
+
+  AtcTimeZone tz = {zone_info, &processor};
+  for (size_t i = 0; i < n; i++) {
+    AtcFindResult expected;
+    atc_processor_find_by_local_date_time(&processor, &ldts[i], &expected);
+    const AtcLocalResolution *r = &resolutions[i];
+    if (r->type != expected.type) return false;
+    if (r->type == kAtcFindResultNotFound) continue;
+    if (r->fold != expected.fold
+        || r->std_offset_seconds != expected.std_offset_seconds
+        || r->dst_offset_seconds != expected.dst_offset_seconds
+        || r->req_std_offset_seconds != expected.req_std_offset_seconds
+        || r->req_dst_offset_seconds != expected.req_dst_offset_seconds) {
+      return false;
+    }
+
+    AtcOffsetDateTime odt;
+    atc_time_zone_offset_date_time_from_local_date_time(&tz, &ldts[i], &odt);
+    if (r->epoch_seconds != atc_offset_date_time_to_epoch_seconds(&odt)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Verify that atc_processor_find_by_epoch_seconds(), which skips the
+// calculation of the UTC year when the previous transition still matches,
+// agrees with a lookup using the transitions of the UTC year.
+ACU_TEST(test_atc_processor_find_by_epoch_seconds_memo_all_zones)
+{
+  AtcZoneProcessor processor;
+  AtcZoneProcessor reference;
+  atc_processor_init(&processor);
+  atc_processor_init(&reference);
+
+  AtcLocalDateTime ldt = {2000, 1, 1, 0, 0, 0, 0 /*fold*/};
+  atc_time_t start = atc_local_date_time_to_epoch_seconds(&ldt);
+  ldt.year = 2030;
+  atc_time_t until = atc_local_date_time_to_epoch_seconds(&ldt);
+  for (uint16_t i = 0; i < kAtcAllZoneRegistrySize; i++) {
+    const AtcZoneInfo *zone_info = kAtcAllZoneRegistry[i];
+    atc_processor_init_for_zone_info(&processor, zone_info);
+    atc_processor_init_for_zone_info(&reference, zone_info);
+    for (atc_time_t es = start; es < until; es += 7 * 3600 + 1) {
+      AtcFindResult observed;
+      atc_processor_find_by_epoch_seconds(&processor, es, &observed);
+      AtcFindResult expected;
+      atc_processor_init_for_epoch_seconds(&reference, es);
+      atc_processor_calc_all_abbreviations(&reference);
+      atc_processor_lookup_by_epoch_seconds(&reference, es, &expected);
+      ACU_ASSERT(observed.type == expected.type);
+      ACU_ASSERT(observed.fold == expected.fold);
+      ACU_ASSERT(observed.std_offset_seconds == expected.std_offset_seconds);
+      ACU_ASSERT(observed.dst_offset_seconds == expected.dst_offset_seconds);
+      ACU_ASSERT(strcmp(observed.abbrev, expected.abbrev) == 0);
+    }
+  }
+}
+
+ACU_TEST(test_atc_processor_resolve_local_date_times_all_zones)
+{
+  for (uint16_t i = 0; i < kAtcAllZoneRegistrySize; i++) {
+    ACU_ASSERT(check_resolve_against_find(kAtcAllZoneRegistry[i]));
+  }
+}
+
+ACU_TEST(test_atc_processor_fixed_offset_start_year)
+{
+  ACU_ASSERT(atc_processor_fixed_offset_start_year(&kAtcAllZoneEtc_GMT_PLUS_5)
+      == kAtcMinYear);
+  ACU_ASSERT(atc_processor_is_fixed_offset_zone(&kAtcAllZoneEtc_GMT_PLUS_5));
+  ACU_ASSERT(atc_processor_is_fixed_offset_zone(&kAtcAllZoneEtc_UTC));
+
+  // Last DST rule change in 1945.
+  int16_t year = atc_processor_fixed_offset_start_year(
+      &kAtcAllZoneAsia_Kolkata);
+  ACU_ASSERT(1945 < year && year < 2000);
+  ACU_ASSERT(! atc_processor_is_fixed_offset_zone(&kAtcAllZoneAsia_Kolkata));
+
+  // Permanent +03 since 2016-09-07.
+  ACU_ASSERT(atc_processor_fixed_offset_start_year(
+      &kAtcAllZoneEurope_Istanbul) == 2017);
+
+  ACU_ASSERT(atc_processor_fixed_offset_start_year(
+      &kAtcAllZoneAmerica_Los_Angeles) == kAtcInvalidYear);
+  ACU_ASSERT(! atc_processor_is_fixed_offset_zone(
+      &kAtcAllZoneAmerica_Los_Angeles));
+}
+
+// Verify that the fixed offset fast path returns the same results as the
+// transitions over the first 3 years of the constant offset of every zone. The
+// epoch year is moved to the first year, so that it can be represented by a
+// 32-bit atc_time_t.
+ACU_TEST(test_atc_processor_fixed_offset_all_zones)
+{
+  AtcZoneProcessor processor;
+  AtcZoneProcessor reference;
+  atc_processor_init(&processor);
+  atc_processor_init(&reference);
+
+  for (uint16_t i = 0; i < kAtcAllZoneRegistrySize; i++) {
+    const AtcZoneInfo *zone_info = kAtcAllZoneRegistry[i];
+    int16_t start_year = atc_processor_fixed_offset_start_year(zone_info);
+    if (start_year == kAtcInvalidYear) continue;
+    if (start_year == kAtcMinYear) start_year = 2000;
+
+    AtcEpochContext ctx;
+    atc_epoch_context_init(&ctx, start_year);
+    atc_processor_init_for_zone_info(&processor, zone_info);
+    atc_processor_init_for_zone_info(&reference, zone_info);
+    atc_time_t until = 86400
+        * atc_local_date_to_epoch_days_ctx(&ctx, start_year + 3, 1, 1);
+    for (atc_time_t es = 0; es < until; es += 5 * 86400 + 3601) {
+      AtcFindResult observed;
+      AtcFindResult expected;
+      atc_processor_find_by_epoch_seconds_ctx(
+          &processor, &ctx, es, &observed);
+      atc_processor_init_for_epoch_seconds_ctx(&reference, &ctx, es);
+      atc_processor_calc_all_abbreviations(&reference);
+      atc_processor_lookup_by_epoch_seconds(&reference, es, &expected);
+      ACU_ASSERT(observed.type == expected.type);
+      ACU_ASSERT(observed.fold == expected.fold);
+      ACU_ASSERT(observed.std_offset_seconds == expected.std_offset_seconds);
+      ACU_ASSERT(observed.dst_offset_seconds == expected.dst_offset_seconds);
+      ACU_ASSERT(strcmp(observed.abbrev, expected.abbrev) == 0);
+
+      AtcLocalDateTime ldt;
+      atc_local_date_time_from_epoch_seconds_ctx(&ctx, &ldt, es);
+      atc_processor_find_by_local_date_time_ctx(
+          &processor, &ctx, &ldt, &observed);
+      atc_processor_init_for_year_ctx(&reference, &ctx, ldt.year);
+      atc_processor_calc_all_abbreviations(&reference);
+      atc_processor_lookup_by_local_date_time(&reference, &ldt, &expected);
+      ACU_ASSERT(observed.type == expected.type);
+      ACU_ASSERT(observed.fold == expected.fold);
+      ACU_ASSERT(observed.std_offset_seconds == expected.std_offset_seconds);
+      ACU_ASSERT(observed.dst_offset_seconds == expected.dst_offset_seconds);
+      ACU_ASSERT(observed.req_std_offset_seconds
+          == expected.req_std_offset_seconds);
+      ACU_ASSERT(observed.req_dst_offset_seconds
+          == expected.req_dst_offset_seconds);
+      ACU_ASSERT(strcmp(observed.abbrev, expected.abbrev) == 0);
+    }
+
+    // The transitions were never calculated.
+    ACU_ASSERT(processor.year == kAtcInvalidYear);
+  }
+}
+
+ACU_TEST(test_atc_processor_transition_year)
+{
+  const AtcZoneInfo *la = &kAtcAllZoneAmerica_Los_Angeles;
+  ACU_ASSERT(atc_processor_next_transition_year(la, 2000) == 2000);
+  ACU_ASSERT(atc_processor_prev_transition_year(la, 2000) == 2000);
+
+  // Last DST rule change in 1945.
+  const AtcZoneInfo *kolkata = &kAtcAllZoneAsia_Kolkata;
+  ACU_ASSERT(atc_processor_next_transition_year(kolkata, 2000)
+      == kAtcInvalidYear);
+  int16_t year = atc_processor_prev_transition_year(kolkata, 2000);
+  ACU_ASSERT(1945 <= year && year < 1950);
+
+  // Permanent +03 since 2016-09-07.
+  const AtcZoneInfo *istanbul = &kAtcAllZoneEurope_Istanbul;
+  ACU_ASSERT(atc_processor_next_transition_year(istanbul, 2020)
+      == kAtcInvalidYear);
+  year = atc_processor_prev_transition_year(istanbul, 2020);
+  ACU_ASSERT(2016 <= year && year < 2020);
+
+  // No transitions at all.
+  const AtcZoneInfo *utc = &kAtcAllZoneEtc_UTC;
+  ACU_ASSERT(atc_processor_next_transition_year(utc, 2000)
+      == kAtcInvalidYear);
+  ACU_ASSERT(atc_processor_prev_transition_year(utc, 2000)
+      == kAtcInvalidYear);
+}
+
+// Verify that the years skipped by atc_processor_next_transition_year() and
+// atc_processor_prev_transition_year() really contain no transition. The epoch
+// year is moved to each year, so that it can be represented by a 32-bit
+// atc_time_t.
+ACU_TEST(test_atc_processor_transition_year_all_zones)
+{
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+
+  for (uint16_t i = 0; i < kAtcAllZoneRegistrySize; i++) {
+    const AtcZoneInfo *zone_info = kAtcAllZoneRegistry[i];
+    atc_processor_init_for_zone_info(&processor, zone_info);
+    for (int16_t year = 1900; year < 2100; year++) {
+      AtcEpochContext ctx;
+      atc_epoch_context_init(&ctx, year);
+      atc_processor_init_for_year_ctx(&processor, &ctx, year);
+      atc_processor_calc_all_abbreviations(&processor);
+
+      AtcTransitionStorage *ts = &processor.transition_storage;
+      AtcTransition **begin = atc_transition_storage_get_active_pool_begin(ts);
+      AtcTransition **end = atc_transition_storage_get_active_pool_end(ts);
+      bool has_transition = false;
+      for (AtcTransition **iter = begin + 1; iter < end; ++iter) {
+        const AtcTransition *prev = *(iter - 1);
+        const AtcTransition *t = *iter;
+        if (t->start_epoch_seconds < processor.year_start_epoch_seconds
+            || t->start_epoch_seconds >= processor.year_until_epoch_seconds) {
+          continue;
+        }
+        if (prev->offset_seconds != t->offset_seconds
+            || prev->delta_seconds != t->delta_seconds
+            || strcmp(prev->abbrev, t->abbrev) != 0) {
+          has_transition = true;
+          break;
+        }
+      }
+      if (! has_transition) continue;
+
+      ACU_ASSERT(atc_processor_next_transition_year(zone_info, year) == year);
+      ACU_ASSERT(atc_processor_prev_transition_year(zone_info, year) == year);
+    }
+  }
+}
+
+ACU_TEST(test_atc_processor_find_by_epoch_seconds_time64)
+{
+#if ATC_TIME64
+  // Years far outside of the 32-bit range around the default epoch year.
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  atc_processor_init_for_zone_info(&processor, &kAtcAllZoneAmerica_Los_Angeles);
+
+  AtcLocalDateTime ldt = {1850, 6, 1, 0, 0, 0, 0 /*fold*/};
+  atc_time_t es = atc_local_date_time_to_epoch_seconds(&ldt);
+  AtcFindResult result;
+  atc_processor_find_by_epoch_seconds(&processor, es, &result);
+  ACU_ASSERT(result.type == kAtcFindResultExact);
+  ACU_ASSERT(result.std_offset_seconds == -(7*3600 + 52*60 + 58));
+  ACU_ASSERT(result.dst_offset_seconds == 0);
+  ACU_ASSERT(strcmp(result.abbrev, "LMT") == 0);
+
+  ldt = (AtcLocalDateTime) {2150, 7, 1, 0, 0, 0, 0 /*fold*/};
+  es = atc_local_date_time_to_epoch_seconds(&ldt);
+  atc_processor_find_by_epoch_seconds(&processor, es, &result);
+  ACU_ASSERT(result.type == kAtcFindResultExact);
+  ACU_ASSERT(result.std_offset_seconds == -8*3600);
+  ACU_ASSERT(result.dst_offset_seconds == 3600);
+  ACU_ASSERT(strcmp(result.abbrev, "PDT") == 0);
+
+  atc_processor_find_by_local_date_time(&processor, &ldt, &result);
+  ACU_ASSERT(result.type == kAtcFindResultExact);
+  ACU_ASSERT(result.dst_offset_seconds == 3600);
+#else
+  // These years cannot be represented by a 32-bit atc_time_t.
+  ACU_ASSERT(atc_epoch_valid_year_lower() > 1850);
+  ACU_ASSERT(atc_epoch_valid_year_upper() <= 2150);
+#endif
+}
+
 //---------------------------------------------------------------------------
 
 ACU_CONTEXT();
@@ -1153,5 +1611,16 @@ int main()
   ACU_RUN_TEST(test_atc_processor_create_transitions_from_named_match);
   ACU_RUN_TEST(test_fix_transition_times_generate_start_until_times);
   ACU_RUN_TEST(test_atc_processor_create_abbreviation);
+  ACU_RUN_TEST(test_atc_processor_find_by_epoch_seconds_ctx);
+  ACU_RUN_TEST(test_atc_processor_find_by_local_date_time_ctx);
+  ACU_RUN_TEST(test_atc_processor_find_by_epoch_seconds_memo_all_zones);
+  ACU_RUN_TEST(test_atc_processor_lazy_abbreviations);
+  ACU_RUN_TEST(test_atc_processor_fixed_offset_start_year);
+  ACU_RUN_TEST(test_atc_processor_fixed_offset_all_zones);
+  ACU_RUN_TEST(test_atc_processor_transition_year);
+  ACU_RUN_TEST(test_atc_processor_transition_year_all_zones);
+  ACU_RUN_TEST(test_atc_processor_find_by_epoch_seconds_time64);
+  ACU_RUN_TEST(test_atc_processor_resolve_local_date_times);
+  ACU_RUN_TEST(test_atc_processor_resolve_local_date_times_all_zones);
   ACU_SUMMARY();
 }
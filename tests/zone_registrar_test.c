@@ -1,6 +1,20 @@
+#include <string.h> // strcmp(), strncmp(), strlen()
 #include <acunit.h>
 #include <acetimec.h>
 
+// Return true if the first n characters of a and b are equal without regard
+// to ASCII case. A shorter string is padded with NUL.
+static bool equal_ignore_case(const char *a, const char *b, size_t n)
+{
+  for (size_t i = 0; i < n; i++) {
+    char ca = (a[i] >= 'A' && a[i] <= 'Z') ? a[i] - 'A' + 'a' : a[i];
+    char cb = (b[i] >= 'A' && b[i] <= 'Z') ? b[i] - 'A' + 'a' : b[i];
+    if (ca != cb) return false;
+    if (ca == '\0') return true;
+  }
+  return true;
+}
+
 static const AtcZoneInfo * const kUnsortedRegistry[] = {
   &kAtcTestingZoneAmerica_Los_Angeles,
   &kAtcTestingZoneAmerica_Denver,
@@ -84,6 +98,214 @@ ACU_TEST(test_atc_registrar_find_by_name_unsorted)
   ACU_ASSERT(info == NULL);
 }
 
+ACU_TEST(test_atc_registrar_index_all_zones)
+{
+  enum { kSize = kAtcAllZoneAndLinkRegistrySize };
+  static uint16_t seeds[ATC_REGISTRY_INDEX_NUM_BUCKETS(kSize)];
+  static uint32_t ids[kSize];
+  static uint16_t indexes[kSize];
+  AtcZoneRegistryIndex index;
+  int8_t err = atc_registrar_build_index(
+      &index, kAtcAllZoneAndLinkRegistry, kSize, seeds, ids, indexes);
+  ACU_ASSERT(err == kAtcErrOk);
+
+  AtcZoneRegistrar registrar;
+  atc_registrar_init(&registrar, kAtcAllZoneAndLinkRegistry, kSize);
+  atc_registrar_set_index(&registrar, &index);
+
+  // Every zone is found, both by id and by name.
+  for (uint16_t i = 0; i < kSize; i++) {
+    const AtcZoneInfo *expected = kAtcAllZoneAndLinkRegistry[i];
+    ACU_ASSERT(indexes[i] < kSize);
+    ACU_ASSERT(atc_registrar_find_by_id(&registrar, expected->zone_id)
+        == expected);
+    ACU_ASSERT(atc_registrar_find_by_name(&registrar, expected->name)
+        == expected);
+  }
+
+  // Zones which are not in the registry.
+  ACU_ASSERT(atc_registrar_find_by_id(&registrar, 0x0) == NULL);
+  ACU_ASSERT(atc_registrar_find_by_name(&registrar, "should not exist")
+      == NULL);
+  ACU_ASSERT(atc_registrar_find_by_name(&registrar, "") == NULL);
+
+  // Back to the binary search.
+  atc_registrar_set_index(&registrar, NULL);
+  ACU_ASSERT(atc_registrar_find_by_id(&registrar, kAtcAllZoneIdEurope_London)
+      == &kAtcAllZoneEurope_London);
+}
+
+ACU_TEST(test_atc_registrar_index_unsorted)
+{
+  uint16_t seeds[ATC_REGISTRY_INDEX_NUM_BUCKETS(UNSORTED_SIZE)];
+  uint32_t ids[UNSORTED_SIZE];
+  uint16_t indexes[UNSORTED_SIZE];
+  AtcZoneRegistryIndex index;
+  int8_t err = atc_registrar_build_index(
+      &index, kUnsortedRegistry, UNSORTED_SIZE, seeds, ids, indexes);
+  ACU_ASSERT(err == kAtcErrOk);
+
+  AtcZoneRegistrar registrar;
+  atc_registrar_init(&registrar, kUnsortedRegistry, UNSORTED_SIZE);
+  atc_registrar_set_index(&registrar, &index);
+  for (uint16_t i = 0; i < UNSORTED_SIZE; i++) {
+    ACU_ASSERT(atc_registrar_find_by_name(
+        &registrar, kUnsortedRegistry[i]->name) == kUnsortedRegistry[i]);
+  }
+  ACU_ASSERT(atc_registrar_find_by_id(&registrar, 0x0) == NULL);
+}
+
+ACU_TEST(test_atc_registrar_index_errors)
+{
+  // Duplicate zone ids.
+  const AtcZoneInfo * const registry[] = {
+    &kAtcTestingZoneAmerica_Los_Angeles,
+    &kAtcTestingZoneAmerica_Denver,
+    &kAtcTestingZoneAmerica_Los_Angeles,
+  };
+  uint16_t seeds[ATC_REGISTRY_INDEX_NUM_BUCKETS(3)];
+  uint32_t ids[3];
+  uint16_t indexes[3];
+  AtcZoneRegistryIndex index;
+  int8_t err = atc_registrar_build_index(
+      &index, registry, 3, seeds, ids, indexes);
+  ACU_ASSERT(err == kAtcErrGeneric);
+
+  // An empty registry finds nothing.
+  err = atc_registrar_build_index(&index, registry, 0, seeds, ids, indexes);
+  ACU_ASSERT(err == kAtcErrOk);
+  AtcZoneRegistrar registrar;
+  atc_registrar_init(&registrar, registry, 0);
+  atc_registrar_set_index(&registrar, &index);
+  ACU_ASSERT(atc_registrar_find_by_id(
+      &registrar, kAtcTestingZoneAmerica_Denver.zone_id) == NULL);
+}
+
+ACU_TEST(test_atc_registrar_name_index_order)
+{
+  enum { kSize = kAtcAllZoneAndLinkRegistrySize };
+  static uint16_t indexes[kSize];
+  AtcZoneNameIndex name_index;
+  atc_registrar_build_name_index(
+      &name_index, kAtcAllZoneAndLinkRegistry, kSize, false, indexes);
+
+  AtcZoneRegistrar registrar;
+  atc_registrar_init(&registrar, kAtcAllZoneAndLinkRegistry, kSize);
+  ACU_ASSERT(atc_registrar_get_by_name_order(&registrar, 0) == NULL);
+  atc_registrar_set_name_index(&registrar, &name_index);
+
+  // Sorted, and a permutation of the registry.
+  static bool seen[kSize];
+  for (uint16_t i = 0; i < kSize; i++) {
+    ACU_ASSERT(indexes[i] < kSize);
+    ACU_ASSERT(! seen[indexes[i]]);
+    seen[indexes[i]] = true;
+    if (i > 0) {
+      const AtcZoneInfo *prev =
+          atc_registrar_get_by_name_order(&registrar, i - 1);
+      const AtcZoneInfo *curr =
+          atc_registrar_get_by_name_order(&registrar, i);
+      ACU_ASSERT(strcmp(prev->name, curr->name) < 0);
+    }
+  }
+  ACU_ASSERT(strcmp(atc_registrar_get_by_name_order(&registrar, 0)->name,
+      "Africa/Abidjan") == 0);
+  ACU_ASSERT(atc_registrar_get_by_name_order(&registrar, kSize) == NULL);
+
+  // Every name is found.
+  for (uint16_t i = 0; i < kSize; i++) {
+    const AtcZoneInfo *info = kAtcAllZoneAndLinkRegistry[i];
+    ACU_ASSERT(atc_registrar_find_by_name_index(&registrar, info->name)
+        == info);
+  }
+  ACU_ASSERT(atc_registrar_find_by_name_index(&registrar, "america/new_york")
+      == NULL);
+  ACU_ASSERT(atc_registrar_find_by_name_index(&registrar, "America/New")
+      == NULL);
+  ACU_ASSERT(atc_registrar_find_by_name_index(&registrar, "zzz") == NULL);
+}
+
+// Count the names which start with `prefix` by a linear scan.
+static uint16_t count_prefix(const char *prefix, bool fold_case)
+{
+  uint16_t count = 0;
+  for (uint16_t i = 0; i < kAtcAllZoneAndLinkRegistrySize; i++) {
+    const char *name = kAtcAllZoneAndLinkRegistry[i]->name;
+    size_t n = strlen(prefix);
+    bool match = fold_case
+        ? equal_ignore_case(name, prefix, n)
+        : strncmp(name, prefix, n) == 0;
+    if (match) count++;
+  }
+  return count;
+}
+
+ACU_TEST(test_atc_registrar_name_index_prefix)
+{
+  enum { kSize = kAtcAllZoneAndLinkRegistrySize };
+  static uint16_t indexes[kSize];
+  static uint16_t folded_indexes[kSize];
+  AtcZoneNameIndex name_index;
+  AtcZoneNameIndex folded_index;
+  atc_registrar_build_name_index(
+      &name_index, kAtcAllZoneAndLinkRegistry, kSize, false, indexes);
+  atc_registrar_build_name_index(
+      &folded_index, kAtcAllZoneAndLinkRegistry, kSize, true, folded_indexes);
+
+  AtcZoneRegistrar registrar;
+  atc_registrar_init(&registrar, kAtcAllZoneAndLinkRegistry, kSize);
+  uint16_t start;
+  ACU_ASSERT(atc_registrar_find_by_prefix(&registrar, "A", &start) == 0);
+
+  static const char * const prefixes[] = {
+    "", "A", "America/", "America/N", "america/n", "AMERICA/NEW_YORK",
+    "America/New_York", "America/New_Yorkx", "Etc/GMT+1", "US/", "Z", "zulu",
+    "~",
+  };
+  for (size_t i = 0; i < sizeof(prefixes) / sizeof(prefixes[0]); i++) {
+    const char *prefix = prefixes[i];
+    size_t n = strlen(prefix);
+
+    atc_registrar_set_name_index(&registrar, &name_index);
+    uint16_t count = atc_registrar_find_by_prefix(&registrar, prefix, &start);
+    ACU_ASSERT(count == count_prefix(prefix, false));
+    for (uint16_t j = start; j < start + count; j++) {
+      const AtcZoneInfo *info = atc_registrar_get_by_name_order(&registrar, j);
+      ACU_ASSERT(strncmp(info->name, prefix, n) == 0);
+    }
+
+    atc_registrar_set_name_index(&registrar, &folded_index);
+    count = atc_registrar_find_by_prefix(&registrar, prefix, &start);
+    ACU_ASSERT(count == count_prefix(prefix, true));
+    for (uint16_t j = start; j < start + count; j++) {
+      const AtcZoneInfo *info = atc_registrar_get_by_name_order(&registrar, j);
+      ACU_ASSERT(equal_ignore_case(info->name, prefix, n));
+    }
+  }
+
+  // Exact matches without regard to case.
+  ACU_ASSERT(atc_registrar_find_by_name_index(&registrar, "america/new_york")
+      == &kAtcAllZoneAmerica_New_York);
+  ACU_ASSERT(atc_registrar_find_by_name_index(&registrar, "US/PACIFIC")
+      == &kAtcAllZoneUS_Pacific);
+  ACU_ASSERT(atc_registrar_find_by_name_index(&registrar, "us/pacifi")
+      == NULL);
+}
+
+ACU_TEST(test_atc_registrar_name_index_empty)
+{
+  AtcZoneNameIndex name_index;
+  atc_registrar_build_name_index(
+      &name_index, kUnsortedRegistry, 0, true, NULL);
+  AtcZoneRegistrar registrar;
+  atc_registrar_init(&registrar, kUnsortedRegistry, 0);
+  atc_registrar_set_name_index(&registrar, &name_index);
+  uint16_t start;
+  ACU_ASSERT(atc_registrar_find_by_prefix(&registrar, "", &start) == 0);
+  ACU_ASSERT(atc_registrar_find_by_name_index(&registrar, "") == NULL);
+  ACU_ASSERT(atc_registrar_get_by_name_order(&registrar, 0) == NULL);
+}
+
 //---------------------------------------------------------------------------
 
 ACU_CONTEXT();
@@ -95,5 +317,11 @@ int main()
   ACU_RUN_TEST(test_atc_registrar_find_by_name_sorted);
   ACU_RUN_TEST(test_atc_registrar_find_by_id_unsorted);
   ACU_RUN_TEST(test_atc_registrar_find_by_name_unsorted);
+  ACU_RUN_TEST(test_atc_registrar_index_all_zones);
+  ACU_RUN_TEST(test_atc_registrar_index_unsorted);
+  ACU_RUN_TEST(test_atc_registrar_index_errors);
+  ACU_RUN_TEST(test_atc_registrar_name_index_order);
+  ACU_RUN_TEST(test_atc_registrar_name_index_prefix);
+  ACU_RUN_TEST(test_atc_registrar_name_index_empty);
   ACU_SUMMARY();
 }
@@ -0,0 +1,289 @@
+#include <string.h> // strcmp()
+#include <acunit.h>
+#include <acetimec.h>
+
+enum { kCapacity = 256 };
+
+//---------------------------------------------------------------------------
+
+static atc_time_t to_epoch_seconds(
+    int16_t year, uint8_t month, uint8_t day,
+    uint8_t hour, uint8_t minute, uint8_t second)
+{
+  AtcLocalDateTime ldt = {year, month, day, hour, minute, second, 0 /*fold*/};
+  return atc_local_date_time_to_epoch_seconds(&ldt);
+}
+
+// Verify that the transitions returned by the iterator are the same as the
+// transitions of an AtcCompiledZone over the same years, and that the offsets
+// on either side of each transition agree with the AtcZoneProcessor.
+static bool check_against_compiled_zone(
+    const AtcZoneInfo *zone_info,
+    int16_t start_year,
+    int16_t until_year)
+{
+  AtcCompiledTransition transitions[kCapacity];
+  AtcCompiledZone zone;
+  int8_t err = atc_compiled_zone_init(
+      &zone, zone_info, start_year, until_year, transitions, kCapacity);
+  if (err) return false;
+
+  AtcZoneTransitions iter;
+  err = atc_zone_transitions_begin(
+      &iter, zone_info, zone.start_epoch_seconds, zone.until_epoch_seconds);
+  if (err) return false;
+
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  atc_processor_init_for_zone_info(&processor, zone_info);
+
+  // Skip the initial transitions of the compiled zone before start_year.
+  uint16_t i = 0;
+  while (i < zone.num_transitions
+      && transitions[i].start_epoch_seconds < zone.start_epoch_seconds) {
+    i++;
+  }
+
+  AtcZoneTransition t;
+  AtcFindResult before;
+  AtcFindResult after;
+  while (atc_zone_transitions_next(&iter, &t)) {
+    if (i == 0 || i >= zone.num_transitions) return false;
+    const AtcCompiledTransition *ct = &transitions[i];
+    const AtcCompiledTransition *prev = &transitions[i - 1];
+    if (t.epoch_seconds != ct->start_epoch_seconds) return false;
+    if (t.std_offset_seconds != ct->std_offset_seconds) return false;
+    if (t.dst_offset_seconds != ct->dst_offset_seconds) return false;
+    if (strcmp(t.abbrev, zone.abbrevs[ct->abbrev_index]) != 0) return false;
+    if (t.old_offset_seconds
+        != prev->std_offset_seconds + prev->dst_offset_seconds) {
+      return false;
+    }
+    i++;
+
+    atc_processor_find_by_epoch_seconds(&processor, t.epoch_seconds - 1,
+        &before);
+    atc_processor_find_by_epoch_seconds(&processor, t.epoch_seconds, &after);
+    if (before.type == kAtcFindResultNotFound) return false;
+    if (after.type == kAtcFindResultNotFound) return false;
+    if (t.old_offset_seconds
+        != before.std_offset_seconds + before.dst_offset_seconds) {
+      return false;
+    }
+    if (t.new_offset_seconds
+        != after.std_offset_seconds + after.dst_offset_seconds) {
+      return false;
+    }
+  }
+  return i == zone.num_transitions;
+}
+
+//---------------------------------------------------------------------------
+
+ACU_TEST(test_atc_zone_transitions_los_angeles)
+{
+  AtcZoneTransitions iter;
+  AtcZoneTransition t;
+  int8_t err = atc_zone_transitions_begin(
+      &iter, &kAtcTestingZoneAmerica_Los_Angeles,
+      to_epoch_seconds(2022, 1, 1, 0, 0, 0),
+      to_epoch_seconds(2023, 1, 1, 0, 0, 0));
+  ACU_ASSERT(err == kAtcErrOk);
+
+  // 2022-03-13T02:00:00-08:00
+  ACU_ASSERT(atc_zone_transitions_next(&iter, &t));
+  ACU_ASSERT(t.epoch_seconds == to_epoch_seconds(2022, 3, 13, 10, 0, 0));
+  ACU_ASSERT(t.old_offset_seconds == -8*3600);
+  ACU_ASSERT(t.new_offset_seconds == -7*3600);
+  ACU_ASSERT(t.std_offset_seconds == -8*3600);
+  ACU_ASSERT(t.dst_offset_seconds == 1*3600);
+  ACU_ASSERT(strcmp(t.abbrev, "PDT") == 0);
+
+  // 2022-11-06T02:00:00-07:00
+  ACU_ASSERT(atc_zone_transitions_next(&iter, &t));
+  ACU_ASSERT(t.epoch_seconds == to_epoch_seconds(2022, 11, 6, 9, 0, 0));
+  ACU_ASSERT(t.old_offset_seconds == -7*3600);
+  ACU_ASSERT(t.new_offset_seconds == -8*3600);
+  ACU_ASSERT(t.std_offset_seconds == -8*3600);
+  ACU_ASSERT(t.dst_offset_seconds == 0);
+  ACU_ASSERT(strcmp(t.abbrev, "PST") == 0);
+
+  ACU_ASSERT(! atc_zone_transitions_next(&iter, &t));
+  // Stays exhausted.
+  ACU_ASSERT(! atc_zone_transitions_next(&iter, &t));
+}
+
+ACU_TEST(test_atc_zone_transitions_multiple_years)
+{
+  AtcZoneTransitions iter;
+  AtcZoneTransition t;
+  int8_t err = atc_zone_transitions_begin(
+      &iter, &kAtcTestingZoneAmerica_Los_Angeles,
+      to_epoch_seconds(2000, 1, 1, 0, 0, 0),
+      to_epoch_seconds(2030, 1, 1, 0, 0, 0));
+  ACU_ASSERT(err == kAtcErrOk);
+
+  uint16_t count = 0;
+  atc_time_t prev = kAtcInvalidEpochSeconds;
+  int32_t prev_offset = -8*3600;
+  while (atc_zone_transitions_next(&iter, &t)) {
+    ACU_ASSERT(prev == kAtcInvalidEpochSeconds || prev < t.epoch_seconds);
+    ACU_ASSERT(t.old_offset_seconds == prev_offset);
+    ACU_ASSERT(t.new_offset_seconds != t.old_offset_seconds);
+    prev = t.epoch_seconds;
+    prev_offset = t.new_offset_seconds;
+    count++;
+  }
+  // 2 transitions per year, without duplicates.
+  ACU_ASSERT(count == 2 * 30);
+}
+
+ACU_TEST(test_atc_zone_transitions_boundaries)
+{
+  atc_time_t spring = to_epoch_seconds(2022, 3, 13, 10, 0, 0);
+  atc_time_t fall = to_epoch_seconds(2022, 11, 6, 9, 0, 0);
+  AtcZoneTransitions iter;
+  AtcZoneTransition t;
+
+  // A transition at 'start' is included, a transition at 'until' is not.
+  int8_t err = atc_zone_transitions_begin(
+      &iter, &kAtcTestingZoneAmerica_Los_Angeles, spring, fall);
+  ACU_ASSERT(err == kAtcErrOk);
+  ACU_ASSERT(atc_zone_transitions_next(&iter, &t));
+  ACU_ASSERT(t.epoch_seconds == spring);
+  ACU_ASSERT(! atc_zone_transitions_next(&iter, &t));
+
+  // Interval spanning the end of a year, with no transitions.
+  err = atc_zone_transitions_begin(
+      &iter, &kAtcTestingZoneAmerica_Los_Angeles, fall + 1,
+      to_epoch_seconds(2023, 3, 12, 10, 0, 0));
+  ACU_ASSERT(err == kAtcErrOk);
+  ACU_ASSERT(! atc_zone_transitions_next(&iter, &t));
+
+  // One second later includes the spring transition of 2023.
+  err = atc_zone_transitions_begin(
+      &iter, &kAtcTestingZoneAmerica_Los_Angeles, fall + 1,
+      to_epoch_seconds(2023, 3, 12, 10, 0, 1));
+  ACU_ASSERT(err == kAtcErrOk);
+  ACU_ASSERT(atc_zone_transitions_next(&iter, &t));
+  ACU_ASSERT(t.epoch_seconds == to_epoch_seconds(2023, 3, 12, 10, 0, 0));
+  ACU_ASSERT(t.old_offset_seconds == -8*3600);
+  ACU_ASSERT(! atc_zone_transitions_next(&iter, &t));
+}
+
+ACU_TEST(test_atc_zone_transitions_fixed_offset)
+{
+  AtcZoneTransitions iter;
+  AtcZoneTransition t;
+  int8_t err = atc_zone_transitions_begin(
+      &iter, &kAtcTestingZoneEtc_UTC,
+      to_epoch_seconds(2000, 1, 1, 0, 0, 0),
+      to_epoch_seconds(2050, 1, 1, 0, 0, 0));
+  ACU_ASSERT(err == kAtcErrOk);
+  ACU_ASSERT(! atc_zone_transitions_next(&iter, &t));
+}
+
+ACU_TEST(test_atc_zone_transitions_errors)
+{
+  AtcZoneTransitions iter;
+  AtcZoneTransition t;
+  atc_time_t es = to_epoch_seconds(2022, 1, 1, 0, 0, 0);
+
+  // Empty interval.
+  int8_t err = atc_zone_transitions_begin(
+      &iter, &kAtcTestingZoneAmerica_Los_Angeles, es, es);
+  ACU_ASSERT(err == kAtcErrGeneric);
+  ACU_ASSERT(! atc_zone_transitions_next(&iter, &t));
+
+  // Invalid epoch seconds.
+  err = atc_zone_transitions_begin(
+      &iter, &kAtcTestingZoneAmerica_Los_Angeles, kAtcInvalidEpochSeconds, es);
+  ACU_ASSERT(err == kAtcErrGeneric);
+  ACU_ASSERT(! atc_zone_transitions_next(&iter, &t));
+
+  // No zone.
+  err = atc_zone_transitions_begin(&iter, NULL, es, es + 1);
+  ACU_ASSERT(err == kAtcErrGeneric);
+  ACU_ASSERT(! atc_zone_transitions_next(&iter, &t));
+}
+
+ACU_TEST(test_atc_zone_transitions_matches_compiled_zone_all_zones)
+{
+  for (uint16_t i = 0; i < kAtcAllZoneRegistrySize; i++) {
+    const AtcZoneInfo *zone_info = kAtcAllZoneRegistry[i];
+    ACU_ASSERT(check_against_compiled_zone(zone_info, 2000, 2050));
+  }
+}
+
+static bool transitions_equal(
+    const AtcZoneTransition *a,
+    const AtcZoneTransition *b)
+{
+  return a->epoch_seconds == b->epoch_seconds
+      && a->old_offset_seconds == b->old_offset_seconds
+      && a->new_offset_seconds == b->new_offset_seconds
+      && a->std_offset_seconds == b->std_offset_seconds
+      && a->dst_offset_seconds == b->dst_offset_seconds
+      && strcmp(a->abbrev, b->abbrev) == 0;
+}
+
+// Verify that atc_time_zone_next_transition() and
+// atc_time_zone_prev_transition() return the same transitions as the iterator.
+static bool check_against_time_zone(
+    const AtcZoneInfo *zone_info,
+    atc_time_t start_epoch_seconds,
+    atc_time_t until_epoch_seconds)
+{
+  AtcZoneTransitions iter;
+  int8_t err = atc_zone_transitions_begin(
+      &iter, zone_info, start_epoch_seconds, until_epoch_seconds);
+  if (err) return false;
+
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  AtcTimeZone tz = {zone_info, &processor};
+
+  AtcZoneTransition expected;
+  AtcZoneTransition next;
+  AtcZoneTransition prev;
+  atc_time_t epoch_seconds = start_epoch_seconds - 1;
+  while (atc_zone_transitions_next(&iter, &expected)) {
+    err = atc_time_zone_next_transition(&tz, epoch_seconds, &next);
+    if (err) return false;
+    if (! transitions_equal(&next, &expected)) return false;
+    err = atc_time_zone_prev_transition(&tz, expected.epoch_seconds, &prev);
+    if (err) return false;
+    if (! transitions_equal(&prev, &expected)) return false;
+    epoch_seconds = expected.epoch_seconds;
+  }
+
+  // No other transition before the end of the interval.
+  err = atc_time_zone_next_transition(&tz, epoch_seconds, &next);
+  return err != kAtcErrOk || next.epoch_seconds >= until_epoch_seconds;
+}
+
+ACU_TEST(test_atc_zone_transitions_matches_time_zone_all_zones)
+{
+  atc_time_t start = to_epoch_seconds(2000, 1, 1, 0, 0, 0);
+  atc_time_t until = to_epoch_seconds(2050, 1, 1, 0, 0, 0);
+  for (uint16_t i = 0; i < kAtcAllZoneRegistrySize; i++) {
+    const AtcZoneInfo *zone_info = kAtcAllZoneRegistry[i];
+    ACU_ASSERT(check_against_time_zone(zone_info, start, until));
+  }
+}
+
+//---------------------------------------------------------------------------
+
+ACU_CONTEXT();
+
+int main()
+{
+  ACU_RUN_TEST(test_atc_zone_transitions_los_angeles);
+  ACU_RUN_TEST(test_atc_zone_transitions_multiple_years);
+  ACU_RUN_TEST(test_atc_zone_transitions_boundaries);
+  ACU_RUN_TEST(test_atc_zone_transitions_fixed_offset);
+  ACU_RUN_TEST(test_atc_zone_transitions_errors);
+  ACU_RUN_TEST(test_atc_zone_transitions_matches_compiled_zone_all_zones);
+  ACU_RUN_TEST(test_atc_zone_transitions_matches_time_zone_all_zones);
+  ACU_SUMMARY();
+}
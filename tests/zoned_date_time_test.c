@@ -1,4 +1,4 @@
-#include <string.h> // strcmp
+#include <string.h> // strcmp, strlen
 #include <acunit.h>
 #include <acetimec.h>
 
@@ -677,6 +677,71 @@ ACU_TEST(test_zoned_date_time_print)
   ACU_ASSERT(strcmp(sb.p, expected) == 0);
 }
 
+ACU_TEST(test_zoned_date_time_parse)
+{
+  AtcZoneRegistrar registrar;
+  atc_registrar_init(&registrar,
+      kAtcTestingZoneAndLinkRegistry, kAtcTestingZoneAndLinkRegistrySize);
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+
+  // Without an offset, the local date time is resolved in the zone, so the
+  // time in the gap is shifted forward.
+  AtcZonedDateTime zdt;
+  const char *s = "2018-03-11T02:30:00[America/Los_Angeles]";
+  int8_t err = atc_zoned_date_time_parse(
+      &zdt, s, strlen(s), &registrar, &processor);
+  ACU_ASSERT(err == kAtcErrOk);
+  ACU_ASSERT(zdt.tz.zone_info == &kAtcTestingZoneAmerica_Los_Angeles);
+  ACU_ASSERT(zdt.tz.zone_processor == &processor);
+  ACU_ASSERT(zdt.hour == 3);
+  ACU_ASSERT(zdt.minute == 30);
+  ACU_ASSERT(zdt.offset_seconds == -7 * 3600);
+
+  // With an offset, the instant is converted to the zone.
+  s = "2018-03-11T10:30:00.000Z[America/Los_Angeles]";
+  err = atc_zoned_date_time_parse(&zdt, s, strlen(s), &registrar, &processor);
+  ACU_ASSERT(err == kAtcErrOk);
+  ACU_ASSERT(zdt.day == 11);
+  ACU_ASSERT(zdt.hour == 3);
+  ACU_ASSERT(zdt.minute == 30);
+  ACU_ASSERT(zdt.offset_seconds == -7 * 3600);
+
+  // Round trip with atc_zoned_date_time_print().
+  char buf[64];
+  AtcStringBuffer sb;
+  atc_buf_init(&sb, buf, sizeof(buf));
+  atc_zoned_date_time_print(&sb, &zdt);
+  atc_buf_close(&sb);
+  ACU_ASSERT(strcmp(sb.p, "2018-03-11T03:30:00-07:00[America/Los_Angeles]")
+      == 0);
+
+  // "UTC" is accepted even if it is not in the registry.
+  s = "2018-03-11T10:30:00+01:00[UTC]";
+  err = atc_zoned_date_time_parse(&zdt, s, strlen(s), &registrar, &processor);
+  ACU_ASSERT(err == kAtcErrOk);
+  ACU_ASSERT(zdt.tz.zone_info == NULL);
+  ACU_ASSERT(zdt.hour == 9);
+  ACU_ASSERT(zdt.offset_seconds == 0);
+
+  const char * const errors[] = {
+    "2018-03-11T02:30:00",
+    "2018-03-11T02:30:00Z",
+    "2018-03-11T02:30:00[]",
+    "2018-03-11T02:30:00[America/Los_Angeles",
+    "2018-03-11T02:30:00America/Los_Angeles]",
+    "2018-03-11T02:30:00[America/Unknown]",
+    "2018-03-11T02:30:00 [America/Los_Angeles]",
+    "2018-03-11T02:30:00[America/Los_Angeles]x",
+  };
+  for (size_t i = 0; i < sizeof(errors) / sizeof(errors[0]); i++) {
+    err = atc_zoned_date_time_parse(
+        &zdt, errors[i], strlen(errors[i]), &registrar, &processor);
+    ACU_ASSERT(err == kAtcErrGeneric);
+    ACU_ASSERT(atc_zoned_date_time_is_error(&zdt));
+  }
+}
+
 //---------------------------------------------------------------------------
 
 ACU_CONTEXT();
@@ -701,5 +766,6 @@ int main()
   ACU_RUN_TEST(test_zoned_date_time_convert);
   ACU_RUN_TEST(test_zoned_date_time_normalize);
   ACU_RUN_TEST(test_zoned_date_time_print);
+  ACU_RUN_TEST(test_zoned_date_time_parse);
   ACU_SUMMARY();
 }
@@ -0,0 +1,362 @@
+#include <string.h> // strcmp()
+#include <time.h> // strftime()
+#include <acunit.h>
+#include <acetimec.h>
+
+static char buf[255];
+
+ACU_TEST(test_atc_zoned_format_compile)
+{
+  AtcZonedFormat fmt;
+
+  // The date and the time are fused into single ops.
+  ACU_ASSERT(atc_zoned_format_compile(&fmt, "%Y-%m-%d %H:%M:%S %Z")
+      == kAtcErrOk);
+  ACU_ASSERT(fmt.num_ops == 5);
+  ACU_ASSERT(fmt.num_literals == 2);
+  ACU_ASSERT(atc_zoned_format_max_length(&fmt) == 19 + 1 + 6);
+  ACU_ASSERT(fmt.needs_extra);
+
+  // The shortcuts expand to the same program.
+  ACU_ASSERT(atc_zoned_format_compile(&fmt, "%F %T%:z") == kAtcErrOk);
+  ACU_ASSERT(fmt.num_ops == 4);
+  ACU_ASSERT(atc_zoned_format_max_length(&fmt) == 19 + 6);
+  ACU_ASSERT(!fmt.needs_extra);
+
+  // Other separators are not fused, and adjacent literals are merged.
+  ACU_ASSERT(atc_zoned_format_compile(&fmt, "%Y/%m/%d -- %H:%M") == kAtcErrOk);
+  ACU_ASSERT(fmt.num_ops == 9);
+  ACU_ASSERT(fmt.num_literals == 7);
+  ACU_ASSERT(atc_zoned_format_max_length(&fmt) == 19);
+
+  ACU_ASSERT(atc_zoned_format_compile(&fmt, "") == kAtcErrOk);
+  ACU_ASSERT(fmt.num_ops == 0);
+  ACU_ASSERT(atc_zoned_format_max_length(&fmt) == 0);
+
+  // Unsupported conversions.
+  ACU_ASSERT(atc_zoned_format_compile(&fmt, "%Q") == kAtcErrGeneric);
+  ACU_ASSERT(atc_zoned_format_compile(&fmt, "%Y%") == kAtcErrGeneric);
+  ACU_ASSERT(atc_zoned_format_compile(&fmt, "%:Z") == kAtcErrGeneric);
+
+  // Too many ops.
+  ACU_ASSERT(atc_zoned_format_compile(&fmt,
+      "%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y")
+      == kAtcErrOk);
+  ACU_ASSERT(atc_zoned_format_compile(&fmt,
+      "%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y%Y")
+      == kAtcErrGeneric);
+
+  // Too many literals.
+  ACU_ASSERT(atc_zoned_format_compile(&fmt,
+      "0123456789012345678901234567890123456789012345678901234567890123")
+      == kAtcErrOk);
+  ACU_ASSERT(atc_zoned_format_compile(&fmt,
+      "01234567890123456789012345678901234567890123456789012345678901234")
+      == kAtcErrGeneric);
+
+  // Longer than 255 characters.
+  ACU_ASSERT(atc_zoned_format_compile(&fmt,
+      "%A%A%A%A%A%A%A%A%A%A%A%A%A%A%A%A%A%A%A%A%A%A%A%A%A%A%A%A")
+      == kAtcErrOk);
+  ACU_ASSERT(atc_zoned_format_compile(&fmt,
+      "%A%A%A%A%A%A%A%A%A%A%A%A%A%A%A%A%A%A%A%A%A%A%A%A%A%A%A%A%A")
+      == kAtcErrGeneric);
+}
+
+ACU_TEST(test_atc_zoned_format_print_zone)
+{
+  int16_t saved_epoch_year = atc_get_current_epoch_year();
+  atc_set_current_epoch_year(2000);
+
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  AtcTimeZone tz = {&kAtcTestingZoneAmerica_Los_Angeles, &processor};
+
+  AtcZonedFormat fmt;
+  ACU_ASSERT(atc_zoned_format_compile(&fmt, "%Y-%m-%d %H:%M:%S %Z (%z) %%")
+      == kAtcErrOk);
+
+  AtcZonedDateTime zdt;
+  AtcZonedExtra extra;
+  atc_zoned_date_time_from_epoch_seconds(&zdt, 0, &tz);
+  atc_zoned_extra_from_epoch_seconds(&extra, 0, &tz);
+
+  AtcStringBuffer sb;
+  atc_buf_init(&sb, buf, sizeof(buf));
+  ACU_ASSERT(atc_zoned_format_print(&sb, &fmt, &zdt, &extra) == kAtcErrOk);
+  atc_buf_close(&sb);
+  ACU_ASSERT(strcmp(sb.p, "1999-12-31 16:00:00 PST (-0800) %") == 0);
+
+  atc_zoned_date_time_from_epoch_seconds(&zdt, 86400 * 181, &tz);
+  atc_zoned_extra_from_epoch_seconds(&extra, 86400 * 181, &tz);
+  AtcLargeStringBuffer large;
+  atc_large_buf_init(&large, buf, sizeof(buf));
+  ACU_ASSERT(atc_zoned_format_print_large(&large, &fmt, &zdt, &extra)
+      == kAtcErrOk);
+  atc_large_buf_close(&large);
+  ACU_ASSERT(strcmp(large.p, "2000-06-29 17:00:00 PDT (-0700) %") == 0);
+
+  // The extra is required by %Z.
+  atc_buf_reset(&sb);
+  ACU_ASSERT(atc_zoned_format_print(&sb, &fmt, &zdt, NULL) == kAtcErrGeneric);
+  ACU_ASSERT(sb.size == 0);
+
+  // But not otherwise.
+  ACU_ASSERT(atc_zoned_format_compile(&fmt, "%FT%T%:z") == kAtcErrOk);
+  ACU_ASSERT(atc_zoned_format_print(&sb, &fmt, &zdt, NULL) == kAtcErrOk);
+  atc_buf_close(&sb);
+  ACU_ASSERT(strcmp(sb.p, "2000-06-29T17:00:00-07:00") == 0);
+
+  atc_set_current_epoch_year(saved_epoch_year);
+}
+
+ACU_TEST(test_atc_zoned_format_print_errors)
+{
+  AtcZonedFormat fmt;
+  ACU_ASSERT(atc_zoned_format_compile(&fmt, "%F %T") == kAtcErrOk);
+  AtcZonedDateTime zdt = {
+    2024, 3, 9, 7, 5, 3, 0 /*fold*/, 0 /*offset_seconds*/, {NULL, NULL}
+  };
+
+  // The capacity must cover the maximum length.
+  AtcStringBuffer sb;
+  atc_buf_init(&sb, buf, 18);
+  ACU_ASSERT(atc_zoned_format_print(&sb, &fmt, &zdt, NULL) == kAtcErrGeneric);
+  ACU_ASSERT(sb.size == 0);
+  atc_buf_init(&sb, buf, 20);
+  ACU_ASSERT(atc_zoned_format_print(&sb, &fmt, &zdt, NULL) == kAtcErrOk);
+  atc_buf_close(&sb);
+  ACU_ASSERT(strcmp(sb.p, "2024-03-09 07:05:03") == 0);
+
+  // Invalid or unprintable dates.
+  atc_buf_reset(&sb);
+  zdt.year = 10000;
+  ACU_ASSERT(atc_zoned_format_print(&sb, &fmt, &zdt, NULL) == kAtcErrGeneric);
+  atc_zoned_date_time_set_error(&zdt);
+  ACU_ASSERT(atc_zoned_format_print(&sb, &fmt, &zdt, NULL) == kAtcErrGeneric);
+  ACU_ASSERT(sb.size == 0);
+}
+
+// Compare the fields which do not depend on the time zone against strftime()
+// in the "C" locale, for every day of 3 years and various hours.
+static void assert_matches_strftime(
+    AcuContext *acu_context, const char *pattern)
+{
+  AtcZonedFormat fmt;
+  ACU_ASSERT(atc_zoned_format_compile(&fmt, pattern) == kAtcErrOk);
+
+  // 2000-01-01 was a Saturday.
+  AtcZonedDateTime zdt = {
+    2000, 1, 1, 0, 0, 0, 0 /*fold*/, 0 /*offset_seconds*/, {NULL, NULL}
+  };
+  struct tm tm;
+  memset(&tm, 0, sizeof(tm));
+  tm.tm_wday = 6;
+
+  for (int i = 0; i < 3 * 366; i++) {
+    zdt.hour = (uint8_t) (i % 24);
+    zdt.minute = (uint8_t) (i % 60);
+    zdt.second = (uint8_t) ((i * 7) % 60);
+
+    tm.tm_year = zdt.year - 1900;
+    tm.tm_mon = zdt.month - 1;
+    tm.tm_mday = zdt.day;
+    tm.tm_hour = zdt.hour;
+    tm.tm_min = zdt.minute;
+    tm.tm_sec = zdt.second;
+    char expected[128];
+    strftime(expected, sizeof(expected), pattern, &tm);
+
+    AtcStringBuffer sb;
+    atc_buf_init(&sb, buf, sizeof(buf));
+    ACU_ASSERT(atc_zoned_format_print(&sb, &fmt, &zdt, NULL) == kAtcErrOk);
+    atc_buf_close(&sb);
+    ACU_ASSERT(strcmp(sb.p, expected) == 0);
+
+    // Next day
+    tm.tm_wday = (tm.tm_wday + 1) % 7;
+    tm.tm_yday++;
+    zdt.day++;
+    if (zdt.day > atc_local_date_days_in_year_month(zdt.year, zdt.month)) {
+      zdt.day = 1;
+      zdt.month++;
+      if (zdt.month > 12) {
+        zdt.month = 1;
+        zdt.year++;
+        tm.tm_yday = 0;
+      }
+    }
+  }
+}
+
+ACU_TEST(test_atc_zoned_format_print_matches_strftime)
+{
+  ACU_ASSERT_NO_FATAL_FAILURE(
+      assert_matches_strftime(acu_context, "%Y %y %m %b %B %d %e %j %%"));
+  ACU_ASSERT_NO_FATAL_FAILURE(
+      assert_matches_strftime(acu_context, "%a %A %u %H %I %p %M %S"));
+  ACU_ASSERT_NO_FATAL_FAILURE(
+      assert_matches_strftime(acu_context, "%FT%T"));
+  ACU_ASSERT_NO_FATAL_FAILURE(
+      assert_matches_strftime(acu_context, "%Y-%m-%d|%H:%M:%S|%m-%d-%Y"));
+}
+
+// Print the epoch_seconds using a new AtcZonedDateTime and AtcZonedExtra,
+// which is the expected output of the AtcTimestampRenderer.
+static void print_expected(
+    char *expected, size_t size,
+    const AtcZonedFormat *fmt,
+    const AtcTimeZone *tz,
+    atc_time_t epoch_seconds)
+{
+  AtcZonedDateTime zdt;
+  AtcZonedExtra extra;
+  atc_zoned_date_time_from_epoch_seconds(&zdt, epoch_seconds, tz);
+  atc_zoned_extra_from_epoch_seconds(&extra, epoch_seconds, tz);
+  AtcStringBuffer sb;
+  atc_buf_init(&sb, expected, (uint8_t) size);
+  atc_zoned_format_print(&sb, fmt, &zdt, &extra);
+  atc_buf_close(&sb);
+}
+
+ACU_TEST(test_atc_timestamp_renderer_print)
+{
+  int16_t saved_epoch_year = atc_get_current_epoch_year();
+  atc_set_current_epoch_year(2000);
+
+  AtcZoneProcessor processor;
+  atc_processor_init(&processor);
+  AtcTimeZone tz = {&kAtcTestingZoneAmerica_Los_Angeles, &processor};
+  AtcZoneProcessor expected_processor;
+  atc_processor_init(&expected_processor);
+  AtcTimeZone expected_tz = {
+    &kAtcTestingZoneAmerica_Los_Angeles, &expected_processor
+  };
+
+  AtcZonedFormat fmt;
+  ACU_ASSERT(atc_zoned_format_compile(&fmt,
+      "%a %F %T %I:%M%p %Z %z|%H%S") == kAtcErrOk);
+  AtcTimestampRenderer renderer;
+  atc_timestamp_renderer_init(&renderer, &fmt, &tz);
+
+  // Step through the year 2000, which crosses both DST transitions of
+  // Los_Angeles, with steps of a few seconds to a few hours, and some steps
+  // backwards.
+  char expected[128];
+  uint32_t state = 1;
+  atc_time_t epoch_seconds = 0;
+  for (int i = 0; i < 20000; i++) {
+    state = state * 1103515245u + 12345u;
+    uint32_t r = (state >> 16) % 1000;
+    if (r < 300) {
+      // Same second
+    } else if (r < 990) {
+      epoch_seconds += (atc_time_t) (r * 2);
+    } else {
+      epoch_seconds -= (atc_time_t) (r * 10);
+    }
+
+    AtcStringBuffer sb;
+    atc_buf_init(&sb, buf, sizeof(buf));
+    ACU_ASSERT(atc_timestamp_renderer_print(&renderer, &sb, epoch_seconds)
+        == kAtcErrOk);
+    atc_buf_close(&sb);
+    print_expected(expected, sizeof(expected), &fmt, &expected_tz,
+        epoch_seconds);
+    ACU_ASSERT(strcmp(sb.p, expected) == 0);
+  }
+  ACU_ASSERT(renderer.num_second_hits > 0);
+  ACU_ASSERT(renderer.num_day_hits > renderer.num_misses);
+
+  // Every second around the DST transitions, 2000-04-02 02:00 PST and
+  // 2000-10-29 02:00 PDT.
+  const atc_time_t transitions[] = {
+    atc_epoch_seconds_from_unix_seconds(954669600),
+    atc_epoch_seconds_from_unix_seconds(972810000),
+  };
+  for (int t = 0; t < 2; t++) {
+    for (int32_t i = -3600; i < 3600; i++) {
+      epoch_seconds = transitions[t] + i;
+      AtcLargeStringBuffer sb;
+      atc_large_buf_init(&sb, buf, sizeof(buf));
+      ACU_ASSERT(atc_timestamp_renderer_print_large(
+          &renderer, &sb, epoch_seconds) == kAtcErrOk);
+      atc_large_buf_close(&sb);
+      print_expected(expected, sizeof(expected), &fmt, &expected_tz,
+          epoch_seconds);
+      ACU_ASSERT(strcmp(sb.p, expected) == 0);
+    }
+  }
+
+  atc_set_current_epoch_year(saved_epoch_year);
+}
+
+ACU_TEST(test_atc_timestamp_renderer_memoization)
+{
+  int16_t saved_epoch_year = atc_get_current_epoch_year();
+  atc_set_current_epoch_year(2000);
+
+  AtcZonedFormat fmt;
+  ACU_ASSERT(atc_zoned_format_compile(&fmt, "%FT%T%:z") == kAtcErrOk);
+  AtcTimestampRenderer renderer;
+  atc_timestamp_renderer_init(&renderer, &fmt, &atc_time_zone_utc);
+
+  AtcStringBuffer sb;
+  atc_buf_init(&sb, buf, sizeof(buf));
+  ACU_ASSERT(atc_timestamp_renderer_print(&renderer, &sb, 86399)
+      == kAtcErrOk);
+  ACU_ASSERT(atc_timestamp_renderer_print(&renderer, &sb, 86399)
+      == kAtcErrOk);
+  ACU_ASSERT(atc_timestamp_renderer_print(&renderer, &sb, 86400)
+      == kAtcErrOk);
+  ACU_ASSERT(atc_timestamp_renderer_print(&renderer, &sb, 86401)
+      == kAtcErrOk);
+  atc_buf_close(&sb);
+  ACU_ASSERT(strcmp(sb.p,
+      "2000-01-01T23:59:59+00:00"
+      "2000-01-01T23:59:59+00:00"
+      "2000-01-02T00:00:00+00:00"
+      "2000-01-02T00:00:01+00:00") == 0);
+  ACU_ASSERT(renderer.num_misses == 2);
+  ACU_ASSERT(renderer.num_second_hits == 1);
+  ACU_ASSERT(renderer.num_day_hits == 1);
+
+  // Not enough room prints nothing.
+  atc_buf_init(&sb, buf, 24);
+  ACU_ASSERT(atc_timestamp_renderer_print(&renderer, &sb, 86402)
+      == kAtcErrGeneric);
+  ACU_ASSERT(sb.size == 0);
+
+  // The epoch year changed, so the memoized text must be discarded.
+  atc_set_current_epoch_year(2050);
+  atc_timestamp_renderer_reset(&renderer);
+  atc_buf_init(&sb, buf, sizeof(buf));
+  ACU_ASSERT(atc_timestamp_renderer_print(&renderer, &sb, 86402)
+      == kAtcErrOk);
+  atc_buf_close(&sb);
+  ACU_ASSERT(strcmp(sb.p, "2050-01-02T00:00:02+00:00") == 0);
+  ACU_ASSERT(renderer.num_misses == 3);
+
+  // Invalid epoch seconds.
+  atc_buf_reset(&sb);
+  ACU_ASSERT(atc_timestamp_renderer_print(
+      &renderer, &sb, kAtcInvalidEpochSeconds) == kAtcErrGeneric);
+  ACU_ASSERT(sb.size == 0);
+
+  atc_set_current_epoch_year(saved_epoch_year);
+}
+
+//---------------------------------------------------------------------------
+
+ACU_CONTEXT();
+
+int main()
+{
+  ACU_RUN_TEST(test_atc_zoned_format_compile);
+  ACU_RUN_TEST(test_atc_zoned_format_print_zone);
+  ACU_RUN_TEST(test_atc_zoned_format_print_errors);
+  ACU_RUN_TEST(test_atc_zoned_format_print_matches_strftime);
+  ACU_RUN_TEST(test_atc_timestamp_renderer_print);
+  ACU_RUN_TEST(test_atc_timestamp_renderer_memoization);
+  ACU_SUMMARY();
+}